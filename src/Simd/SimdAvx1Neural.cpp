@@ -25,6 +25,7 @@
 #include "Simd/SimdStore.h"
 #include "Simd/SimdExtract.h"
 #include "Simd/SimdBase.h"
+#include "Simd/SimdNeural.h"
 
 namespace Simd
 {
@@ -1135,7 +1136,7 @@ namespace Simd
                     sums[1] = _mm256_add_ps(sums[1], _mm256_mul_ps(a1, Load<align>(b)));
                 }
 
-                template <bool align> void Execute(size_t M, size_t N, size_t K, const float * a, const float * b, float * c)
+                template <bool align> void Execute(size_t M, size_t N, size_t K, const float * a, const float * b, float * c, const NeuralConvolution * epilogue)
                 {
                     size_t M2 = Simd::AlignLo(M, 2);
                     size_t N4 = Simd::AlignLo(N, 4);
@@ -1189,6 +1190,8 @@ namespace Simd
                             pc0[j] += Avx::ExtractSum(sums[0]);
                             pc1[j] += Avx::ExtractSum(sums[1]);
                         }
+                        if (epilogue)
+                            epilogue->Epilogue(i, 2, c + i*N);
                     }
                     for (; i < M; ++i)
                     {
@@ -1229,15 +1232,17 @@ namespace Simd
                             }
                             pc[j] += Avx::ExtractSum(sum);
                         }
+                        if (epilogue)
+                            epilogue->Epilogue(i, 1, c + i*N);
                     }
                 }
 
-                void Execute(size_t M, size_t N, size_t K, const float * a, const float * b, float * c)
+                void Execute(size_t M, size_t N, size_t K, const float * a, const float * b, float * c, const NeuralConvolution * epilogue = NULL)
                 {
                     if (Aligned(K, F))
-                        Execute<true>(M, N, K, a, b, c);
+                        Execute<true>(M, N, K, a, b, c, epilogue);
                     else
-                        Execute<false>(M, N, K, a, b, c);
+                        Execute<false>(M, N, K, a, b, c, epilogue);
                 }
             }
 
@@ -1487,7 +1492,7 @@ namespace Simd
                     AddSums8(sums, 4, mask, c, N);
                 }
 
-                template <bool align> void Execute4x8(size_t M, size_t N, size_t K, const float * a, const float * b, float * c)
+                template <bool align> void Execute4x8(size_t M, size_t N, size_t K, const float * a, const float * b, float * c, const NeuralConvolution * epilogue)
                 {
                     size_t M4 = Simd::AlignLo(M, 4);
                     size_t N8 = Simd::AlignLo(N, 8);
@@ -1501,6 +1506,8 @@ namespace Simd
                             Kernel4x8<align>(N, K, a + i*K, b + j*K, c + i*N + j, NULL);
                         if (N8 < N)
                             Kernel4x8<align>(N, K, a + i*K, b + j*K, c + i*N + j, tail);
+                        if (epilogue)
+                            epilogue->Epilogue(i, 4, c + i*N);
                     }
                     if (M4 < M)
                     {
@@ -1509,6 +1516,8 @@ namespace Simd
                             KernelMx8<align>(N, K, a + i*K, b + j*K, c + i*N + j, NULL, M - M4);
                         if (N8 < N)
                             KernelMx8<align>(N, K, a + i*K, b + j*K, c + i*N + j, tail, M - M4);
+                        if (epilogue)
+                            epilogue->Epilogue(i, M - M4, c + i*N);
                     }
                 }
 
@@ -1580,7 +1589,7 @@ namespace Simd
                     AddSums16(sums, 4, mask, c, N);
                 }
 
-                template <bool align> void Execute4x16(size_t M, size_t N, size_t K, const float * a, const float * b, float * c)
+                template <bool align> void Execute4x16(size_t M, size_t N, size_t K, const float * a, const float * b, float * c, const NeuralConvolution * epilogue)
                 {
                     size_t M4 = Simd::AlignLo(M, 4);
                     size_t N16 = Simd::AlignLo(N, 16);
@@ -1594,6 +1603,8 @@ namespace Simd
                             Kernel4x16<align>(N, K, a + i*K, b + j*K, c + i*N + j, NULL);
                         if (N16 < N)
                             Kernel4x16<align>(N, K, a + i*K, b + j*K, c + i*N + j, tail);
+                        if (epilogue)
+                            epilogue->Epilogue(i, 4, c + i*N);
                     }
                     if (M4 < M)
                     {
@@ -1602,17 +1613,19 @@ namespace Simd
                             KernelMx16<align>(N, K, a + i*K, b + j*K, c + i*N + j, NULL, M - M4);
                         if (N16 < N)
                             KernelMx16<align>(N, K, a + i*K, b + j*K, c + i*N + j, tail, M - M4);
+                        if (epilogue)
+                            epilogue->Epilogue(i, M - M4, c + i*N);
                     }
                 }
 
-                void Execute(size_t M, size_t N, size_t K, const float * a, const float * b, float * c, size_t cellA, size_t cellB)
+                void Execute(size_t M, size_t N, size_t K, const float * a, const float * b, float * c, size_t cellA, size_t cellB, const NeuralConvolution * epilogue = NULL)
                 {
                     if (cellA == 4)
                     {
                         if (cellB == 8)
-                            Execute4x8<false>(M, N, K, a, b, c);
+                            Execute4x8<false>(M, N, K, a, b, c, epilogue);
                         if (cellB == 16)
-                            Execute4x16<false>(M, N, K, a, b, c);
+                            Execute4x16<false>(M, N, K, a, b, c, epilogue);
                     }
                 }
             }
@@ -1642,7 +1655,7 @@ namespace Simd
                 }
 
                 template <bool align, size_t kernelX, size_t kernelY> void AddConvolution8x8(const float * src, size_t srcWidth, size_t srcHeight, size_t srcDepth,
-                    const float * weight, float * dst, size_t dstDepth)
+                    const float * weight, float * dst, size_t dstDepth, const NeuralConvolution * epilogue)
                 {
                     __m256 _weight[kernelX*kernelY];
                     for (size_t dstChannel = 0; dstChannel < dstDepth; ++dstChannel)
@@ -1685,15 +1698,17 @@ namespace Simd
                         }
                         for (size_t row = 0; row < 8; ++row, dst += 8)
                             Avx::Store<align>(dst, _dst[row]);
+                        if (epilogue)
+                            epilogue->Epilogue(dstChannel, 1, dst - 64);
                     }
                 }
 
                 template <bool align, size_t kernelX, size_t kernelY> void AddConvolution(const float * src, size_t srcWidth, size_t srcHeight, size_t srcDepth,
-                    const float * weight, float * dst, size_t dstWidth, size_t dstHeight, size_t dstDepth)
+                    const float * weight, float * dst, size_t dstWidth, size_t dstHeight, size_t dstDepth, const NeuralConvolution * epilogue)
                 {
                     if (dstWidth == 8 && dstHeight == 8)
                     {
-                        AddConvolution8x8<align, kernelX, kernelY>(src, srcWidth, srcHeight, srcDepth, weight, dst, dstDepth);
+                        AddConvolution8x8<align, kernelX, kernelY>(src, srcWidth, srcHeight, srcDepth, weight, dst, dstDepth, epilogue);
                         return;
                     }
                     size_t alignedWidth = AlignLo(dstWidth, F);
@@ -1728,20 +1743,22 @@ namespace Simd
                             }
                         }
                     }
+                    if (epilogue)
+                        epilogue->Epilogue(0, dstDepth, dst);
                 }
 
                 void Execute(const float * src, size_t srcWidth, size_t srcHeight, size_t srcDepth,
-                    const float * weight, size_t kernelX, size_t kernelY, float * dst, size_t dstWidth, size_t dstHeight, size_t dstDepth)
+                    const float * weight, size_t kernelX, size_t kernelY, float * dst, size_t dstWidth, size_t dstHeight, size_t dstDepth, const NeuralConvolution * epilogue = NULL)
                 {
                     assert(kernelX == kernelY);
                     if (kernelX == 2)
-                        AddConvolution<false, 2, 2>(src, srcWidth, srcHeight, srcDepth, weight, dst, dstWidth, dstHeight, dstDepth);
+                        AddConvolution<false, 2, 2>(src, srcWidth, srcHeight, srcDepth, weight, dst, dstWidth, dstHeight, dstDepth, epilogue);
                     else if (kernelX == 3)
-                        AddConvolution<false, 3, 3>(src, srcWidth, srcHeight, srcDepth, weight, dst, dstWidth, dstHeight, dstDepth);
+                        AddConvolution<false, 3, 3>(src, srcWidth, srcHeight, srcDepth, weight, dst, dstWidth, dstHeight, dstDepth, epilogue);
                     else if (kernelX == 4)
-                        AddConvolution<false, 4, 4>(src, srcWidth, srcHeight, srcDepth, weight, dst, dstWidth, dstHeight, dstDepth);
+                        AddConvolution<false, 4, 4>(src, srcWidth, srcHeight, srcDepth, weight, dst, dstWidth, dstHeight, dstDepth, epilogue);
                     else if (kernelX == 5)
-                        AddConvolution<false, 5, 5>(src, srcWidth, srcHeight, srcDepth, weight, dst, dstWidth, dstHeight, dstDepth);
+                        AddConvolution<false, 5, 5>(src, srcWidth, srcHeight, srcDepth, weight, dst, dstWidth, dstHeight, dstDepth, epilogue);
                     else
                         assert(0);
                 }
@@ -1879,6 +1896,136 @@ namespace Simd
             private:
                 void * _data;
             };
+
+            void PrepareB(const Opt & opt, const float * src, size_t srcWidth, size_t srcHeight, size_t srcDepth, size_t kernelX, size_t kernelY,
+                size_t padX, size_t padY, size_t strideX, size_t strideY, size_t dilationX, size_t dilationY, Data & data, size_t dstWidth, size_t dstHeight)
+            {
+                if (opt.sizeB)
+                {
+                    switch (opt.alg)
+                    {
+                    case Opt::Ver0: Ver0::PrepareB(src, srcWidth, srcHeight, srcDepth, kernelX, kernelY, padX, padY, strideX, strideY, dilationX, dilationY, dstWidth, dstHeight, data.b); break;
+                    case Opt::Ver1: Ver1::PrepareB(src, srcWidth, srcHeight, srcDepth, kernelX, kernelY, padX, padY, strideX, strideY, dilationX, dilationY, dstWidth, dstHeight, opt.cellB, data.t, data.b); break;
+                    case Opt::Ver2: Ver2::PrepareB(src, srcWidth, srcHeight, srcDepth, padX, padY, data.b, opt.paddedW, opt.paddedH); break;
+                    default: break;
+                    }
+                }
+                else
+                    data.b = (float*)src;
+            }
+
+            void Execute(const Opt & opt, size_t srcDepth, const float * weight, size_t kernelX, size_t kernelY, const Data & data, 
+                float * dst, size_t dstWidth, size_t dstHeight, size_t dstDepth, const NeuralConvolution * epilogue = NULL)
+            {
+                switch (opt.alg)
+                {
+                case Opt::Ver0: Ver0::Execute(dstDepth, opt.N, opt.K, weight, data.b, dst, epilogue); break;
+                case Opt::Ver1: Ver1::Execute(dstDepth, opt.N, opt.K, weight, data.b, dst, opt.cellA, opt.cellB, epilogue); break;
+                case Opt::Ver2: Ver2::Execute(data.b, opt.paddedW, opt.paddedH, srcDepth, weight, kernelX, kernelY, dst, dstWidth, dstHeight, dstDepth, epilogue); break;
+                default: break;
+                }
+            }
+
+            void Forward(const Opt & opt, const float * src, size_t srcWidth, size_t srcHeight, size_t srcDepth, const float * weight, size_t kernelX, size_t kernelY,
+                size_t padX, size_t padY, size_t strideX, size_t strideY, size_t dilationX, size_t dilationY, Data & data, float * dst, size_t dstWidth, size_t dstHeight, size_t dstDepth)
+            {
+                PrepareB(opt, src, srcWidth, srcHeight, srcDepth, kernelX, kernelY, padX, padY, strideX, strideY, dilationX, dilationY, data, dstWidth, dstHeight);
+                Execute(opt, srcDepth, weight, kernelX, kernelY, data, dst, dstWidth, dstHeight, dstDepth);
+            }
+
+            template <SimdNeuralActivationType type> SIMD_INLINE __m256 Activate(__m256 value, const __m256 * params);
+
+            template <> SIMD_INLINE __m256 Activate<SimdNeuralActivationIdentity>(__m256 value, const __m256 * params)
+            {
+                return value;
+            }
+
+            template <> SIMD_INLINE __m256 Activate<SimdNeuralActivationTanh>(__m256 value, const __m256 * params)
+            {
+                __m256 x = _mm256_andnot_ps(params[4], _mm256_mul_ps(value, params[0]));
+                __m256 x2 = _mm256_mul_ps(x, x);
+                __m256 x4 = _mm256_mul_ps(x2, x2);
+                __m256 pe = _mm256_add_ps(_mm256_add_ps(params[2], x), _mm256_add_ps(_mm256_mul_ps(x2, params[5]), _mm256_mul_ps(x4, params[6])));
+                __m256 ne = _mm256_rcp_ps(pe);
+                __m256 absTanh = _mm256_mul_ps(_mm256_sub_ps(pe, ne), _mm256_rcp_ps(_mm256_add_ps(pe, ne)));
+                return _mm256_xor_ps(absTanh, _mm256_and_ps(params[4], _mm256_cmp_ps(params[4], value, _CMP_GT_OS)));
+            }
+
+            template <> SIMD_INLINE __m256 Activate<SimdNeuralActivationSigmoid>(__m256 value, const __m256 * params)
+            {
+                __m256 e1 = _mm256_max_ps(params[3], _mm256_sub_ps(params[2], _mm256_mul_ps(value, params[1])));
+                __m256 e2 = _mm256_mul_ps(e1, e1);
+                __m256 e4 = _mm256_mul_ps(e2, e2);
+                __m256 e8 = _mm256_mul_ps(e4, e4);
+                __m256 e16 = _mm256_mul_ps(e8, e8);
+                __m256 e32 = _mm256_mul_ps(e16, e16);
+                __m256 e64 = _mm256_mul_ps(e32, e32);
+                return _mm256_rcp_ps(_mm256_add_ps(params[2], _mm256_mul_ps(e64, e64)));
+            }
+
+            template <> SIMD_INLINE __m256 Activate<SimdNeuralActivationRelu>(__m256 value, const __m256 * params)
+            {
+                return _mm256_max_ps(_mm256_mul_ps(params[0], value), value);
+            }
+
+            struct Convolution : public NeuralConvolution
+            {
+                Convolution(size_t srcWidth, size_t srcHeight, size_t srcDepth, const float * weight, size_t kernelX, size_t kernelY, size_t padX, size_t padY,
+                    size_t strideX, size_t strideY, size_t dilationX, size_t dilationY, size_t dstWidth, size_t dstHeight, size_t dstDepth,
+                    const float * bias, SimdNeuralActivationType activation, const float * slope)
+                    : NeuralConvolution(srcWidth, srcHeight, srcDepth, kernelX, kernelY, padX, padY, strideX, strideY, dilationX, dilationY, dstWidth, dstHeight, dstDepth,
+                        bias, activation, slope)
+                    , _opt(srcWidth, srcHeight, srcDepth, kernelX, kernelY, padX, padY, strideX, strideY, dilationX, dilationY, dstWidth, dstHeight, dstDepth)
+                {
+                    size_t size = _opt.sizeA ? _opt.sizeA : _opt.M*_opt.K;
+                    this->weight = (float*)Allocate(AlignHi(size, F) * sizeof(float));
+                    if (_opt.alg == Opt::Ver1)
+                        Ver1::PrepareA(weight, _opt.M, _opt.K, _opt.cellA, this->weight);
+                    else
+                        memcpy(this->weight, weight, size * sizeof(float));
+                }
+
+                virtual void Run(const float * src, void * buffer, size_t * size, float * dst, int add) const
+                {
+                    if (!add)
+                        memset(dst, 0, dstWidth*dstHeight*dstDepth * sizeof(float));
+
+                    Data data(0, _opt.sizeB, _opt.sizeT, buffer, size);
+
+                    PrepareB(_opt, src, srcWidth, srcHeight, srcDepth, kernelX, kernelY, padX, padY, strideX, strideY, dilationX, dilationY, data, dstWidth, dstHeight);
+                    Execute(_opt, srcDepth, weight, kernelX, kernelY, data, dst, dstWidth, dstHeight, dstDepth, HasEpilogue() ? this : NULL);
+                }
+
+            private:
+                template <SimdNeuralActivationType type> void Epilogue(size_t channel, size_t count, float * dst) const
+                {
+                    size_t size = dstWidth*dstHeight, aligned = AlignLo(size, F);
+                    __m256 params[7] = { _mm256_set1_ps(slope), _mm256_set1_ps(slope*0.0078125f), _mm256_set1_ps(1.0f), _mm256_set1_ps(0.5f), _mm256_set1_ps(-0.0f), _mm256_set1_ps(0.5658f), _mm256_set1_ps(0.1430f) };
+                    for (size_t c = channel; c < channel + count; ++c)
+                    {
+                        __m256 _bias = _mm256_set1_ps(bias ? bias[c] : 0.0f);
+                        size_t i = 0;
+                        for (; i < aligned; i += F)
+                            Store<false>(dst + i, Ncf::Activate<type>(_mm256_add_ps(Load<false>(dst + i), _bias), params));
+                        NeuralConvolution::Epilogue(c, i, size, dst);
+                        dst += size;
+                    }
+                }
+
+                virtual void Epilogue(size_t channel, size_t count, float * dst) const
+                {
+                    switch (activation)
+                    {
+                    case SimdNeuralActivationIdentity: Epilogue<SimdNeuralActivationIdentity>(channel, count, dst); break;
+                    case SimdNeuralActivationTanh: Epilogue<SimdNeuralActivationTanh>(channel, count, dst); break;
+                    case SimdNeuralActivationSigmoid: Epilogue<SimdNeuralActivationSigmoid>(channel, count, dst); break;
+                    case SimdNeuralActivationRelu: Epilogue<SimdNeuralActivationRelu>(channel, count, dst); break;
+                    default: assert(0);
+                    }
+                }
+
+                Opt _opt;
+            };
         }
 
         void NeuralConvolutionForward(const float * src, size_t srcWidth, size_t srcHeight, size_t srcDepth,
@@ -1909,26 +2056,16 @@ namespace Simd
             else
                 data.a = (float*)weight;
 
-            if (opt.sizeB)
-            {
-                switch (opt.alg)
-                {
-                case Opt::Ver0: Ver0::PrepareB(src, srcWidth, srcHeight, srcDepth, kernelX, kernelY, padX, padY, strideX, strideY, dilationX, dilationY, dstWidth, dstHeight, data.b); break;
-                case Opt::Ver1: Ver1::PrepareB(src, srcWidth, srcHeight, srcDepth, kernelX, kernelY, padX, padY, strideX, strideY, dilationX, dilationY, dstWidth, dstHeight, opt.cellB, data.t, data.b); break;
-                case Opt::Ver2: Ver2::PrepareB(src, srcWidth, srcHeight, srcDepth, padX, padY, data.b, opt.paddedW, opt.paddedH); break;
-                default: break;
-                }
-            }
-            else
-                data.b = (float*)src;
+            Forward(opt, src, srcWidth, srcHeight, srcDepth, data.a, kernelX, kernelY, padX, padY, strideX, strideY, dilationX, dilationY,
+                data, dst, dstWidth, dstHeight, dstDepth);
+        }
 
-            switch (opt.alg)
-            {
-            case Opt::Ver0: Ver0::Execute(opt.M, opt.N, opt.K, data.a, data.b, dst); break;
-            case Opt::Ver1: Ver1::Execute(opt.M, opt.N, opt.K, data.a, data.b, dst, opt.cellA, opt.cellB); break;
-            case Opt::Ver2: Ver2::Execute(data.b, opt.paddedW, opt.paddedH, srcDepth, weight, kernelX, kernelY, dst, dstWidth, dstHeight, dstDepth); break;
-            default: break;
-            }
+        void * NeuralConvolutionInit(size_t srcWidth, size_t srcHeight, size_t srcDepth, const float * weight, size_t kernelX, size_t kernelY,
+            size_t padX, size_t padY, size_t strideX, size_t strideY, size_t dilationX, size_t dilationY, size_t dstWidth, size_t dstHeight, size_t dstDepth,
+            const float * bias, SimdNeuralActivationType activation, const float * slope)
+        {
+            return new Ncf::Convolution(srcWidth, srcHeight, srcDepth, weight, kernelX, kernelY, padX, padY, strideX, strideY, dilationX, dilationY, dstWidth, dstHeight, dstDepth,
+                bias, activation, slope);
         }
     }
 #endif// SIMD_AVX_ENABLE
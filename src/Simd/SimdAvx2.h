@@ -137,6 +137,12 @@ namespace Simd
 		void DetectionHaarDetect32fi(const void * hid, const uint8_t * mask, size_t maskStride,
 			ptrdiff_t left, ptrdiff_t top, ptrdiff_t right, ptrdiff_t bottom, uint8_t * dst, size_t dstStride);
 
+		void DetectionHaarDetect16ip(const void * hid, const uint8_t * mask, size_t maskStride,
+			ptrdiff_t left, ptrdiff_t top, ptrdiff_t right, ptrdiff_t bottom, uint8_t * dst, size_t dstStride);
+
+		void DetectionHaarDetect16ii(const void * hid, const uint8_t * mask, size_t maskStride,
+			ptrdiff_t left, ptrdiff_t top, ptrdiff_t right, ptrdiff_t bottom, uint8_t * dst, size_t dstStride);
+
 		void DetectionLbpDetect32fp(const void * hid, const uint8_t * mask, size_t maskStride,
 			ptrdiff_t left, ptrdiff_t top, ptrdiff_t right, ptrdiff_t bottom, uint8_t * dst, size_t dstStride);
 
@@ -177,6 +183,8 @@ namespace Simd
 
 		void SquaredDifferenceSum16f(const uint16_t * a, const uint16_t * b, size_t size, float * sum);
 
+		void NeuralProductSum16f(const float * a, const uint16_t * b, size_t size, float * sum);
+
 		void Float32ToUint8(const float * src, size_t size, const float * lower, const float * upper, uint8_t * dst);
 
 		void Uint8ToFloat32(const uint8_t * src, size_t size, const float * lower, const float * upper, float * dst);
@@ -268,6 +276,8 @@ namespace Simd
 
 		void NeuralProductSum(const float * a, const float * b, size_t size, float * sum);
 
+		void NeuralProductSum8i(size_t M, size_t N, size_t K, const int8_t * a, const uint8_t * b, int32_t * c);
+
 		void NeuralAddVectorMultipliedByValue(const float * src, size_t size, const float * value, float * dst);
 
 		void NeuralRoughSigmoid2(const float * src, size_t size, const float * slope, float * dst);
@@ -304,6 +314,10 @@ namespace Simd
 			size_t kernelX, size_t kernelY, size_t padX, size_t padY, size_t strideX, size_t strideY, size_t dilationX, size_t dilationY,
 			void * buffer, size_t * size, float * dst, size_t dstWidth, size_t dstHeight, size_t dstDepth, int add);
 
+		void * NeuralConvolutionInit(size_t srcWidth, size_t srcHeight, size_t srcDepth, const float * weight, size_t kernelX, size_t kernelY,
+			size_t padX, size_t padY, size_t strideX, size_t strideY, size_t dilationX, size_t dilationY, size_t dstWidth, size_t dstHeight, size_t dstDepth,
+			const float * bias, SimdNeuralActivationType activation, const float * slope);
+
 		void OperationBinary8u(const uint8_t * a, size_t aStride, const uint8_t * b, size_t bStride,
 			size_t width, size_t height, size_t channelCount, uint8_t * dst, size_t dstStride, SimdOperationBinary8uType type);
 
@@ -333,6 +347,9 @@ namespace Simd
 		void ResizeBilinear(const uint8_t *src, size_t srcWidth, size_t srcHeight, size_t srcStride,
 			uint8_t *dst, size_t dstWidth, size_t dstHeight, size_t dstStride, size_t channelCount);
 
+		void ResizeBilinearRows(const uint8_t *src, size_t srcWidth, size_t srcHeight, size_t srcStride,
+			uint8_t *dst, size_t dstWidth, size_t dstHeight, size_t dstStride, size_t channelCount, size_t yBegin, size_t yEnd);
+
 		void SegmentationChangeIndex(uint8_t * mask, size_t stride, size_t width, size_t height, uint8_t oldIndex, uint8_t newIndex);
 
 		void SegmentationFillSingleHoles(uint8_t * mask, size_t stride, size_t width, size_t height, uint8_t index);
@@ -344,6 +361,9 @@ namespace Simd
 		void SegmentationShrinkRegion(const uint8_t * mask, size_t stride, size_t width, size_t height, uint8_t index,
 			ptrdiff_t * left, ptrdiff_t * top, ptrdiff_t * right, ptrdiff_t * bottom);
 
+		size_t SegmentationLabel(uint8_t * mask, size_t maskStride, size_t width, size_t height, const uint8_t * difference, size_t differenceStride,
+			uint8_t seedIndex, uint8_t emptyIndex, uint8_t invalidIndex, uint8_t differenceThreshold, size_t areaMin, uint8_t indexMin, ptrdiff_t * rects);
+
 		void ShiftBilinear(const uint8_t * src, size_t srcStride, size_t width, size_t height, size_t channelCount,
 			const uint8_t * bkg, size_t bkgStride, const double * shiftX, const double * shiftY,
 			size_t cropLeft, size_t cropTop, size_t cropRight, size_t cropBottom, uint8_t * dst, size_t dstStride);
@@ -403,6 +423,12 @@ namespace Simd
 		void TextureBoostedUv(const uint8_t * src, size_t srcStride, size_t width, size_t height,
 			uint8_t boost, uint8_t * dst, size_t dstStride);
 
+		void TextureFeatureDifference(const uint8_t * gray, size_t grayStride, size_t width, size_t height, uint8_t saturation, uint8_t boost,
+			const uint8_t * grayLo, size_t grayLoStride, const uint8_t * grayHi, size_t grayHiStride, uint16_t grayWeight,
+			uint8_t * dx, size_t dxStride, const uint8_t * dxLo, size_t dxLoStride, const uint8_t * dxHi, size_t dxHiStride, uint16_t dxWeight,
+			uint8_t * dy, size_t dyStride, const uint8_t * dyLo, size_t dyLoStride, const uint8_t * dyHi, size_t dyHiStride, uint16_t dyWeight,
+			const uint8_t * mask, size_t maskStride, uint8_t * difference, size_t differenceStride);
+
 		void TextureGetDifferenceSum(const uint8_t * src, size_t srcStride, size_t width, size_t height,
 			const uint8_t * lo, size_t loStride, const uint8_t * hi, size_t hiStride, int64_t * sum);
 
@@ -412,6 +438,9 @@ namespace Simd
 		void Yuv420pToBgr(const uint8_t * y, size_t yStride, const uint8_t * u, size_t uStride, const uint8_t * v, size_t vStride,
 			size_t width, size_t height, uint8_t * bgr, size_t bgrStride);
 
+		void Nv12ToBgr(const uint8_t * y, size_t yStride, const uint8_t * uv, size_t uvStride,
+			size_t width, size_t height, uint8_t * bgr, size_t bgrStride);
+
 		void Yuv422pToBgr(const uint8_t * y, size_t yStride, const uint8_t * u, size_t uStride, const uint8_t * v, size_t vStride,
 			size_t width, size_t height, uint8_t * bgr, size_t bgrStride);
 
@@ -421,6 +450,9 @@ namespace Simd
 		void Yuv420pToBgra(const uint8_t * y, size_t yStride, const uint8_t * u, size_t uStride, const uint8_t * v, size_t vStride,
 			size_t width, size_t height, uint8_t * bgra, size_t bgraStride, uint8_t alpha);
 
+		void Nv12ToBgra(const uint8_t * y, size_t yStride, const uint8_t * uv, size_t uvStride,
+			size_t width, size_t height, uint8_t * bgra, size_t bgraStride, uint8_t alpha);
+
 		void Yuv422pToBgra(const uint8_t * y, size_t yStride, const uint8_t * u, size_t uStride, const uint8_t * v, size_t vStride,
 			size_t width, size_t height, uint8_t * bgra, size_t bgraStride, uint8_t alpha);
 
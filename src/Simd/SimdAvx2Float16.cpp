@@ -151,6 +151,54 @@ namespace Simd
             else
                 SquaredDifferenceSum16f<false>(a, b, size, sum);
         }
+
+        template <bool align> SIMD_INLINE void NeuralProductSum16f(const float * a, const uint16_t * b, size_t offset, __m256 & sum)
+        {
+            __m256 _a = Avx::Load<align>(a + offset);
+            __m256 _b = _mm256_cvtph_ps(Sse2::Load<align>((__m128i*)(b + offset)));
+            sum = _mm256_fmadd_ps(_a, _b, sum);
+        }
+
+        template <bool align> SIMD_INLINE void NeuralProductSum16f(const float * a, const uint16_t * b, size_t size, float * sum)
+        {
+            if (align)
+                assert(Aligned(a) && Aligned(b));
+
+            size_t partialAlignedSize = AlignLo(size, F);
+            size_t fullAlignedSize = AlignLo(size, QF);
+            size_t i = 0;
+            __m256 sums[4] = { _mm256_setzero_ps(), _mm256_setzero_ps(), _mm256_setzero_ps(), _mm256_setzero_ps() };
+            if (fullAlignedSize)
+            {
+                for (; i < fullAlignedSize; i += QF)
+                {
+                    NeuralProductSum16f<align>(a, b, i + F * 0, sums[0]);
+                    NeuralProductSum16f<align>(a, b, i + F * 1, sums[1]);
+                    NeuralProductSum16f<align>(a, b, i + F * 2, sums[2]);
+                    NeuralProductSum16f<align>(a, b, i + F * 3, sums[3]);
+                }
+                sums[0] = _mm256_add_ps(_mm256_add_ps(sums[0], sums[1]), _mm256_add_ps(sums[2], sums[3]));
+            }
+            for (; i < partialAlignedSize; i += F)
+                NeuralProductSum16f<align>(a, b, i, sums[0]);
+            if (partialAlignedSize != size)
+            {
+                float _a[F] = { 0 };
+                uint16_t _b[F] = { 0 };
+                memcpy(_a, a + i, (size - i) * sizeof(float));
+                memcpy(_b, b + i, (size - i) * sizeof(uint16_t));
+                NeuralProductSum16f<false>(_a, _b, 0, sums[0]);
+            }
+            *sum = Avx::ExtractSum(sums[0]);
+        }
+
+        void NeuralProductSum16f(const float * a, const uint16_t * b, size_t size, float * sum)
+        {
+            if (Aligned(a) && Aligned(b))
+                NeuralProductSum16f<true>(a, b, size, sum);
+            else
+                NeuralProductSum16f<false>(a, b, size, sum);
+        }
     }
 #endif// SIMD_AVX2_ENABLE
 }
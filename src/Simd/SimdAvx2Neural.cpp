@@ -23,6 +23,7 @@
 */
 #include "Simd/SimdMemory.h"
 #include "Simd/SimdExtract.h"
+#include "Simd/SimdArray.h"
 #include "Simd/SimdStore.h"
 #include "Simd/SimdStream.h"
 #include "Simd/SimdBase.h"
@@ -146,6 +147,179 @@ namespace Simd
                 NeuralProductSum<false>(a, b, size, sum);
         }
 
+        SIMD_INLINE void NeuralProductSum8i(const __m256i & a, const __m256i & b, __m256i & sum)
+        {
+            sum = _mm256_add_epi32(sum, _mm256_madd_epi16(_mm256_maddubs_epi16(b, a), K16_0001));
+        }
+
+        SIMD_INLINE __m128i Extract4Sums(const __m256i sums[4])
+        {
+            __m256i sum = _mm256_hadd_epi32(_mm256_hadd_epi32(sums[0], sums[1]), _mm256_hadd_epi32(sums[2], sums[3]));
+            return _mm_add_epi32(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+        }
+
+        void NeuralProductSum8i4(size_t K, size_t alignedK, const int8_t * a, const uint8_t * b, const uint8_t * aTail, const uint8_t * bTail, int32_t * c, size_t N)
+        {
+            const int8_t * a0 = a + 0 * K;
+            const int8_t * a1 = a + 1 * K;
+            const int8_t * a2 = a + 2 * K;
+            const int8_t * a3 = a + 3 * K;
+            __m256i sums[4] = { _mm256_setzero_si256(), _mm256_setzero_si256(), _mm256_setzero_si256(), _mm256_setzero_si256() };
+            for (size_t k = 0; k < alignedK; k += A)
+            {
+                __m256i _b = Load<false>((__m256i*)(b + k));
+                NeuralProductSum8i(Load<false>((__m256i*)(a0 + k)), _b, sums[0]);
+                NeuralProductSum8i(Load<false>((__m256i*)(a1 + k)), _b, sums[1]);
+                NeuralProductSum8i(Load<false>((__m256i*)(a2 + k)), _b, sums[2]);
+                NeuralProductSum8i(Load<false>((__m256i*)(a3 + k)), _b, sums[3]);
+            }
+            if (alignedK < K)
+            {
+                __m256i _b = Load<true>((__m256i*)bTail);
+                NeuralProductSum8i(Load<true>((__m256i*)aTail + 0), _b, sums[0]);
+                NeuralProductSum8i(Load<true>((__m256i*)aTail + 1), _b, sums[1]);
+                NeuralProductSum8i(Load<true>((__m256i*)aTail + 2), _b, sums[2]);
+                NeuralProductSum8i(Load<true>((__m256i*)aTail + 3), _b, sums[3]);
+            }
+            __m128i sum = Extract4Sums(sums);
+            c[0 * N] = _mm_extract_epi32(sum, 0);
+            c[1 * N] = _mm_extract_epi32(sum, 1);
+            c[2 * N] = _mm_extract_epi32(sum, 2);
+            c[3 * N] = _mm_extract_epi32(sum, 3);
+        }
+
+        void NeuralProductSum8i1(size_t K, size_t alignedK, const int8_t * a, const uint8_t * b, const uint8_t * aTail, const uint8_t * bTail, int32_t * c)
+        {
+            __m256i sum = _mm256_setzero_si256();
+            for (size_t k = 0; k < alignedK; k += A)
+                NeuralProductSum8i(Load<false>((__m256i*)(a + k)), Load<false>((__m256i*)(b + k)), sum);
+            if (alignedK < K)
+                NeuralProductSum8i(Load<true>((__m256i*)aTail), Load<true>((__m256i*)bTail), sum);
+            c[0] = ExtractSum<uint32_t>(sum);
+        }
+
+        void NeuralProductSum8iDot(size_t M, size_t N, size_t K, const int8_t * a, const uint8_t * b, int32_t * c)
+        {
+            size_t alignedK = AlignLo(K, A), tail = K - alignedK;
+            size_t alignedM = AlignLo(M, 4);
+            Array<uint8_t> tails(tail ? (M + N)*A : 0, true), bt(N*K);
+            for (size_t j = 0; j < N; ++j)
+                for (size_t k = 0; k < K; ++k)
+                    bt[j*K + k] = b[k*N + j];
+            b = bt.data;
+            uint8_t * aTails = tails.data, * bTails = tails.data + M*A;
+            for (size_t i = 0; i < M; ++i)
+                for (size_t k = 0; k < tail; ++k)
+                    aTails[i*A + k] = a[i*K + alignedK + k];
+            for (size_t j = 0; j < N; ++j)
+                for (size_t k = 0; k < tail; ++k)
+                    bTails[j*A + k] = b[j*K + alignedK + k];
+            size_t i = 0;
+            for (; i < alignedM; i += 4)
+            {
+                for (size_t j = 0; j < N; ++j)
+                    NeuralProductSum8i4(K, alignedK, a + i*K, b + j*K, aTails + i*A, bTails + j*A, c + i*N + j, N);
+            }
+            for (; i < M; ++i)
+            {
+                for (size_t j = 0; j < N; ++j)
+                    NeuralProductSum8i1(K, alignedK, a + i*K, b + j*K, aTails + i*A, bTails + j*A, c + i*N + j);
+            }
+        }
+
+        template <size_t rows> void NeuralProductSum8iBlock(size_t K4, const int32_t * a, const uint8_t * b, size_t bStride, int32_t * c, size_t N, size_t width)
+        {
+            __m256i sums[rows][2];
+            for (size_t r = 0; r < rows; ++r)
+                sums[r][0] = _mm256_setzero_si256(), sums[r][1] = _mm256_setzero_si256();
+            for (size_t k = 0; k < K4; ++k, b += bStride)
+            {
+                __m256i b0 = Load<true>((__m256i*)b + 0);
+                __m256i b1 = Load<true>((__m256i*)b + 1);
+                for (size_t r = 0; r < rows; ++r)
+                {
+                    __m256i _a = _mm256_set1_epi32(a[r*K4 + k]);
+                    NeuralProductSum8i(_a, b0, sums[r][0]);
+                    NeuralProductSum8i(_a, b1, sums[r][1]);
+                }
+            }
+            for (size_t r = 0; r < rows; ++r)
+            {
+                if (width == DF)
+                {
+                    Store<false>((__m256i*)(c + r*N) + 0, sums[r][0]);
+                    Store<false>((__m256i*)(c + r*N) + 1, sums[r][1]);
+                }
+                else
+                {
+                    int32_t buffer[DF];
+                    Store<false>((__m256i*)buffer + 0, sums[r][0]);
+                    Store<false>((__m256i*)buffer + 1, sums[r][1]);
+                    for (size_t j = 0; j < width; ++j)
+                        c[r*N + j] = buffer[j];
+                }
+            }
+        }
+
+        SIMD_INLINE void NeuralPackB4(const uint8_t * b, size_t N, uint8_t * dst)
+        {
+            __m256i b0 = Load<false>((__m256i*)(b + 0 * N));
+            __m256i b1 = Load<false>((__m256i*)(b + 1 * N));
+            __m256i b2 = Load<false>((__m256i*)(b + 2 * N));
+            __m256i b3 = Load<false>((__m256i*)(b + 3 * N));
+            __m256i lo01 = _mm256_unpacklo_epi8(b0, b1), hi01 = _mm256_unpackhi_epi8(b0, b1);
+            __m256i lo23 = _mm256_unpacklo_epi8(b2, b3), hi23 = _mm256_unpackhi_epi8(b2, b3);
+            __m256i q0 = _mm256_unpacklo_epi16(lo01, lo23), q1 = _mm256_unpackhi_epi16(lo01, lo23);
+            __m256i q2 = _mm256_unpacklo_epi16(hi01, hi23), q3 = _mm256_unpackhi_epi16(hi01, hi23);
+            Store<false>((__m256i*)dst + 0, _mm256_permute2x128_si256(q0, q1, 0x20));
+            Store<false>((__m256i*)dst + 1, _mm256_permute2x128_si256(q2, q3, 0x20));
+            Store<false>((__m256i*)dst + 2, _mm256_permute2x128_si256(q0, q1, 0x31));
+            Store<false>((__m256i*)dst + 3, _mm256_permute2x128_si256(q2, q3, 0x31));
+        }
+
+        void NeuralProductSum8iPacked(size_t M, size_t N, size_t K, const int8_t * a, const uint8_t * b, int32_t * c)
+        {
+            size_t K4 = (K + 3) / 4, alignedN = AlignHi(N, DF), bStride = alignedN * 4;
+            Array<uint8_t> buffer(K4*bStride + M*K4*4, true);
+            uint8_t * pb = buffer.data;
+            int32_t * pa = (int32_t*)(buffer.data + K4*bStride);
+            for (size_t i = 0; i < M; ++i)
+                memcpy(pa + i*K4, a + i*K, K);
+            size_t fullN = AlignLo(N, A);
+            for (size_t k = 0; k < K; k += 4, b += 4 * N)
+            {
+                uint8_t * pd = pb + k / 4 * bStride;
+                size_t rows = Simd::Min<size_t>(K - k, 4), j = 0;
+                if (rows == 4)
+                {
+                    for (; j < fullN; j += A)
+                        NeuralPackB4(b + j, N, pd + j * 4);
+                }
+                for (; j < N; ++j)
+                    for (size_t r = 0; r < rows; ++r)
+                        pd[j * 4 + r] = b[r*N + j];
+            }
+
+            size_t alignedM = AlignLo(M, 4);
+            for (size_t j = 0; j < N; j += DF)
+            {
+                size_t width = Simd::Min(N - j, DF);
+                size_t i = 0;
+                for (; i < alignedM; i += 4)
+                    NeuralProductSum8iBlock<4>(K4, pa + i*K4, pb + j * 4, bStride, c + i*N + j, N, width);
+                for (; i < M; ++i)
+                    NeuralProductSum8iBlock<1>(K4, pa + i*K4, pb + j * 4, bStride, c + i*N + j, N, width);
+            }
+        }
+
+        void NeuralProductSum8i(size_t M, size_t N, size_t K, const int8_t * a, const uint8_t * b, int32_t * c)
+        {
+            if (N >= F)
+                NeuralProductSum8iPacked(M, N, K, a, b, c);
+            else
+                NeuralProductSum8iDot(M, N, K, a, b, c);
+        }
+
         template <bool align> SIMD_INLINE void AddMultiplied(const float * src, const __m256 & value, float * dst)
         {
             Avx::Store<align>(dst, _mm256_fmadd_ps(value, Load<align>(src), Load<align>(dst)));
@@ -785,7 +959,7 @@ namespace Simd
                     sums[1] = _mm256_fmadd_ps(a1, Avx::Load<align>(b), sums[1]);
                 }
 
-                template <bool align> void Execute(size_t M, size_t N, size_t K, const float * a, const float * b, float * c)
+                template <bool align> void Execute(size_t M, size_t N, size_t K, const float * a, const float * b, float * c, const NeuralConvolution * epilogue)
                 {
                     size_t M2 = Simd::AlignLo(M, 2);
                     size_t N4 = Simd::AlignLo(N, 4);
@@ -839,6 +1013,8 @@ namespace Simd
                             pc0[j] += Avx::ExtractSum(sums[0]);
                             pc1[j] += Avx::ExtractSum(sums[1]);
                         }
+                        if (epilogue)
+                            epilogue->Epilogue(i, 2, c + i*N);
                     }
                     for (; i < M; ++i)
                     {
@@ -879,15 +1055,17 @@ namespace Simd
                             }
                             pc[j] += Avx::ExtractSum(sum);
                         }
+                        if (epilogue)
+                            epilogue->Epilogue(i, 1, c + i*N);
                     }
                 }
 
-                void Execute(size_t M, size_t N, size_t K, const float * a, const float * b, float * c)
+                void Execute(size_t M, size_t N, size_t K, const float * a, const float * b, float * c, const NeuralConvolution * epilogue = NULL)
                 {
                     if (Aligned(K, F))
-                        Execute<true>(M, N, K, a, b, c);
+                        Execute<true>(M, N, K, a, b, c, epilogue);
                     else
-                        Execute<false>(M, N, K, a, b, c);
+                        Execute<false>(M, N, K, a, b, c, epilogue);
                 }
             }
 
@@ -1137,7 +1315,7 @@ namespace Simd
                     AddSums8(sums, 4, mask, c, N);
                 }
 
-                template <bool align> void Execute4x8(size_t M, size_t N, size_t K, const float * a, const float * b, float * c)
+                template <bool align> void Execute4x8(size_t M, size_t N, size_t K, const float * a, const float * b, float * c, const NeuralConvolution * epilogue)
                 {
                     size_t M4 = Simd::AlignLo(M, 4);
                     size_t N8 = Simd::AlignLo(N, 8);
@@ -1151,6 +1329,8 @@ namespace Simd
                             Kernel4x8<align>(N, K, a + i*K, b + j*K, c + i*N + j, NULL);
                         if (N8 < N)
                             Kernel4x8<align>(N, K, a + i*K, b + j*K, c + i*N + j, tail);
+                        if (epilogue)
+                            epilogue->Epilogue(i, 4, c + i*N);
                     }
                     if (M4 < M)
                     {
@@ -1159,6 +1339,8 @@ namespace Simd
                             KernelMx8<align>(N, K, a + i*K, b + j*K, c + i*N + j, NULL, M - M4);
                         if (N8 < N)
                             KernelMx8<align>(N, K, a + i*K, b + j*K, c + i*N + j, tail, M - M4);
+                        if (epilogue)
+                            epilogue->Epilogue(i, M - M4, c + i*N);
                     }
                 }
 
@@ -1230,7 +1412,7 @@ namespace Simd
                     AddSums16(sums, 4, mask, c, N);
                 }
 
-                template <bool align> void Execute4x16(size_t M, size_t N, size_t K, const float * a, const float * b, float * c)
+                template <bool align> void Execute4x16(size_t M, size_t N, size_t K, const float * a, const float * b, float * c, const NeuralConvolution * epilogue)
                 {
                     size_t M4 = Simd::AlignLo(M, 4);
                     size_t N16 = Simd::AlignLo(N, 16);
@@ -1244,6 +1426,8 @@ namespace Simd
                             Kernel4x16<align>(N, K, a + i*K, b + j*K, c + i*N + j, NULL);
                         if (N16 < N)
                             Kernel4x16<align>(N, K, a + i*K, b + j*K, c + i*N + j, tail);
+                        if (epilogue)
+                            epilogue->Epilogue(i, 4, c + i*N);
                     }
                     if (M4 < M)
                     {
@@ -1252,17 +1436,19 @@ namespace Simd
                             KernelMx16<align>(N, K, a + i*K, b + j*K, c + i*N + j, NULL, M - M4);
                         if (N16 < N)
                             KernelMx16<align>(N, K, a + i*K, b + j*K, c + i*N + j, tail, M - M4);
+                        if (epilogue)
+                            epilogue->Epilogue(i, M - M4, c + i*N);
                     }
                 }
 
-                void Execute(size_t M, size_t N, size_t K, const float * a, const float * b, float * c, size_t cellA, size_t cellB)
+                void Execute(size_t M, size_t N, size_t K, const float * a, const float * b, float * c, size_t cellA, size_t cellB, const NeuralConvolution * epilogue = NULL)
                 {
                     if (cellA == 4)
                     {
                         if (cellB == 8)
-                            Execute4x8<false>(M, N, K, a, b, c);
+                            Execute4x8<false>(M, N, K, a, b, c, epilogue);
                         if (cellB == 16)
-                            Execute4x16<false>(M, N, K, a, b, c);
+                            Execute4x16<false>(M, N, K, a, b, c, epilogue);
                     }
                 }
             }
@@ -1292,7 +1478,7 @@ namespace Simd
                 }
 
                 template <bool align, size_t kernelX, size_t kernelY> void AddConvolution8x8(const float * src, size_t srcWidth, size_t srcHeight, size_t srcDepth,
-                    const float * weight, float * dst, size_t dstDepth)
+                    const float * weight, float * dst, size_t dstDepth, const NeuralConvolution * epilogue)
                 {
                     __m256 _weight[kernelX*kernelY];
                     for (size_t dstChannel = 0; dstChannel < dstDepth; ++dstChannel)
@@ -1335,15 +1521,17 @@ namespace Simd
                         }
                         for (size_t row = 0; row < 8; ++row, dst += 8)
                             Avx::Store<align>(dst, _dst[row]);
+                        if (epilogue)
+                            epilogue->Epilogue(dstChannel, 1, dst - 64);
                     }
                 }
 
                 template <bool align, size_t kernelX, size_t kernelY> void AddConvolution(const float * src, size_t srcWidth, size_t srcHeight, size_t srcDepth,
-                    const float * weight, float * dst, size_t dstWidth, size_t dstHeight, size_t dstDepth)
+                    const float * weight, float * dst, size_t dstWidth, size_t dstHeight, size_t dstDepth, const NeuralConvolution * epilogue)
                 {
                     if (dstWidth == 8 && dstHeight == 8)
                     {
-                        AddConvolution8x8<align, kernelX, kernelY>(src, srcWidth, srcHeight, srcDepth, weight, dst, dstDepth);
+                        AddConvolution8x8<align, kernelX, kernelY>(src, srcWidth, srcHeight, srcDepth, weight, dst, dstDepth, epilogue);
                         return;
                     }
                     size_t alignedWidth = AlignLo(dstWidth, F);
@@ -1377,21 +1565,23 @@ namespace Simd
                                 pdst += dstWidth;
                             }
                         }
+                        if (epilogue)
+                            epilogue->Epilogue(dstChannel, 1, dst + dstWidth*dstHeight*dstChannel);
                     }
                 }
 
                 void Execute(const float * src, size_t srcWidth, size_t srcHeight, size_t srcDepth,
-                    const float * weight, size_t kernelX, size_t kernelY, float * dst, size_t dstWidth, size_t dstHeight, size_t dstDepth)
+                    const float * weight, size_t kernelX, size_t kernelY, float * dst, size_t dstWidth, size_t dstHeight, size_t dstDepth, const NeuralConvolution * epilogue = NULL)
                 {
                     assert(kernelX == kernelY);
                     if (kernelX == 2)
-                        AddConvolution<false, 2, 2>(src, srcWidth, srcHeight, srcDepth, weight, dst, dstWidth, dstHeight, dstDepth);
+                        AddConvolution<false, 2, 2>(src, srcWidth, srcHeight, srcDepth, weight, dst, dstWidth, dstHeight, dstDepth, epilogue);
                     else if (kernelX == 3)
-                        AddConvolution<false, 3, 3>(src, srcWidth, srcHeight, srcDepth, weight, dst, dstWidth, dstHeight, dstDepth);
+                        AddConvolution<false, 3, 3>(src, srcWidth, srcHeight, srcDepth, weight, dst, dstWidth, dstHeight, dstDepth, epilogue);
                     else if (kernelX == 4)
-                        AddConvolution<false, 4, 4>(src, srcWidth, srcHeight, srcDepth, weight, dst, dstWidth, dstHeight, dstDepth);
+                        AddConvolution<false, 4, 4>(src, srcWidth, srcHeight, srcDepth, weight, dst, dstWidth, dstHeight, dstDepth, epilogue);
                     else if (kernelX == 5)
-                        AddConvolution<false, 5, 5>(src, srcWidth, srcHeight, srcDepth, weight, dst, dstWidth, dstHeight, dstDepth);
+                        AddConvolution<false, 5, 5>(src, srcWidth, srcHeight, srcDepth, weight, dst, dstWidth, dstHeight, dstDepth, epilogue);
                     else
                         assert(0);
                 }
@@ -1407,6 +1597,138 @@ namespace Simd
                 }
             }
 
+            namespace Ver3
+            {
+                void PrepareA(const float * src, size_t M, size_t K, size_t cell, float * dst)
+                {
+                    size_t size = M*K;
+                    float * filter = (float*)Allocate(16 * size * sizeof(float));
+                    Base::Winograd2x3SetFilter(src, size, filter);
+                    for (size_t i = 0; i < 16; ++i)
+                        Ver1::PrepareA(filter + i*size, M, K, cell, dst + i*size);
+                    Free(filter);
+                }
+
+                SIMD_INLINE void InputTransform(const float * even, const float * odd, size_t stride, float * dst, size_t size)
+                {
+                    __m256 t[4][4];
+                    for (size_t r = 0; r < 4; ++r, even += stride, odd += stride)
+                    {
+                        __m256 d0 = Avx::Load<false>(even + 0);
+                        __m256 d1 = Avx::Load<false>(odd + 0);
+                        __m256 d2 = Avx::Load<false>(even + 1);
+                        __m256 d3 = Avx::Load<false>(odd + 1);
+                        t[r][0] = _mm256_sub_ps(d0, d2);
+                        t[r][1] = _mm256_add_ps(d1, d2);
+                        t[r][2] = _mm256_sub_ps(d2, d1);
+                        t[r][3] = _mm256_sub_ps(d1, d3);
+                    }
+                    for (size_t c = 0; c < 4; ++c)
+                    {
+                        Avx::Store<false>(dst + (0 + c)*size, _mm256_sub_ps(t[0][c], t[2][c]));
+                        Avx::Store<false>(dst + (4 + c)*size, _mm256_add_ps(t[1][c], t[2][c]));
+                        Avx::Store<false>(dst + (8 + c)*size, _mm256_sub_ps(t[2][c], t[1][c]));
+                        Avx::Store<false>(dst + (12 + c)*size, _mm256_sub_ps(t[1][c], t[3][c]));
+                    }
+                }
+
+                void PrepareB(const float * src, size_t srcWidth, size_t srcHeight, size_t srcDepth, size_t padX, size_t padY, 
+                    size_t tileX, size_t tileY, size_t cell, float * tmp, float * dst)
+                {
+                    size_t N = tileX*tileY, width = AlignHi(tileX, F) + 1, height = tileY * 2 + 2, size = srcDepth*N + F;
+                    float * even = tmp + 16 * size, * odd = even + width*height;
+                    for (size_t c = 0; c < srcDepth; ++c, src += srcWidth*srcHeight)
+                    {
+                        Base::Winograd2x3SplitInput(src, srcWidth, srcHeight, padX, padY, width, height, even, odd);
+                        for (size_t y = 0; y < tileY; ++y)
+                        {
+                            const float * pe = even + 2 * y*width, * po = odd + 2 * y*width;
+                            float * pd = tmp + c*N + y*tileX;
+                            for (size_t x = 0; x < tileX; x += F)
+                                InputTransform(pe + x, po + x, width, pd + x, size);
+                        }
+                    }
+                    for (size_t i = 0; i < 16; ++i)
+                        Ver1::PrepareB(tmp + i*size, N, 1, srcDepth, 1, 1, 0, 0, 1, 1, 1, 1, N, 1, cell, NULL, dst + i*AlignHi(N, cell)*srcDepth);
+                }
+
+                SIMD_INLINE void OutputTransform(const float * src, size_t stride, __m256 * dst)
+                {
+                    __m256 m[16];
+                    for (size_t i = 0; i < 16; ++i)
+                        m[i] = Avx::Load<false>(src + i*stride);
+                    __m256 t[2][4];
+                    for (size_t c = 0; c < 4; ++c)
+                    {
+                        t[0][c] = _mm256_add_ps(_mm256_add_ps(m[c], m[4 + c]), m[8 + c]);
+                        t[1][c] = _mm256_sub_ps(_mm256_sub_ps(m[4 + c], m[8 + c]), m[12 + c]);
+                    }
+                    for (size_t r = 0; r < 2; ++r)
+                    {
+                        __m256 y0 = _mm256_add_ps(_mm256_add_ps(t[r][0], t[r][1]), t[r][2]);
+                        __m256 y1 = _mm256_sub_ps(_mm256_sub_ps(t[r][1], t[r][2]), t[r][3]);
+                        __m256 lo = _mm256_unpacklo_ps(y0, y1);
+                        __m256 hi = _mm256_unpackhi_ps(y0, y1);
+                        dst[2 * r + 0] = _mm256_permute2f128_ps(lo, hi, 0x20);
+                        dst[2 * r + 1] = _mm256_permute2f128_ps(lo, hi, 0x31);
+                    }
+                }
+
+                void Execute(size_t M, size_t N, size_t K, const float * a, size_t strideA, const float * b, float * t, 
+                    float * dst, size_t dstWidth, size_t dstHeight, size_t cellA, size_t cellB, const NeuralConvolution * epilogue = NULL)
+                {
+                    size_t strideB = AlignHi(N, cellB)*K, strideT = M*N;
+                    memset(t, 0, 16 * strideT * sizeof(float));
+                    for (size_t i = 0; i < 16; ++i)
+                        Ver1::Execute(M, N, K, a + i*strideA, b + i*strideB, t + i*strideT, cellA, cellB);
+
+                    size_t tileX = (dstWidth + 1) / 2, tileY = (dstHeight + 1) / 2, fullX = AlignLo(dstWidth / 2, F);
+                    for (size_t m = 0; m < M; ++m, t += N, dst += dstWidth*dstHeight)
+                    {
+                        for (size_t y = 0; y < tileY; ++y)
+                        {
+                            const float * ps = t + y*tileX;
+                            float * pd = dst + 2 * y*dstWidth;
+                            size_t rows = Simd::Min<size_t>(2, dstHeight - 2 * y), x = 0;
+                            __m256 out[4];
+                            if (rows == 2)
+                            {
+                                for (; x < fullX; x += F)
+                                {
+                                    OutputTransform(ps + x, strideT, out);
+                                    float * pd0 = pd + 2 * x, * pd1 = pd0 + dstWidth;
+                                    Avx::Store<false>(pd0 + 0, _mm256_add_ps(Avx::Load<false>(pd0 + 0), out[0]));
+                                    Avx::Store<false>(pd0 + F, _mm256_add_ps(Avx::Load<false>(pd0 + F), out[1]));
+                                    Avx::Store<false>(pd1 + 0, _mm256_add_ps(Avx::Load<false>(pd1 + 0), out[2]));
+                                    Avx::Store<false>(pd1 + F, _mm256_add_ps(Avx::Load<false>(pd1 + F), out[3]));
+                                }
+                            }
+                            for (; x < tileX; x += F)
+                            {
+                                OutputTransform(ps + x, strideT, out);
+                                size_t cols = Simd::Min<size_t>(2 * F, dstWidth - 2 * x);
+                                const float * po = (float*)out;
+                                for (size_t r = 0; r < rows; ++r, po += 2 * F)
+                                    for (size_t c = 0; c < cols; ++c)
+                                        pd[r*dstWidth + 2 * x + c] += po[c];
+                            }
+                        }
+                        if (epilogue)
+                            epilogue->Epilogue(m, 1, dst);
+                    }
+                }
+
+                bool Preferable(size_t srcDepth, size_t kernelX, size_t kernelY, size_t strideX, size_t strideY, size_t dilationX, size_t dilationY, size_t dstWidth, size_t dstHeight, size_t dstDepth)
+                {
+                    if (kernelX == 3 && kernelY == 3 && strideX*strideY*dilationX*dilationY == 1)
+                    {
+                        if (srcDepth >= 32 && dstDepth >= 32 && dstWidth*dstHeight >= 12 * 12)
+                            return true;
+                    }
+                    return false;
+                }
+            }
+
             struct Opt
             {
                 enum Alg
@@ -1415,6 +1737,7 @@ namespace Simd
                     Ver0,
                     Ver1,
                     Ver2,
+                    Ver3,
                 } alg;
 
                 size_t sizeA;
@@ -1428,6 +1751,8 @@ namespace Simd
                 size_t strideB;
                 size_t paddedW;
                 size_t paddedH;
+                size_t tileX;
+                size_t tileY;
 
                 Opt(size_t srcWidth, size_t srcHeight, size_t srcDepth, size_t kernelX, size_t kernelY, size_t padX, size_t padY, size_t strideX, size_t strideY, size_t dilationX, size_t dilationY, size_t dstWidth, size_t dstHeight, size_t dstDepth)
                 {
@@ -1448,6 +1773,8 @@ namespace Simd
                         alg = Ver1;
                     if (Ver2::Preferable(srcDepth, kernelX, kernelY, strideX, strideY, dilationX, dilationY, dstWidth, dstHeight, dstDepth))
                         alg = Ver2;
+                    if (Ver3::Preferable(srcDepth, kernelX, kernelY, strideX, strideY, dilationX, dilationY, dstWidth, dstHeight, dstDepth))
+                        alg = Ver3;
 
                     switch (alg)
                     {
@@ -1476,6 +1803,20 @@ namespace Simd
                             paddedH = srcHeight;
                         }
                         break;
+                    case Ver3:
+                        cellA = 4;
+                        cellB = 16;
+                        tileX = (dstWidth + 1) / 2;
+                        tileY = (dstHeight + 1) / 2;
+                        N = tileX*tileY;
+                        K = srcDepth;
+                        sizeA = 16 * M*K;
+                        strideB = Simd::AlignHi(N, cellB);
+                        sizeB = 16 * strideB*K;
+                        paddedW = Simd::AlignHi(tileX, F) + 1;
+                        paddedH = tileY * 2 + 2;
+                        sizeT = Simd::Max(16 * (K*N + F) + 2 * paddedW*paddedH, 16 * M*N + F);
+                        break;
                     default:
                         assert(0);
                         break;
@@ -1529,6 +1870,140 @@ namespace Simd
             private:
                 void * _data;
             };
+
+            void PrepareB(const Opt & opt, const float * src, size_t srcWidth, size_t srcHeight, size_t srcDepth, size_t kernelX, size_t kernelY,
+                size_t padX, size_t padY, size_t strideX, size_t strideY, size_t dilationX, size_t dilationY, Data & data, size_t dstWidth, size_t dstHeight)
+            {
+                if (opt.sizeB)
+                {
+                    switch (opt.alg)
+                    {
+                    case Opt::Ver0: Ver0::PrepareB(src, srcWidth, srcHeight, srcDepth, kernelX, kernelY, padX, padY, strideX, strideY, dilationX, dilationY, dstWidth, dstHeight, data.b); break;
+                    case Opt::Ver1: Ver1::PrepareB(src, srcWidth, srcHeight, srcDepth, kernelX, kernelY, padX, padY, strideX, strideY, dilationX, dilationY, dstWidth, dstHeight, opt.cellB, data.t, data.b); break;
+                    case Opt::Ver2: Ver2::PrepareB(src, srcWidth, srcHeight, srcDepth, padX, padY, data.b, opt.paddedW, opt.paddedH); break;
+                    case Opt::Ver3: Ver3::PrepareB(src, srcWidth, srcHeight, srcDepth, padX, padY, opt.tileX, opt.tileY, opt.cellB, data.t, data.b); break;
+                    default: break;
+                    }
+                }
+                else
+                    data.b = (float*)src;
+            }
+
+            void Execute(const Opt & opt, size_t srcDepth, const float * weight, size_t kernelX, size_t kernelY, const Data & data, 
+                float * dst, size_t dstWidth, size_t dstHeight, size_t dstDepth, const NeuralConvolution * epilogue = NULL)
+            {
+                switch (opt.alg)
+                {
+                case Opt::Ver0: Ver0::Execute(dstDepth, opt.N, opt.K, weight, data.b, dst, epilogue); break;
+                case Opt::Ver1: Ver1::Execute(dstDepth, opt.N, opt.K, weight, data.b, dst, opt.cellA, opt.cellB, epilogue); break;
+                case Opt::Ver2: Ver2::Execute(data.b, opt.paddedW, opt.paddedH, srcDepth, weight, kernelX, kernelY, dst, dstWidth, dstHeight, dstDepth, epilogue); break;
+                case Opt::Ver3: Ver3::Execute(dstDepth, opt.N, opt.K, weight, opt.M*opt.K, data.b, data.t, dst, dstWidth, dstHeight, opt.cellA, opt.cellB, epilogue); break;
+                default: break;
+                }
+            }
+
+            void Forward(const Opt & opt, const float * src, size_t srcWidth, size_t srcHeight, size_t srcDepth, const float * weight, size_t kernelX, size_t kernelY,
+                size_t padX, size_t padY, size_t strideX, size_t strideY, size_t dilationX, size_t dilationY, Data & data, float * dst, size_t dstWidth, size_t dstHeight, size_t dstDepth)
+            {
+                PrepareB(opt, src, srcWidth, srcHeight, srcDepth, kernelX, kernelY, padX, padY, strideX, strideY, dilationX, dilationY, data, dstWidth, dstHeight);
+                Execute(opt, srcDepth, weight, kernelX, kernelY, data, dst, dstWidth, dstHeight, dstDepth);
+            }
+
+            template <SimdNeuralActivationType type> SIMD_INLINE __m256 Activate(__m256 value, const __m256 * params);
+
+            template <> SIMD_INLINE __m256 Activate<SimdNeuralActivationIdentity>(__m256 value, const __m256 * params)
+            {
+                return value;
+            }
+
+            template <> SIMD_INLINE __m256 Activate<SimdNeuralActivationTanh>(__m256 value, const __m256 * params)
+            {
+                __m256 x = _mm256_andnot_ps(params[4], _mm256_mul_ps(value, params[0]));
+                __m256 x2 = _mm256_mul_ps(x, x);
+                __m256 x4 = _mm256_mul_ps(x2, x2);
+                __m256 pe = _mm256_add_ps(_mm256_fmadd_ps(x2, params[5], params[2]), _mm256_fmadd_ps(x4, params[6], x));
+                __m256 ne = _mm256_rcp_ps(pe);
+                __m256 absTanh = _mm256_mul_ps(_mm256_sub_ps(pe, ne), _mm256_rcp_ps(_mm256_add_ps(pe, ne)));
+                return _mm256_xor_ps(absTanh, _mm256_and_ps(params[4], _mm256_cmp_ps(params[4], value, _CMP_GT_OS)));
+            }
+
+            template <> SIMD_INLINE __m256 Activate<SimdNeuralActivationSigmoid>(__m256 value, const __m256 * params)
+            {
+                __m256 e1 = _mm256_max_ps(params[3], _mm256_fmadd_ps(value, params[1], params[2]));
+                __m256 e2 = _mm256_mul_ps(e1, e1);
+                __m256 e4 = _mm256_mul_ps(e2, e2);
+                __m256 e8 = _mm256_mul_ps(e4, e4);
+                __m256 e16 = _mm256_mul_ps(e8, e8);
+                __m256 e32 = _mm256_mul_ps(e16, e16);
+                __m256 e64 = _mm256_mul_ps(e32, e32);
+                return _mm256_rcp_ps(_mm256_fmadd_ps(e64, e64, params[2]));
+            }
+
+            template <> SIMD_INLINE __m256 Activate<SimdNeuralActivationRelu>(__m256 value, const __m256 * params)
+            {
+                return _mm256_max_ps(_mm256_mul_ps(params[0], value), value);
+            }
+
+            struct Convolution : public NeuralConvolution
+            {
+                Convolution(size_t srcWidth, size_t srcHeight, size_t srcDepth, const float * weight, size_t kernelX, size_t kernelY, size_t padX, size_t padY,
+                    size_t strideX, size_t strideY, size_t dilationX, size_t dilationY, size_t dstWidth, size_t dstHeight, size_t dstDepth,
+                    const float * bias, SimdNeuralActivationType activation, const float * slope)
+                    : NeuralConvolution(srcWidth, srcHeight, srcDepth, kernelX, kernelY, padX, padY, strideX, strideY, dilationX, dilationY, dstWidth, dstHeight, dstDepth,
+                        bias, activation, slope)
+                    , _opt(srcWidth, srcHeight, srcDepth, kernelX, kernelY, padX, padY, strideX, strideY, dilationX, dilationY, dstWidth, dstHeight, dstDepth)
+                {
+                    size_t size = _opt.sizeA ? _opt.sizeA : _opt.M*_opt.K;
+                    this->weight = (float*)Allocate(AlignHi(size, F) * sizeof(float));
+                    if (_opt.alg == Opt::Ver1)
+                        Ver1::PrepareA(weight, _opt.M, _opt.K, _opt.cellA, this->weight);
+                    else if (_opt.alg == Opt::Ver3)
+                        Ver3::PrepareA(weight, _opt.M, _opt.K, _opt.cellA, this->weight);
+                    else
+                        memcpy(this->weight, weight, size * sizeof(float));
+                }
+
+                virtual void Run(const float * src, void * buffer, size_t * size, float * dst, int add) const
+                {
+                    if (!add)
+                        memset(dst, 0, dstWidth*dstHeight*dstDepth * sizeof(float));
+
+                    Data data(0, _opt.sizeB, _opt.sizeT, buffer, size);
+
+                    PrepareB(_opt, src, srcWidth, srcHeight, srcDepth, kernelX, kernelY, padX, padY, strideX, strideY, dilationX, dilationY, data, dstWidth, dstHeight);
+                    Execute(_opt, srcDepth, weight, kernelX, kernelY, data, dst, dstWidth, dstHeight, dstDepth, HasEpilogue() ? this : NULL);
+                }
+
+            private:
+                template <SimdNeuralActivationType type> void Epilogue(size_t channel, size_t count, float * dst) const
+                {
+                    size_t size = dstWidth*dstHeight, aligned = AlignLo(size, F);
+                    __m256 params[7] = { _mm256_set1_ps(slope), _mm256_set1_ps(-slope*0.0078125f), _mm256_set1_ps(1.0f), _mm256_set1_ps(0.5f), _mm256_set1_ps(-0.0f), _mm256_set1_ps(0.5658f), _mm256_set1_ps(0.1430f) };
+                    for (size_t c = channel; c < channel + count; ++c)
+                    {
+                        __m256 _bias = _mm256_set1_ps(bias ? bias[c] : 0.0f);
+                        size_t i = 0;
+                        for (; i < aligned; i += F)
+                            Avx::Store<false>(dst + i, Ncf::Activate<type>(_mm256_add_ps(Avx::Load<false>(dst + i), _bias), params));
+                        NeuralConvolution::Epilogue(c, i, size, dst);
+                        dst += size;
+                    }
+                }
+
+                virtual void Epilogue(size_t channel, size_t count, float * dst) const
+                {
+                    switch (activation)
+                    {
+                    case SimdNeuralActivationIdentity: Epilogue<SimdNeuralActivationIdentity>(channel, count, dst); break;
+                    case SimdNeuralActivationTanh: Epilogue<SimdNeuralActivationTanh>(channel, count, dst); break;
+                    case SimdNeuralActivationSigmoid: Epilogue<SimdNeuralActivationSigmoid>(channel, count, dst); break;
+                    case SimdNeuralActivationRelu: Epilogue<SimdNeuralActivationRelu>(channel, count, dst); break;
+                    default: assert(0);
+                    }
+                }
+
+                Opt _opt;
+            };
         }
 
         void NeuralConvolutionForward(const float * src, size_t srcWidth, size_t srcHeight, size_t srcDepth,
@@ -1551,7 +2026,8 @@ namespace Simd
             {
                 switch (opt.alg)
                 {
-                case Opt::Ver1: Ver1::PrepareA(weight, opt.M, opt.K, opt.cellA, data.a);
+                case Opt::Ver1: Ver1::PrepareA(weight, opt.M, opt.K, opt.cellA, data.a); break;
+                case Opt::Ver3: Ver3::PrepareA(weight, opt.M, opt.K, opt.cellA, data.a); break;
                 default:
                     break;
                 }
@@ -1559,26 +2035,16 @@ namespace Simd
             else
                 data.a = (float*)weight;
 
-            if (opt.sizeB)
-            {
-                switch (opt.alg)
-                {
-                case Opt::Ver0: Ver0::PrepareB(src, srcWidth, srcHeight, srcDepth, kernelX, kernelY, padX, padY, strideX, strideY, dilationX, dilationY, dstWidth, dstHeight, data.b); break;
-                case Opt::Ver1: Ver1::PrepareB(src, srcWidth, srcHeight, srcDepth, kernelX, kernelY, padX, padY, strideX, strideY, dilationX, dilationY, dstWidth, dstHeight, opt.cellB, data.t, data.b); break;
-                case Opt::Ver2: Ver2::PrepareB(src, srcWidth, srcHeight, srcDepth, padX, padY, data.b, opt.paddedW, opt.paddedH); break;
-                default: break;
-                }
-            }
-            else
-                data.b = (float*)src;
+            Forward(opt, src, srcWidth, srcHeight, srcDepth, data.a, kernelX, kernelY, padX, padY, strideX, strideY, dilationX, dilationY,
+                data, dst, dstWidth, dstHeight, dstDepth);
+        }
 
-            switch (opt.alg)
-            {
-            case Opt::Ver0: Ver0::Execute(opt.M, opt.N, opt.K, data.a, data.b, dst); break;
-            case Opt::Ver1: Ver1::Execute(opt.M, opt.N, opt.K, data.a, data.b, dst, opt.cellA, opt.cellB); break;
-            case Opt::Ver2: Ver2::Execute(data.b, opt.paddedW, opt.paddedH, srcDepth, weight, kernelX, kernelY, dst, dstWidth, dstHeight, dstDepth); break;
-            default: break;
-            }
+        void * NeuralConvolutionInit(size_t srcWidth, size_t srcHeight, size_t srcDepth, const float * weight, size_t kernelX, size_t kernelY,
+            size_t padX, size_t padY, size_t strideX, size_t strideY, size_t dilationX, size_t dilationY, size_t dstWidth, size_t dstHeight, size_t dstDepth,
+            const float * bias, SimdNeuralActivationType activation, const float * slope)
+        {
+            return new Ncf::Convolution(srcWidth, srcHeight, srcDepth, weight, kernelX, kernelY, padX, padY, strideX, strideY, dilationX, dilationY, dstWidth, dstHeight, dstDepth,
+                bias, activation, slope);
         }
     }
 #endif// SIMD_AVX2_ENABLE
@@ -24,6 +24,7 @@
 #include "Simd/SimdMemory.h"
 #include "Simd/SimdStore.h"
 #include "Simd/SimdCompare.h"
+#include "Simd/SimdSegmentation.h"
 
 namespace Simd
 {
@@ -277,6 +278,34 @@ namespace Simd
                 }
             }
         }
+
+        size_t SegmentationLabel(uint8_t * mask, size_t maskStride, size_t width, size_t height, const uint8_t * difference, size_t differenceStride,
+            uint8_t seedIndex, uint8_t emptyIndex, uint8_t invalidIndex, uint8_t differenceThreshold, size_t areaMin, uint8_t indexMin, ptrdiff_t * rects)
+        {
+            __m256i _seedIndex = _mm256_set1_epi8((char)seedIndex);
+            __m256i _emptyIndex = _mm256_set1_epi8((char)emptyIndex);
+            __m256i _threshold = _mm256_set1_epi8((char)differenceThreshold);
+            size_t alignedWidth = Simd::AlignLo(width, A);
+            Segmentation::Labeller labeller(width, height);
+            uint32_t * set = labeller.Set();
+            uint32_t * seed = labeller.Seed();
+            for (size_t row = 0; row < height; ++row)
+            {
+                const uint8_t * m = mask + row*maskStride;
+                const uint8_t * d = difference + row*differenceStride;
+                for (size_t col = 0; col < alignedWidth; col += A)
+                {
+                    const __m256i _mask = Load<false>((__m256i*)(m + col));
+                    const __m256i _seed = _mm256_cmpeq_epi8(_mask, _seedIndex);
+                    const __m256i _grow = _mm256_and_si256(_mm256_cmpeq_epi8(_mask, _emptyIndex), Greater8u(Load<false>((__m256i*)(d + col)), _threshold));
+                    set[col / A] = _mm256_movemask_epi8(_mm256_or_si256(_seed, _grow));
+                    seed[col / A] = _mm256_movemask_epi8(_seed);
+                }
+                labeller.SetTail(m, d, alignedWidth, seedIndex, emptyIndex, differenceThreshold);
+                labeller.AddRow(row);
+            }
+            return labeller.Finish(mask, maskStride, invalidIndex, areaMin, indexMin, rects);
+        }
     }
 #endif//SIMD_AVX2_ENABLE
 }
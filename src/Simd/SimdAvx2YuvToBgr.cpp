@@ -182,6 +182,56 @@ namespace Simd
             else
                 Yuv420pToBgr<false>(y, yStride, u, uStride, v, vStride, width, height, bgr, bgrStride);
         }
+
+        template <bool align> SIMD_INLINE void LoadUvPermuted(const uint8_t * uv, __m256i & u, __m256i & v)
+        {
+            __m256i uv0 = Load<align>((__m256i*)uv + 0);
+            __m256i uv1 = Load<align>((__m256i*)uv + 1);
+            u = _mm256_packus_epi16(_mm256_and_si256(uv0, K16_00FF), _mm256_and_si256(uv1, K16_00FF));
+            v = _mm256_packus_epi16(_mm256_srli_epi16(uv0, 8), _mm256_srli_epi16(uv1, 8));
+        }
+
+        template <bool align> void Nv12ToBgr(const uint8_t * y, size_t yStride, const uint8_t * uv, size_t uvStride,
+            size_t width, size_t height, uint8_t * bgr, size_t bgrStride)
+        {
+            assert((width % 2 == 0) && (height % 2 == 0) && (width >= DA) && (height >= 2));
+            if (align)
+                assert(Aligned(y) && Aligned(yStride) && Aligned(uv) && Aligned(uvStride) && Aligned(bgr) && Aligned(bgrStride));
+
+            size_t bodyWidth = AlignLo(width, DA);
+            size_t tail = width - bodyWidth;
+            size_t A6 = A * 6;
+            for (size_t row = 0; row < height; row += 2)
+            {
+                for (size_t colY = 0, colBgr = 0; colY < bodyWidth; colY += DA, colBgr += A6)
+                {
+                    __m256i u_, v_;
+                    LoadUvPermuted<align>(uv + colY, u_, v_);
+                    Yuv422pToBgr<align>(y + colY, u_, v_, bgr + colBgr);
+                    Yuv422pToBgr<align>(y + colY + yStride, u_, v_, bgr + colBgr + bgrStride);
+                }
+                if (tail)
+                {
+                    size_t offset = width - DA;
+                    __m256i u_, v_;
+                    LoadUvPermuted<false>(uv + offset, u_, v_);
+                    Yuv422pToBgr<false>(y + offset, u_, v_, bgr + 3 * offset);
+                    Yuv422pToBgr<false>(y + offset + yStride, u_, v_, bgr + 3 * offset + bgrStride);
+                }
+                y += 2 * yStride;
+                uv += uvStride;
+                bgr += 2 * bgrStride;
+            }
+        }
+
+        void Nv12ToBgr(const uint8_t * y, size_t yStride, const uint8_t * uv, size_t uvStride,
+            size_t width, size_t height, uint8_t * bgr, size_t bgrStride)
+        {
+            if (Aligned(y) && Aligned(yStride) && Aligned(uv) && Aligned(uvStride) && Aligned(bgr) && Aligned(bgrStride))
+                Nv12ToBgr<true>(y, yStride, uv, uvStride, width, height, bgr, bgrStride);
+            else
+                Nv12ToBgr<false>(y, yStride, uv, uvStride, width, height, bgr, bgrStride);
+        }
     }
 #endif// SIMD_AVX2_ENABLE
 }
@@ -338,6 +338,219 @@ namespace Simd
                 Image(hid.sum.width - 1, hid.sum.height - 1, dstStride, Image::Gray8, dst).Ref());
         }
 
+        SIMD_INLINE __m512i Norm16i(const __m512i & sum, const __m512i & sqsum, const __m512 & area, const __m512 & scale)
+        {
+            __m512 _sum = _mm512_cvtepi32_ps(sum);
+            __m512 _sqsum = _mm512_cvtepi32_ps(sqsum);
+            __m512 norm = ValidSqrt(_mm512_sub_ps(_mm512_mul_ps(_sqsum, area), _mm512_mul_ps(_sum, _sum)));
+            return _mm512_cvtps_epi32(_mm512_mul_ps(norm, scale));
+        }
+
+        template <bool masked> SIMD_INLINE __m512i Norm16ip(const HidHaarCascade16i & hid, size_t offset, const __mmask16 * tails)
+        {
+            __m512 area = _mm512_set1_ps(hid.windowArea);
+            __m512 scale = _mm512_set1_ps(hid.normScale);
+            __m512i lo = Norm16i(Sum32ip<masked>(hid.p, offset + 0, tails[0]), Sum32ip<masked>(hid.pq, offset + 0, tails[0]), area, scale);
+            __m512i hi = Norm16i(Sum32ip<masked>(hid.p, offset + F, tails[1]), Sum32ip<masked>(hid.pq, offset + F, tails[1]), area, scale);
+            return _mm512_permutexvar_epi64(K64_PERMUTE_FOR_PACK, _mm512_packs_epi32(lo, hi));
+        }
+
+        template <bool masked> SIMD_INLINE __m512i Norm16ii(const HidHaarCascade16i & hid, size_t offset, const __mmask16 * tails)
+        {
+            __m512 area = _mm512_set1_ps(hid.windowArea);
+            __m512 scale = _mm512_set1_ps(hid.normScale);
+            __m512i lo = Norm16i(Sum32ii<masked>(hid.p, offset + 0, tails + 0), Sum32ii<masked>(hid.pq, offset + 0, tails + 0), area, scale);
+            __m512i hi = Norm16i(Sum32ii<masked>(hid.p, offset + HA, tails + 2), Sum32ii<masked>(hid.pq, offset + HA, tails + 2), area, scale);
+            return _mm512_permutexvar_epi64(K64_PERMUTE_FOR_PACK, _mm512_packs_epi32(lo, hi));
+        }
+
+        template <bool masked> SIMD_INLINE __m512i RectSum16i(const WeightedRect16i & rect, size_t offset, __mmask16 tail, const __m512i & round, const __m128i & shift)
+        {
+            __m512i s0 = Load<false, masked>(rect.p0 + offset, tail);
+            __m512i s1 = Load<false, masked>(rect.p1 + offset, tail);
+            __m512i s2 = Load<false, masked>(rect.p2 + offset, tail);
+            __m512i s3 = Load<false, masked>(rect.p3 + offset, tail);
+            __m512i sum = _mm512_sub_epi32(_mm512_sub_epi32(s0, s1), _mm512_sub_epi32(s2, s3));
+            return _mm512_srl_epi32(_mm512_add_epi32(sum, round), shift);
+        }
+
+        template <bool masked> SIMD_INLINE __m512i WeightedSum16i(const WeightedRect16i & rect, size_t offset, __mmask32 tail, const __m512i & round, const __m128i & shift)
+        {
+            __m512i lo = RectSum16i<masked>(rect, offset + 0, __mmask16(tail), round, shift);
+            __m512i hi = RectSum16i<masked>(rect, offset + F, __mmask16(tail >> 16), round, shift);
+            __m512i sum = _mm512_permutexvar_epi64(K64_PERMUTE_FOR_PACK, _mm512_packs_epi32(lo, hi));
+            return _mm512_mullo_epi16(sum, _mm512_set1_epi16(rect.weight));
+        }
+
+        SIMD_INLINE void StageSum16i(const int16_t * leaves, int16_t threshold, const __m512i & sum, const __m512i & norm, __m512i & stageSum)
+        {
+            __mmask32 mask = _mm512_cmpgt_epi16_mask(sum, _mm512_mulhi_epi16(_mm512_set1_epi16(threshold), norm));
+            stageSum = _mm512_add_epi16(stageSum, _mm512_mask_blend_epi16(mask, _mm512_set1_epi16(leaves[0]), _mm512_set1_epi16(leaves[1])));
+        }
+
+        template <bool masked> __mmask32 Detect16i(const HidHaarCascade16i & hid, size_t offset, const __m512i & norm, __mmask32 result)
+        {
+            typedef HidHaarCascade16i Hid;
+            const int16_t * leaves = hid.leaves.data();
+            const Hid::Node * node = hid.nodes.data();
+            const Hid::Stage * stages = hid.stages.data();
+            for (int i = 0, n = (int)hid.stages.size(); i < n; ++i)
+            {
+                const Hid::Stage & stage = stages[i];
+                const Hid::Node * end = node + stage.ntrees;
+                __m512i stageSum = _mm512_setzero_si512();
+                if (stage.hasThree)
+                {
+                    for (; node < end; ++node, leaves += 2)
+                    {
+                        const Hid::Feature & feature = hid.features[node->featureIdx];
+                        __m512i round = _mm512_set1_epi32(1 << feature.shift >> 1);
+                        __m128i shift = _mm_cvtsi32_si128(feature.shift);
+                        __m512i sum = _mm512_add_epi16(
+                            WeightedSum16i<masked>(feature.rect[0], offset, result, round, shift),
+                            WeightedSum16i<masked>(feature.rect[1], offset, result, round, shift));
+                        if (feature.rect[2].p0)
+                            sum = _mm512_add_epi16(sum, WeightedSum16i<masked>(feature.rect[2], offset, result, round, shift));
+                        StageSum16i(leaves, node->threshold, sum, norm, stageSum);
+                    }
+                }
+                else
+                {
+                    for (; node < end; ++node, leaves += 2)
+                    {
+                        const Hid::Feature & feature = hid.features[node->featureIdx];
+                        __m512i round = _mm512_set1_epi32(1 << feature.shift >> 1);
+                        __m128i shift = _mm_cvtsi32_si128(feature.shift);
+                        __m512i sum = _mm512_add_epi16(WeightedSum16i<masked>(feature.rect[0], offset, result, round, shift),
+                            WeightedSum16i<masked>(feature.rect[1], offset, result, round, shift));
+                        StageSum16i(leaves, node->threshold, sum, norm, stageSum);
+                    }
+                }
+                result = result & _mm512_cmpge_epi16_mask(stageSum, _mm512_set1_epi16(stage.threshold));
+                if (!result)
+                    return result;
+                int resultCount = _mm_popcnt_u32(result);
+                if (resultCount == 1)
+                {
+                    int j = _tzcnt_u32(result);
+                    int16_t SIMD_ALIGNED(64) _norm[HA];
+                    _mm512_store_si512(_norm, norm);
+                    return Base::Detect16i(hid, offset + j, i + 1, _norm[j]) > 0 ? result : __mmask32(0);
+                }
+            }
+            return result;
+        }
+
+        void DetectionHaarDetect16ip(const HidHaarCascade16i & hid, const Image & mask, const Rect & rect, Image & dst)
+        {
+            size_t width = rect.Width();
+            size_t alignedWidth = Simd::AlignLo(width, HA);
+            __mmask32 tailMask = TailMask32(width - alignedWidth);
+            __mmask16 tailMasks[2];
+            for (size_t c = 0; c < 2; ++c)
+                tailMasks[c] = TailMask16(width - alignedWidth - F*c);
+            Buffer<uint16_t> buffer(width);
+            for (ptrdiff_t row = rect.top; row < rect.bottom; row += 1)
+            {
+                size_t col = 0;
+                size_t p_offset = row * hid.sum.stride / sizeof(uint32_t) + rect.left;
+                size_t pq_offset = row * hid.sqsum.stride / sizeof(uint32_t) + rect.left;
+
+                UnpackMask16i(mask.data + row*mask.stride + rect.left, width, buffer.m, K8_01);
+                memset(buffer.d, 0, width * sizeof(uint16_t));
+                for (; col < alignedWidth; col += HA)
+                {
+                    __mmask32 result = _mm512_cmpneq_epi16_mask(Load<false>(buffer.m + col), K_ZERO);
+                    if (result)
+                    {
+                        __m512i norm = Norm16ip<false>(hid, pq_offset + col, tailMasks);
+                        result = Detect16i<false>(hid, p_offset + col, norm, result);
+                        Store<false>(buffer.d + col, _mm512_maskz_set1_epi16(result, 1));
+                    }
+                }
+                if (col < width)
+                {
+                    __mmask32 result = _mm512_cmpneq_epi16_mask((Load<false, true>(buffer.m + col, tailMask)), K_ZERO);
+                    if (result)
+                    {
+                        __m512i norm = Norm16ip<true>(hid, pq_offset + col, tailMasks);
+                        result = Detect16i<true>(hid, p_offset + col, norm, result);
+                        Store<false, true>(buffer.d + col, _mm512_maskz_set1_epi16(result, 1), tailMask);
+                    }
+                }
+                PackResult16i(buffer.d, width, dst.data + row*dst.stride + rect.left);
+            }
+        }
+
+        void DetectionHaarDetect16ip(const void * _hid, const uint8_t * mask, size_t maskStride,
+            ptrdiff_t left, ptrdiff_t top, ptrdiff_t right, ptrdiff_t bottom, uint8_t * dst, size_t dstStride)
+        {
+            const HidHaarCascade16i & hid = *(HidHaarCascade16i*)_hid;
+            return DetectionHaarDetect16ip(hid,
+                Image(hid.sum.width - 1, hid.sum.height - 1, maskStride, Image::Gray8, (uint8_t*)mask),
+                Rect(left, top, right, bottom),
+                Image(hid.sum.width - 1, hid.sum.height - 1, dstStride, Image::Gray8, dst).Ref());
+        }
+
+        void DetectionHaarDetect16ii(const HidHaarCascade16i & hid, const Image & mask, const Rect & rect, Image & dst)
+        {
+            const size_t step = 2;
+            size_t width = rect.Width();
+            size_t alignedWidth = Simd::AlignLo(width, A);
+            size_t evenWidth = Simd::AlignLo(width, 2);
+            __mmask32 tailMask = TailMask32((evenWidth - alignedWidth) / 2);
+            __mmask16 tailMasks[4];
+            for (size_t c = 0; c < 4; ++c)
+                tailMasks[c] = TailMask16(evenWidth - alignedWidth - F*c);
+            for (ptrdiff_t row = rect.top; row < rect.bottom; row += step)
+            {
+                size_t col = 0;
+                size_t p_offset = row * hid.isum.stride / sizeof(uint32_t) + rect.left / 2;
+                size_t pq_offset = row * hid.sqsum.stride / sizeof(uint32_t) + rect.left;
+                const uint8_t * m = mask.data + row*mask.stride + rect.left;
+                uint8_t * d = dst.data + row*dst.stride + rect.left;
+                for (; col < alignedWidth; col += A)
+                {
+                    __mmask32 result = _mm512_cmpneq_epi16_mask(_mm512_and_si512(Load<false>(m + col), K16_00FF), K_ZERO);
+                    if (result)
+                    {
+                        __m512i norm = Norm16ii<false>(hid, pq_offset + col, tailMasks);
+                        result = Detect16i<false>(hid, p_offset + col / 2, norm, result);
+                        Store<false>(d + col, _mm512_maskz_set1_epi16(result, 1));
+                    }
+                }
+                if (col < evenWidth)
+                {
+                    __mmask32 result = _mm512_cmpneq_epi16_mask(_mm512_and_si512((Load<false, true>((uint16_t*)m + col / 2, tailMask)), K16_00FF), K_ZERO);
+                    if (result)
+                    {
+                        __m512i norm = Norm16ii<true>(hid, pq_offset + col, tailMasks);
+                        result = Detect16i<true>(hid, p_offset + col / 2, norm, result);
+                        Store<false, true>((uint16_t*)d + col / 2, _mm512_maskz_set1_epi16(result, 1), tailMask);
+                    }
+                    col = evenWidth;
+                }
+                for (; col < width; col += step)
+                {
+                    if (mask.At<uint8_t>(col + rect.left, row) == 0)
+                        continue;
+                    int16_t norm = Base::Norm16i(hid, pq_offset + col);
+                    if (Base::Detect16i(hid, p_offset + col / 2, 0, norm) > 0)
+                        dst.At<uint8_t>(col + rect.left, row) = 1;
+                }
+            }
+        }
+
+        void DetectionHaarDetect16ii(const void * _hid, const uint8_t * mask, size_t maskStride,
+            ptrdiff_t left, ptrdiff_t top, ptrdiff_t right, ptrdiff_t bottom, uint8_t * dst, size_t dstStride)
+        {
+            const HidHaarCascade16i & hid = *(HidHaarCascade16i*)_hid;
+            return DetectionHaarDetect16ii(hid,
+                Image(hid.sum.width - 1, hid.sum.height - 1, maskStride, Image::Gray8, (uint8_t*)mask),
+                Rect(left, top, right, bottom),
+                Image(hid.sum.width - 1, hid.sum.height - 1, dstStride, Image::Gray8, dst).Ref());
+        }
+
         const __m512i K8_SHUFFLE_BITS = SIMD_MM512_SETR_EPI8(
             0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
             0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
@@ -202,6 +202,48 @@ namespace Simd
             else
                 SquaredDifferenceSum16f<false>(a, b, size, sum);
         }
+
+        template <bool align, bool mask> SIMD_INLINE void NeuralProductSum16f(const float * a, const uint16_t * b, size_t offset, __m512 & sum, __mmask16 m = -1)
+        {
+            __m512 _a = Avx512f::Load<align, mask>(a + offset, m);
+            __m512 _b = _mm512_cvtph_ps(mask ? _mm256_maskz_loadu_epi16(m, b + offset) : Avx2::Load<align>((__m256i*)(b + offset)));
+            sum = _mm512_fmadd_ps(_a, _b, sum);
+        }
+
+        template <bool align> SIMD_INLINE void NeuralProductSum16f(const float * a, const uint16_t * b, size_t size, float * sum)
+        {
+            if (align)
+                assert(Aligned(a) && Aligned(b));
+
+            size_t partialAlignedSize = AlignLo(size, F);
+            size_t fullAlignedSize = AlignLo(size, QF);
+            size_t i = 0;
+            __m512 sum0 = _mm512_setzero_ps(), sum1 = _mm512_setzero_ps(), sum2 = _mm512_setzero_ps(), sum3 = _mm512_setzero_ps();
+            for (; i < fullAlignedSize; i += QF)
+            {
+                NeuralProductSum16f<align, false>(a, b, i + F * 0, sum0);
+                NeuralProductSum16f<align, false>(a, b, i + F * 1, sum1);
+                NeuralProductSum16f<align, false>(a, b, i + F * 2, sum2);
+                NeuralProductSum16f<align, false>(a, b, i + F * 3, sum3);
+            }
+            sum0 = _mm512_add_ps(_mm512_add_ps(sum0, sum1), _mm512_add_ps(sum2, sum3));
+            for (; i < partialAlignedSize; i += F)
+                NeuralProductSum16f<align, false>(a, b, i, sum0);
+            if (i < size)
+            {
+                __mmask16 tailMask = __mmask16(-1) >> (F + i - size);
+                NeuralProductSum16f<align, true>(a, b, i, sum0, tailMask);
+            }
+            *sum = Avx512f::ExtractSum(sum0);
+        }
+
+        void NeuralProductSum16f(const float * a, const uint16_t * b, size_t size, float * sum)
+        {
+            if (Aligned(a) && Aligned(b))
+                NeuralProductSum16f<true>(a, b, size, sum);
+            else
+                NeuralProductSum16f<false>(a, b, size, sum);
+        }
     }
 #endif// SIMD_AVX512BW_ENABLE
 }
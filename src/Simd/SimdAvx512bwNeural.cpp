@@ -24,6 +24,8 @@
 #include "Simd/SimdMemory.h"
 #include "Simd/SimdStore.h"
 #include "Simd/SimdStream.h"
+#include "Simd/SimdExtract.h"
+#include "Simd/SimdArray.h"
 
 namespace Simd
 {
@@ -90,6 +92,164 @@ namespace Simd
             else
                 NeuralConvert<false>(src, srcStride, width, height, dst, dstStride);
         }
+
+        SIMD_INLINE void NeuralProductSum8i(const __m512i & a, const __m512i & b, __m512i & sum)
+        {
+            sum = _mm512_add_epi32(sum, _mm512_madd_epi16(_mm512_maddubs_epi16(b, a), K16_0001));
+        }
+
+        SIMD_INLINE __m128i Extract4Sums(const __m512i sums[4])
+        {
+            __m256i sum0 = _mm256_add_epi32(_mm512_castsi512_si256(sums[0]), _mm512_extracti64x4_epi64(sums[0], 1));
+            __m256i sum1 = _mm256_add_epi32(_mm512_castsi512_si256(sums[1]), _mm512_extracti64x4_epi64(sums[1], 1));
+            __m256i sum2 = _mm256_add_epi32(_mm512_castsi512_si256(sums[2]), _mm512_extracti64x4_epi64(sums[2], 1));
+            __m256i sum3 = _mm256_add_epi32(_mm512_castsi512_si256(sums[3]), _mm512_extracti64x4_epi64(sums[3], 1));
+            __m256i sum = _mm256_hadd_epi32(_mm256_hadd_epi32(sum0, sum1), _mm256_hadd_epi32(sum2, sum3));
+            return _mm_add_epi32(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+        }
+
+        template <bool mask> SIMD_INLINE void NeuralProductSum8i4(const int8_t * a, size_t K, const uint8_t * b, __m512i * sums, __mmask64 tail = -1)
+        {
+            __m512i _b = Load<false, mask>(b, tail);
+            NeuralProductSum8i(Load<false, mask>((const uint8_t*)a + 0 * K, tail), _b, sums[0]);
+            NeuralProductSum8i(Load<false, mask>((const uint8_t*)a + 1 * K, tail), _b, sums[1]);
+            NeuralProductSum8i(Load<false, mask>((const uint8_t*)a + 2 * K, tail), _b, sums[2]);
+            NeuralProductSum8i(Load<false, mask>((const uint8_t*)a + 3 * K, tail), _b, sums[3]);
+        }
+
+        void NeuralProductSum8i4(size_t K, size_t alignedK, const int8_t * a, const uint8_t * b, __mmask64 tailMask, int32_t * c, size_t N)
+        {
+            __m512i sums[4] = { _mm512_setzero_si512(), _mm512_setzero_si512(), _mm512_setzero_si512(), _mm512_setzero_si512() };
+            size_t k = 0;
+            for (; k < alignedK; k += A)
+                NeuralProductSum8i4<false>(a + k, K, b + k, sums);
+            if (k < K)
+                NeuralProductSum8i4<true>(a + k, K, b + k, sums, tailMask);
+            __m128i sum = Extract4Sums(sums);
+            c[0 * N] = _mm_extract_epi32(sum, 0);
+            c[1 * N] = _mm_extract_epi32(sum, 1);
+            c[2 * N] = _mm_extract_epi32(sum, 2);
+            c[3 * N] = _mm_extract_epi32(sum, 3);
+        }
+
+        void NeuralProductSum8i1(size_t K, size_t alignedK, const int8_t * a, const uint8_t * b, __mmask64 tailMask, int32_t * c)
+        {
+            __m512i sum = _mm512_setzero_si512();
+            size_t k = 0;
+            for (; k < alignedK; k += A)
+                NeuralProductSum8i(Load<false>(a + k), Load<false>(b + k), sum);
+            if (k < K)
+                NeuralProductSum8i(Load<false, true>((const uint8_t*)a + k, tailMask), Load<false, true>(b + k, tailMask), sum);
+            c[0] = ExtractSum<uint32_t>(sum);
+        }
+
+        void NeuralProductSum8iDot(size_t M, size_t N, size_t K, const int8_t * a, const uint8_t * b, int32_t * c)
+        {
+            Array<uint8_t> bt(N*K);
+            for (size_t j = 0; j < N; ++j)
+                for (size_t k = 0; k < K; ++k)
+                    bt[j*K + k] = b[k*N + j];
+            b = bt.data;
+            size_t alignedK = AlignLo(K, A);
+            size_t alignedM = AlignLo(M, 4);
+            __mmask64 tailMask = TailMask64(K - alignedK);
+            size_t i = 0;
+            for (; i < alignedM; i += 4)
+            {
+                for (size_t j = 0; j < N; ++j)
+                    NeuralProductSum8i4(K, alignedK, a + i*K, b + j*K, tailMask, c + i*N + j, N);
+            }
+            for (; i < M; ++i)
+            {
+                for (size_t j = 0; j < N; ++j)
+                    NeuralProductSum8i1(K, alignedK, a + i*K, b + j*K, tailMask, c + i*N + j);
+            }
+        }
+
+        template <size_t rows> void NeuralProductSum8iBlock(size_t K4, const int32_t * a, const uint8_t * b, size_t bStride, int32_t * c, size_t N, __mmask16 tails[2])
+        {
+            __m512i sums[rows][2];
+            for (size_t r = 0; r < rows; ++r)
+                sums[r][0] = _mm512_setzero_si512(), sums[r][1] = _mm512_setzero_si512();
+            for (size_t k = 0; k < K4; ++k, b += bStride)
+            {
+                __m512i b0 = Load<true>(b + 0);
+                __m512i b1 = Load<true>(b + A);
+                for (size_t r = 0; r < rows; ++r)
+                {
+                    __m512i _a = _mm512_set1_epi32(a[r*K4 + k]);
+                    NeuralProductSum8i(_a, b0, sums[r][0]);
+                    NeuralProductSum8i(_a, b1, sums[r][1]);
+                }
+            }
+            for (size_t r = 0; r < rows; ++r)
+            {
+                _mm512_mask_storeu_epi32(c + r*N + 0, tails[0], sums[r][0]);
+                _mm512_mask_storeu_epi32(c + r*N + F, tails[1], sums[r][1]);
+            }
+        }
+
+        SIMD_INLINE void NeuralPackB4(const uint8_t * b, size_t N, uint8_t * dst)
+        {
+            __m512i b0 = Load<false>(b + 0 * N);
+            __m512i b1 = Load<false>(b + 1 * N);
+            __m512i b2 = Load<false>(b + 2 * N);
+            __m512i b3 = Load<false>(b + 3 * N);
+            __m512i lo01 = _mm512_unpacklo_epi8(b0, b1), hi01 = _mm512_unpackhi_epi8(b0, b1);
+            __m512i lo23 = _mm512_unpacklo_epi8(b2, b3), hi23 = _mm512_unpackhi_epi8(b2, b3);
+            __m512i q0 = _mm512_unpacklo_epi16(lo01, lo23), q1 = _mm512_unpackhi_epi16(lo01, lo23);
+            __m512i q2 = _mm512_unpacklo_epi16(hi01, hi23), q3 = _mm512_unpackhi_epi16(hi01, hi23);
+            __m512i t0 = _mm512_shuffle_i64x2(q0, q1, 0x44), t1 = _mm512_shuffle_i64x2(q2, q3, 0x44);
+            __m512i t2 = _mm512_shuffle_i64x2(q0, q1, 0xEE), t3 = _mm512_shuffle_i64x2(q2, q3, 0xEE);
+            Store<false>(dst + 0 * A, _mm512_shuffle_i64x2(t0, t1, 0x88));
+            Store<false>(dst + 1 * A, _mm512_shuffle_i64x2(t0, t1, 0xDD));
+            Store<false>(dst + 2 * A, _mm512_shuffle_i64x2(t2, t3, 0x88));
+            Store<false>(dst + 3 * A, _mm512_shuffle_i64x2(t2, t3, 0xDD));
+        }
+
+        void NeuralProductSum8iPacked(size_t M, size_t N, size_t K, const int8_t * a, const uint8_t * b, int32_t * c)
+        {
+            size_t K4 = (K + 3) / 4, alignedN = AlignHi(N, DF), bStride = alignedN * 4;
+            Array<uint8_t> buffer(K4*bStride + M*K4*4, true);
+            uint8_t * pb = buffer.data;
+            int32_t * pa = (int32_t*)(buffer.data + K4*bStride);
+            for (size_t i = 0; i < M; ++i)
+                memcpy(pa + i*K4, a + i*K, K);
+            size_t fullN = AlignLo(N, A);
+            for (size_t k = 0; k < K; k += 4, b += 4 * N)
+            {
+                uint8_t * pd = pb + k / 4 * bStride;
+                size_t rows = Simd::Min<size_t>(K - k, 4), j = 0;
+                if (rows == 4)
+                {
+                    for (; j < fullN; j += A)
+                        NeuralPackB4(b + j, N, pd + j * 4);
+                }
+                for (; j < N; ++j)
+                    for (size_t r = 0; r < rows; ++r)
+                        pd[j * 4 + r] = b[r*N + j];
+            }
+
+            size_t alignedM = AlignLo(M, 4);
+            for (size_t j = 0; j < N; j += DF)
+            {
+                size_t width = Simd::Min(N - j, DF);
+                __mmask16 tails[2] = { TailMask16(width), TailMask16(width - F) };
+                size_t i = 0;
+                for (; i < alignedM; i += 4)
+                    NeuralProductSum8iBlock<4>(K4, pa + i*K4, pb + j * 4, bStride, c + i*N + j, N, tails);
+                for (; i < M; ++i)
+                    NeuralProductSum8iBlock<1>(K4, pa + i*K4, pb + j * 4, bStride, c + i*N + j, N, tails);
+            }
+        }
+
+        void NeuralProductSum8i(size_t M, size_t N, size_t K, const int8_t * a, const uint8_t * b, int32_t * c)
+        {
+            if (N >= F)
+                NeuralProductSum8iPacked(M, N, K, a, b, c);
+            else
+                NeuralProductSum8iDot(M, N, K, a, b, c);
+        }
     }
 #endif// SIMD_AVX512BW_ENABLE
 }
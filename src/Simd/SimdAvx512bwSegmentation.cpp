@@ -24,6 +24,7 @@
 #include "Simd/SimdMemory.h"
 #include "Simd/SimdStore.h"
 #include "Simd/SimdCompare.h"
+#include "Simd/SimdSegmentation.h"
 
 namespace Simd
 {
@@ -284,6 +285,37 @@ namespace Simd
                 }
             }
         }
+
+        size_t SegmentationLabel(uint8_t * mask, size_t maskStride, size_t width, size_t height, const uint8_t * difference, size_t differenceStride,
+            uint8_t seedIndex, uint8_t emptyIndex, uint8_t invalidIndex, uint8_t differenceThreshold, size_t areaMin, uint8_t indexMin, ptrdiff_t * rects)
+        {
+            __m512i _seedIndex = _mm512_set1_epi8((char)seedIndex);
+            __m512i _emptyIndex = _mm512_set1_epi8((char)emptyIndex);
+            __m512i _threshold = _mm512_set1_epi8((char)differenceThreshold);
+            size_t alignedWidth = Simd::AlignLo(width, A);
+            Segmentation::Labeller labeller(width, height);
+            uint32_t * set = labeller.Set();
+            uint32_t * seed = labeller.Seed();
+            for (size_t row = 0; row < height; ++row)
+            {
+                const uint8_t * m = mask + row*maskStride;
+                const uint8_t * d = difference + row*differenceStride;
+                for (size_t col = 0; col < alignedWidth; col += A)
+                {
+                    const __m512i _mask = Load<false>(m + col);
+                    __mmask64 _seed = _mm512_cmpeq_epi8_mask(_mask, _seedIndex);
+                    __mmask64 _grow = _mm512_cmpeq_epi8_mask(_mask, _emptyIndex) & _mm512_cmpgt_epu8_mask(Load<false>(d + col), _threshold);
+                    __mmask64 _set = _seed | _grow;
+                    set[col / 32 + 0] = uint32_t(_set);
+                    set[col / 32 + 1] = uint32_t(_set >> 32);
+                    seed[col / 32 + 0] = uint32_t(_seed);
+                    seed[col / 32 + 1] = uint32_t(_seed >> 32);
+                }
+                labeller.SetTail(m, d, alignedWidth, seedIndex, emptyIndex, differenceThreshold);
+                labeller.AddRow(row);
+            }
+            return labeller.Finish(mask, maskStride, invalidIndex, areaMin, indexMin, rects);
+        }
     }
 #endif//SIMD_AVX512BW_ENABLE
 }
@@ -147,6 +147,107 @@ namespace Simd
                 TextureBoostedUv<false>(src, srcStride, width, height, boost, dst, dstStride);
         }
 
+        template <bool align, bool mask> SIMD_INLINE __m512i TextureFeatureDifference(const uint8_t * value, const uint8_t * lo, const uint8_t * hi,
+            size_t offset, const __m512i & weight, __mmask64 tail)
+        {
+            const __m512i _value = Load<align, mask>(value + offset, tail);
+            const __m512i _lo = Load<align, mask>(lo + offset, tail);
+            const __m512i _hi = Load<align, mask>(hi + offset, tail);
+            const __m512i featureDifference = _mm512_max_epu8(_mm512_subs_epu8(_value, _hi), _mm512_subs_epu8(_lo, _value));
+            const __m512i differenceLo = _mm512_unpacklo_epi8(featureDifference, K_ZERO);
+            const __m512i differenceHi = _mm512_unpackhi_epi8(featureDifference, K_ZERO);
+            return _mm512_packus_epi16(_mm512_mulhi_epu16(_mm512_mullo_epi16(differenceLo, differenceLo), weight),
+                _mm512_mulhi_epu16(_mm512_mullo_epi16(differenceHi, differenceHi), weight));
+        }
+
+        template <bool align, bool mask> SIMD_INLINE void TextureFeatureDifference(const uint8_t * gray, const uint8_t * grayLo, const uint8_t * grayHi, const __m512i & grayWeight,
+            const uint8_t * dx, const uint8_t * dxLo, const uint8_t * dxHi, const __m512i & dxWeight, const uint8_t * dy, const uint8_t * dyLo, const uint8_t * dyHi, const __m512i & dyWeight,
+            const uint8_t * roi, uint8_t * difference, size_t offset, __mmask64 tail = -1)
+        {
+            __m512i sum = TextureFeatureDifference<align, mask>(gray, grayLo, grayHi, offset, grayWeight, tail);
+            sum = _mm512_adds_epu8(sum, TextureFeatureDifference<align, mask>(dx, dxLo, dxHi, offset, dxWeight, tail));
+            sum = _mm512_adds_epu8(sum, TextureFeatureDifference<align, mask>(dy, dyLo, dyHi, offset, dyWeight, tail));
+            if (roi)
+                sum = _mm512_and_si512(sum, Load<align, mask>(roi + offset, tail));
+            Store<align, mask>(difference + offset, sum, tail);
+        }
+
+        template<bool align> void TextureFeatureDifference(const uint8_t * gray, size_t grayStride, size_t width, size_t height, uint8_t saturation, uint8_t boost,
+            const uint8_t * grayLo, size_t grayLoStride, const uint8_t * grayHi, size_t grayHiStride, uint16_t grayWeight,
+            uint8_t * dx, size_t dxStride, const uint8_t * dxLo, size_t dxLoStride, const uint8_t * dxHi, size_t dxHiStride, uint16_t dxWeight,
+            uint8_t * dy, size_t dyStride, const uint8_t * dyLo, size_t dyLoStride, const uint8_t * dyHi, size_t dyHiStride, uint16_t dyWeight,
+            const uint8_t * mask, size_t maskStride, uint8_t * difference, size_t differenceStride)
+        {
+            assert(width >= 3 && height >= 3 && int(2)*saturation*boost <= 0xFF);
+
+            size_t alignedWidth = AlignLo(width, A);
+            __mmask64 tailMask = TailMask64(width - alignedWidth);
+            __m512i _saturation = _mm512_set1_epi16(saturation);
+            __m512i _boost = _mm512_set1_epi16(boost);
+            __m512i _grayWeight = _mm512_set1_epi16((short)grayWeight);
+            __m512i _dxWeight = _mm512_set1_epi16((short)dxWeight);
+            __m512i _dyWeight = _mm512_set1_epi16((short)dyWeight);
+
+            for (size_t row = 0; row < height; ++row)
+            {
+                size_t col = 0;
+                if (row == 0 || row == height - 1)
+                {
+                    memset(dx, 0, width);
+                    memset(dy, 0, width);
+                }
+                else
+                {
+                    for (; col < alignedWidth; col += A)
+                        TextureBoostedSaturatedGradient<align, false>(gray + col, dx + col, dy + col, grayStride, _saturation, _boost);
+                    if (col < width)
+                        TextureBoostedSaturatedGradient<false, true>(gray + col, dx + col, dy + col, grayStride, _saturation, _boost, tailMask);
+
+                    dx[0] = 0;
+                    dy[0] = 0;
+                    dx[width - 1] = 0;
+                    dy[width - 1] = 0;
+                }
+
+                for (col = 0; col < alignedWidth; col += A)
+                    TextureFeatureDifference<align, false>(gray, grayLo, grayHi, _grayWeight, dx, dxLo, dxHi, _dxWeight, dy, dyLo, dyHi, _dyWeight, mask, difference, col);
+                if (col < width)
+                    TextureFeatureDifference<false, true>(gray, grayLo, grayHi, _grayWeight, dx, dxLo, dxHi, _dxWeight, dy, dyLo, dyHi, _dyWeight, mask, difference, col, tailMask);
+
+                gray += grayStride;
+                grayLo += grayLoStride;
+                grayHi += grayHiStride;
+                dx += dxStride;
+                dxLo += dxLoStride;
+                dxHi += dxHiStride;
+                dy += dyStride;
+                dyLo += dyLoStride;
+                dyHi += dyHiStride;
+                if (mask)
+                    mask += maskStride;
+                difference += differenceStride;
+            }
+        }
+
+        void TextureFeatureDifference(const uint8_t * gray, size_t grayStride, size_t width, size_t height, uint8_t saturation, uint8_t boost,
+            const uint8_t * grayLo, size_t grayLoStride, const uint8_t * grayHi, size_t grayHiStride, uint16_t grayWeight,
+            uint8_t * dx, size_t dxStride, const uint8_t * dxLo, size_t dxLoStride, const uint8_t * dxHi, size_t dxHiStride, uint16_t dxWeight,
+            uint8_t * dy, size_t dyStride, const uint8_t * dyLo, size_t dyLoStride, const uint8_t * dyHi, size_t dyHiStride, uint16_t dyWeight,
+            const uint8_t * mask, size_t maskStride, uint8_t * difference, size_t differenceStride)
+        {
+            if (Aligned(gray) && Aligned(grayStride) && Aligned(grayLo) && Aligned(grayLoStride) && Aligned(grayHi) && Aligned(grayHiStride) &&
+                Aligned(dx) && Aligned(dxStride) && Aligned(dxLo) && Aligned(dxLoStride) && Aligned(dxHi) && Aligned(dxHiStride) &&
+                Aligned(dy) && Aligned(dyStride) && Aligned(dyLo) && Aligned(dyLoStride) && Aligned(dyHi) && Aligned(dyHiStride) &&
+                Aligned(mask) && Aligned(maskStride) && Aligned(difference) && Aligned(differenceStride))
+                TextureFeatureDifference<true>(gray, grayStride, width, height, saturation, boost, grayLo, grayLoStride, grayHi, grayHiStride, grayWeight,
+                    dx, dxStride, dxLo, dxLoStride, dxHi, dxHiStride, dxWeight, dy, dyStride, dyLo, dyLoStride, dyHi, dyHiStride, dyWeight,
+                    mask, maskStride, difference, differenceStride);
+            else
+                TextureFeatureDifference<false>(gray, grayStride, width, height, saturation, boost, grayLo, grayLoStride, grayHi, grayHiStride, grayWeight,
+                    dx, dxStride, dxLo, dxLoStride, dxHi, dxHiStride, dxWeight, dy, dyStride, dyLo, dyLoStride, dyHi, dyHiStride, dyWeight,
+                    mask, maskStride, difference, differenceStride);
+        }
+
         SIMD_INLINE void TextureGetDifferenceSum(const __m512i & current, const __m512i & average, __m512i & positive, __m512i & negative)
         {
             positive = _mm512_add_epi64(positive, _mm512_sad_epu8(_mm512_subs_epu8(current, average), K_ZERO));
@@ -1865,7 +1865,7 @@ namespace Simd
                     a[1] = Load<align, mask>(p + 1 * step, tail);
                 }
 
-                template <bool align> void Execute(size_t M, size_t N, size_t K, const float * a, const float * b, float * c)
+                template <bool align> void Execute(size_t M, size_t N, size_t K, const float * a, const float * b, float * c, const NeuralConvolution * epilogue)
                 {
                     size_t M2 = Simd::AlignLo(M, 2);
                     size_t M4 = Simd::AlignLo(M, 4);
@@ -1924,6 +1924,8 @@ namespace Simd
                             pc[2 * N + j] += ExtractSum(sums[2]);
                             pc[3 * N + j] += ExtractSum(sums[3]);
                         }
+                        if (epilogue)
+                            epilogue->Epilogue(i, 4, c + i*N);
                     }
 #endif
                     for (; i < M2; i += 2)
@@ -1970,6 +1972,8 @@ namespace Simd
                             pc[0 * N + j] += ExtractSum(sums[0]);
                             pc[1 * N + j] += ExtractSum(sums[1]);
                         }
+                        if (epilogue)
+                            epilogue->Epilogue(i, 2, c + i*N);
                     }
                     for (; i < M; ++i)
                     {
@@ -2010,15 +2014,17 @@ namespace Simd
                             }
                             pc[j] += ExtractSum(sum);
                         }
+                        if (epilogue)
+                            epilogue->Epilogue(i, 1, c + i*N);
                     }
                 }
 
-                void Execute(size_t M, size_t N, size_t K, const float * a, const float * b, float * c)
+                void Execute(size_t M, size_t N, size_t K, const float * a, const float * b, float * c, const NeuralConvolution * epilogue = NULL)
                 {
                     if (Aligned(K, F))
-                        Execute<true>(M, N, K, a, b, c);
+                        Execute<true>(M, N, K, a, b, c, epilogue);
                     else
-                        Execute<false>(M, N, K, a, b, c);
+                        Execute<false>(M, N, K, a, b, c, epilogue);
                 }
             }
 
@@ -2295,7 +2301,7 @@ namespace Simd
                     AddSums16<mask>(sums, 4, c, N, tail);
                 }
 
-                template <bool align> void Execute4x16(size_t M, size_t N, size_t K, const float * a, const float * b, float * c)
+                template <bool align> void Execute4x16(size_t M, size_t N, size_t K, const float * a, const float * b, float * c, const NeuralConvolution * epilogue)
                 {
                     size_t M4 = Simd::AlignLo(M, 4);
                     size_t N16 = Simd::AlignLo(N, 16);
@@ -2308,6 +2314,8 @@ namespace Simd
                             Kernel4x16<align, false>(N, K, a + i*K, b + j*K, c + i*N + j);
                         if (j < N)
                             Kernel4x16<align, true>(N, K, a + i*K, b + j*K, c + i*N + j, tailMask);
+                        if (epilogue)
+                            epilogue->Epilogue(i, 4, c + i*N);
                     }
                     if (i < M)
                     {
@@ -2316,6 +2324,8 @@ namespace Simd
                             KernelMx16<align, false>(N, K, a + i*K, b + j*K, c + i*N + j, M - M4);
                         if (j < N)
                             KernelMx16<align, true>(N, K, a + i*K, b + j*K, c + i*N + j, M - M4, tailMask);
+                        if (epilogue)
+                            epilogue->Epilogue(i, M - M4, c + i*N);
                     }
                 }
 
@@ -2374,7 +2384,7 @@ namespace Simd
                     AddSums32<mask>(sums, 4, c, N, tails);
                 }
 
-                template <bool align> void Execute4x32(size_t M, size_t N, size_t K, const float * a, const float * b, float * c)
+                template <bool align> void Execute4x32(size_t M, size_t N, size_t K, const float * a, const float * b, float * c, const NeuralConvolution * epilogue)
                 {
                     size_t M4 = Simd::AlignLo(M, 4);
                     size_t N32 = Simd::AlignLo(N, 32);
@@ -2389,6 +2399,8 @@ namespace Simd
                             Kernel4x32<align, false>(N, K, a + i*K, b + j*K, c + i*N + j, tailMasks);
                         if (j < N)
                             Kernel4x32<align, true>(N, K, a + i*K, b + j*K, c + i*N + j, tailMasks);
+                        if (epilogue)
+                            epilogue->Epilogue(i, 4, c + i*N);
                     }
                     if (i < M)
                     {
@@ -2397,17 +2409,19 @@ namespace Simd
                             KernelMx32<align, false>(N, K, a + i*K, b + j*K, c + i*N + j, M - M4, tailMasks);
                         if (j < N)
                             KernelMx32<align, true>(N, K, a + i*K, b + j*K, c + i*N + j, M - M4, tailMasks);
+                        if (epilogue)
+                            epilogue->Epilogue(i, M - M4, c + i*N);
                     }
                 }
 
-                void Execute(size_t M, size_t N, size_t K, const float * a, const float * b, float * c, size_t cellA, size_t cellB)
+                void Execute(size_t M, size_t N, size_t K, const float * a, const float * b, float * c, size_t cellA, size_t cellB, const NeuralConvolution * epilogue = NULL)
                 {
                     if (cellA == 4)
                     {
                         if (cellB == 16)
-                            Execute4x16<false>(M, N, K, a, b, c);
+                            Execute4x16<false>(M, N, K, a, b, c, epilogue);
                         if (cellB == 32)
-                            Execute4x32<false>(M, N, K, a, b, c);
+                            Execute4x32<false>(M, N, K, a, b, c, epilogue);
                     }
                 }
             }
@@ -2437,7 +2451,7 @@ namespace Simd
                 }
 
                 template <bool align, size_t kernelX, size_t kernelY> void AddConvolution8x8(const float * src, size_t srcWidth, size_t srcHeight, size_t srcDepth,
-                    const float * weight, float * dst, size_t dstDepth)
+                    const float * weight, float * dst, size_t dstDepth, const NeuralConvolution * epilogue)
                 {
                     __m256 _weight[kernelX*kernelY];
                     for (size_t dstChannel = 0; dstChannel < dstDepth; ++dstChannel)
@@ -2480,11 +2494,13 @@ namespace Simd
                         }
                         for (size_t row = 0; row < 8; ++row, dst += 8)
                             Avx::Store<align>(dst, _dst[row]);
+                        if (epilogue)
+                            epilogue->Epilogue(dstChannel, 1, dst - 64);
                     }
                 }
 
                 template <bool align, size_t kernelX, size_t kernelY> void AddConvolution16x16(const float * src, size_t srcWidth, size_t srcHeight, size_t srcDepth,
-                    const float * weight, float * dst, size_t dstDepth)
+                    const float * weight, float * dst, size_t dstDepth, const NeuralConvolution * epilogue)
                 {
                     __m512 _weight[kernelX*kernelY];
                     for (size_t dstChannel = 0; dstChannel < dstDepth; ++dstChannel)
@@ -2527,20 +2543,22 @@ namespace Simd
                         }
                         for (size_t row = 0; row < 16; ++row, dst += 16)
                             Store<align>(dst, _dst[row]);
+                        if (epilogue)
+                            epilogue->Epilogue(dstChannel, 1, dst - 256);
                     }
                 }
 
                 template <bool align, size_t kernelX, size_t kernelY> void AddConvolution(const float * src, size_t srcWidth, size_t srcHeight, size_t srcDepth,
-                    const float * weight, float * dst, size_t dstWidth, size_t dstHeight, size_t dstDepth)
+                    const float * weight, float * dst, size_t dstWidth, size_t dstHeight, size_t dstDepth, const NeuralConvolution * epilogue)
                 {
                     if (dstWidth == 8 && dstHeight == 8)
                     {
-                        AddConvolution8x8<align, kernelX, kernelY>(src, srcWidth, srcHeight, srcDepth, weight, dst, dstDepth);
+                        AddConvolution8x8<align, kernelX, kernelY>(src, srcWidth, srcHeight, srcDepth, weight, dst, dstDepth, epilogue);
                         return;
                     }
                     if (dstWidth == 16 && dstHeight == 16)
                     {
-                        AddConvolution16x16<align, kernelX, kernelY>(src, srcWidth, srcHeight, srcDepth, weight, dst, dstDepth);
+                        AddConvolution16x16<align, kernelX, kernelY>(src, srcWidth, srcHeight, srcDepth, weight, dst, dstDepth, epilogue);
                         return;
                     }
                     size_t alignedWidth = AlignLo(dstWidth, F);
@@ -2573,21 +2591,23 @@ namespace Simd
                                 pdst += dstWidth;
                             }
                         }
+                        if (epilogue)
+                            epilogue->Epilogue(dstChannel, 1, dst + dstWidth*dstHeight*dstChannel);
                     }
                 }
 
                 void Execute(const float * src, size_t srcWidth, size_t srcHeight, size_t srcDepth,
-                    const float * weight, size_t kernelX, size_t kernelY, float * dst, size_t dstWidth, size_t dstHeight, size_t dstDepth)
+                    const float * weight, size_t kernelX, size_t kernelY, float * dst, size_t dstWidth, size_t dstHeight, size_t dstDepth, const NeuralConvolution * epilogue = NULL)
                 {
                     assert(kernelX == kernelY);
                     if (kernelX == 2)
-                        AddConvolution<false, 2, 2>(src, srcWidth, srcHeight, srcDepth, weight, dst, dstWidth, dstHeight, dstDepth);
+                        AddConvolution<false, 2, 2>(src, srcWidth, srcHeight, srcDepth, weight, dst, dstWidth, dstHeight, dstDepth, epilogue);
                     else if (kernelX == 3)
-                        AddConvolution<false, 3, 3>(src, srcWidth, srcHeight, srcDepth, weight, dst, dstWidth, dstHeight, dstDepth);
+                        AddConvolution<false, 3, 3>(src, srcWidth, srcHeight, srcDepth, weight, dst, dstWidth, dstHeight, dstDepth, epilogue);
                     else if (kernelX == 4)
-                        AddConvolution<false, 4, 4>(src, srcWidth, srcHeight, srcDepth, weight, dst, dstWidth, dstHeight, dstDepth);
+                        AddConvolution<false, 4, 4>(src, srcWidth, srcHeight, srcDepth, weight, dst, dstWidth, dstHeight, dstDepth, epilogue);
                     else if (kernelX == 5)
-                        AddConvolution<false, 5, 5>(src, srcWidth, srcHeight, srcDepth, weight, dst, dstWidth, dstHeight, dstDepth);
+                        AddConvolution<false, 5, 5>(src, srcWidth, srcHeight, srcDepth, weight, dst, dstWidth, dstHeight, dstDepth, epilogue);
                     else
                         assert(0);
                 }
@@ -2603,6 +2623,139 @@ namespace Simd
                 }
             }
 
+            namespace Ver3
+            {
+                void PrepareA(const float * src, size_t M, size_t K, size_t cell, float * dst)
+                {
+                    size_t size = M*K;
+                    float * filter = (float*)Allocate(16 * size * sizeof(float));
+                    Base::Winograd2x3SetFilter(src, size, filter);
+                    for (size_t i = 0; i < 16; ++i)
+                        Ver1::PrepareA(filter + i*size, M, K, cell, dst + i*size);
+                    Free(filter);
+                }
+
+                SIMD_INLINE void InputTransform(const float * even, const float * odd, size_t stride, float * dst, size_t size)
+                {
+                    __m512 t[4][4];
+                    for (size_t r = 0; r < 4; ++r, even += stride, odd += stride)
+                    {
+                        __m512 d0 = Load<false>(even + 0);
+                        __m512 d1 = Load<false>(odd + 0);
+                        __m512 d2 = Load<false>(even + 1);
+                        __m512 d3 = Load<false>(odd + 1);
+                        t[r][0] = _mm512_sub_ps(d0, d2);
+                        t[r][1] = _mm512_add_ps(d1, d2);
+                        t[r][2] = _mm512_sub_ps(d2, d1);
+                        t[r][3] = _mm512_sub_ps(d1, d3);
+                    }
+                    for (size_t c = 0; c < 4; ++c)
+                    {
+                        Store<false>(dst + (0 + c)*size, _mm512_sub_ps(t[0][c], t[2][c]));
+                        Store<false>(dst + (4 + c)*size, _mm512_add_ps(t[1][c], t[2][c]));
+                        Store<false>(dst + (8 + c)*size, _mm512_sub_ps(t[2][c], t[1][c]));
+                        Store<false>(dst + (12 + c)*size, _mm512_sub_ps(t[1][c], t[3][c]));
+                    }
+                }
+
+                void PrepareB(const float * src, size_t srcWidth, size_t srcHeight, size_t srcDepth, size_t padX, size_t padY, 
+                    size_t tileX, size_t tileY, size_t cell, float * tmp, float * dst)
+                {
+                    size_t N = tileX*tileY, width = AlignHi(tileX, F) + 1, height = tileY * 2 + 2, size = srcDepth*N + F;
+                    float * even = tmp + 16 * size, * odd = even + width*height;
+                    for (size_t c = 0; c < srcDepth; ++c, src += srcWidth*srcHeight)
+                    {
+                        Base::Winograd2x3SplitInput(src, srcWidth, srcHeight, padX, padY, width, height, even, odd);
+                        for (size_t y = 0; y < tileY; ++y)
+                        {
+                            const float * pe = even + 2 * y*width, * po = odd + 2 * y*width;
+                            float * pd = tmp + c*N + y*tileX;
+                            for (size_t x = 0; x < tileX; x += F)
+                                InputTransform(pe + x, po + x, width, pd + x, size);
+                        }
+                    }
+                    for (size_t i = 0; i < 16; ++i)
+                        Ver1::PrepareB(tmp + i*size, N, 1, srcDepth, 1, 1, 0, 0, 1, 1, 1, 1, N, 1, cell, NULL, dst + i*AlignHi(N, cell)*srcDepth);
+                }
+
+                __m512i K32_INTERLEAVE_0 = SIMD_MM512_SETR_EPI32(0, 16, 1, 17, 2, 18, 3, 19, 4, 20, 5, 21, 6, 22, 7, 23);
+                __m512i K32_INTERLEAVE_1 = SIMD_MM512_SETR_EPI32(8, 24, 9, 25, 10, 26, 11, 27, 12, 28, 13, 29, 14, 30, 15, 31);
+
+                SIMD_INLINE void OutputTransform(const float * src, size_t stride, __m512 * dst)
+                {
+                    __m512 m[16];
+                    for (size_t i = 0; i < 16; ++i)
+                        m[i] = Load<false>(src + i*stride);
+                    __m512 t[2][4];
+                    for (size_t c = 0; c < 4; ++c)
+                    {
+                        t[0][c] = _mm512_add_ps(_mm512_add_ps(m[c], m[4 + c]), m[8 + c]);
+                        t[1][c] = _mm512_sub_ps(_mm512_sub_ps(m[4 + c], m[8 + c]), m[12 + c]);
+                    }
+                    for (size_t r = 0; r < 2; ++r)
+                    {
+                        __m512 y0 = _mm512_add_ps(_mm512_add_ps(t[r][0], t[r][1]), t[r][2]);
+                        __m512 y1 = _mm512_sub_ps(_mm512_sub_ps(t[r][1], t[r][2]), t[r][3]);
+                        dst[2 * r + 0] = _mm512_permutex2var_ps(y0, K32_INTERLEAVE_0, y1);
+                        dst[2 * r + 1] = _mm512_permutex2var_ps(y0, K32_INTERLEAVE_1, y1);
+                    }
+                }
+
+                void Execute(size_t M, size_t N, size_t K, const float * a, size_t strideA, const float * b, float * t, 
+                    float * dst, size_t dstWidth, size_t dstHeight, size_t cellA, size_t cellB, const NeuralConvolution * epilogue = NULL)
+                {
+                    size_t strideB = AlignHi(N, cellB)*K, strideT = M*N;
+                    memset(t, 0, 16 * strideT * sizeof(float));
+                    for (size_t i = 0; i < 16; ++i)
+                        Ver1::Execute(M, N, K, a + i*strideA, b + i*strideB, t + i*strideT, cellA, cellB);
+
+                    size_t tileX = (dstWidth + 1) / 2, tileY = (dstHeight + 1) / 2, fullX = AlignLo(dstWidth / 2, F);
+                    for (size_t m = 0; m < M; ++m, t += N, dst += dstWidth*dstHeight)
+                    {
+                        for (size_t y = 0; y < tileY; ++y)
+                        {
+                            const float * ps = t + y*tileX;
+                            float * pd = dst + 2 * y*dstWidth;
+                            size_t rows = Simd::Min<size_t>(2, dstHeight - 2 * y), x = 0;
+                            __m512 out[4];
+                            if (rows == 2)
+                            {
+                                for (; x < fullX; x += F)
+                                {
+                                    OutputTransform(ps + x, strideT, out);
+                                    float * pd0 = pd + 2 * x, * pd1 = pd0 + dstWidth;
+                                    Store<false>(pd0 + 0, _mm512_add_ps(Load<false>(pd0 + 0), out[0]));
+                                    Store<false>(pd0 + F, _mm512_add_ps(Load<false>(pd0 + F), out[1]));
+                                    Store<false>(pd1 + 0, _mm512_add_ps(Load<false>(pd1 + 0), out[2]));
+                                    Store<false>(pd1 + F, _mm512_add_ps(Load<false>(pd1 + F), out[3]));
+                                }
+                            }
+                            for (; x < tileX; x += F)
+                            {
+                                OutputTransform(ps + x, strideT, out);
+                                size_t cols = Simd::Min<size_t>(2 * F, dstWidth - 2 * x);
+                                const float * po = (float*)out;
+                                for (size_t r = 0; r < rows; ++r, po += 2 * F)
+                                    for (size_t c = 0; c < cols; ++c)
+                                        pd[r*dstWidth + 2 * x + c] += po[c];
+                            }
+                        }
+                        if (epilogue)
+                            epilogue->Epilogue(m, 1, dst);
+                    }
+                }
+
+                bool Preferable(size_t srcDepth, size_t kernelX, size_t kernelY, size_t strideX, size_t strideY, size_t dilationX, size_t dilationY, size_t dstWidth, size_t dstHeight, size_t dstDepth)
+                {
+                    if (kernelX == 3 && kernelY == 3 && strideX*strideY*dilationX*dilationY == 1)
+                    {
+                        if (srcDepth >= 32 && dstDepth >= 32 && dstWidth*dstHeight >= 12 * 12)
+                            return true;
+                    }
+                    return false;
+                }
+            }
+
             struct Opt
             {
                 enum Alg
@@ -2611,6 +2764,7 @@ namespace Simd
                     Ver0,
                     Ver1,
                     Ver2,
+                    Ver3,
                 } alg;
 
                 size_t sizeA;
@@ -2624,6 +2778,8 @@ namespace Simd
                 size_t strideB;
                 size_t paddedW;
                 size_t paddedH;
+                size_t tileX;
+                size_t tileY;
 
                 Opt(size_t srcWidth, size_t srcHeight, size_t srcDepth, size_t kernelX, size_t kernelY, size_t padX, size_t padY, size_t strideX, size_t strideY, size_t dilationX, size_t dilationY, size_t dstWidth, size_t dstHeight, size_t dstDepth)
                 {
@@ -2644,6 +2800,8 @@ namespace Simd
                         alg = Ver1;
                     if (Ver2::Preferable(srcDepth, kernelX, kernelY, strideX, strideY, dilationX, dilationY, dstWidth, dstHeight, dstDepth))
                         alg = Ver2;
+                    if (Ver3::Preferable(srcDepth, kernelX, kernelY, strideX, strideY, dilationX, dilationY, dstWidth, dstHeight, dstDepth))
+                        alg = Ver3;
 
                     switch (alg)
                     {
@@ -2672,6 +2830,20 @@ namespace Simd
                             paddedH = srcHeight;
                         }
                         break;
+                    case Ver3:
+                        cellA = 4;
+                        cellB = 32;
+                        tileX = (dstWidth + 1) / 2;
+                        tileY = (dstHeight + 1) / 2;
+                        N = tileX*tileY;
+                        K = srcDepth;
+                        sizeA = 16 * M*K;
+                        strideB = Simd::AlignHi(N, cellB);
+                        sizeB = 16 * strideB*K;
+                        paddedW = Simd::AlignHi(tileX, F) + 1;
+                        paddedH = tileY * 2 + 2;
+                        sizeT = Simd::Max(16 * (K*N + F) + 2 * paddedW*paddedH, 16 * M*N + F);
+                        break;
                     default:
                         assert(0);
                         break;
@@ -2725,6 +2897,144 @@ namespace Simd
             private:
                 void * _data;
             };
+
+            void PrepareB(const Opt & opt, const float * src, size_t srcWidth, size_t srcHeight, size_t srcDepth, size_t kernelX, size_t kernelY,
+                size_t padX, size_t padY, size_t strideX, size_t strideY, size_t dilationX, size_t dilationY, Data & data, size_t dstWidth, size_t dstHeight)
+            {
+                if (opt.sizeB)
+                {
+                    switch (opt.alg)
+                    {
+                    case Opt::Ver0: Ver0::PrepareB(src, srcWidth, srcHeight, srcDepth, kernelX, kernelY, padX, padY, strideX, strideY, dilationX, dilationY, dstWidth, dstHeight, data.b); break;
+                    case Opt::Ver1: Ver1::PrepareB(src, srcWidth, srcHeight, srcDepth, kernelX, kernelY, padX, padY, strideX, strideY, dilationX, dilationY, dstWidth, dstHeight, opt.cellB, data.t, data.b); break;
+                    case Opt::Ver2: Ver2::PrepareB(src, srcWidth, srcHeight, srcDepth, padX, padY, data.b, opt.paddedW, opt.paddedH); break;
+                    case Opt::Ver3: Ver3::PrepareB(src, srcWidth, srcHeight, srcDepth, padX, padY, opt.tileX, opt.tileY, opt.cellB, data.t, data.b); break;
+                    default: break;
+                    }
+                }
+                else
+                    data.b = (float*)src;
+            }
+
+            void Execute(const Opt & opt, size_t srcDepth, const float * weight, size_t kernelX, size_t kernelY, const Data & data, 
+                float * dst, size_t dstWidth, size_t dstHeight, size_t dstDepth, const NeuralConvolution * epilogue = NULL)
+            {
+                switch (opt.alg)
+                {
+                case Opt::Ver0: Ver0::Execute(dstDepth, opt.N, opt.K, weight, data.b, dst, epilogue); break;
+                case Opt::Ver1: Ver1::Execute(dstDepth, opt.N, opt.K, weight, data.b, dst, opt.cellA, opt.cellB, epilogue); break;
+                case Opt::Ver2: Ver2::Execute(data.b, opt.paddedW, opt.paddedH, srcDepth, weight, kernelX, kernelY, dst, dstWidth, dstHeight, dstDepth, epilogue); break;
+                case Opt::Ver3: Ver3::Execute(dstDepth, opt.N, opt.K, weight, opt.M*opt.K, data.b, data.t, dst, dstWidth, dstHeight, opt.cellA, opt.cellB, epilogue); break;
+                default: break;
+                }
+            }
+
+            void Forward(const Opt & opt, const float * src, size_t srcWidth, size_t srcHeight, size_t srcDepth, const float * weight, size_t kernelX, size_t kernelY,
+                size_t padX, size_t padY, size_t strideX, size_t strideY, size_t dilationX, size_t dilationY, Data & data, float * dst, size_t dstWidth, size_t dstHeight, size_t dstDepth)
+            {
+                PrepareB(opt, src, srcWidth, srcHeight, srcDepth, kernelX, kernelY, padX, padY, strideX, strideY, dilationX, dilationY, data, dstWidth, dstHeight);
+                Execute(opt, srcDepth, weight, kernelX, kernelY, data, dst, dstWidth, dstHeight, dstDepth);
+            }
+
+            template <SimdNeuralActivationType type> SIMD_INLINE __m512 Activate(__m512 value, const __m512 * params);
+
+            template <> SIMD_INLINE __m512 Activate<SimdNeuralActivationIdentity>(__m512 value, const __m512 * params)
+            {
+                return value;
+            }
+
+            template <> SIMD_INLINE __m512 Activate<SimdNeuralActivationTanh>(__m512 value, const __m512 * params)
+            {
+                __m512 x = AndNot(params[4], _mm512_mul_ps(value, params[0]));
+                __m512 x2 = _mm512_mul_ps(x, x);
+                __m512 x4 = _mm512_mul_ps(x2, x2);
+                __m512 pe = _mm512_add_ps(_mm512_fmadd_ps(x2, params[5], params[2]), _mm512_fmadd_ps(x4, params[6], x));
+                __m512 ne = Rcp14(pe);
+                __m512 absTanh = _mm512_mul_ps(_mm512_sub_ps(pe, ne), Rcp14(_mm512_add_ps(pe, ne)));
+                return Xor(absTanh, AndMaskZ(params[4], params[4], _mm512_cmp_ps_mask(params[4], value, _CMP_GT_OS)));
+            }
+
+            template <> SIMD_INLINE __m512 Activate<SimdNeuralActivationSigmoid>(__m512 value, const __m512 * params)
+            {
+                __m512 e1 = _mm512_max_ps(params[3], _mm512_fmadd_ps(value, params[1], params[2]));
+                __m512 e2 = _mm512_mul_ps(e1, e1);
+                __m512 e4 = _mm512_mul_ps(e2, e2);
+                __m512 e8 = _mm512_mul_ps(e4, e4);
+                __m512 e16 = _mm512_mul_ps(e8, e8);
+                __m512 e32 = _mm512_mul_ps(e16, e16);
+                __m512 e64 = _mm512_mul_ps(e32, e32);
+                return Rcp14(_mm512_fmadd_ps(e64, e64, params[2]));
+            }
+
+            template <> SIMD_INLINE __m512 Activate<SimdNeuralActivationRelu>(__m512 value, const __m512 * params)
+            {
+                return _mm512_max_ps(_mm512_mul_ps(params[0], value), value);
+            }
+
+            struct Convolution : public NeuralConvolution
+            {
+                Convolution(size_t srcWidth, size_t srcHeight, size_t srcDepth, const float * weight, size_t kernelX, size_t kernelY, size_t padX, size_t padY,
+                    size_t strideX, size_t strideY, size_t dilationX, size_t dilationY, size_t dstWidth, size_t dstHeight, size_t dstDepth,
+                    const float * bias, SimdNeuralActivationType activation, const float * slope)
+                    : NeuralConvolution(srcWidth, srcHeight, srcDepth, kernelX, kernelY, padX, padY, strideX, strideY, dilationX, dilationY, dstWidth, dstHeight, dstDepth,
+                        bias, activation, slope)
+                    , _opt(srcWidth, srcHeight, srcDepth, kernelX, kernelY, padX, padY, strideX, strideY, dilationX, dilationY, dstWidth, dstHeight, dstDepth)
+                {
+                    size_t size = _opt.sizeA ? _opt.sizeA : _opt.M*_opt.K;
+                    this->weight = (float*)Allocate(AlignHi(size, F) * sizeof(float));
+                    if (_opt.alg == Opt::Ver1)
+                        Ver1::PrepareA(weight, _opt.M, _opt.K, _opt.cellA, this->weight);
+                    else if (_opt.alg == Opt::Ver3)
+                        Ver3::PrepareA(weight, _opt.M, _opt.K, _opt.cellA, this->weight);
+                    else
+                        memcpy(this->weight, weight, size * sizeof(float));
+                }
+
+                virtual void Run(const float * src, void * buffer, size_t * size, float * dst, int add) const
+                {
+                    if (!add)
+                        memset(dst, 0, dstWidth*dstHeight*dstDepth * sizeof(float));
+
+                    Data data(0, _opt.sizeB, _opt.sizeT, buffer, size);
+
+                    PrepareB(_opt, src, srcWidth, srcHeight, srcDepth, kernelX, kernelY, padX, padY, strideX, strideY, dilationX, dilationY, data, dstWidth, dstHeight);
+                    Execute(_opt, srcDepth, weight, kernelX, kernelY, data, dst, dstWidth, dstHeight, dstDepth, HasEpilogue() ? this : NULL);
+                }
+
+            private:
+                template <SimdNeuralActivationType type> void Epilogue(size_t channel, size_t count, float * dst) const
+                {
+                    size_t size = dstWidth*dstHeight, aligned = AlignLo(size, F);
+                    __m512 params[7] = { _mm512_set1_ps(slope), _mm512_set1_ps(-slope*0.0078125f), _mm512_set1_ps(1.0f), _mm512_set1_ps(0.5f), _mm512_set1_ps(-0.0f), _mm512_set1_ps(0.5658f), _mm512_set1_ps(0.1430f) };
+                    for (size_t c = channel; c < channel + count; ++c)
+                    {
+                        __m512 _bias = _mm512_set1_ps(bias ? bias[c] : 0.0f);
+                        size_t i = 0;
+                        for (; i < aligned; i += F)
+                            Store<false>(dst + i, Ncf::Activate<type>(_mm512_add_ps(Load<false>(dst + i), _bias), params));
+                        if (i < size)
+                        {
+                            __mmask16 tail = __mmask16(-1) >> (F + i - size);
+                            Store<false, true>(dst + i, Ncf::Activate<type>(_mm512_add_ps(Load<false, true>(dst + i, tail), _bias), params), tail);
+                        }
+                        dst += size;
+                    }
+                }
+
+                virtual void Epilogue(size_t channel, size_t count, float * dst) const
+                {
+                    switch (activation)
+                    {
+                    case SimdNeuralActivationIdentity: Epilogue<SimdNeuralActivationIdentity>(channel, count, dst); break;
+                    case SimdNeuralActivationTanh: Epilogue<SimdNeuralActivationTanh>(channel, count, dst); break;
+                    case SimdNeuralActivationSigmoid: Epilogue<SimdNeuralActivationSigmoid>(channel, count, dst); break;
+                    case SimdNeuralActivationRelu: Epilogue<SimdNeuralActivationRelu>(channel, count, dst); break;
+                    default: assert(0);
+                    }
+                }
+
+                Opt _opt;
+            };
         }
 
         void NeuralConvolutionForward(const float * src, size_t srcWidth, size_t srcHeight, size_t srcDepth,
@@ -2747,7 +3057,8 @@ namespace Simd
             {
                 switch (opt.alg)
                 {
-                case Opt::Ver1: Ver1::PrepareA(weight, opt.M, opt.K, opt.cellA, data.a);
+                case Opt::Ver1: Ver1::PrepareA(weight, opt.M, opt.K, opt.cellA, data.a); break;
+                case Opt::Ver3: Ver3::PrepareA(weight, opt.M, opt.K, opt.cellA, data.a); break;
                 default:
                     break;
                 }
@@ -2755,26 +3066,16 @@ namespace Simd
             else
                 data.a = (float*)weight;
 
-            if (opt.sizeB)
-            {
-                switch (opt.alg)
-                {
-                case Opt::Ver0: Ver0::PrepareB(src, srcWidth, srcHeight, srcDepth, kernelX, kernelY, padX, padY, strideX, strideY, dilationX, dilationY, dstWidth, dstHeight, data.b); break;
-                case Opt::Ver1: Ver1::PrepareB(src, srcWidth, srcHeight, srcDepth, kernelX, kernelY, padX, padY, strideX, strideY, dilationX, dilationY, dstWidth, dstHeight, opt.cellB, data.t, data.b); break;
-                case Opt::Ver2: Ver2::PrepareB(src, srcWidth, srcHeight, srcDepth, padX, padY, data.b, opt.paddedW, opt.paddedH); break;
-                default: break;
-                }
-            }
-            else
-                data.b = (float*)src;
+            Forward(opt, src, srcWidth, srcHeight, srcDepth, data.a, kernelX, kernelY, padX, padY, strideX, strideY, dilationX, dilationY,
+                data, dst, dstWidth, dstHeight, dstDepth);
+        }
 
-            switch (opt.alg)
-            {
-            case Opt::Ver0: Ver0::Execute(opt.M, opt.N, opt.K, data.a, data.b, dst); break;
-            case Opt::Ver1: Ver1::Execute(opt.M, opt.N, opt.K, data.a, data.b, dst, opt.cellA, opt.cellB); break;
-            case Opt::Ver2: Ver2::Execute(data.b, opt.paddedW, opt.paddedH, srcDepth, weight, kernelX, kernelY, dst, dstWidth, dstHeight, dstDepth); break;
-            default: break;
-            }
+        void * NeuralConvolutionInit(size_t srcWidth, size_t srcHeight, size_t srcDepth, const float * weight, size_t kernelX, size_t kernelY,
+            size_t padX, size_t padY, size_t strideX, size_t strideY, size_t dilationX, size_t dilationY, size_t dstWidth, size_t dstHeight, size_t dstDepth,
+            const float * bias, SimdNeuralActivationType activation, const float * slope)
+        {
+            return new Ncf::Convolution(srcWidth, srcHeight, srcDepth, weight, kernelX, kernelY, padX, padY, strideX, strideY, dilationX, dilationY, dstWidth, dstHeight, dstDepth,
+                bias, activation, slope);
         }
     }
 #endif// SIMD_AVX512F_ENABLE
@@ -23,12 +23,14 @@
 */
 #include "Simd/SimdMemory.h"
 #include "Simd/SimdDetection.h"
+#include "Simd/SimdBase.h"
 #include "Simd/SimdBase_tinyxml2.h"
 
 #include <exception>
 #include <stdexcept>
 #include <iostream>
 #include <sstream>
+#include <fstream>
 
 #define SIMD_EX(message) \
 { \
@@ -147,10 +149,247 @@ namespace Simd
             const char * rect = "rect";
         }
 
+        namespace Binary
+        {
+            const uint32_t MAGIC = 0x43444D53;
+            const uint32_t VERSION = 2;
+
+            enum Array
+            {
+                Stages,
+                Classifiers,
+                Nodes,
+                Leaves,
+                Subsets,
+                HaarFeatures,
+                LbpFeatures,
+                ArrayCount
+            };
+
+            struct Header
+            {
+                uint32_t magic;
+                uint32_t version;
+                int32_t stageType;
+                int32_t featureType;
+                int32_t ncategories;
+                int32_t width;
+                int32_t height;
+                uint32_t isStumpBased;
+                uint32_t hasTilted;
+                uint32_t canInt16;
+                uint32_t checksum;
+                uint32_t count[ArrayCount];
+                uint32_t size[ArrayCount];
+            };
+
+            template<class T> SIMD_INLINE void SetArray(Header & header, Array array, const std::vector<T> & vector)
+            {
+                header.count[array] = (uint32_t)vector.size();
+                header.size[array] = (uint32_t)sizeof(T);
+            }
+
+            template<class T> SIMD_INLINE void Write(std::vector<uint8_t> & buffer, const std::vector<T> & vector)
+            {
+                const uint8_t * data = (const uint8_t*)vector.data();
+                buffer.insert(buffer.end(), data, data + vector.size() * sizeof(T));
+            }
+
+            template<class T> SIMD_INLINE const uint8_t * Read(const Header & header, Array array, const uint8_t * src, const uint8_t * end, std::vector<T> & vector)
+            {
+                if (header.size[array] != sizeof(T) || header.count[array] > size_t(end - src) / sizeof(T))
+                    SIMD_EX("Invalid binary cascade array!");
+                size_t size = header.count[array] * sizeof(T);
+                vector.resize(header.count[array]);
+                if (size)
+                    memcpy(vector.data(), src, size);
+                return src + size;
+            }
+
+            SIMD_INLINE bool InWindow(const Data::Rect & r, ptrdiff_t left, ptrdiff_t top, ptrdiff_t right, ptrdiff_t bottom, const Size & window)
+            {
+                return r.width >= 0 && r.height >= 0 && left >= 0 && top >= 0 && right <= window.x && bottom <= window.y;
+            }
+
+            void Validate(const Data & data)
+            {
+                if (data.stageType != 0 || data.origWinSize.x <= 0 || data.origWinSize.y <= 0 || data.ncategories < 0 || data.ncategories > 256)
+                    SIMD_EX("Invalid binary cascade parameters!");
+                size_t featureCount;
+                if (data.featureType == SimdDetectionInfoFeatureHaar)
+                {
+                    featureCount = data.haarFeatures.size();
+                    for (size_t i = 0; i < featureCount; ++i)
+                    {
+                        const Data::HaarFeature & feature = data.haarFeatures[i];
+                        for (size_t j = 0; j < Data::HaarFeature::RECT_NUM; ++j)
+                        {
+                            const Data::Rect & r = feature.rect[j].r;
+                            bool valid = feature.tilted ?
+                                InWindow(r, (ptrdiff_t)r.x - r.height, r.y, (ptrdiff_t)r.x + r.width, (ptrdiff_t)r.y + r.width + r.height, data.origWinSize) :
+                                InWindow(r, r.x, r.y, (ptrdiff_t)r.x + r.width, (ptrdiff_t)r.y + r.height, data.origWinSize);
+                            if (!valid)
+                                SIMD_EX("Invalid binary cascade HAAR feature " << i << "!");
+                        }
+                    }
+                }
+                else if (data.featureType == SimdDetectionInfoFeatureLbp)
+                {
+                    featureCount = data.lbpFeatures.size();
+                    for (size_t i = 0; i < featureCount; ++i)
+                    {
+                        const Data::Rect & r = data.lbpFeatures[i].rect;
+                        if (!InWindow(r, r.x, r.y, (ptrdiff_t)r.x + 3 * r.width, (ptrdiff_t)r.y + 3 * r.height, data.origWinSize))
+                            SIMD_EX("Invalid binary cascade LBP feature " << i << "!");
+                    }
+                }
+                else
+                    SIMD_EX("Invalid binary cascade feature type!");
+
+                for (size_t i = 0; i < data.stages.size(); ++i)
+                {
+                    const Data::Stage & stage = data.stages[i];
+                    if (stage.first < 0 || stage.ntrees < 0 || size_t(stage.first) + size_t(stage.ntrees) > data.classifiers.size())
+                        SIMD_EX("Invalid binary cascade stage " << i << "!");
+                }
+
+                size_t nodeCount = 0, leafCount = 0;
+                for (size_t i = 0; i < data.classifiers.size(); ++i)
+                {
+                    int count = data.classifiers[i].nodeCount;
+                    if (count < 1 || (data.isStumpBased && count != 1) || size_t(count) > data.nodes.size() - nodeCount)
+                        SIMD_EX("Invalid binary cascade classifier " << i << "!");
+                    for (int j = 0; j < count; ++j)
+                    {
+                        const Data::DTreeNode & node = data.nodes[nodeCount + j];
+                        if (node.featureIdx < 0 || size_t(node.featureIdx) >= featureCount ||
+                            node.left >= count || node.left < -count || node.right >= count || node.right < -count)
+                            SIMD_EX("Invalid binary cascade node " << nodeCount + j << "!");
+                    }
+                    nodeCount += count;
+                    leafCount += count + 1;
+                }
+
+                size_t subsetSize = (data.ncategories + 31) / 32;
+                if (nodeCount != data.nodes.size() || leafCount != data.leaves.size() || nodeCount*subsetSize != data.subsets.size())
+                    SIMD_EX("Invalid binary cascade size of nodes, leaves or subsets!");
+                if (data.featureType == SimdDetectionInfoFeatureLbp && subsetSize != 8)
+                    SIMD_EX("Invalid binary cascade LBP subsets!");
+            }
+
+            bool IsBinary(const char * path)
+            {
+                uint32_t magic = 0;
+                std::ifstream ifs(path, std::ios::binary);
+                ifs.read((char*)&magic, sizeof(magic));
+                return ifs.good() && magic == MAGIC;
+            }
+        }
+
+        void * DetectionLoadBinary(const void * buffer, size_t size)
+        {
+            Data * data = NULL;
+            try
+            {
+                const uint8_t * src = (const uint8_t*)buffer;
+                const uint8_t * end = src + size;
+                Binary::Header header;
+                if (buffer == NULL || size < sizeof(header))
+                    SIMD_EX("Invalid binary cascade size!");
+                memcpy(&header, src, sizeof(header));
+                src += sizeof(header);
+                if (header.magic != Binary::MAGIC || header.version != Binary::VERSION)
+                    SIMD_EX("Invalid binary cascade header!");
+                if (header.checksum != Crc32c(src, size - sizeof(header)))
+                    SIMD_EX("Invalid binary cascade checksum!");
+
+                data = new Data();
+                data->stageType = header.stageType;
+                data->featureType = (SimdDetectionInfoFlags)header.featureType;
+                data->ncategories = header.ncategories;
+                data->origWinSize = Size(header.width, header.height);
+                data->isStumpBased = header.isStumpBased != 0;
+                data->hasTilted = header.hasTilted != 0;
+                data->canInt16 = header.canInt16 != 0;
+
+                src = Binary::Read(header, Binary::Stages, src, end, data->stages);
+                src = Binary::Read(header, Binary::Classifiers, src, end, data->classifiers);
+                src = Binary::Read(header, Binary::Nodes, src, end, data->nodes);
+                src = Binary::Read(header, Binary::Leaves, src, end, data->leaves);
+                src = Binary::Read(header, Binary::Subsets, src, end, data->subsets);
+                src = Binary::Read(header, Binary::HaarFeatures, src, end, data->haarFeatures);
+                src = Binary::Read(header, Binary::LbpFeatures, src, end, data->lbpFeatures);
+                if (src != end)
+                    SIMD_EX("Invalid binary cascade size!");
+                Binary::Validate(*data);
+            }
+            catch (...)
+            {
+                delete data;
+                data = NULL;
+            }
+            return data;
+        }
+
+        int DetectionSaveBinary(const void * _data, const char * path)
+        {
+            const Data * data = (const Data*)_data;
+            if (data == NULL)
+                return 0;
+
+            Binary::Header header;
+            memset(&header, 0, sizeof(header));
+            header.magic = Binary::MAGIC;
+            header.version = Binary::VERSION;
+            header.stageType = data->stageType;
+            header.featureType = data->featureType;
+            header.ncategories = data->ncategories;
+            header.width = (int32_t)data->origWinSize.x;
+            header.height = (int32_t)data->origWinSize.y;
+            header.isStumpBased = data->isStumpBased ? 1 : 0;
+            header.hasTilted = data->featureType == SimdDetectionInfoFeatureHaar && data->hasTilted ? 1 : 0;
+            header.canInt16 = data->canInt16 ? 1 : 0;
+            Binary::SetArray(header, Binary::Stages, data->stages);
+            Binary::SetArray(header, Binary::Classifiers, data->classifiers);
+            Binary::SetArray(header, Binary::Nodes, data->nodes);
+            Binary::SetArray(header, Binary::Leaves, data->leaves);
+            Binary::SetArray(header, Binary::Subsets, data->subsets);
+            Binary::SetArray(header, Binary::HaarFeatures, data->haarFeatures);
+            Binary::SetArray(header, Binary::LbpFeatures, data->lbpFeatures);
+
+            std::vector<uint8_t> buffer;
+            Binary::Write(buffer, data->stages);
+            Binary::Write(buffer, data->classifiers);
+            Binary::Write(buffer, data->nodes);
+            Binary::Write(buffer, data->leaves);
+            Binary::Write(buffer, data->subsets);
+            Binary::Write(buffer, data->haarFeatures);
+            Binary::Write(buffer, data->lbpFeatures);
+            header.checksum = Crc32c(buffer.data(), buffer.size());
+
+            std::ofstream ofs(path, std::ios::binary);
+            if (!ofs.is_open())
+                return 0;
+            ofs.write((const char*)&header, sizeof(header));
+            if (buffer.size())
+                ofs.write((const char*)buffer.data(), buffer.size());
+            return ofs.good() ? 1 : 0;
+        }
+
         void * DetectionLoadA(const char * path)
         {
             static const float THRESHOLD_EPS = 1e-5f;
 
+            if (Binary::IsBinary(path))
+            {
+                std::ifstream ifs(path, std::ios::binary);
+                ifs.seekg(0, std::ios::end);
+                std::vector<char> buffer((size_t)ifs.tellg());
+                ifs.seekg(0, std::ios::beg);
+                ifs.read(buffer.data(), buffer.size());
+                return DetectionLoadBinary(buffer.data(), buffer.size());
+            }
+
             Data * data = NULL;
             try
             {
@@ -267,6 +506,12 @@ namespace Simd
                 if (data->featureType == SimdDetectionInfoFeatureHaar)
                 {
                     data->hasTilted = false;
+                    data->canInt16 = true;
+                    for (size_t i = 0; i < data->nodes.size(); ++i)
+                    {
+                        if (std::abs(data->nodes[i].threshold) >= 1.0f)
+                            data->canInt16 = false;
+                    }
                     data->haarFeatures.reserve(Xml::GetSize(featureNodes));
                     for (tinyxml2::XMLNode * featureNode = featureNodes->FirstChildElement(); featureNode != NULL; featureNode = featureNode->NextSiblingElement())
                     {
@@ -281,6 +526,8 @@ namespace Simd
                             feature.rect[rectIndex].r.width = (int)values[2];
                             feature.rect[rectIndex].r.height = (int)values[3];
                             feature.rect[rectIndex].weight = (float)values[4];
+                            if (values[4] != Simd::Round(values[4]))
+                                data->canInt16 = false;
                         }
                         feature.tilted = featureNode->FirstChildElement(Names::tilted) && Xml::GetValue<int>(featureNode, Names::tilted) != 0;
                         if (feature.tilted)
@@ -326,9 +573,12 @@ namespace Simd
                 if (height)
                     *height = data->origWinSize.y;
                 if (flags)
+                {
+                    int int16 = data->featureType == SimdDetectionInfoFeatureHaar ? SimdDetectionInfoCanHaarInt16 : SimdDetectionInfoCanInt16;
                     *flags = SimdDetectionInfoFlags(data->featureType |
-                    (data->hasTilted ? SimdDetectionInfoHasTilted : 0) |
-                        (data->canInt16 ? SimdDetectionInfoCanInt16 : 0));
+                        (data->hasTilted ? SimdDetectionInfoHasTilted : 0) |
+                        (data->canInt16 ? int16 : 0));
+                }
             }
         }
 
@@ -401,7 +651,7 @@ namespace Simd
                 return (T*)& view.At<T>(col, row);
         }
 
-        static void InitBase(HidHaarCascade * hid, const Image & sum, const Image & sqsum, const Image & tilted)
+        template<class Hid> static void InitBase(Hid * hid, const Image & sum, const Image & sqsum, const Image & tilted)
         {
             Rect rect(1, 1, hid->origWinSize.x - 1, hid->origWinSize.y - 1);
             hid->windowArea = (float)rect.Area();
@@ -421,52 +671,163 @@ namespace Simd
             hid->tilted = tilted;
         }
 
-        template<class T> SIMD_INLINE void UpdateFeaturePtrs(HidHaarCascade * hid, const Data & data)
+        template<class T, class R> SIMD_INLINE void UpdateRectPtrs(R & hr, const Data::Rect & dr, bool isTilted, const Image & sum, const Image & tilted, bool throughColumn)
+        {
+            if (hr.weight != 0)
+            {
+                if (isTilted)
+                {
+                    hr.p0 = SumElemPtr<T>(tilted, dr.y, dr.x, throughColumn);
+                    hr.p1 = SumElemPtr<T>(tilted, dr.y + dr.height, dr.x - dr.height, throughColumn);
+                    hr.p2 = SumElemPtr<T>(tilted, dr.y + dr.width, dr.x + dr.width, throughColumn);
+                    hr.p3 = SumElemPtr<T>(tilted, dr.y + dr.width + dr.height, dr.x + dr.width - dr.height, throughColumn);
+                }
+                else
+                {
+                    hr.p0 = SumElemPtr<T>(sum, dr.y, dr.x, throughColumn);
+                    hr.p1 = SumElemPtr<T>(sum, dr.y, dr.x + dr.width, throughColumn);
+                    hr.p2 = SumElemPtr<T>(sum, dr.y + dr.height, dr.x, throughColumn);
+                    hr.p3 = SumElemPtr<T>(sum, dr.y + dr.height, dr.x + dr.width, throughColumn);
+                }
+            }
+            else
+            {
+                hr.p0 = NULL;
+                hr.p1 = NULL;
+                hr.p2 = NULL;
+                hr.p3 = NULL;
+            }
+        }
+
+        template<class T, class Hid> SIMD_INLINE void UpdateFeaturePtrs(Hid * hid, const Data & data)
         {
             Image sum = hid->isThroughColumn ? hid->isum : hid->sum;
             Image tilted = hid->isThroughColumn ? hid->itilted : hid->tilted;
             for (size_t i = 0; i < hid->features.size(); i++)
             {
                 const Data::HaarFeature & df = data.haarFeatures[i];
-                HidHaarCascade::Feature & hf = hid->features[i];
+                typename Hid::Feature & hf = hid->features[i];
+                for (int j = 0; j < Data::HaarFeature::RECT_NUM; ++j)
+                    UpdateRectPtrs<T>(hf.rect[j], df.rect[j].r, df.tilted, sum, tilted, hid->isThroughColumn);
+            }
+        }
+
+        HidHaarCascade * InitHaar(const Data & data, const Image & sum, const Image & sqsum, const Image & tilted, bool throughColumn)
+        {
+            if (!data.isStumpBased)
+                SIMD_EX("Can't use tree classfier for vector haar classifier!");
+
+            HidHaarCascade * hid = CreateHidHaar(data);
+            InitBase(hid, sum, sqsum, tilted);
+            if (throughColumn)
+            {
+                hid->isThroughColumn = true;
+                hid->isum.Recreate(sum.width, sum.height, Image::Int32, NULL, Image::PixelSize(Image::Int32));
+                if (hid->hasTilted)
+                    hid->itilted.Recreate(tilted.width, tilted.height, Image::Int32, NULL, Image::PixelSize(Image::Int32));
+            }
+            UpdateFeaturePtrs<uint32_t>(hid, data);
+            return hid;
+        }
+
+        HidHaarCascade16i * CreateHidHaar16i(const Data & data)
+        {
+            if (data.featureType != SimdDetectionInfoFeatureHaar)
+                SIMD_EX("It is not HAAR cascade!");
+            if (!data.canInt16)
+                SIMD_EX("Can't use 16-bit integer haar classifier for this cascade!");
+
+            HidHaarCascade16i * hid = new HidHaarCascade16i();
+
+            hid->isInt16 = true;
+            hid->isThroughColumn = false;
+            hid->isStumpBased = data.isStumpBased;
+            hid->featureType = data.featureType;
+            hid->origWinSize = data.origWinSize;
+
+            // Every rectangle sum is taken from 32-bit integral images and rounded to 2^shift units of its feature,
+            // so it does not depend on window position. Feature sums and norm must fit into int16_t.
+            int normMax = (UCHAR_MAX + 1) / 2 * (data.origWinSize.x - 2)*(data.origWinSize.y - 2), normShift = 0;
+            while ((normMax >> normShift) > SHRT_MAX)
+                normShift++;
+            hid->normScale = 1.0f / float(1 << normShift);
+
+            hid->features.resize(data.haarFeatures.size());
+            for (size_t i = 0; i < hid->features.size(); ++i)
+            {
+                const Data::HaarFeature & df = data.haarFeatures[i];
+                int positive = 0, negative = 0, weights = 0;
                 for (int j = 0; j < Data::HaarFeature::RECT_NUM; ++j)
                 {
-                    const Data::Rect & dr = df.rect[j].r;
-                    WeightedRect & hr = hf.rect[j];
-                    if (hr.weight != 0.0)
-                    {
-                        if (df.tilted)
-                        {
-                            hr.p0 = SumElemPtr<T>(tilted, dr.y, dr.x, hid->isThroughColumn);
-                            hr.p1 = SumElemPtr<T>(tilted, dr.y + dr.height, dr.x - dr.height, hid->isThroughColumn);
-                            hr.p2 = SumElemPtr<T>(tilted, dr.y + dr.width, dr.x + dr.width, hid->isThroughColumn);
-                            hr.p3 = SumElemPtr<T>(tilted, dr.y + dr.width + dr.height, dr.x + dr.width - dr.height, hid->isThroughColumn);
-                        }
-                        else
-                        {
-                            hr.p0 = SumElemPtr<T>(sum, dr.y, dr.x, hid->isThroughColumn);
-                            hr.p1 = SumElemPtr<T>(sum, dr.y, dr.x + dr.width, hid->isThroughColumn);
-                            hr.p2 = SumElemPtr<T>(sum, dr.y + dr.height, dr.x, hid->isThroughColumn);
-                            hr.p3 = SumElemPtr<T>(sum, dr.y + dr.height, dr.x + dr.width, hid->isThroughColumn);
-                        }
-                    }
+                    int weight = Simd::Round(df.rect[j].weight);
+                    int area = df.rect[j].r.width*df.rect[j].r.height*(df.tilted ? 2 : 1);
+                    if (weight > 0)
+                        positive += weight*area;
                     else
-                    {
-                        hr.p0 = NULL;
-                        hr.p1 = NULL;
-                        hr.p2 = NULL;
-                        hr.p3 = NULL;
-                    }
+                        negative -= weight*area;
+                    weights += std::abs(weight);
+                    hid->features[i].rect[j].weight = (int16_t)weight;
                 }
+                int featureMax = UCHAR_MAX*std::max(positive, negative);
+                hid->features[i].shift = 0;
+                while ((featureMax >> hid->features[i].shift) + 2 * weights > SHRT_MAX)
+                    hid->features[i].shift++;
+                if (df.tilted)
+                    hid->hasTilted = true;
+            }
+
+            // Node thresholds are Q16 numbers which also convert the norm scale to the scale of the feature.
+            // The high half of threshold*norm is its floor, so the integer feature sum is compared with it by '>'
+            // what is equal to float comparison 'sum >= threshold*norm'.
+            for (size_t i = 0; i < data.nodes.size(); ++i)
+            {
+                int & shift = hid->features[data.nodes[i].featureIdx].shift;
+                while (std::abs(data.nodes[i].threshold)*float(1 << (16 + normShift)) >= float(SHRT_MAX << shift))
+                    shift++;
+            }
+            hid->nodes.resize(data.nodes.size());
+            for (size_t i = 0; i < data.nodes.size(); ++i)
+            {
+                float scale = float(1 << (16 + normShift)) / float(1 << hid->features[data.nodes[i].featureIdx].shift);
+                hid->nodes[i].featureIdx = data.nodes[i].featureIdx;
+                hid->nodes[i].threshold = (int16_t)Simd::RestrictRange(Simd::Round(data.nodes[i].threshold*scale), -SHRT_MAX, SHRT_MAX);
             }
+
+            hid->stages.resize(data.stages.size());
+            hid->leaves.resize(data.leaves.size());
+            for (size_t i = 0; i < data.stages.size(); ++i)
+            {
+                const Data::Stage & stage = data.stages[i];
+                float min = 0, max = 0;
+                for (int j = stage.first, n = stage.first + stage.ntrees; j < n; ++j)
+                {
+                    min += std::min(data.leaves[2 * j + 0], data.leaves[2 * j + 1]);
+                    max += std::max(data.leaves[2 * j + 0], data.leaves[2 * j + 1]);
+                }
+                float k = float(SHRT_MAX)*0.9f / std::max(std::abs(min), std::abs(max));
+
+                hid->stages[i].first = stage.first;
+                hid->stages[i].ntrees = stage.ntrees;
+                hid->stages[i].threshold = (int16_t)Simd::RestrictRange(Simd::Round(stage.threshold*k), -SHRT_MAX, SHRT_MAX);
+                hid->stages[i].hasThree = false;
+                for (int j = stage.first, n = stage.first + stage.ntrees; j < n; ++j)
+                {
+                    hid->leaves[2 * j + 0] = (int16_t)Simd::Round(data.leaves[2 * j + 0] * k);
+                    hid->leaves[2 * j + 1] = (int16_t)Simd::Round(data.leaves[2 * j + 1] * k);
+                    if (data.haarFeatures[data.nodes[j].featureIdx].rect[2].weight != 0)
+                        hid->stages[i].hasThree = true;
+                }
+            }
+
+            return hid;
         }
 
-        HidHaarCascade * InitHaar(const Data & data, const Image & sum, const Image & sqsum, const Image & tilted, bool throughColumn)
+        HidHaarCascade16i * InitHaar16i(const Data & data, const Image & sum, const Image & sqsum, const Image & tilted, bool throughColumn)
         {
             if (!data.isStumpBased)
                 SIMD_EX("Can't use tree classfier for vector haar classifier!");
 
-            HidHaarCascade * hid = CreateHidHaar(data);
+            HidHaarCascade16i * hid = CreateHidHaar16i(data);
             InitBase(hid, sum, sqsum, tilted);
             if (throughColumn)
             {
@@ -619,6 +980,12 @@ namespace Simd
             switch (data.featureType)
             {
             case SimdDetectionInfoFeatureHaar:
+                if (int16 && data.canInt16)
+                    return InitHaar16i(data,
+                        Image(width, height, sumStride, Image::Int32, sum),
+                        Image(width, height, sqsumStride, Image::Int32, sqsum),
+                        Image(width, height, tiltedStride, Image::Int32, tilted),
+                        throughColumn != 0);
                 return InitHaar(data,
                     Image(width, height, sumStride, Image::Int32, sum),
                     Image(width, height, sqsumStride, Image::Int32, sqsum),
@@ -686,7 +1053,14 @@ namespace Simd
         void DetectionPrepare(void * _hid)
         {
             HidBase * hidBase = (HidBase*)_hid;
-            if (hidBase->featureType == SimdDetectionInfoFeatureHaar && hidBase->isThroughColumn)
+            if (hidBase->featureType == SimdDetectionInfoFeatureHaar && hidBase->isInt16 && hidBase->isThroughColumn)
+            {
+                HidHaarCascade16i * hid = (HidHaarCascade16i*)hidBase;
+                PrepareThroughColumn32i(hid->sum, hid->isum);
+                if (hid->hasTilted)
+                    PrepareThroughColumn32i(hid->tilted, hid->itilted);
+            }
+            else if (hidBase->featureType == SimdDetectionInfoFeatureHaar && hidBase->isThroughColumn)
             {
                 HidHaarCascade * hid = (HidHaarCascade*)hidBase;
                 PrepareThroughColumn32i(hid->sum, hid->isum);
@@ -801,6 +1175,107 @@ namespace Simd
                 Image(hid.sum.width - 1, hid.sum.height - 1, dstStride, Image::Gray8, dst).Ref());
         }
 
+        // Mixed path: the variance norm is computed once per window in float and rounded to int16_t,
+        // all feature sums and comparisons are integer.
+        int16_t Norm16i(const HidHaarCascade16i & hid, size_t offset)
+        {
+            float sum = float(Sum32i(hid.p, offset));
+            float sqsum = float(Sum32i(hid.pq, offset));
+            float q = sqsum*hid.windowArea - sum*sum;
+            return (int16_t)Simd::Round((q > 0.0f ? sqrtf(q) : 1.0f)*hid.normScale);
+        }
+
+        int Detect16i(const HidHaarCascade16i & hid, size_t offset, int startStage, int16_t norm)
+        {
+            typedef HidHaarCascade16i Hid;
+            const Hid::Stage * stages = hid.stages.data();
+            const Hid::Node * node = hid.nodes.data() + stages[startStage].first;
+            const int16_t * leaves = hid.leaves.data() + stages[startStage].first * 2;
+            for (int i = startStage, n = (int)hid.stages.size(); i < n; ++i)
+            {
+                const Hid::Stage & stage = stages[i];
+                const Hid::Node * end = node + stage.ntrees;
+                int stageSum = 0;
+                if (stage.hasThree)
+                {
+                    for (; node < end; ++node, leaves += 2)
+                    {
+                        const Hid::Feature & feature = hid.features[node->featureIdx];
+                        int sum = WeightedSum16i(feature.rect[0], offset, feature.shift) + WeightedSum16i(feature.rect[1], offset, feature.shift);
+                        if (feature.rect[2].p0)
+                            sum += WeightedSum16i(feature.rect[2], offset, feature.shift);
+                        stageSum += leaves[int16_t(sum) > Threshold16i(node->threshold, norm)];
+                    }
+                }
+                else
+                {
+                    for (; node < end; ++node, leaves += 2)
+                    {
+                        const Hid::Feature & feature = hid.features[node->featureIdx];
+                        int sum = WeightedSum16i(feature.rect[0], offset, feature.shift) + WeightedSum16i(feature.rect[1], offset, feature.shift);
+                        stageSum += leaves[int16_t(sum) > Threshold16i(node->threshold, norm)];
+                    }
+                }
+                if (stageSum < stage.threshold)
+                    return -i;
+            }
+            return 1;
+        }
+
+        void DetectionHaarDetect16ip(const HidHaarCascade16i & hid, const Image & mask, const Rect & rect, Image & dst)
+        {
+            for (ptrdiff_t row = rect.top; row < rect.bottom; row += 1)
+            {
+                size_t p_offset = row * hid.sum.stride / sizeof(uint32_t);
+                size_t pq_offset = row * hid.sqsum.stride / sizeof(uint32_t);
+                for (ptrdiff_t col = rect.left; col < rect.right; col += 1)
+                {
+                    if (mask.At<uint8_t>(col, row) == 0)
+                        continue;
+                    int16_t norm = Norm16i(hid, pq_offset + col);
+                    if (Detect16i(hid, p_offset + col, 0, norm) > 0)
+                        dst.At<uint8_t>(col, row) = 1;
+                }
+            }
+        }
+
+        void DetectionHaarDetect16ip(const void * _hid, const uint8_t * mask, size_t maskStride,
+            ptrdiff_t left, ptrdiff_t top, ptrdiff_t right, ptrdiff_t bottom, uint8_t * dst, size_t dstStride)
+        {
+            const HidHaarCascade16i & hid = *(HidHaarCascade16i*)_hid;
+            return DetectionHaarDetect16ip(hid,
+                Image(hid.sum.width - 1, hid.sum.height - 1, maskStride, Image::Gray8, (uint8_t*)mask),
+                Rect(left, top, right, bottom),
+                Image(hid.sum.width - 1, hid.sum.height - 1, dstStride, Image::Gray8, dst).Ref());
+        }
+
+        void DetectionHaarDetect16ii(const HidHaarCascade16i & hid, const Image & mask, const Rect & rect, Image & dst)
+        {
+            for (ptrdiff_t row = rect.top; row < rect.bottom; row += 2)
+            {
+                size_t p_offset = row * hid.isum.stride / sizeof(uint32_t);
+                size_t pq_offset = row * hid.sqsum.stride / sizeof(uint32_t);
+                for (ptrdiff_t col = rect.left; col < rect.right; col += 2)
+                {
+                    if (mask.At<uint8_t>(col, row) == 0)
+                        continue;
+                    int16_t norm = Norm16i(hid, pq_offset + col);
+                    if (Detect16i(hid, p_offset + col / 2, 0, norm) > 0)
+                        dst.At<uint8_t>(col, row) = 1;
+                }
+            }
+        }
+
+        void DetectionHaarDetect16ii(const void * _hid, const uint8_t * mask, size_t maskStride,
+            ptrdiff_t left, ptrdiff_t top, ptrdiff_t right, ptrdiff_t bottom, uint8_t * dst, size_t dstStride)
+        {
+            const HidHaarCascade16i & hid = *(HidHaarCascade16i*)_hid;
+            return DetectionHaarDetect16ii(hid,
+                Image(hid.sum.width - 1, hid.sum.height - 1, maskStride, Image::Gray8, (uint8_t*)mask),
+                Rect(left, top, right, bottom),
+                Image(hid.sum.width - 1, hid.sum.height - 1, dstStride, Image::Gray8, dst).Ref());
+        }
+
         void DetectionLbpDetect32fp(const HidLbpCascade<float, uint32_t> & hid, const Image & mask, const Rect & rect, Image & dst)
         {
             for (ptrdiff_t row = rect.top; row < rect.bottom; row += 1)
@@ -146,5 +146,22 @@ namespace Simd
                 sums[0] += SquaredDifference16f(a[i], b[i]);
             *sum = sums[0] + sums[1] + sums[2] + sums[3];
         }
+
+        void NeuralProductSum16f(const float * a, const uint16_t * b, size_t size, float * sum)
+        {
+            size_t alignedSize = Simd::AlignLo(size, 4);
+            float sums[4] = { 0, 0, 0, 0 };
+            size_t i = 0;
+            for (; i < alignedSize; i += 4)
+            {
+                sums[0] += a[i + 0] * Float16ToFloat32(b[i + 0]);
+                sums[1] += a[i + 1] * Float16ToFloat32(b[i + 1]);
+                sums[2] += a[i + 2] * Float16ToFloat32(b[i + 2]);
+                sums[3] += a[i + 3] * Float16ToFloat32(b[i + 3]);
+            }
+            for (; i < size; ++i)
+                sums[0] += a[i] * Float16ToFloat32(b[i]);
+            *sum = sums[0] + sums[1] + sums[2] + sums[3];
+        }
     }
 }
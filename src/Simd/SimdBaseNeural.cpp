@@ -23,6 +23,7 @@
 */
 #include "Simd/SimdMath.h"
 #include "Simd/SimdMemory.h"
+#include "Simd/SimdNeural.h"
 
 namespace Simd
 {
@@ -69,6 +70,24 @@ namespace Simd
             *sum = ProductSum(a, b, Simd::AlignLo(size, 4), size);
         }
 
+        void NeuralProductSum8i(size_t M, size_t N, size_t K, const int8_t * a, const uint8_t * b, int32_t * c)
+        {
+            for (size_t i = 0; i < M; ++i)
+            {
+                for (size_t j = 0; j < N; ++j)
+                    c[j] = 0;
+                for (size_t k = 0; k < K; ++k)
+                {
+                    int32_t value = a[k];
+                    const uint8_t * pb = b + k*N;
+                    for (size_t j = 0; j < N; ++j)
+                        c[j] += value * pb[j];
+                }
+                a += K;
+                c += N;
+            }
+        }
+
         SIMD_INLINE void AddMultiplied(const float * src, size_t aligned, size_t full, float value, float * dst)
         {
             size_t i = 0;
@@ -653,5 +672,48 @@ namespace Simd
             if (internal)
                 Free(internal);
         }
+
+        namespace Ncf
+        {
+            struct Convolution : public NeuralConvolution
+            {
+                Convolution(size_t srcWidth, size_t srcHeight, size_t srcDepth, const float * weight, size_t kernelX, size_t kernelY, size_t padX, size_t padY,
+                    size_t strideX, size_t strideY, size_t dilationX, size_t dilationY, size_t dstWidth, size_t dstHeight, size_t dstDepth,
+                    const float * bias, SimdNeuralActivationType activation, const float * slope)
+                    : NeuralConvolution(srcWidth, srcHeight, srcDepth, kernelX, kernelY, padX, padY, strideX, strideY, dilationX, dilationY, dstWidth, dstHeight, dstDepth,
+                        bias, activation, slope)
+                {
+                    size_t size = dstDepth*kernelX*kernelY*srcDepth;
+                    this->weight = (float*)Allocate(size * sizeof(float));
+                    memcpy(this->weight, weight, size * sizeof(float));
+                }
+
+                virtual void Run(const float * src, void * buffer, size_t * size, float * dst, int add) const
+                {
+                    NeuralConvolutionForward(src, srcWidth, srcHeight, srcDepth, weight, kernelX, kernelY, padX, padY, strideX, strideY, dilationX, dilationY,
+                        buffer, size, dst, dstWidth, dstHeight, dstDepth, add);
+                    if (HasEpilogue())
+                        Epilogue(0, dstDepth, dst);
+                }
+            };
+        }
+
+        void * NeuralConvolutionInit(size_t srcWidth, size_t srcHeight, size_t srcDepth, const float * weight, size_t kernelX, size_t kernelY, 
+            size_t padX, size_t padY, size_t strideX, size_t strideY, size_t dilationX, size_t dilationY, size_t dstWidth, size_t dstHeight, size_t dstDepth,
+            const float * bias, SimdNeuralActivationType activation, const float * slope)
+        {
+            return new Ncf::Convolution(srcWidth, srcHeight, srcDepth, weight, kernelX, kernelY, padX, padY, strideX, strideY, dilationX, dilationY, dstWidth, dstHeight, dstDepth,
+                bias, activation, slope);
+        }
+
+        void NeuralConvolutionRun(const void * context, const float * src, void * buffer, size_t * size, float * dst, int add)
+        {
+            ((const NeuralConvolution*)context)->Run(src, buffer, size, dst, add);
+        }
+
+        void NeuralConvolutionFree(void * context)
+        {
+            delete (NeuralConvolution*)context;
+        }
     }
 }
@@ -88,9 +88,9 @@ namespace Simd
             }
         }
 
-        void ResizeBilinear(
+        void ResizeBilinearRows(
             const uint8_t *src, size_t srcWidth, size_t srcHeight, size_t srcStride,
-            uint8_t *dst, size_t dstWidth, size_t dstHeight, size_t dstStride, size_t channelCount)
+            uint8_t *dst, size_t dstWidth, size_t dstHeight, size_t dstStride, size_t channelCount, size_t yBegin, size_t yEnd)
         {
             assert(channelCount >= 1 && channelCount <= 4);
 
@@ -104,7 +104,8 @@ namespace Simd
 
             ptrdiff_t previous = -2;
 
-            for (size_t yDst = 0; yDst < dstHeight; yDst++, dst += dstStride)
+            dst += yBegin*dstStride;
+            for (size_t yDst = yBegin; yDst < yEnd; yDst++, dst += dstStride)
             {
                 int fy = buffer.ay[yDst];
                 ptrdiff_t sy = buffer.iy[yDst];
@@ -149,6 +150,13 @@ namespace Simd
                 }
             }
         }
+
+        void ResizeBilinear(
+            const uint8_t *src, size_t srcWidth, size_t srcHeight, size_t srcStride,
+            uint8_t *dst, size_t dstWidth, size_t dstHeight, size_t dstStride, size_t channelCount)
+        {
+            ResizeBilinearRows(src, srcWidth, srcHeight, srcStride, dst, dstWidth, dstHeight, dstStride, channelCount, 0, dstHeight);
+        }
     }
 }
 
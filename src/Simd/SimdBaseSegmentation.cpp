@@ -22,6 +22,7 @@
 * SOFTWARE.
 */
 #include "Simd/SimdDefs.h"
+#include "Simd/SimdSegmentation.h"
 
 namespace Simd
 {
@@ -191,5 +192,17 @@ namespace Simd
                 }
             }
         }
+
+        size_t SegmentationLabel(uint8_t * mask, size_t maskStride, size_t width, size_t height, const uint8_t * difference, size_t differenceStride,
+            uint8_t seedIndex, uint8_t emptyIndex, uint8_t invalidIndex, uint8_t differenceThreshold, size_t areaMin, uint8_t indexMin, ptrdiff_t * rects)
+        {
+            Segmentation::Labeller labeller(width, height);
+            for (size_t row = 0; row < height; ++row)
+            {
+                labeller.SetTail(mask + row*maskStride, difference + row*differenceStride, 0, seedIndex, emptyIndex, differenceThreshold);
+                labeller.AddRow(row);
+            }
+            return labeller.Finish(mask, maskStride, invalidIndex, areaMin, indexMin, rects);
+        }
     }
 }
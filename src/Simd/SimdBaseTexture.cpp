@@ -81,6 +81,61 @@ namespace Simd
             }
         }
 
+        SIMD_INLINE int TextureFeatureDifference(int difference, int value, int lo, int hi, uint32_t weight)
+        {
+            uint32_t featureDifference = Max(0, Max(value - hi, lo - value));
+            return Min(difference + int(featureDifference*featureDifference*weight >> 16), 0xFF);
+        }
+
+        void TextureFeatureDifference(const uint8_t * gray, size_t grayStride, size_t width, size_t height, uint8_t saturation, uint8_t boost,
+            const uint8_t * grayLo, size_t grayLoStride, const uint8_t * grayHi, size_t grayHiStride, uint16_t grayWeight,
+            uint8_t * dx, size_t dxStride, const uint8_t * dxLo, size_t dxLoStride, const uint8_t * dxHi, size_t dxHiStride, uint16_t dxWeight,
+            uint8_t * dy, size_t dyStride, const uint8_t * dyLo, size_t dyLoStride, const uint8_t * dyHi, size_t dyHiStride, uint16_t dyWeight,
+            const uint8_t * mask, size_t maskStride, uint8_t * difference, size_t differenceStride)
+        {
+            assert(width >= 3 && height >= 3 && int(2)*saturation*boost <= 0xFF);
+
+            for (size_t row = 0; row < height; ++row)
+            {
+                if (row == 0 || row == height - 1)
+                {
+                    memset(dx, 0, width);
+                    memset(dy, 0, width);
+                }
+                else
+                {
+                    dx[0] = 0;
+                    dy[0] = 0;
+                    for (size_t col = 1; col < width - 1; ++col)
+                    {
+                        dy[col] = TextureBoostedSaturatedGradient(gray + col, grayStride, saturation, boost);
+                        dx[col] = TextureBoostedSaturatedGradient(gray + col, 1, saturation, boost);
+                    }
+                    dx[width - 1] = 0;
+                    dy[width - 1] = 0;
+                }
+                for (size_t col = 0; col < width; ++col)
+                {
+                    int sum = TextureFeatureDifference(0, gray[col], grayLo[col], grayHi[col], grayWeight);
+                    sum = TextureFeatureDifference(sum, dx[col], dxLo[col], dxHi[col], dxWeight);
+                    sum = TextureFeatureDifference(sum, dy[col], dyLo[col], dyHi[col], dyWeight);
+                    difference[col] = mask ? sum & mask[col] : sum;
+                }
+                gray += grayStride;
+                grayLo += grayLoStride;
+                grayHi += grayHiStride;
+                dx += dxStride;
+                dxLo += dxLoStride;
+                dxHi += dxHiStride;
+                dy += dyStride;
+                dyLo += dyLoStride;
+                dyHi += dyHiStride;
+                if (mask)
+                    mask += maskStride;
+                difference += differenceStride;
+            }
+        }
+
         void TextureGetDifferenceSum(const uint8_t * src, size_t srcStride, size_t width, size_t height,
             const uint8_t * lo, size_t loStride, const uint8_t * hi, size_t hiStride, int64_t * sum)
         {
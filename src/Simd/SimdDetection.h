@@ -196,6 +196,64 @@ namespace Simd
             }
         };
 
+        struct WeightedRect16i
+        {
+            uint32_t *p0, *p1, *p2, *p3;
+            int16_t weight;
+        };
+
+        struct HidHaarFeature16i
+        {
+            WeightedRect16i rect[Data::HaarFeature::RECT_NUM];
+            int shift;
+        };
+
+        struct HidHaarStage16i
+        {
+            int first;
+            int ntrees;
+            int16_t threshold;
+            bool hasThree;
+        };
+
+        struct HidHaarNode16i
+        {
+            int featureIdx;
+            int16_t threshold;
+        };
+
+        struct HidHaarCascade16i : public HidBase
+        {
+            typedef HidHaarNode16i Node;
+            typedef std::vector<Node> Nodes;
+
+            typedef HidHaarFeature16i Feature;
+            typedef std::vector<Feature> Features;
+
+            typedef HidHaarStage16i Stage;
+            typedef std::vector<Stage> Stages;
+
+            typedef int16_t Leave;
+            typedef std::vector<Leave> Leaves;
+
+            Nodes nodes;
+            Stages stages;
+            Leaves leaves;
+            Features features;
+
+            float windowArea;
+            float normScale;
+            uint32_t *pq[4];
+            uint32_t *p[4];
+
+            Image sum, sqsum, tilted;
+            Image isum, itilted;
+
+            virtual ~HidHaarCascade16i()
+            {
+            }
+        };
+
         template<class TSum> struct HidLbpFeature
         {
             Rect rect;
@@ -300,6 +358,21 @@ namespace Simd
 
         int Detect32f(const struct HidHaarCascade & hid, size_t offset, int startStage, float norm);
 
+        int16_t Norm16i(const struct HidHaarCascade16i & hid, size_t offset);
+
+        SIMD_INLINE int WeightedSum16i(const WeightedRect16i & rect, size_t offset, int shift)
+        {
+            uint32_t sum = rect.p0[offset] - rect.p1[offset] - rect.p2[offset] + rect.p3[offset];
+            return int((sum + (1 << shift >> 1)) >> shift)*rect.weight;
+        }
+
+        SIMD_INLINE int16_t Threshold16i(int16_t threshold, int16_t norm)
+        {
+            return int16_t((threshold*norm) >> 16);
+        }
+
+        int Detect16i(const struct HidHaarCascade16i & hid, size_t offset, int startStage, int16_t norm);
+
         template< class T> SIMD_INLINE T IntegralSum(const T * p0, const T * p1, const T * p2, const T * p3, ptrdiff_t offset)
         {
             return p0[offset] - p1[offset] - p2[offset] + p3[offset];
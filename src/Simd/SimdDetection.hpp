@@ -28,6 +28,7 @@
 #include "Simd/SimdParallel.hpp"
 
 #include <vector>
+#include <algorithm>
 #include <map>
 #include <memory>
 
@@ -37,6 +38,10 @@
 #define SIMD_CHECK_PERFORMANCE()
 #endif
 
+#ifndef SIMD_CHECK_PERFORMANCE_
+#define SIMD_CHECK_PERFORMANCE_(name)
+#endif
+
 namespace Simd
 {
     /*! @ingroup cpp_detection
@@ -210,7 +215,7 @@ namespace Simd
         }
 
         /*!
-            Loads from file classifier cascade. Supports OpenCV HAAR and LBP cascades type.
+            Loads from file classifier cascade. Supports OpenCV HAAR and LBP cascades type and binary format (see ::SimdDetectionSaveBinary).
             You can call this function more than once if you want to use several object detectors at the same time.
 
             \note Tree based cascades and old cascade formats are not supported!
@@ -221,16 +226,21 @@ namespace Simd
         */
         bool Load(const std::string & path, Tag tag = UNDEFINED_OBJECT_TAG)
         {
-            Handle handle = ::SimdDetectionLoadA(path.c_str());
-            if (handle)
-            {
-                Data data;
-                data.handle = handle;
-                data.tag = tag;
-                ::SimdDetectionInfo(handle, (size_t*)&data.size.x, (size_t*)&data.size.y, &data.flags);
-                _data.push_back(data);
-            }
-            return handle != NULL;
+            return Add(::SimdDetectionLoadA(path.c_str()), tag);
+        }
+
+        /*!
+            Loads classifier cascade in binary format (see ::SimdDetectionSaveBinary) from memory buffer (for example memory mapped file).
+            You can call this function more than once if you want to use several object detectors at the same time.
+
+            \param [in] buffer - a pointer to memory buffer with cascade.
+            \param [in] size - a size of the buffer.
+            \param [in] tag - an user defined tag. This tag will be inserted in output Object structure.
+            \return a result of this operation.
+        */
+        bool LoadBinary(const void * buffer, size_t size, Tag tag = UNDEFINED_OBJECT_TAG)
+        {
+            return Add(::SimdDetectionLoadBinary(buffer, size), tag);
         }
 
         /*!
@@ -244,14 +254,17 @@ namespace Simd
             \param [in] roi - a 8-bit image mask which defines Region Of Interest. User can restricts detection region with using this mask.
                               The mask affects to the center of detected object.
             \param [in] threadNumber - a number of work threads. It useful for multi core CPU. Use value -1 to auto choose of thread number.
+            \param [in] haarInt16 - a flag to use 16-bit integer HAAR detection (::SimdDetectionHaarDetect16ip, ::SimdDetectionHaarDetect16ii) for cascades
+                                   which allow it. It is faster but its results can slightly differ from 32-bit float detection. By default it is switched off.
             \return a result of this operation.
         */
         bool Init(const Size & imageSize, double scaleFactor = 1.1, const Size & sizeMin = Size(0, 0),
-            const Size & sizeMax = Size(INT_MAX, INT_MAX), const View & roi = View(), ptrdiff_t threadNumber = -1)
+            const Size & sizeMax = Size(INT_MAX, INT_MAX), const View & roi = View(), ptrdiff_t threadNumber = -1, bool haarInt16 = false)
         {
             if (_data.empty())
                 return false;
             _imageSize = imageSize;
+            _haarInt16 = haarInt16;
             ptrdiff_t threadNumberMax = std::thread::hardware_concurrency();
             _threadNumber = (threadNumber <= 0 || threadNumber > threadNumberMax) ? threadNumberMax : threadNumber;
             return InitLevels(scaleFactor, sizeMin, sizeMax, roi);
@@ -279,28 +292,49 @@ namespace Simd
 
             FillLevels(src);
 
-            typedef std::map<Tag, Objects> Candidates;
-            Candidates candidates;
-
+            std::vector<size_t> active;
             for (size_t i = 0; i < _levels.size(); ++i)
             {
                 Level & level = *_levels[i];
-                View mask = level.roi;
-                Rect rect = level.rect;
+                level.detectMask = level.roi;
+                level.detectRect = level.rect;
+                level.detectRects.assign(1, level.rect);
                 if (motionMask)
                 {
-                    FillMotionMask(motionRegions, level, rect);
-                    mask = level.mask;
+                    FillMotionMask(motionRegions, level, level.detectRect, level.detectRects);
+                    level.detectMask = level.mask;
                 }
-                if (rect.Empty())
+                if (level.detectRect.Empty())
                     continue;
+                active.push_back(i);
+            }
+
+            Execute(active.size(), [&](size_t i)
+            {
+                Level & level = *_levels[active[i]];
+                FillLevel(level);
                 for (size_t j = 0; j < level.hids.size(); ++j)
-                {
-                    Hid & hid = level.hids[j];
+                    level.hids[j].Prepare();
+            });
 
-                    hid.Detect(mask, rect, level.dst, _threadNumber, level.throughColumn);
+            Tasks tasks;
+            CreateTasks(active, tasks);
+            Execute(tasks.size(), [&](size_t i)
+            {
+                const Task & task = tasks[i];
+                SIMD_CHECK_PERFORMANCE_("Detection level " + std::to_string(task.level));
+                task.hid->Detect(_levels[task.level]->detectMask, task.region);
+            });
 
-                    AddObjects(candidates[hid.data->tag], level.dst, rect, hid.data->size, level.scale,
+            typedef std::map<Tag, Objects> Candidates;
+            Candidates candidates;
+            for (size_t i = 0; i < active.size(); ++i)
+            {
+                Level & level = *_levels[active[i]];
+                for (size_t j = 0; j < level.hids.size(); ++j)
+                {
+                    Hid & hid = level.hids[j];
+                    AddObjects(candidates[hid.data->tag], hid.dst, level.detectRect, hid.data->size, level.scale,
                         level.throughColumn ? 2 : 1, hid.data->tag);
                 }
             }
@@ -312,6 +346,26 @@ namespace Simd
             return true;
         }
 
+        /*!
+            Groups elementary detections into objects in the same way as function Detect does it.
+            It is useful if elementary detections are collected from several frames or external sources.
+
+            \param [in] src - elementary detections (every one must have weight 1).
+            \param [out] dst - grouped objects. Detections with different tags are grouped separately.
+            \param [in] groupSizeMin - a minimal weight (number of elementary detections) of detected image.
+            \param [in] sizeDifferenceMax - a parameter to group elementary detections.
+        */
+        void Group(const Objects & src, Objects & dst, int groupSizeMin = 3, double sizeDifferenceMax = 0.2)
+        {
+            std::map<Tag, Objects> candidates;
+            for (size_t i = 0; i < src.size(); ++i)
+                candidates[src[i].tag].push_back(src[i]);
+
+            dst.clear();
+            for (typename std::map<Tag, Objects>::iterator it = candidates.begin(); it != candidates.end(); ++it)
+                GroupObjects(dst, it->second, groupSizeMin, sizeDifferenceMax);
+        }
+
     private:
 
         typedef void * Handle;
@@ -326,6 +380,7 @@ namespace Simd
             bool Haar() const { return (flags&::SimdDetectionInfoFeatureMask) == ::SimdDetectionInfoFeatureHaar; }
             bool Tilted() const { return (flags&::SimdDetectionInfoHasTilted) != 0; }
             bool Int16() const { return (flags&::SimdDetectionInfoCanInt16) != 0; }
+            bool HaarInt16() const { return (flags&::SimdDetectionInfoCanHaarInt16) != 0; }
         };
 
         typedef void(*DetectPtr)(const void * hid, const uint8_t * mask, size_t maskStride,
@@ -340,21 +395,27 @@ namespace Simd
             Handle handle;
             Data * data;
             DetectPtr detect;
+            View dst;
 
-            void Detect(const View & mask, const Rect & rect, View & dst, size_t threadNumber, bool throughColumn)
+            Rect Region(const Rect & rect) const
+            {
+                return rect.Shifted(-data->size / 2).Intersection(Rect(dst.Size() - data->size));
+            }
+
+            void Prepare()
             {
                 SIMD_CHECK_PERFORMANCE();
 
-                Size s = dst.Size() - data->size;
-                View m = mask.Region(s, View::MiddleCenter);
-                Rect r = rect.Shifted(-data->size / 2).Intersection(Rect(s));
                 Simd::Fill(dst, 0);
                 ::SimdDetectionPrepare(handle);
+            }
 
-                Parallel(r.top, r.bottom, [&](size_t thread, size_t begin, size_t end)
-                {
-                    detect(handle, m.data, m.stride, r.left, begin, r.right, end, dst.data, dst.stride);
-                }, rect.Area() >= (data->Haar() ? 10000 : 30000) ? threadNumber : 1, throughColumn ? 2 : 1);
+            void Detect(const View & mask, const Rect & region)
+            {
+                SIMD_CHECK_PERFORMANCE();
+
+                View m = mask.Region(dst.Size() - data->size, View::MiddleCenter);
+                detect(handle, m.data, m.stride, region.left, region.top, region.right, region.bottom, dst.data, dst.stride);
             }
         };
         typedef std::vector<Hid> Hids;
@@ -374,7 +435,9 @@ namespace Simd
             View sqsum;
             View tilted;
 
-            View dst;
+            View detectMask;
+            Rect detectRect;
+            Rects detectRects;
 
             bool throughColumn;
             bool needSqsum;
@@ -392,9 +455,28 @@ namespace Simd
         std::vector<Data> _data;
         Size _imageSize;
         bool _needNormalization;
+        bool _haarInt16;
         ptrdiff_t _threadNumber;
         LevelPtrs _levels;
 
+        bool Add(Handle handle, Tag tag)
+        {
+            if (handle)
+            {
+                Data data;
+                data.handle = handle;
+                data.tag = tag;
+                ::SimdDetectionInfo(handle, (size_t*)&data.size.x, (size_t*)&data.size.y, &data.flags);
+                _data.push_back(data);
+            }
+            return handle != NULL;
+        }
+
+        bool Int16(const Data & data) const
+        {
+            return data.Haar() ? data.HaarInt16() && _haarInt16 : data.Int16();
+        }
+
         bool InitLevels(double scaleFactor, const Size & sizeMin, const Size & sizeMax, const View & roi)
         {
             _needNormalization = false;
@@ -436,25 +518,28 @@ namespace Simd
                     level.sqsum.Recreate(scaledSize + Size(1, 1), View::Int32);
                     level.tilted.Recreate(scaledSize + Size(1, 1), View::Int32);
 
-                    level.dst.Recreate(scaledSize, View::Gray8);
-
                     level.needSqsum = false, level.needTilted = false;
                     for (size_t i = 0; i < _data.size(); ++i)
                     {
                         if (!inserts[i])
                             continue;
                         Handle handle = ::SimdDetectionInit(_data[i].handle, level.sum.data, level.sum.stride, level.sum.width, level.sum.height,
-                            level.sqsum.data, level.sqsum.stride, level.tilted.data, level.tilted.stride, level.throughColumn, _data[i].Int16());
+                            level.sqsum.data, level.sqsum.stride, level.tilted.data, level.tilted.stride, level.throughColumn, Int16(_data[i]));
                         if (handle)
                         {
                             Hid hid;
                             hid.handle = handle;
                             hid.data = &_data[i];
                             if (_data[i].Haar())
-                                hid.detect = level.throughColumn ? ::SimdDetectionHaarDetect32fi : ::SimdDetectionHaarDetect32fp;
+                            {
+                                if (Int16(_data[i]))
+                                    hid.detect = level.throughColumn ? ::SimdDetectionHaarDetect16ii : ::SimdDetectionHaarDetect16ip;
+                                else
+                                    hid.detect = level.throughColumn ? ::SimdDetectionHaarDetect32fi : ::SimdDetectionHaarDetect32fp;
+                            }
                             else
                             {
-                                if (_data[i].Int16())
+                                if (Int16(_data[i]))
                                     hid.detect = level.throughColumn ? ::SimdDetectionLbpDetect16ii : ::SimdDetectionLbpDetect16ip;
                                 else
                                     hid.detect = level.throughColumn ? ::SimdDetectionLbpDetect32fi : ::SimdDetectionLbpDetect32fp;
@@ -467,6 +552,8 @@ namespace Simd
                         level.needTilted = level.needTilted | _data[i].Tilted();
                         _needNormalization = _needNormalization | _data[i].Haar();
                     }
+                    for (size_t i = 0; i < level.hids.size(); ++i)
+                        level.hids[i].dst.Recreate(scaledSize, View::Gray8);
 
                     level.rect = Rect(level.roi.Size());
                     if (roi.format == View::None)
@@ -496,36 +583,132 @@ namespace Simd
             Simd::ResizeBilinear(src, _levels[0]->src);
             if (_needNormalization)
                 Simd::NormalizeHistogram(_levels[0]->src, _levels[0]->src);
-            EstimateIntegral(*_levels[0]);
-            for (size_t i = 1; i < _levels.size(); ++i)
+        }
+
+        void FillLevel(Level & level)
+        {
+            SIMD_CHECK_PERFORMANCE();
+
+            typedef std::pair<ptrdiff_t, ptrdiff_t> Band;
+            std::vector<Band> bands;
+            for (size_t i = 0; i < level.detectRects.size(); ++i)
+            {
+                ptrdiff_t top = level.src.height, bottom = 0;
+                for (size_t j = 0; j < level.hids.size(); ++j)
+                {
+                    Rect r = level.hids[j].Region(level.detectRects[i]);
+                    if (r.Empty())
+                        continue;
+                    top = std::min(top, r.top);
+                    bottom = std::max(bottom, r.bottom + level.hids[j].data->size.y);
+                }
+                bottom = std::min<ptrdiff_t>(bottom, level.src.height);
+                if (level.needTilted)
+                    top = 0;
+                if (top < bottom)
+                    bands.push_back(Band(top, bottom));
+            }
+            std::sort(bands.begin(), bands.end());
+
+            for (size_t i = 0; i < bands.size();)
             {
-                Simd::ResizeBilinear(_levels[0]->src, _levels[i]->src);
-                EstimateIntegral(*_levels[i]);
+                ptrdiff_t top = bands[i].first, bottom = bands[i].second;
+                for (++i; i < bands.size() && bands[i].first <= bottom; ++i)
+                    bottom = std::max(bottom, bands[i].second);
+                if (&level != _levels[0].get())
+                    Simd::ResizeBilinearRows(_levels[0]->src, level.src, top, bottom);
+                EstimateIntegral(level, top, bottom);
             }
         }
 
-        void EstimateIntegral(Level & level)
+        void EstimateIntegral(Level & level, ptrdiff_t top, ptrdiff_t bottom)
         {
+            const ptrdiff_t width = level.src.width;
+            View src = level.src.Region(0, top, width, bottom);
+            View sum = level.sum.Region(0, top, width + 1, bottom + 1);
             if (level.needSqsum)
             {
+                View sqsum = level.sqsum.Region(0, top, width + 1, bottom + 1);
                 if (level.needTilted)
-                    Simd::Integral(level.src, level.sum, level.sqsum, level.tilted);
+                {
+                    View tilted = level.tilted.Region(0, top, width + 1, bottom + 1);
+                    Simd::Integral(src, sum, sqsum, tilted);
+                }
                 else
-                    Simd::Integral(level.src, level.sum, level.sqsum);
+                    Simd::Integral(src, sum, sqsum);
             }
             else
-                Simd::Integral(level.src, level.sum);
+                Simd::Integral(src, sum);
+        }
+
+        struct Task
+        {
+            size_t level;
+            Hid * hid;
+            Rect region;
+
+            Task(size_t l, Hid * h, const Rect & r)
+                : level(l)
+                , hid(h)
+                , region(r)
+            {
+            }
+        };
+        typedef std::vector<Task> Tasks;
+
+        void CreateTasks(const std::vector<size_t> & active, Tasks & tasks)
+        {
+            ptrdiff_t total = 0;
+            for (size_t i = 0; i < active.size(); ++i)
+            {
+                Level & level = *_levels[active[i]];
+                for (size_t j = 0; j < level.hids.size(); ++j)
+                    total += level.hids[j].Region(level.detectRect).Area();
+            }
+            ptrdiff_t portion = std::max<ptrdiff_t>(total / (_threadNumber * 4), 1);
+
+            for (size_t i = 0; i < active.size(); ++i)
+            {
+                Level & level = *_levels[active[i]];
+                ptrdiff_t step = level.throughColumn ? 2 : 1;
+                for (size_t j = 0; j < level.hids.size(); ++j)
+                {
+                    Hid & hid = level.hids[j];
+                    Rect region = hid.Region(level.detectRect);
+                    if (region.Empty())
+                        continue;
+                    ptrdiff_t rows = (portion / region.Width() + step - 1) / step * step;
+                    rows = std::max(rows, step);
+                    for (ptrdiff_t top = region.top; top < region.bottom; top += rows)
+                        tasks.push_back(Task(active[i], &hid, Rect(region.left, top, region.right, std::min(top + rows, region.bottom))));
+                }
+            }
         }
 
-        void FillMotionMask(const Rects & rects, Level & level, Rect & rect) const
+        template<class Function> void Execute(size_t count, const Function & function)
+        {
+            size_t threadNumber = std::min<size_t>(_threadNumber, count);
+            std::atomic<size_t> next(0);
+            Parallel(0, threadNumber, [&](size_t thread, size_t begin, size_t end)
+            {
+                for (size_t i = next++; i < count; i = next++)
+                    function(i);
+            }, threadNumber);
+        }
+
+        void FillMotionMask(const Rects & rects, Level & level, Rect & rect, Rects & parts) const
         {
             Simd::Fill(level.mask, 0);
             rect = Rect();
+            parts.clear();
             for (size_t i = 0; i < rects.size(); i++)
             {
                 Rect r = rects[i] / level.scale;
                 rect |= r;
                 Simd::Fill(level.mask.Region(r).Ref(), 0xFF);
+                r &= level.rect;
+                if (!r.Empty())
+                    parts.push_back(r);
             }
             rect &= level.rect;
             Simd::OperationBinary8u(level.mask, level.roi, level.mask, SimdOperationBinary8uAnd);
@@ -566,78 +749,53 @@ namespace Simd
             double _sizeDifferenceMax;
         };
 
+        static int FindRoot(std::vector<int> & parents, int i)
+        {
+            while (parents[i] != i)
+            {
+                parents[i] = parents[parents[i]];
+                i = parents[i];
+            }
+            return i;
+        }
+
         template<typename T> int Partition(const std::vector<T> & vec, std::vector<int> & labels, double sizeDifferenceMax)
         {
             Similar similar(sizeDifferenceMax);
-            int i, j, N = (int)vec.size();
-            const int PARENT = 0;
-            const int RANK = 1;
+            int N = (int)vec.size();
 
-            std::vector<int> _nodes(N * 2);
-            int(*nodes)[2] = (int(*)[2])&_nodes[0];
+            std::vector<int> order(N), parents(N), ranks(N, 0);
+            for (int i = 0; i < N; i++)
+                order[i] = parents[i] = i;
+            std::sort(order.begin(), order.end(), [&vec](int a, int b) { return vec[a].rect.left < vec[b].rect.left; });
 
-            for (i = 0; i < N; i++)
+            for (int a = 0; a < N; a++)
             {
-                nodes[i][PARENT] = -1;
-                nodes[i][RANK] = 0;
-            }
-
-            for (i = 0; i < N; i++)
-            {
-                int root = i;
-                while (nodes[root][PARENT] >= 0)
-                    root = nodes[root][PARENT];
-
-                for (j = 0; j < N; j++)
+                const T & o1 = vec[order[a]];
+                double range = sizeDifferenceMax*(o1.rect.Width() + o1.rect.Height())*0.5;
+                for (int b = a + 1; b < N && vec[order[b]].rect.left - o1.rect.left <= range; b++)
                 {
-                    if (i == j || !similar(vec[i], vec[j]))
+                    if (!similar(o1, vec[order[b]]))
                         continue;
-                    int root2 = j;
-
-                    while (nodes[root2][PARENT] >= 0)
-                        root2 = nodes[root2][PARENT];
-
-                    if (root2 != root)
-                    {
-                        int rank = nodes[root][RANK], rank2 = nodes[root2][RANK];
-                        if (rank > rank2)
-                            nodes[root2][PARENT] = root;
-                        else
-                        {
-                            nodes[root][PARENT] = root2;
-                            nodes[root2][RANK] += rank == rank2;
-                            root = root2;
-                        }
-                        assert(nodes[root][PARENT] < 0);
-
-                        int k = j, parent;
-                        while ((parent = nodes[k][PARENT]) >= 0)
-                        {
-                            nodes[k][PARENT] = root;
-                            k = parent;
-                        }
-
-                        k = i;
-                        while ((parent = nodes[k][PARENT]) >= 0)
-                        {
-                            nodes[k][PARENT] = root;
-                            k = parent;
-                        }
-                    }
+                    int root1 = FindRoot(parents, order[a]), root2 = FindRoot(parents, order[b]);
+                    if (root1 == root2)
+                        continue;
+                    if (ranks[root1] < ranks[root2])
+                        std::swap(root1, root2);
+                    parents[root2] = root1;
+                    ranks[root1] += ranks[root1] == ranks[root2];
                 }
             }
 
             labels.resize(N);
             int nclasses = 0;
-
-            for (i = 0; i < N; i++)
+            std::vector<int> classes(N, -1);
+            for (int i = 0; i < N; i++)
             {
-                int root = i;
-                while (nodes[root][PARENT] >= 0)
-                    root = nodes[root][PARENT];
-                if (nodes[root][RANK] >= 0)
-                    nodes[root][RANK] = ~nclasses++;
-                labels[i] = ~nodes[root][RANK];
+                int root = FindRoot(parents, i);
+                if (classes[root] < 0)
+                    classes[root] = nclasses++;
+                labels[i] = classes[root];
             }
 
             return nclasses;
@@ -661,30 +819,34 @@ namespace Simd
                 buffer[cls].tag = src[i].tag;
             }
 
+            size_t groups = 0;
             for (size_t i = 0; i < buffer.size(); i++)
+            {
+                if (buffer[i].weight < (int)groupSizeMin)
+                    continue;
                 buffer[i].rect = buffer[i].rect / double(buffer[i].weight);
+                buffer[groups++] = buffer[i];
+            }
+            buffer.resize(groups);
 
             for (size_t i = 0; i < buffer.size(); i++)
             {
                 Rect r1 = buffer[i].rect;
                 int n1 = buffer[i].weight;
-                if (n1 < (int)groupSizeMin)
-                    continue;
 
                 size_t j;
                 for (j = 0; j < buffer.size(); j++)
                 {
-                    int n2 = buffer[j].weight;
-
-                    if (j == i || n2 < (int)groupSizeMin)
+                    if (j == i)
                         continue;
 
+                    int n2 = buffer[j].weight;
                     Rect r2 = buffer[j].rect;
 
                     int dx = Simd::Round(r2.Width() * sizeDifferenceMax);
                     int dy = Simd::Round(r2.Height() * sizeDifferenceMax);
 
-                    if (i != j && (n2 > std::max(3, n1) || n1 < 3) &&
+                    if ((n2 > std::max(3, n1) || n1 < 3) &&
                         r1.left >= r2.left - dx && r1.top >= r2.top - dy &&
                         r1.right <= r2.right + dx && r1.bottom <= r2.bottom + dy)
                         break;
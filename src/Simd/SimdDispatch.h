@@ -0,0 +1,208 @@
+/*
+* Simd Library (http://ermig1979.github.io/Simd).
+*
+* Copyright (c) 2011-2017 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#ifndef __SimdDispatch_h__
+#define __SimdDispatch_h__
+
+#include "Simd/SimdLib.h"
+
+#include <vector>
+#include <atomic>
+#include <mutex>
+#include <memory>
+#include <initializer_list>
+
+namespace Simd
+{
+    class Dispatcher
+    {
+    public:
+        Dispatcher(const char * name)
+            : _name(name)
+        {
+            Registry().push_back(this);
+        }
+
+        virtual ~Dispatcher()
+        {
+        }
+
+        const char * Name() const
+        {
+            return _name;
+        }
+
+        virtual int Info() const = 0;
+
+        virtual void SetMask(int mask) = 0;
+
+        static std::vector<Dispatcher*> & Registry()
+        {
+            static std::vector<Dispatcher*> registry;
+            return registry;
+        }
+
+        static std::mutex & Mutex()
+        {
+            static std::mutex mutex;
+            return mutex;
+        }
+
+    private:
+        const char * _name;
+    };
+
+    template<class Func> class Dispatch : public Dispatcher
+    {
+    public:
+        struct Candidate
+        {
+            SimdCpuInfoFlags isa;
+            bool enable;
+            size_t width;
+            Func func;
+        };
+
+        Dispatch(const char * name, Func base, std::initializer_list<Candidate> candidates)
+            : Dispatcher(name)
+            , _base(base)
+            , _candidates(candidates)
+            , _table(NULL)
+        {
+            SetMask(-1);
+        }
+
+        virtual int Info() const
+        {
+            return _table.load(std::memory_order_acquire)->info;
+        }
+
+        virtual void SetMask(int mask)
+        {
+            for (size_t i = 0; i < _tables.size(); ++i)
+            {
+                if (_tables[i]->mask == mask)
+                {
+                    _table.store(_tables[i].get(), std::memory_order_release);
+                    return;
+                }
+            }
+            Table * table = new Table();
+            table->mask = mask;
+            table->info = 0;
+            for (size_t i = 0; i < _candidates.size(); ++i)
+            {
+                const Candidate & candidate = _candidates[i];
+                if (candidate.enable && (mask & (1 << candidate.isa)))
+                {
+                    if (table->entries.empty())
+                        table->info = 1 << candidate.isa;
+                    table->entries.push_back(Entry(candidate.width, candidate.func));
+                    if (candidate.width == 0)
+                        break;
+                }
+            }
+            if (table->entries.empty() || table->entries.back().width)
+                table->entries.push_back(Entry(0, _base));
+            _tables.push_back(std::unique_ptr<Table>(table));
+            _table.store(table, std::memory_order_release);
+        }
+
+        SIMD_INLINE Func operator() (size_t width) const
+        {
+            const Entry * entry = _table.load(std::memory_order_acquire)->entries.data();
+            while (width < entry->width)
+                entry++;
+            return entry->func;
+        }
+
+    private:
+        struct Entry
+        {
+            size_t width;
+            Func func;
+            Entry(size_t w, Func f) : width(w), func(f) {}
+        };
+
+        struct Table
+        {
+            int mask, info;
+            std::vector<Entry> entries;
+        };
+
+        Func _base;
+        std::vector<Candidate> _candidates;
+        std::vector<std::unique_ptr<Table>> _tables;
+        std::atomic<const Table*> _table;
+    };
+}
+
+#ifdef SIMD_SSE42_ENABLE
+#define SIMD_SSE42_DISPATCH(func, width) { SimdCpuInfoSse42, Simd::Sse42::Enable, width, Simd::Sse42::func },
+#else
+#define SIMD_SSE42_DISPATCH(func, width)
+#endif
+
+#ifdef SIMD_SSE41_ENABLE
+#define SIMD_SSE41_DISPATCH(func, width) { SimdCpuInfoSse41, Simd::Sse41::Enable, width, Simd::Sse41::func },
+#else
+#define SIMD_SSE41_DISPATCH(func, width)
+#endif
+
+#ifdef SIMD_SSSE3_ENABLE
+#define SIMD_SSSE3_DISPATCH(func, width) { SimdCpuInfoSsse3, Simd::Ssse3::Enable, width, Simd::Ssse3::func },
+#else
+#define SIMD_SSSE3_DISPATCH(func, width)
+#endif
+
+#ifdef SIMD_SSE2_ENABLE
+#define SIMD_SSE2_DISPATCH(func, width) { SimdCpuInfoSse2, Simd::Sse2::Enable, width, Simd::Sse2::func },
+#else
+#define SIMD_SSE2_DISPATCH(func, width)
+#endif
+
+#ifdef SIMD_AVX2_ENABLE
+#define SIMD_AVX2_DISPATCH(func, width) { SimdCpuInfoAvx2, Simd::Avx2::Enable, width, Simd::Avx2::func },
+#else
+#define SIMD_AVX2_DISPATCH(func, width)
+#endif
+
+#ifdef SIMD_AVX512BW_ENABLE
+#define SIMD_AVX512BW_DISPATCH(func, width) { SimdCpuInfoAvx512bw, Simd::Avx512bw::Enable, width, Simd::Avx512bw::func },
+#else
+#define SIMD_AVX512BW_DISPATCH(func, width)
+#endif
+
+#ifdef SIMD_VMX_ENABLE
+#define SIMD_VMX_DISPATCH(func, width) { SimdCpuInfoVmx, Simd::Vmx::Enable, width, Simd::Vmx::func },
+#else
+#define SIMD_VMX_DISPATCH(func, width)
+#endif
+
+#ifdef SIMD_NEON_ENABLE
+#define SIMD_NEON_DISPATCH(func, width) { SimdCpuInfoNeon, Simd::Neon::Enable, width, Simd::Neon::func },
+#else
+#define SIMD_NEON_DISPATCH(func, width)
+#endif
+
+#endif//__SimdDispatch_h__
@@ -661,19 +661,11 @@ namespace Simd
                 DeinterleaveUv(src.planes[1], dst.planes[1], dst.planes[2]);
                 break;
             case Frame<A>::Bgra32:
-            {
-                View<A> u(src.Size(), View<A>::Gray8), v(src.Size(), View<A>::Gray8);
-                DeinterleaveUv(src.planes[1], u, v);
-                Yuv420pToBgra(src.planes[0], u, v, dst.planes[0]);
+                Nv12ToBgra(src.planes[0], src.planes[1], dst.planes[0]);
                 break;
-            }
             case Frame<A>::Bgr24:
-            {
-                View<A> u(src.Size(), View<A>::Gray8), v(src.Size(), View<A>::Gray8);
-                DeinterleaveUv(src.planes[1], u, v);
-                Yuv420pToBgr(src.planes[0], u, v, dst.planes[0]);
+                Nv12ToBgr(src.planes[0], src.planes[1], dst.planes[0]);
                 break;
-            }
             case Frame<A>::Gray8:
                 Copy(src.planes[0], dst.planes[0]);
                 break;
@@ -68,8 +68,104 @@ BOOL APIENTRY DllMain(HMODULE hModule, DWORD dwReasonForCall, LPVOID lpReserved)
 #include "Simd/SimdNeon.h"
 #include "Simd/SimdMsa.h"
 
+#include "Simd/SimdParallel.hpp"
+#include "Simd/SimdDispatch.h"
+
 using namespace Simd;
 
+namespace
+{
+    std::atomic<size_t> g_threadNumber(1);
+    thread_local size_t g_localThreadNumber = 0;
+
+    SIMD_INLINE size_t ThreadNumber()
+    {
+        return g_localThreadNumber ? g_localThreadNumber : g_threadNumber.load();
+    }
+
+    const size_t PARALLEL_ROWS_AREA_MIN = 0x10000;
+    const size_t PARALLEL_ROWS_BAND_MIN = 16;
+
+    template<class Function> void ParallelRows(size_t width, size_t height, size_t step, const Function & function)
+    {
+        size_t count = std::min<size_t>(ThreadNumber(), height / PARALLEL_ROWS_BAND_MIN);
+        if (count <= 1 || width*height < PARALLEL_ROWS_AREA_MIN)
+            function(0, height);
+        else
+        {
+            Simd::Detail::ParallelExecute(count, [&](size_t index)
+            {
+                size_t begin = AlignLo(height*index / count, step);
+                size_t end = index + 1 == count ? height : AlignLo(height*(index + 1) / count, step);
+                if (begin < end)
+                    function(begin, end);
+            });
+        }
+    }
+
+    const size_t PARALLEL_TILE_SIZE = 0x40000;
+
+    template<class Function> void ParallelTiles(size_t width, size_t height, size_t planeCount, const Function & function)
+    {
+        size_t tile = std::max<size_t>(PARALLEL_TILE_SIZE / (width*planeCount), 1);
+        size_t tileCount = (height + tile - 1) / tile;
+        size_t count = std::min<size_t>(ThreadNumber(), tileCount);
+        if (count <= 1 || width*height < PARALLEL_ROWS_AREA_MIN)
+            function(0, height);
+        else
+        {
+            std::atomic<size_t> next(0);
+            Simd::Detail::ParallelExecute(count, [&](size_t)
+            {
+                for (size_t index = next++; index < tileCount; index = next++)
+                {
+                    size_t begin = index*tile;
+                    function(begin, std::min(begin + tile, height));
+                }
+            });
+        }
+    }
+
+    template<class Kernel> void ParallelFilter(const uint8_t * src, size_t srcStride, size_t width, size_t height, size_t halo,
+        size_t rowSize, uint8_t * dst, size_t dstStride, const Kernel & kernel)
+    {
+        ParallelRows(width, height, 1, [&](size_t begin, size_t end)
+        {
+            kernel(src + begin*srcStride, end - begin, dst + begin*dstStride, dstStride);
+            if (begin == 0 && end == height)
+                return;
+            size_t ranges[2][2], rangeCount = 0;
+            if (begin > 0)
+            {
+                ranges[rangeCount][0] = begin;
+                ranges[rangeCount++][1] = std::min(begin + halo, end);
+            }
+            if (end < height)
+            {
+                size_t first = std::max(begin + halo, end) - halo;
+                if (rangeCount && first <= ranges[0][1])
+                    ranges[0][1] = end;
+                else
+                {
+                    ranges[rangeCount][0] = first;
+                    ranges[rangeCount++][1] = end;
+                }
+            }
+            size_t bufferStride = AlignHi(rowSize, SIMD_ALIGN);
+            uint8_t * buffer = (uint8_t*)Allocate(4 * halo*bufferStride);
+            for (size_t r = 0; r < rangeCount; ++r)
+            {
+                size_t first = ranges[r][0], last = ranges[r][1];
+                size_t top = first > halo ? first - halo : 0, bottom = std::min(last + halo, height);
+                kernel(src + top*srcStride, bottom - top, buffer, bufferStride);
+                for (size_t row = first; row < last; ++row)
+                    memcpy(dst + row*dstStride, buffer + (row - top)*bufferStride, rowSize);
+            }
+            Free(buffer);
+        });
+    }
+}
+
 SIMD_API int SimdCpuInfo()
 {
     int info = 0;
@@ -118,6 +214,34 @@ SIMD_API int SimdCpuInfo()
     return info;
 }
 
+SIMD_API int SimdDispatchInfo(const char * name)
+{
+    std::lock_guard<std::mutex> lock(Dispatcher::Mutex());
+    const std::vector<Dispatcher*> & registry = Dispatcher::Registry();
+    for (size_t i = 0; i < registry.size(); ++i)
+    {
+        if (name && strcmp(registry[i]->Name(), name) == 0)
+            return registry[i]->Info();
+    }
+    return -1;
+}
+
+SIMD_API int SimdSetDispatchMask(const char * name, int mask)
+{
+    std::lock_guard<std::mutex> lock(Dispatcher::Mutex());
+    const std::vector<Dispatcher*> & registry = Dispatcher::Registry();
+    int count = 0;
+    for (size_t i = 0; i < registry.size(); ++i)
+    {
+        if (name == NULL || strcmp(registry[i]->Name(), name) == 0)
+        {
+            registry[i]->SetMask(mask);
+            count++;
+        }
+    }
+    return count;
+}
+
 SIMD_API const char * SimdVersion()
 {
     return SIMD_VERSION;
@@ -143,76 +267,61 @@ SIMD_API size_t SimdAlignment()
     return Simd::ALIGNMENT;
 }
 
+SIMD_API void SimdSetThreadNumber(size_t threadNumber)
+{
+    g_threadNumber = std::max<size_t>(threadNumber, 1);
+}
+
+SIMD_API size_t SimdGetThreadNumber()
+{
+    return g_threadNumber;
+}
+
+SIMD_API size_t SimdSetLocalThreadNumber(size_t threadNumber)
+{
+    size_t previous = g_localThreadNumber;
+    g_localThreadNumber = threadNumber;
+    return previous;
+}
+
+static Dispatch<decltype(&Base::Crc32c)> g_crc32c("SimdCrc32c", Base::Crc32c,
+{
+    SIMD_SSE42_DISPATCH(Crc32c, 0)
+});
+
 SIMD_API uint32_t SimdCrc32c(const void * src, size_t size)
 {
-#ifdef SIMD_SSE42_ENABLE
-    if(Sse42::Enable)
-        return Sse42::Crc32c(src, size);
-    else
-#endif
-        return Base::Crc32c(src, size);
+    return g_crc32c(0)(src, size);
 }
 
+static Dispatch<decltype(&Base::AbsDifferenceSum)> g_absDifferenceSum("SimdAbsDifferenceSum", Base::AbsDifferenceSum,
+{
+    SIMD_AVX512BW_DISPATCH(AbsDifferenceSum, 0)
+    SIMD_AVX2_DISPATCH(AbsDifferenceSum, Avx2::A)
+    SIMD_SSE2_DISPATCH(AbsDifferenceSum, Sse2::A)
+    SIMD_VMX_DISPATCH(AbsDifferenceSum, Vmx::A)
+    SIMD_NEON_DISPATCH(AbsDifferenceSum, Neon::A)
+});
+
 SIMD_API void SimdAbsDifferenceSum(const uint8_t *a, size_t aStride, const uint8_t * b, size_t bStride,
                                    size_t width, size_t height, uint64_t * sum)
 {
-#ifdef SIMD_AVX512BW_ENABLE
-    if (Avx512bw::Enable)
-        Avx512bw::AbsDifferenceSum(a, aStride, b, bStride, width, height, sum);
-    else
-#endif
-#ifdef SIMD_AVX2_ENABLE
-    if(Avx2::Enable && width >= Avx2::A)
-        Avx2::AbsDifferenceSum(a, aStride, b, bStride, width, height, sum);
-    else
-#endif
-#ifdef SIMD_SSE2_ENABLE
-    if(Sse2::Enable && width >= Sse2::A)
-        Sse2::AbsDifferenceSum(a, aStride, b, bStride, width, height, sum);
-    else
-#endif
-#ifdef SIMD_VMX_ENABLE
-    if(Vmx::Enable && width >= Vmx::A)
-        Vmx::AbsDifferenceSum(a, aStride, b, bStride, width, height, sum);
-    else
-#endif
-#ifdef SIMD_NEON_ENABLE
-    if (Neon::Enable && width >= Neon::A)
-        Neon::AbsDifferenceSum(a, aStride, b, bStride, width, height, sum);
-    else
-#endif
-        Base::AbsDifferenceSum(a, aStride, b, bStride, width, height, sum);
+    g_absDifferenceSum(width)(a, aStride, b, bStride, width, height, sum);
 }
 
+static Dispatch<decltype(&Base::AbsDifferenceSumMasked)> g_absDifferenceSumMasked("SimdAbsDifferenceSumMasked", Base::AbsDifferenceSumMasked,
+{
+    SIMD_AVX512BW_DISPATCH(AbsDifferenceSumMasked, 0)
+    SIMD_AVX2_DISPATCH(AbsDifferenceSumMasked, Avx2::A)
+    SIMD_SSE2_DISPATCH(AbsDifferenceSumMasked, Sse2::A)
+    SIMD_VMX_DISPATCH(AbsDifferenceSumMasked, Vmx::A)
+    SIMD_NEON_DISPATCH(AbsDifferenceSumMasked, Neon::A)
+});
+
 SIMD_API void SimdAbsDifferenceSumMasked(const uint8_t *a, size_t aStride, const uint8_t *b, size_t bStride,
                                          const uint8_t *mask, size_t maskStride, uint8_t index, size_t width, size_t height, uint64_t * sum)
 {
-#ifdef SIMD_AVX512BW_ENABLE
-    if (Avx512bw::Enable)
-        Avx512bw::AbsDifferenceSumMasked(a, aStride, b, bStride, mask, maskStride, index, width, height, sum);
-    else
-#endif
-#ifdef SIMD_AVX2_ENABLE
-    if(Avx2::Enable && width >= Avx2::A)
-        Avx2::AbsDifferenceSumMasked(a, aStride, b, bStride, mask, maskStride, index, width, height, sum);
-    else
-#endif
-#ifdef SIMD_SSE2_ENABLE
-    if(Sse2::Enable && width >= Sse2::A)
-        Sse2::AbsDifferenceSumMasked(a, aStride, b, bStride, mask, maskStride, index, width, height, sum);
-    else
-#endif
-#ifdef SIMD_VMX_ENABLE
-    if(Vmx::Enable && width >= Vmx::A)
-        Vmx::AbsDifferenceSumMasked(a, aStride, b, bStride, mask, maskStride, index, width, height, sum);
-    else
-#endif
-#ifdef SIMD_NEON_ENABLE
-    if (Neon::Enable && width >= Neon::A)
-        Neon::AbsDifferenceSumMasked(a, aStride, b, bStride, mask, maskStride, index, width, height, sum);
-    else
-#endif
-        Base::AbsDifferenceSumMasked(a, aStride, b, bStride, mask, maskStride, index, width, height, sum);
+    g_absDifferenceSumMasked(width)(a, aStride, b, bStride, mask, maskStride, index, width, height, sum);
 }
 
 SIMD_API void SimdAbsDifferenceSums3x3(const uint8_t *current, size_t currentStride, const uint8_t * background, size_t backgroundStride,
@@ -280,32 +389,36 @@ SIMD_API void SimdAbsDifferenceSums3x3Masked(const uint8_t *current, size_t curr
 SIMD_API void SimdAbsGradientSaturatedSum(const uint8_t * src, size_t srcStride, size_t width, size_t height,
                                           uint8_t * dst, size_t dstStride)
 {
+    auto kernel = [=](const uint8_t * src, size_t height, uint8_t * dst, size_t dstStride)
+    {
 #ifdef SIMD_AVX512BW_ENABLE
-    if (Avx512bw::Enable)
-        Simd::Avx512bw::AbsGradientSaturatedSum(src, srcStride, width, height, dst, dstStride);
-    else
+        if (Avx512bw::Enable)
+            Simd::Avx512bw::AbsGradientSaturatedSum(src, srcStride, width, height, dst, dstStride);
+        else
 #endif
 #ifdef SIMD_AVX2_ENABLE
-    if(Avx2::Enable && width >= Avx2::A)
-        Simd::Avx2::AbsGradientSaturatedSum(src, srcStride, width, height, dst, dstStride);
-    else
+        if(Avx2::Enable && width >= Avx2::A)
+            Simd::Avx2::AbsGradientSaturatedSum(src, srcStride, width, height, dst, dstStride);
+        else
 #endif
 #ifdef SIMD_SSE2_ENABLE
-    if(Sse2::Enable && width >= Sse2::A)
-        Sse2::AbsGradientSaturatedSum(src, srcStride, width, height, dst, dstStride);
-    else
+        if(Sse2::Enable && width >= Sse2::A)
+            Sse2::AbsGradientSaturatedSum(src, srcStride, width, height, dst, dstStride);
+        else
 #endif
 #ifdef SIMD_VMX_ENABLE
-    if(Vmx::Enable && width >= Vmx::A)
-        Vmx::AbsGradientSaturatedSum(src, srcStride, width, height, dst, dstStride);
-    else
+        if(Vmx::Enable && width >= Vmx::A)
+            Vmx::AbsGradientSaturatedSum(src, srcStride, width, height, dst, dstStride);
+        else
 #endif
 #ifdef SIMD_NEON_ENABLE
-    if (Neon::Enable && width >= Neon::A)
-        Neon::AbsGradientSaturatedSum(src, srcStride, width, height, dst, dstStride);
-    else
+        if (Neon::Enable && width >= Neon::A)
+            Neon::AbsGradientSaturatedSum(src, srcStride, width, height, dst, dstStride);
+        else
 #endif
-        Base::AbsGradientSaturatedSum(src, srcStride, width, height, dst, dstStride);
+            Base::AbsGradientSaturatedSum(src, srcStride, width, height, dst, dstStride);
+    };
+    ParallelFilter(src, srcStride, width, height, 1, width, dst, dstStride, kernel);
 }
 
 SIMD_API void SimdAddFeatureDifference(const uint8_t * value, size_t valueStride, size_t width, size_t height,
@@ -379,264 +492,320 @@ SIMD_API void SimdAlphaBlending(const uint8_t *src, size_t srcStride, size_t wid
 SIMD_API void SimdBackgroundGrowRangeSlow(const uint8_t * value, size_t valueStride, size_t width, size_t height,
                                           uint8_t * lo, size_t loStride, uint8_t * hi, size_t hiStride)
 {
+    auto kernel = [=](const uint8_t * value, size_t height, uint8_t * lo, uint8_t * hi)
+    {
 #ifdef SIMD_AVX512BW_ENABLE
-    if (Avx512bw::Enable)
-        Avx512bw::BackgroundGrowRangeSlow(value, valueStride, width, height, lo, loStride, hi, hiStride);
-    else
+        if (Avx512bw::Enable)
+            Avx512bw::BackgroundGrowRangeSlow(value, valueStride, width, height, lo, loStride, hi, hiStride);
+        else
 #endif
 #ifdef SIMD_AVX2_ENABLE
-    if(Avx2::Enable && width >= Avx2::A)
-        Avx2::BackgroundGrowRangeSlow(value, valueStride, width, height, lo, loStride, hi, hiStride);
-    else
+        if(Avx2::Enable && width >= Avx2::A)
+            Avx2::BackgroundGrowRangeSlow(value, valueStride, width, height, lo, loStride, hi, hiStride);
+        else
 #endif
 #ifdef SIMD_SSE2_ENABLE
-    if(Sse2::Enable && width >= Sse2::A)
-        Sse2::BackgroundGrowRangeSlow(value, valueStride, width, height, lo, loStride, hi, hiStride);
-    else
+        if(Sse2::Enable && width >= Sse2::A)
+            Sse2::BackgroundGrowRangeSlow(value, valueStride, width, height, lo, loStride, hi, hiStride);
+        else
 #endif
 #ifdef SIMD_VMX_ENABLE
-    if(Vmx::Enable && width >= Vmx::A)
-        Vmx::BackgroundGrowRangeSlow(value, valueStride, width, height, lo, loStride, hi, hiStride);
-    else
+        if(Vmx::Enable && width >= Vmx::A)
+            Vmx::BackgroundGrowRangeSlow(value, valueStride, width, height, lo, loStride, hi, hiStride);
+        else
 #endif
 #ifdef SIMD_NEON_ENABLE
-    if (Neon::Enable && width >= Neon::A)
-        Neon::BackgroundGrowRangeSlow(value, valueStride, width, height, lo, loStride, hi, hiStride);
-    else
+        if (Neon::Enable && width >= Neon::A)
+            Neon::BackgroundGrowRangeSlow(value, valueStride, width, height, lo, loStride, hi, hiStride);
+        else
 #endif
-        Base::BackgroundGrowRangeSlow(value, valueStride, width, height, lo, loStride, hi, hiStride);
+            Base::BackgroundGrowRangeSlow(value, valueStride, width, height, lo, loStride, hi, hiStride);
+    };
+    ParallelTiles(width, height, 3, [&](size_t begin, size_t end)
+    {
+        kernel(value + begin*valueStride, end - begin, lo + begin*loStride, hi + begin*hiStride);
+    });
 }
 
 SIMD_API void SimdBackgroundGrowRangeFast(const uint8_t * value, size_t valueStride, size_t width, size_t height,
                                           uint8_t * lo, size_t loStride, uint8_t * hi, size_t hiStride)
 {
+    auto kernel = [=](const uint8_t * value, size_t height, uint8_t * lo, uint8_t * hi)
+    {
 #ifdef SIMD_AVX512BW_ENABLE
-    if (Avx512bw::Enable)
-        Avx512bw::BackgroundGrowRangeFast(value, valueStride, width, height, lo, loStride, hi, hiStride);
-    else
+        if (Avx512bw::Enable)
+            Avx512bw::BackgroundGrowRangeFast(value, valueStride, width, height, lo, loStride, hi, hiStride);
+        else
 #endif
 #ifdef SIMD_AVX2_ENABLE
-    if(Avx2::Enable && width >= Avx2::A)
-        Avx2::BackgroundGrowRangeFast(value, valueStride, width, height, lo, loStride, hi, hiStride);
-    else
+        if(Avx2::Enable && width >= Avx2::A)
+            Avx2::BackgroundGrowRangeFast(value, valueStride, width, height, lo, loStride, hi, hiStride);
+        else
 #endif
 #ifdef SIMD_SSE2_ENABLE
-    if(Sse2::Enable && width >= Sse2::A)
-        Sse2::BackgroundGrowRangeFast(value, valueStride, width, height, lo, loStride, hi, hiStride);
-    else
+        if(Sse2::Enable && width >= Sse2::A)
+            Sse2::BackgroundGrowRangeFast(value, valueStride, width, height, lo, loStride, hi, hiStride);
+        else
 #endif
 #ifdef SIMD_VMX_ENABLE
-    if(Vmx::Enable && width >= Vmx::A)
-        Vmx::BackgroundGrowRangeFast(value, valueStride, width, height, lo, loStride, hi, hiStride);
-    else
+        if(Vmx::Enable && width >= Vmx::A)
+            Vmx::BackgroundGrowRangeFast(value, valueStride, width, height, lo, loStride, hi, hiStride);
+        else
 #endif
 #ifdef SIMD_NEON_ENABLE
-    if (Neon::Enable && width >= Neon::A)
-        Neon::BackgroundGrowRangeFast(value, valueStride, width, height, lo, loStride, hi, hiStride);
-    else
+        if (Neon::Enable && width >= Neon::A)
+            Neon::BackgroundGrowRangeFast(value, valueStride, width, height, lo, loStride, hi, hiStride);
+        else
 #endif
-        Base::BackgroundGrowRangeFast(value, valueStride, width, height, lo, loStride, hi, hiStride);
+            Base::BackgroundGrowRangeFast(value, valueStride, width, height, lo, loStride, hi, hiStride);
+    };
+    ParallelTiles(width, height, 3, [&](size_t begin, size_t end)
+    {
+        kernel(value + begin*valueStride, end - begin, lo + begin*loStride, hi + begin*hiStride);
+    });
 }
 
 SIMD_API void SimdBackgroundIncrementCount(const uint8_t * value, size_t valueStride, size_t width, size_t height,
                                            const uint8_t * loValue, size_t loValueStride, const uint8_t * hiValue, size_t hiValueStride,
                                            uint8_t * loCount, size_t loCountStride, uint8_t * hiCount, size_t hiCountStride)
 {
+    auto kernel = [=](const uint8_t * value, size_t height, const uint8_t * loValue, const uint8_t * hiValue, uint8_t * loCount, uint8_t * hiCount)
+    {
 #ifdef SIMD_AVX512BW_ENABLE
-    if (Avx512bw::Enable)
-        Avx2::BackgroundIncrementCount(value, valueStride, width, height, loValue, loValueStride, hiValue, hiValueStride, loCount, loCountStride, hiCount, hiCountStride);
-    else
+        if (Avx512bw::Enable)
+            Avx2::BackgroundIncrementCount(value, valueStride, width, height, loValue, loValueStride, hiValue, hiValueStride, loCount, loCountStride, hiCount, hiCountStride);
+        else
 #endif
 #ifdef SIMD_AVX2_ENABLE
-    if(Avx2::Enable && width >= Avx2::A)
-        Avx2::BackgroundIncrementCount(value, valueStride, width, height, loValue, loValueStride, hiValue, hiValueStride, loCount, loCountStride, hiCount, hiCountStride);
-    else
+        if(Avx2::Enable && width >= Avx2::A)
+            Avx2::BackgroundIncrementCount(value, valueStride, width, height, loValue, loValueStride, hiValue, hiValueStride, loCount, loCountStride, hiCount, hiCountStride);
+        else
 #endif
 #ifdef SIMD_SSE2_ENABLE
-    if(Sse2::Enable && width >= Sse2::A)
-        Sse2::BackgroundIncrementCount(value, valueStride, width, height, loValue, loValueStride, hiValue, hiValueStride, loCount, loCountStride, hiCount, hiCountStride);
-    else
+        if(Sse2::Enable && width >= Sse2::A)
+            Sse2::BackgroundIncrementCount(value, valueStride, width, height, loValue, loValueStride, hiValue, hiValueStride, loCount, loCountStride, hiCount, hiCountStride);
+        else
 #endif
 #ifdef SIMD_VMX_ENABLE
-    if(Vmx::Enable && width >= Vmx::A)
-        Vmx::BackgroundIncrementCount(value, valueStride, width, height, loValue, loValueStride, hiValue, hiValueStride, loCount, loCountStride, hiCount, hiCountStride);
-    else
+        if(Vmx::Enable && width >= Vmx::A)
+            Vmx::BackgroundIncrementCount(value, valueStride, width, height, loValue, loValueStride, hiValue, hiValueStride, loCount, loCountStride, hiCount, hiCountStride);
+        else
 #endif
 #ifdef SIMD_NEON_ENABLE
-    if (Neon::Enable && width >= Neon::A)
-        Neon::BackgroundIncrementCount(value, valueStride, width, height, loValue, loValueStride, hiValue, hiValueStride, loCount, loCountStride, hiCount, hiCountStride);
-    else
+        if (Neon::Enable && width >= Neon::A)
+            Neon::BackgroundIncrementCount(value, valueStride, width, height, loValue, loValueStride, hiValue, hiValueStride, loCount, loCountStride, hiCount, hiCountStride);
+        else
 #endif
-        Base::BackgroundIncrementCount(value, valueStride, width, height, loValue, loValueStride, hiValue, hiValueStride, loCount, loCountStride, hiCount, hiCountStride);
+            Base::BackgroundIncrementCount(value, valueStride, width, height, loValue, loValueStride, hiValue, hiValueStride, loCount, loCountStride, hiCount, hiCountStride);
+    };
+    ParallelTiles(width, height, 5, [&](size_t begin, size_t end)
+    {
+        kernel(value + begin*valueStride, end - begin, loValue + begin*loValueStride, hiValue + begin*hiValueStride, loCount + begin*loCountStride, hiCount + begin*hiCountStride);
+    });
 }
 
 SIMD_API void SimdBackgroundAdjustRange(uint8_t * loCount, size_t loCountStride, size_t width, size_t height,
                                         uint8_t * loValue, size_t loValueStride, uint8_t * hiCount, size_t hiCountStride,
                                         uint8_t * hiValue, size_t hiValueStride, uint8_t threshold)
 {
+    auto kernel = [=](uint8_t * loCount, size_t height, uint8_t * loValue, uint8_t * hiCount, uint8_t * hiValue)
+    {
 #ifdef SIMD_AVX512BW_ENABLE
-    if (Avx512bw::Enable)
-        Avx512bw::BackgroundAdjustRange(loCount, loCountStride, width, height, loValue, loValueStride,
-            hiCount, hiCountStride, hiValue, hiValueStride, threshold);
-    else
+        if (Avx512bw::Enable)
+            Avx512bw::BackgroundAdjustRange(loCount, loCountStride, width, height, loValue, loValueStride,
+                hiCount, hiCountStride, hiValue, hiValueStride, threshold);
+        else
 #endif
 #ifdef SIMD_AVX2_ENABLE
-    if(Avx2::Enable && width >= Avx2::A)
-        Avx2::BackgroundAdjustRange(loCount, loCountStride, width, height, loValue, loValueStride,
-        hiCount, hiCountStride, hiValue, hiValueStride, threshold);
-    else
+        if(Avx2::Enable && width >= Avx2::A)
+            Avx2::BackgroundAdjustRange(loCount, loCountStride, width, height, loValue, loValueStride,
+            hiCount, hiCountStride, hiValue, hiValueStride, threshold);
+        else
 #endif
 #ifdef SIMD_SSE2_ENABLE
-    if(Sse2::Enable && width >= Sse2::A)
-        Sse2::BackgroundAdjustRange(loCount, loCountStride, width, height, loValue, loValueStride,
-        hiCount, hiCountStride, hiValue, hiValueStride, threshold);
-    else
+        if(Sse2::Enable && width >= Sse2::A)
+            Sse2::BackgroundAdjustRange(loCount, loCountStride, width, height, loValue, loValueStride,
+            hiCount, hiCountStride, hiValue, hiValueStride, threshold);
+        else
 #endif
 #ifdef SIMD_VMX_ENABLE
-    if(Vmx::Enable && width >= Vmx::A)
-        Vmx::BackgroundAdjustRange(loCount, loCountStride, width, height, loValue, loValueStride,
-        hiCount, hiCountStride, hiValue, hiValueStride, threshold);
-    else
+        if(Vmx::Enable && width >= Vmx::A)
+            Vmx::BackgroundAdjustRange(loCount, loCountStride, width, height, loValue, loValueStride,
+            hiCount, hiCountStride, hiValue, hiValueStride, threshold);
+        else
 #endif
 #ifdef SIMD_NEON_ENABLE
-    if (Neon::Enable && width >= Neon::A)
-        Neon::BackgroundAdjustRange(loCount, loCountStride, width, height, loValue, loValueStride,
-            hiCount, hiCountStride, hiValue, hiValueStride, threshold);
-    else
+        if (Neon::Enable && width >= Neon::A)
+            Neon::BackgroundAdjustRange(loCount, loCountStride, width, height, loValue, loValueStride,
+                hiCount, hiCountStride, hiValue, hiValueStride, threshold);
+        else
 #endif
-        Base::BackgroundAdjustRange(loCount, loCountStride, width, height, loValue, loValueStride,
-        hiCount, hiCountStride, hiValue, hiValueStride, threshold);
+            Base::BackgroundAdjustRange(loCount, loCountStride, width, height, loValue, loValueStride,
+            hiCount, hiCountStride, hiValue, hiValueStride, threshold);
+    };
+    ParallelTiles(width, height, 4, [&](size_t begin, size_t end)
+    {
+        kernel(loCount + begin*loCountStride, end - begin, loValue + begin*loValueStride, hiCount + begin*hiCountStride, hiValue + begin*hiValueStride);
+    });
 }
 
 SIMD_API void SimdBackgroundAdjustRangeMasked(uint8_t * loCount, size_t loCountStride, size_t width, size_t height,
                                               uint8_t * loValue, size_t loValueStride, uint8_t * hiCount, size_t hiCountStride,
                                               uint8_t * hiValue, size_t hiValueStride, uint8_t threshold, const uint8_t * mask, size_t maskStride)
 {
+    auto kernel = [=](uint8_t * loCount, size_t height, uint8_t * loValue, uint8_t * hiCount, uint8_t * hiValue, const uint8_t * mask)
+    {
 #ifdef SIMD_AVX512BW_ENABLE
-    if (Avx512bw::Enable)
-        Avx512bw::BackgroundAdjustRangeMasked(loCount, loCountStride, width, height, loValue, loValueStride,
-        hiCount, hiCountStride, hiValue, hiValueStride, threshold, mask, maskStride);
-    else
+        if (Avx512bw::Enable)
+            Avx512bw::BackgroundAdjustRangeMasked(loCount, loCountStride, width, height, loValue, loValueStride,
+            hiCount, hiCountStride, hiValue, hiValueStride, threshold, mask, maskStride);
+        else
 #endif
 #ifdef SIMD_AVX2_ENABLE
-    if(Avx2::Enable && width >= Avx2::A)
-        Avx2::BackgroundAdjustRangeMasked(loCount, loCountStride, width, height, loValue, loValueStride,
-        hiCount, hiCountStride,hiValue, hiValueStride, threshold, mask, maskStride);
-    else
+        if(Avx2::Enable && width >= Avx2::A)
+            Avx2::BackgroundAdjustRangeMasked(loCount, loCountStride, width, height, loValue, loValueStride,
+            hiCount, hiCountStride,hiValue, hiValueStride, threshold, mask, maskStride);
+        else
 #endif
 #ifdef SIMD_SSE2_ENABLE
-    if(Sse2::Enable && width >= Sse2::A)
-        Sse2::BackgroundAdjustRangeMasked(loCount, loCountStride, width, height, loValue, loValueStride,
-        hiCount, hiCountStride,hiValue, hiValueStride, threshold, mask, maskStride);
-    else
+        if(Sse2::Enable && width >= Sse2::A)
+            Sse2::BackgroundAdjustRangeMasked(loCount, loCountStride, width, height, loValue, loValueStride,
+            hiCount, hiCountStride,hiValue, hiValueStride, threshold, mask, maskStride);
+        else
 #endif
 #ifdef SIMD_VMX_ENABLE
-    if(Vmx::Enable && width >= Vmx::A)
-        Vmx::BackgroundAdjustRangeMasked(loCount, loCountStride, width, height, loValue, loValueStride,
-        hiCount, hiCountStride,hiValue, hiValueStride, threshold, mask, maskStride);
-    else
+        if(Vmx::Enable && width >= Vmx::A)
+            Vmx::BackgroundAdjustRangeMasked(loCount, loCountStride, width, height, loValue, loValueStride,
+            hiCount, hiCountStride,hiValue, hiValueStride, threshold, mask, maskStride);
+        else
 #endif
 #ifdef SIMD_NEON_ENABLE
-    if (Neon::Enable && width >= Neon::A)
-        Neon::BackgroundAdjustRangeMasked(loCount, loCountStride, width, height, loValue, loValueStride,
-            hiCount, hiCountStride, hiValue, hiValueStride, threshold, mask, maskStride);
-    else
+        if (Neon::Enable && width >= Neon::A)
+            Neon::BackgroundAdjustRangeMasked(loCount, loCountStride, width, height, loValue, loValueStride,
+                hiCount, hiCountStride, hiValue, hiValueStride, threshold, mask, maskStride);
+        else
 #endif
-        Base::BackgroundAdjustRangeMasked(loCount, loCountStride, width, height, loValue, loValueStride,
-        hiCount, hiCountStride, hiValue, hiValueStride, threshold, mask, maskStride);
+            Base::BackgroundAdjustRangeMasked(loCount, loCountStride, width, height, loValue, loValueStride,
+            hiCount, hiCountStride, hiValue, hiValueStride, threshold, mask, maskStride);
+    };
+    ParallelTiles(width, height, 5, [&](size_t begin, size_t end)
+    {
+        kernel(loCount + begin*loCountStride, end - begin, loValue + begin*loValueStride, hiCount + begin*hiCountStride, hiValue + begin*hiValueStride, mask + begin*maskStride);
+    });
 }
 
 SIMD_API void SimdBackgroundShiftRange(const uint8_t * value, size_t valueStride, size_t width, size_t height,
                                        uint8_t * lo, size_t loStride, uint8_t * hi, size_t hiStride)
 {
+    auto kernel = [=](const uint8_t * value, size_t height, uint8_t * lo, uint8_t * hi)
+    {
 #ifdef SIMD_AVX512BW_ENABLE
-    if (Avx512bw::Enable)
-        Avx512bw::BackgroundShiftRange(value, valueStride, width, height, lo, loStride, hi, hiStride);
-    else
+        if (Avx512bw::Enable)
+            Avx512bw::BackgroundShiftRange(value, valueStride, width, height, lo, loStride, hi, hiStride);
+        else
 #endif
 #ifdef SIMD_AVX2_ENABLE
-    if(Avx2::Enable && width >= Avx2::A)
-        Avx2::BackgroundShiftRange(value, valueStride, width, height, lo, loStride, hi, hiStride);
-    else
+        if(Avx2::Enable && width >= Avx2::A)
+            Avx2::BackgroundShiftRange(value, valueStride, width, height, lo, loStride, hi, hiStride);
+        else
 #endif
 #ifdef SIMD_SSE2_ENABLE
-    if(Sse2::Enable && width >= Sse2::A)
-        Sse2::BackgroundShiftRange(value, valueStride, width, height, lo, loStride, hi, hiStride);
-    else
+        if(Sse2::Enable && width >= Sse2::A)
+            Sse2::BackgroundShiftRange(value, valueStride, width, height, lo, loStride, hi, hiStride);
+        else
 #endif
 #ifdef SIMD_VMX_ENABLE
-    if(Vmx::Enable && width >= Vmx::A)
-        Vmx::BackgroundShiftRange(value, valueStride, width, height, lo, loStride, hi, hiStride);
-    else
+        if(Vmx::Enable && width >= Vmx::A)
+            Vmx::BackgroundShiftRange(value, valueStride, width, height, lo, loStride, hi, hiStride);
+        else
 #endif
 #ifdef SIMD_NEON_ENABLE
-    if (Neon::Enable && width >= Neon::A)
-        Neon::BackgroundShiftRange(value, valueStride, width, height, lo, loStride, hi, hiStride);
-    else
+        if (Neon::Enable && width >= Neon::A)
+            Neon::BackgroundShiftRange(value, valueStride, width, height, lo, loStride, hi, hiStride);
+        else
 #endif
-        Base::BackgroundShiftRange(value, valueStride, width, height, lo, loStride, hi, hiStride);
+            Base::BackgroundShiftRange(value, valueStride, width, height, lo, loStride, hi, hiStride);
+    };
+    ParallelTiles(width, height, 3, [&](size_t begin, size_t end)
+    {
+        kernel(value + begin*valueStride, end - begin, lo + begin*loStride, hi + begin*hiStride);
+    });
 }
 
 SIMD_API void SimdBackgroundShiftRangeMasked(const uint8_t * value, size_t valueStride, size_t width, size_t height,
                                              uint8_t * lo, size_t loStride, uint8_t * hi, size_t hiStride, const uint8_t * mask, size_t maskStride)
 {
+    auto kernel = [=](const uint8_t * value, size_t height, uint8_t * lo, uint8_t * hi, const uint8_t * mask)
+    {
 #ifdef SIMD_AVX512BW_ENABLE
-    if (Avx512bw::Enable)
-        Avx512bw::BackgroundShiftRangeMasked(value, valueStride, width, height, lo, loStride, hi, hiStride, mask, maskStride);
-    else
+        if (Avx512bw::Enable)
+            Avx512bw::BackgroundShiftRangeMasked(value, valueStride, width, height, lo, loStride, hi, hiStride, mask, maskStride);
+        else
 #endif
 #ifdef SIMD_AVX2_ENABLE
-    if(Avx2::Enable && width >= Avx2::A)
-        Avx2::BackgroundShiftRangeMasked(value, valueStride, width, height, lo, loStride, hi, hiStride, mask, maskStride);
-    else
+        if(Avx2::Enable && width >= Avx2::A)
+            Avx2::BackgroundShiftRangeMasked(value, valueStride, width, height, lo, loStride, hi, hiStride, mask, maskStride);
+        else
 #endif
 #ifdef SIMD_SSE2_ENABLE
-    if(Sse2::Enable && width >= Sse2::A)
-        Sse2::BackgroundShiftRangeMasked(value, valueStride, width, height, lo, loStride, hi, hiStride, mask, maskStride);
-    else
+        if(Sse2::Enable && width >= Sse2::A)
+            Sse2::BackgroundShiftRangeMasked(value, valueStride, width, height, lo, loStride, hi, hiStride, mask, maskStride);
+        else
 #endif
 #ifdef SIMD_VMX_ENABLE
-    if(Vmx::Enable && width >= Vmx::A)
-        Vmx::BackgroundShiftRangeMasked(value, valueStride, width, height, lo, loStride, hi, hiStride, mask, maskStride);
-    else
+        if(Vmx::Enable && width >= Vmx::A)
+            Vmx::BackgroundShiftRangeMasked(value, valueStride, width, height, lo, loStride, hi, hiStride, mask, maskStride);
+        else
 #endif
 #ifdef SIMD_NEON_ENABLE
-    if (Neon::Enable && width >= Neon::A)
-        Neon::BackgroundShiftRangeMasked(value, valueStride, width, height, lo, loStride, hi, hiStride, mask, maskStride);
-    else
+        if (Neon::Enable && width >= Neon::A)
+            Neon::BackgroundShiftRangeMasked(value, valueStride, width, height, lo, loStride, hi, hiStride, mask, maskStride);
+        else
 #endif
-        Base::BackgroundShiftRangeMasked(value, valueStride, width, height, lo, loStride, hi, hiStride, mask, maskStride);
+            Base::BackgroundShiftRangeMasked(value, valueStride, width, height, lo, loStride, hi, hiStride, mask, maskStride);
+    };
+    ParallelTiles(width, height, 4, [&](size_t begin, size_t end)
+    {
+        kernel(value + begin*valueStride, end - begin, lo + begin*loStride, hi + begin*hiStride, mask + begin*maskStride);
+    });
 }
 
 SIMD_API void SimdBackgroundInitMask(const uint8_t * src, size_t srcStride, size_t width, size_t height,
                                      uint8_t index, uint8_t value, uint8_t * dst, size_t dstStride)
 {
+    auto kernel = [=](const uint8_t * src, size_t height, uint8_t * dst)
+    {
 #ifdef SIMD_AVX512BW_ENABLE
-    if (Avx512bw::Enable)
-        Avx512bw::BackgroundInitMask(src, srcStride, width, height, index, value, dst, dstStride);
-    else
+        if (Avx512bw::Enable)
+            Avx512bw::BackgroundInitMask(src, srcStride, width, height, index, value, dst, dstStride);
+        else
 #endif
 #ifdef SIMD_AVX2_ENABLE
-    if(Avx2::Enable && width >= Avx2::A)
-        Avx2::BackgroundInitMask(src, srcStride, width, height, index, value, dst, dstStride);
-    else
+        if(Avx2::Enable && width >= Avx2::A)
+            Avx2::BackgroundInitMask(src, srcStride, width, height, index, value, dst, dstStride);
+        else
 #endif
 #ifdef SIMD_SSE2_ENABLE
-    if(Sse2::Enable && width >= Sse2::A)
-        Sse2::BackgroundInitMask(src, srcStride, width, height, index, value, dst, dstStride);
-    else
+        if(Sse2::Enable && width >= Sse2::A)
+            Sse2::BackgroundInitMask(src, srcStride, width, height, index, value, dst, dstStride);
+        else
 #endif
 #ifdef SIMD_VMX_ENABLE
-    if(Vmx::Enable && width >= Vmx::A)
-        Vmx::BackgroundInitMask(src, srcStride, width, height, index, value, dst, dstStride);
-    else
+        if(Vmx::Enable && width >= Vmx::A)
+            Vmx::BackgroundInitMask(src, srcStride, width, height, index, value, dst, dstStride);
+        else
 #endif
 #ifdef SIMD_NEON_ENABLE
-    if (Neon::Enable && width >= Neon::A)
-        Neon::BackgroundInitMask(src, srcStride, width, height, index, value, dst, dstStride);
-    else
+        if (Neon::Enable && width >= Neon::A)
+            Neon::BackgroundInitMask(src, srcStride, width, height, index, value, dst, dstStride);
+        else
 #endif
-        Base::BackgroundInitMask(src, srcStride, width, height, index, value, dst, dstStride);
+            Base::BackgroundInitMask(src, srcStride, width, height, index, value, dst, dstStride);
+    };
+    ParallelTiles(width, height, 2, [&](size_t begin, size_t end)
+    {
+        kernel(src + begin*srcStride, end - begin, dst + begin*dstStride);
+    });
 }
 
 SIMD_API void SimdBayerToBgr(const uint8_t * bayer, size_t width, size_t height, size_t bayerStride, SimdPixelFormatType bayerFormat, uint8_t * bgr, size_t bgrStride)
@@ -701,67 +870,81 @@ SIMD_API void SimdBgraToBgr(const uint8_t * bgra, size_t width, size_t height, s
 
 SIMD_API void SimdBgraToGray(const uint8_t *bgra, size_t width, size_t height, size_t bgraStride, uint8_t *gray, size_t grayStride)
 {
+    auto kernel = [=](const uint8_t * bgra, size_t height, uint8_t * gray)
+    {
 #ifdef SIMD_AVX512BW_ENABLE
-    if (Avx512bw::Enable)
-        Avx512bw::BgraToGray(bgra, width, height, bgraStride, gray, grayStride);
-    else
+        if (Avx512bw::Enable)
+            Avx512bw::BgraToGray(bgra, width, height, bgraStride, gray, grayStride);
+        else
 #endif
 #ifdef SIMD_AVX2_ENABLE
-    if(Avx2::Enable && width >= Avx2::A)
-        Avx2::BgraToGray(bgra, width, height, bgraStride, gray, grayStride);
-    else
+        if(Avx2::Enable && width >= Avx2::A)
+            Avx2::BgraToGray(bgra, width, height, bgraStride, gray, grayStride);
+        else
 #endif
 #ifdef SIMD_SSE2_ENABLE
-    if(Sse2::Enable && width >= Sse2::A)
-        Sse2::BgraToGray(bgra, width, height, bgraStride, gray, grayStride);
-    else
+        if(Sse2::Enable && width >= Sse2::A)
+            Sse2::BgraToGray(bgra, width, height, bgraStride, gray, grayStride);
+        else
 #endif
 #ifdef SIMD_VMX_ENABLE
-    if(Vmx::Enable && width >= Vmx::A)
-        Vmx::BgraToGray(bgra, width, height, bgraStride, gray, grayStride);
-    else
+        if(Vmx::Enable && width >= Vmx::A)
+            Vmx::BgraToGray(bgra, width, height, bgraStride, gray, grayStride);
+        else
 #endif
 #ifdef SIMD_NEON_ENABLE
-    if (Neon::Enable && width >= Neon::HA)
-        Neon::BgraToGray(bgra, width, height, bgraStride, gray, grayStride);
-    else
+        if (Neon::Enable && width >= Neon::HA)
+            Neon::BgraToGray(bgra, width, height, bgraStride, gray, grayStride);
+        else
 #endif
-        Base::BgraToGray(bgra, width, height, bgraStride, gray, grayStride);
+            Base::BgraToGray(bgra, width, height, bgraStride, gray, grayStride);
+    };
+    ParallelRows(width, height, 1, [&](size_t begin, size_t end)
+    {
+        kernel(bgra + begin*bgraStride, end - begin, gray + begin*grayStride);
+    });
 }
 
 SIMD_API void SimdBgraToYuv420p(const uint8_t * bgra, size_t width, size_t height, size_t bgraStride, uint8_t * y, size_t yStride, uint8_t * u, size_t uStride, uint8_t * v, size_t vStride)
 {
+    auto kernel = [=](const uint8_t * bgra, size_t height, uint8_t * y, uint8_t * u, uint8_t * v)
+    {
 #ifdef SIMD_AVX512BW_ENABLE
-    if (Avx512bw::Enable)
-        Avx512bw::BgraToYuv420p(bgra, width, height, bgraStride, y, yStride, u, uStride, v, vStride);
-    else
+        if (Avx512bw::Enable)
+            Avx512bw::BgraToYuv420p(bgra, width, height, bgraStride, y, yStride, u, uStride, v, vStride);
+        else
 #endif
 #ifdef SIMD_AVX2_ENABLE
-    if(Avx2::Enable && width >= Avx2::DA)
-        Avx2::BgraToYuv420p(bgra, width, height, bgraStride, y, yStride, u, uStride, v, vStride);
-    else
+        if(Avx2::Enable && width >= Avx2::DA)
+            Avx2::BgraToYuv420p(bgra, width, height, bgraStride, y, yStride, u, uStride, v, vStride);
+        else
 #endif
 #ifdef SIMD_SSSE3_ENABLE
-    if(Ssse3::Enable && width >= Ssse3::DA)
-        Ssse3::BgraToYuv420p(bgra, width, height, bgraStride, y, yStride, u, uStride, v, vStride);
-    else
+        if(Ssse3::Enable && width >= Ssse3::DA)
+            Ssse3::BgraToYuv420p(bgra, width, height, bgraStride, y, yStride, u, uStride, v, vStride);
+        else
 #endif
 #ifdef SIMD_SSE2_ENABLE
-    if(Sse2::Enable && width >= Sse2::DA)
-        Sse2::BgraToYuv420p(bgra, width, height, bgraStride, y, yStride, u, uStride, v, vStride);
-    else
+        if(Sse2::Enable && width >= Sse2::DA)
+            Sse2::BgraToYuv420p(bgra, width, height, bgraStride, y, yStride, u, uStride, v, vStride);
+        else
 #endif
 #ifdef SIMD_VMX_ENABLE
-    if(Vmx::Enable && width >= Vmx::DA)
-        Vmx::BgraToYuv420p(bgra, width, height, bgraStride, y, yStride, u, uStride, v, vStride);
-    else
+        if(Vmx::Enable && width >= Vmx::DA)
+            Vmx::BgraToYuv420p(bgra, width, height, bgraStride, y, yStride, u, uStride, v, vStride);
+        else
 #endif
 #ifdef SIMD_NEON_ENABLE
-    if (Neon::Enable && width >= Neon::DA)
-        Neon::BgraToYuv420p(bgra, width, height, bgraStride, y, yStride, u, uStride, v, vStride);
-    else
+        if (Neon::Enable && width >= Neon::DA)
+            Neon::BgraToYuv420p(bgra, width, height, bgraStride, y, yStride, u, uStride, v, vStride);
+        else
 #endif
-        Base::BgraToYuv420p(bgra, width, height, bgraStride, y, yStride, u, uStride, v, vStride);
+            Base::BgraToYuv420p(bgra, width, height, bgraStride, y, yStride, u, uStride, v, vStride);
+    };
+    ParallelRows(width, height, 2, [&](size_t begin, size_t end)
+    {
+        kernel(bgra + begin*bgraStride, end - begin, y + begin*yStride, u + begin / 2 * uStride, v + begin / 2 * vStride);
+    });
 }
 
 SIMD_API void SimdBgraToYuv422p(const uint8_t * bgra, size_t width, size_t height, size_t bgraStride, uint8_t * y, size_t yStride, uint8_t * u, size_t uStride, uint8_t * v, size_t vStride)
@@ -801,32 +984,39 @@ SIMD_API void SimdBgraToYuv422p(const uint8_t * bgra, size_t width, size_t heigh
 
 SIMD_API void SimdBgraToYuv444p(const uint8_t * bgra, size_t width, size_t height, size_t bgraStride, uint8_t * y, size_t yStride, uint8_t * u, size_t uStride, uint8_t * v, size_t vStride)
 {
+    auto kernel = [=](const uint8_t * bgra, size_t height, uint8_t * y, uint8_t * u, uint8_t * v)
+    {
 #ifdef SIMD_AVX512BW_ENABLE
-    if (Avx512bw::Enable)
-        Avx512bw::BgraToYuv444p(bgra, width, height, bgraStride, y, yStride, u, uStride, v, vStride);
-    else
+        if (Avx512bw::Enable)
+            Avx512bw::BgraToYuv444p(bgra, width, height, bgraStride, y, yStride, u, uStride, v, vStride);
+        else
 #endif
 #ifdef SIMD_AVX2_ENABLE
-    if(Avx2::Enable && width >= Avx2::A)
-        Avx2::BgraToYuv444p(bgra, width, height, bgraStride, y, yStride, u, uStride, v, vStride);
-    else
+        if(Avx2::Enable && width >= Avx2::A)
+            Avx2::BgraToYuv444p(bgra, width, height, bgraStride, y, yStride, u, uStride, v, vStride);
+        else
 #endif
 #ifdef SIMD_SSE2_ENABLE
-    if(Sse2::Enable && width >= Sse2::A)
-        Sse2::BgraToYuv444p(bgra, width, height, bgraStride, y, yStride, u, uStride, v, vStride);
-    else
+        if(Sse2::Enable && width >= Sse2::A)
+            Sse2::BgraToYuv444p(bgra, width, height, bgraStride, y, yStride, u, uStride, v, vStride);
+        else
 #endif
 #ifdef SIMD_VMX_ENABLE
-    if(Vmx::Enable && width >= Vmx::A)
-        Vmx::BgraToYuv444p(bgra, width, height, bgraStride, y, yStride, u, uStride, v, vStride);
-    else
+        if(Vmx::Enable && width >= Vmx::A)
+            Vmx::BgraToYuv444p(bgra, width, height, bgraStride, y, yStride, u, uStride, v, vStride);
+        else
 #endif
 #ifdef SIMD_NEON_ENABLE
-    if (Neon::Enable && width >= Neon::A)
-        Neon::BgraToYuv444p(bgra, width, height, bgraStride, y, yStride, u, uStride, v, vStride);
-    else
+        if (Neon::Enable && width >= Neon::A)
+            Neon::BgraToYuv444p(bgra, width, height, bgraStride, y, yStride, u, uStride, v, vStride);
+        else
 #endif
-        Base::BgraToYuv444p(bgra, width, height, bgraStride, y, yStride, u, uStride, v, vStride);
+            Base::BgraToYuv444p(bgra, width, height, bgraStride, y, yStride, u, uStride, v, vStride);
+    };
+    ParallelRows(width, height, 1, [&](size_t begin, size_t end)
+    {
+        kernel(bgra + begin*bgraStride, end - begin, y + begin*yStride, u + begin*uStride, v + begin*vStride);
+    });
 }
 
 SIMD_API void SimdBgrToBayer(const uint8_t * bgr, size_t width, size_t height, size_t bgrStride, uint8_t * bayer, size_t bayerStride, SimdPixelFormatType bayerFormat)
@@ -917,37 +1107,44 @@ SIMD_API void SimdBgr48pToBgra32(const uint8_t * blue, size_t blueStride, size_t
 
 SIMD_API void SimdBgrToGray(const uint8_t *bgr, size_t width, size_t height, size_t bgrStride, uint8_t *gray, size_t grayStride)
 {
+    auto kernel = [=](const uint8_t * bgr, size_t height, uint8_t * gray)
+    {
 #ifdef SIMD_AVX512BW_ENABLE
-    if (Avx512bw::Enable)
-        Avx512bw::BgrToGray(bgr, width, height, bgrStride, gray, grayStride);
-    else
+        if (Avx512bw::Enable)
+            Avx512bw::BgrToGray(bgr, width, height, bgrStride, gray, grayStride);
+        else
 #endif
 #if defined(SIMD_AVX2_ENABLE) && !defined(SIMD_CLANG_AVX2_BGR_TO_BGRA_ERROR)
-    if(Avx2::Enable && width >= Avx2::A)
-        Avx2::BgrToGray(bgr, width, height, bgrStride, gray, grayStride);
-    else
+        if(Avx2::Enable && width >= Avx2::A)
+            Avx2::BgrToGray(bgr, width, height, bgrStride, gray, grayStride);
+        else
 #endif
 #ifdef SIMD_SSSE3_ENABLE
-    if(Ssse3::Enable && width >= Ssse3::A)
-        Ssse3::BgrToGray(bgr, width, height, bgrStride, gray, grayStride);
-    else
+        if(Ssse3::Enable && width >= Ssse3::A)
+            Ssse3::BgrToGray(bgr, width, height, bgrStride, gray, grayStride);
+        else
 #endif
 #ifdef SIMD_SSE2_ENABLE
-    if(Sse2::Enable && width >= Sse2::A)
-        Sse2::BgrToGray(bgr, width, height, bgrStride, gray, grayStride);
-    else
+        if(Sse2::Enable && width >= Sse2::A)
+            Sse2::BgrToGray(bgr, width, height, bgrStride, gray, grayStride);
+        else
 #endif
 #ifdef SIMD_VMX_ENABLE
-    if(Vmx::Enable && width >= Vmx::A)
-        Vmx::BgrToGray(bgr, width, height, bgrStride, gray, grayStride);
-    else
+        if(Vmx::Enable && width >= Vmx::A)
+            Vmx::BgrToGray(bgr, width, height, bgrStride, gray, grayStride);
+        else
 #endif
 #ifdef SIMD_NEON_ENABLE
-    if (Neon::Enable && width >= Neon::A)
-        Neon::BgrToGray(bgr, width, height, bgrStride, gray, grayStride);
-    else
+        if (Neon::Enable && width >= Neon::A)
+            Neon::BgrToGray(bgr, width, height, bgrStride, gray, grayStride);
+        else
 #endif
-        Base::BgrToGray(bgr, width, height, bgrStride, gray, grayStride);
+            Base::BgrToGray(bgr, width, height, bgrStride, gray, grayStride);
+    };
+    ParallelRows(width, height, 1, [&](size_t begin, size_t end)
+    {
+        kernel(bgr + begin*bgrStride, end - begin, gray + begin*grayStride);
+    });
 }
 
 SIMD_API void SimdBgrToHsl(const uint8_t * bgr, size_t width, size_t height, size_t bgrStride, uint8_t * hsl, size_t hslStride)
@@ -962,32 +1159,39 @@ SIMD_API void SimdBgrToHsv(const uint8_t * bgr, size_t width, size_t height, siz
 
 SIMD_API void SimdBgrToYuv420p(const uint8_t * bgr, size_t width, size_t height, size_t bgrStride, uint8_t * y, size_t yStride, uint8_t * u, size_t uStride, uint8_t * v, size_t vStride)
 {
+    auto kernel = [=](const uint8_t * bgr, size_t height, uint8_t * y, uint8_t * u, uint8_t * v)
+    {
 #ifdef SIMD_AVX512BW_ENABLE
-    if (Avx512bw::Enable)
-        Avx512bw::BgrToYuv420p(bgr, width, height, bgrStride, y, yStride, u, uStride, v, vStride);
-    else
+        if (Avx512bw::Enable)
+            Avx512bw::BgrToYuv420p(bgr, width, height, bgrStride, y, yStride, u, uStride, v, vStride);
+        else
 #endif
 #ifdef SIMD_AVX2_ENABLE
-    if(Avx2::Enable && width >= Avx2::DA)
-        Avx2::BgrToYuv420p(bgr, width, height, bgrStride, y, yStride, u, uStride, v, vStride);
-    else
+        if(Avx2::Enable && width >= Avx2::DA)
+            Avx2::BgrToYuv420p(bgr, width, height, bgrStride, y, yStride, u, uStride, v, vStride);
+        else
 #endif
 #ifdef SIMD_SSSE3_ENABLE
-    if(Ssse3::Enable && width >= Ssse3::DA)
-        Ssse3::BgrToYuv420p(bgr, width, height, bgrStride, y, yStride, u, uStride, v, vStride);
-    else
+        if(Ssse3::Enable && width >= Ssse3::DA)
+            Ssse3::BgrToYuv420p(bgr, width, height, bgrStride, y, yStride, u, uStride, v, vStride);
+        else
 #endif
 #ifdef SIMD_VMX_ENABLE
-    if(Vmx::Enable && width >= Vmx::DA)
-        Vmx::BgrToYuv420p(bgr, width, height, bgrStride, y, yStride, u, uStride, v, vStride);
-    else
+        if(Vmx::Enable && width >= Vmx::DA)
+            Vmx::BgrToYuv420p(bgr, width, height, bgrStride, y, yStride, u, uStride, v, vStride);
+        else
 #endif
 #ifdef SIMD_NEON_ENABLE
-    if (Neon::Enable && width >= Neon::DA)
-        Neon::BgrToYuv420p(bgr, width, height, bgrStride, y, yStride, u, uStride, v, vStride);
-    else
+        if (Neon::Enable && width >= Neon::DA)
+            Neon::BgrToYuv420p(bgr, width, height, bgrStride, y, yStride, u, uStride, v, vStride);
+        else
 #endif
-        Base::BgrToYuv420p(bgr, width, height, bgrStride, y, yStride, u, uStride, v, vStride);
+            Base::BgrToYuv420p(bgr, width, height, bgrStride, y, yStride, u, uStride, v, vStride);
+    };
+    ParallelRows(width, height, 2, [&](size_t begin, size_t end)
+    {
+        kernel(bgr + begin*bgrStride, end - begin, y + begin*yStride, u + begin / 2 * uStride, v + begin / 2 * vStride);
+    });
 }
 
 SIMD_API void SimdBgrToYuv422p(const uint8_t * bgr, size_t width, size_t height, size_t bgrStride, uint8_t * y, size_t yStride, uint8_t * u, size_t uStride, uint8_t * v, size_t vStride)
@@ -1397,6 +1601,16 @@ SIMD_API void * SimdDetectionLoadA(const char * path)
     return Base::DetectionLoadA(path);
 }
 
+SIMD_API void * SimdDetectionLoadBinary(const void * buffer, size_t size)
+{
+    return Base::DetectionLoadBinary(buffer, size);
+}
+
+SIMD_API int SimdDetectionSaveBinary(const void * data, const char * path)
+{
+    return Base::DetectionSaveBinary(data, path);
+}
+
 SIMD_API void SimdDetectionInfo(const void * data, size_t * width, size_t * height, SimdDetectionInfoFlags * flags)
 {
     Base::DetectionInfo(data, width, height, flags);
@@ -1413,166 +1627,116 @@ SIMD_API void SimdDetectionPrepare(void * hid)
     Base::DetectionPrepare(hid);
 }
 
+static Dispatch<decltype(&Base::DetectionHaarDetect32fp)> g_detectionHaarDetect32fp("SimdDetectionHaarDetect32fp", Base::DetectionHaarDetect32fp,
+{
+    SIMD_AVX512BW_DISPATCH(DetectionHaarDetect32fp, 0)
+    SIMD_AVX2_DISPATCH(DetectionHaarDetect32fp, Avx2::A)
+    SIMD_SSE41_DISPATCH(DetectionHaarDetect32fp, Sse41::A)
+    SIMD_NEON_DISPATCH(DetectionHaarDetect32fp, Neon::A)
+});
+
 SIMD_API void SimdDetectionHaarDetect32fp(const void * hid, const uint8_t * mask, size_t maskStride, 
     ptrdiff_t left, ptrdiff_t top, ptrdiff_t right, ptrdiff_t bottom, uint8_t * dst, size_t dstStride)
 {
-    size_t width = right - left;
-#ifdef SIMD_AVX512BW_ENABLE
-    if (Avx512bw::Enable)
-        Avx512bw::DetectionHaarDetect32fp(hid, mask, maskStride, left, top, right, bottom, dst, dstStride);
-    else
-#endif
-#ifdef SIMD_AVX2_ENABLE
-    if (Avx2::Enable && width >= Avx2::A)
-        Avx2::DetectionHaarDetect32fp(hid, mask, maskStride, left, top, right, bottom, dst, dstStride);
-    else
-#endif
-#ifdef SIMD_SSE41_ENABLE
-    if (Sse41::Enable && width >= Sse41::A)
-        Sse41::DetectionHaarDetect32fp(hid, mask, maskStride, left, top, right, bottom, dst, dstStride);
-    else
-#endif
-#ifdef SIMD_NEON_ENABLE
-    if (Neon::Enable && width >= Neon::A)
-        Neon::DetectionHaarDetect32fp(hid, mask, maskStride, left, top, right, bottom, dst, dstStride);
-    else
-#endif
-        Base::DetectionHaarDetect32fp(hid, mask, maskStride, left, top, right, bottom, dst, dstStride);
+    g_detectionHaarDetect32fp(right - left)(hid, mask, maskStride, left, top, right, bottom, dst, dstStride);
 }
 
+static Dispatch<decltype(&Base::DetectionHaarDetect32fi)> g_detectionHaarDetect32fi("SimdDetectionHaarDetect32fi", Base::DetectionHaarDetect32fi,
+{
+    SIMD_AVX512BW_DISPATCH(DetectionHaarDetect32fi, 0)
+    SIMD_AVX2_DISPATCH(DetectionHaarDetect32fi, Avx2::A)
+    SIMD_SSE41_DISPATCH(DetectionHaarDetect32fi, Sse41::A)
+    SIMD_NEON_DISPATCH(DetectionHaarDetect32fi, Neon::A)
+});
+
 SIMD_API void SimdDetectionHaarDetect32fi(const void * hid, const uint8_t * mask, size_t maskStride,
     ptrdiff_t left, ptrdiff_t top, ptrdiff_t right, ptrdiff_t bottom, uint8_t * dst, size_t dstStride)
 {
-    size_t width = right - left;
-#ifdef SIMD_AVX512BW_ENABLE
-    if (Avx512bw::Enable)
-        Avx512bw::DetectionHaarDetect32fi(hid, mask, maskStride, left, top, right, bottom, dst, dstStride);
-    else
-#endif
-#ifdef SIMD_AVX2_ENABLE
-    if (Avx2::Enable && width >= Avx2::A)
-        Avx2::DetectionHaarDetect32fi(hid, mask, maskStride, left, top, right, bottom, dst, dstStride);
-    else
-#endif
-#ifdef SIMD_SSE41_ENABLE
-    if (Sse41::Enable && width >= Sse41::A)
-        Sse41::DetectionHaarDetect32fi(hid, mask, maskStride, left, top, right, bottom, dst, dstStride);
-    else
-#endif
-#ifdef SIMD_NEON_ENABLE
-    if (Neon::Enable && width >= Neon::A)
-        Neon::DetectionHaarDetect32fi(hid, mask, maskStride, left, top, right, bottom, dst, dstStride);
-    else
-#endif
-        Base::DetectionHaarDetect32fi(hid, mask, maskStride, left, top, right, bottom, dst, dstStride);
+    g_detectionHaarDetect32fi(right - left)(hid, mask, maskStride, left, top, right, bottom, dst, dstStride);
+}
+
+static Dispatch<decltype(&Base::DetectionHaarDetect16ip)> g_detectionHaarDetect16ip("SimdDetectionHaarDetect16ip", Base::DetectionHaarDetect16ip,
+{
+    SIMD_AVX512BW_DISPATCH(DetectionHaarDetect16ip, 0)
+    SIMD_AVX2_DISPATCH(DetectionHaarDetect16ip, Avx2::A)
+    SIMD_SSE41_DISPATCH(DetectionHaarDetect16ip, Sse41::A)
+    SIMD_NEON_DISPATCH(DetectionHaarDetect16ip, Neon::A)
+});
+
+SIMD_API void SimdDetectionHaarDetect16ip(const void * hid, const uint8_t * mask, size_t maskStride,
+    ptrdiff_t left, ptrdiff_t top, ptrdiff_t right, ptrdiff_t bottom, uint8_t * dst, size_t dstStride)
+{
+    g_detectionHaarDetect16ip(right - left)(hid, mask, maskStride, left, top, right, bottom, dst, dstStride);
 }
 
+static Dispatch<decltype(&Base::DetectionHaarDetect16ii)> g_detectionHaarDetect16ii("SimdDetectionHaarDetect16ii", Base::DetectionHaarDetect16ii,
+{
+    SIMD_AVX512BW_DISPATCH(DetectionHaarDetect16ii, 0)
+    SIMD_AVX2_DISPATCH(DetectionHaarDetect16ii, Avx2::A)
+    SIMD_SSE41_DISPATCH(DetectionHaarDetect16ii, Sse41::A)
+    SIMD_NEON_DISPATCH(DetectionHaarDetect16ii, Neon::A)
+});
+
+SIMD_API void SimdDetectionHaarDetect16ii(const void * hid, const uint8_t * mask, size_t maskStride,
+    ptrdiff_t left, ptrdiff_t top, ptrdiff_t right, ptrdiff_t bottom, uint8_t * dst, size_t dstStride)
+{
+    g_detectionHaarDetect16ii(right - left)(hid, mask, maskStride, left, top, right, bottom, dst, dstStride);
+}
+
+static Dispatch<decltype(&Base::DetectionLbpDetect32fp)> g_detectionLbpDetect32fp("SimdDetectionLbpDetect32fp", Base::DetectionLbpDetect32fp,
+{
+    SIMD_AVX512BW_DISPATCH(DetectionLbpDetect32fp, 0)
+    SIMD_AVX2_DISPATCH(DetectionLbpDetect32fp, Avx2::A)
+    SIMD_SSE41_DISPATCH(DetectionLbpDetect32fp, Sse41::A)
+    SIMD_NEON_DISPATCH(DetectionLbpDetect32fp, Neon::A)
+});
+
 SIMD_API void SimdDetectionLbpDetect32fp(const void * hid, const uint8_t * mask, size_t maskStride,
     ptrdiff_t left, ptrdiff_t top, ptrdiff_t right, ptrdiff_t bottom, uint8_t * dst, size_t dstStride)
 {
-    size_t width = right - left;
-#ifdef SIMD_AVX512BW_ENABLE
-    if (Avx512bw::Enable)
-        Avx512bw::DetectionLbpDetect32fp(hid, mask, maskStride, left, top, right, bottom, dst, dstStride);
-    else
-#endif
-#ifdef SIMD_AVX2_ENABLE
-    if (Avx2::Enable && width >= Avx2::A)
-        Avx2::DetectionLbpDetect32fp(hid, mask, maskStride, left, top, right, bottom, dst, dstStride);
-    else
-#endif
-#ifdef SIMD_SSE41_ENABLE
-    if (Sse41::Enable && width >= Sse41::A)
-        Sse41::DetectionLbpDetect32fp(hid, mask, maskStride, left, top, right, bottom, dst, dstStride);
-    else
-#endif
-#ifdef SIMD_NEON_ENABLE
-    if (Neon::Enable && width >= Neon::A)
-        Neon::DetectionLbpDetect32fp(hid, mask, maskStride, left, top, right, bottom, dst, dstStride);
-    else
-#endif
-        Base::DetectionLbpDetect32fp(hid, mask, maskStride, left, top, right, bottom, dst, dstStride);
+    g_detectionLbpDetect32fp(right - left)(hid, mask, maskStride, left, top, right, bottom, dst, dstStride);
 }
 
+static Dispatch<decltype(&Base::DetectionLbpDetect32fi)> g_detectionLbpDetect32fi("SimdDetectionLbpDetect32fi", Base::DetectionLbpDetect32fi,
+{
+    SIMD_AVX512BW_DISPATCH(DetectionLbpDetect32fi, 0)
+    SIMD_AVX2_DISPATCH(DetectionLbpDetect32fi, Avx2::A)
+    SIMD_SSE41_DISPATCH(DetectionLbpDetect32fi, Sse41::A)
+    SIMD_NEON_DISPATCH(DetectionLbpDetect32fi, Neon::A)
+});
+
 SIMD_API void SimdDetectionLbpDetect32fi(const void * hid, const uint8_t * mask, size_t maskStride,
     ptrdiff_t left, ptrdiff_t top, ptrdiff_t right, ptrdiff_t bottom, uint8_t * dst, size_t dstStride)
 {
-    size_t width = right - left;
-#ifdef SIMD_AVX512BW_ENABLE
-    if (Avx512bw::Enable)
-        Avx512bw::DetectionLbpDetect32fi(hid, mask, maskStride, left, top, right, bottom, dst, dstStride);
-    else
-#endif
-#ifdef SIMD_AVX2_ENABLE
-    if (Avx2::Enable && width >= Avx2::A)
-        Avx2::DetectionLbpDetect32fi(hid, mask, maskStride, left, top, right, bottom, dst, dstStride);
-    else
-#endif
-#ifdef SIMD_SSE41_ENABLE
-    if (Sse41::Enable && width >= Sse41::A)
-        Sse41::DetectionLbpDetect32fi(hid, mask, maskStride, left, top, right, bottom, dst, dstStride);
-    else
-#endif
-#ifdef SIMD_NEON_ENABLE
-    if (Neon::Enable && width >= Neon::A)
-        Neon::DetectionLbpDetect32fi(hid, mask, maskStride, left, top, right, bottom, dst, dstStride);
-    else
-#endif
-        Base::DetectionLbpDetect32fi(hid, mask, maskStride, left, top, right, bottom, dst, dstStride);
+    g_detectionLbpDetect32fi(right - left)(hid, mask, maskStride, left, top, right, bottom, dst, dstStride);
 }
 
+static Dispatch<decltype(&Base::DetectionLbpDetect16ip)> g_detectionLbpDetect16ip("SimdDetectionLbpDetect16ip", Base::DetectionLbpDetect16ip,
+{
+    SIMD_AVX512BW_DISPATCH(DetectionLbpDetect16ip, 0)
+    SIMD_AVX2_DISPATCH(DetectionLbpDetect16ip, Avx2::A)
+    SIMD_SSE41_DISPATCH(DetectionLbpDetect16ip, Sse41::A)
+    SIMD_NEON_DISPATCH(DetectionLbpDetect16ip, Neon::A)
+});
+
 SIMD_API void SimdDetectionLbpDetect16ip(const void * hid, const uint8_t * mask, size_t maskStride,
     ptrdiff_t left, ptrdiff_t top, ptrdiff_t right, ptrdiff_t bottom, uint8_t * dst, size_t dstStride)
 {
-    size_t width = right - left;
-#ifdef SIMD_AVX512BW_ENABLE
-    if (Avx512bw::Enable)
-        Avx512bw::DetectionLbpDetect16ip(hid, mask, maskStride, left, top, right, bottom, dst, dstStride);
-    else
-#endif
-#ifdef SIMD_AVX2_ENABLE
-    if (Avx2::Enable && width >= Avx2::A)
-        Avx2::DetectionLbpDetect16ip(hid, mask, maskStride, left, top, right, bottom, dst, dstStride);
-    else
-#endif
-#ifdef SIMD_SSE41_ENABLE
-    if (Sse41::Enable && width >= Sse41::A)
-        Sse41::DetectionLbpDetect16ip(hid, mask, maskStride, left, top, right, bottom, dst, dstStride);
-    else
-#endif
-#ifdef SIMD_NEON_ENABLE
-    if (Neon::Enable && width >= Neon::A)
-        Neon::DetectionLbpDetect16ip(hid, mask, maskStride, left, top, right, bottom, dst, dstStride);
-    else
-#endif
-        Base::DetectionLbpDetect16ip(hid, mask, maskStride, left, top, right, bottom, dst, dstStride);
+    g_detectionLbpDetect16ip(right - left)(hid, mask, maskStride, left, top, right, bottom, dst, dstStride);
 }
 
+static Dispatch<decltype(&Base::DetectionLbpDetect16ii)> g_detectionLbpDetect16ii("SimdDetectionLbpDetect16ii", Base::DetectionLbpDetect16ii,
+{
+    SIMD_AVX512BW_DISPATCH(DetectionLbpDetect16ii, 0)
+    SIMD_AVX2_DISPATCH(DetectionLbpDetect16ii, Avx2::A)
+    SIMD_SSE41_DISPATCH(DetectionLbpDetect16ii, Sse41::A)
+    SIMD_NEON_DISPATCH(DetectionLbpDetect16ii, Neon::A)
+});
+
 SIMD_API void SimdDetectionLbpDetect16ii(const void * hid, const uint8_t * mask, size_t maskStride,
     ptrdiff_t left, ptrdiff_t top, ptrdiff_t right, ptrdiff_t bottom, uint8_t * dst, size_t dstStride)
 {
-    size_t width = right - left;
-#ifdef SIMD_AVX512BW_ENABLE
-    if (Avx512bw::Enable)
-        Avx512bw::DetectionLbpDetect16ii(hid, mask, maskStride, left, top, right, bottom, dst, dstStride);
-    else
-#endif
-#ifdef SIMD_AVX2_ENABLE
-    if (Avx2::Enable && width >= Avx2::A)
-        Avx2::DetectionLbpDetect16ii(hid, mask, maskStride, left, top, right, bottom, dst, dstStride);
-    else
-#endif
-#ifdef SIMD_SSE41_ENABLE
-    if (Sse41::Enable && width >= Sse41::A)
-        Sse41::DetectionLbpDetect16ii(hid, mask, maskStride, left, top, right, bottom, dst, dstStride);
-    else
-#endif
-#ifdef SIMD_NEON_ENABLE
-    if (Neon::Enable && width >= Neon::A)
-        Neon::DetectionLbpDetect16ii(hid, mask, maskStride, left, top, right, bottom, dst, dstStride);
-    else
-#endif
-        Base::DetectionLbpDetect16ii(hid, mask, maskStride, left, top, right, bottom, dst, dstStride);
+    g_detectionLbpDetect16ii(right - left)(hid, mask, maskStride, left, top, right, bottom, dst, dstStride);
 }
 
 SIMD_API void SimdDetectionFree(void * ptr)
@@ -1583,193 +1747,242 @@ SIMD_API void SimdDetectionFree(void * ptr)
 SIMD_API void SimdEdgeBackgroundGrowRangeSlow(const uint8_t * value, size_t valueStride, size_t width, size_t height,
                                  uint8_t * background, size_t backgroundStride)
 {
+    auto kernel = [=](const uint8_t * value, size_t height, uint8_t * background)
+    {
 #ifdef SIMD_AVX512BW_ENABLE
-    if (Avx512bw::Enable)
-        Avx512bw::EdgeBackgroundGrowRangeSlow(value, valueStride, width, height, background, backgroundStride);
-    else
+        if (Avx512bw::Enable)
+            Avx512bw::EdgeBackgroundGrowRangeSlow(value, valueStride, width, height, background, backgroundStride);
+        else
 #endif
 #ifdef SIMD_AVX2_ENABLE
-    if(Avx2::Enable && width >= Avx2::A)
-        Avx2::EdgeBackgroundGrowRangeSlow(value, valueStride, width, height, background, backgroundStride);
-    else
+        if(Avx2::Enable && width >= Avx2::A)
+            Avx2::EdgeBackgroundGrowRangeSlow(value, valueStride, width, height, background, backgroundStride);
+        else
 #endif
 #ifdef SIMD_SSE2_ENABLE
-    if(Sse2::Enable && width >= Sse2::A)
-        Sse2::EdgeBackgroundGrowRangeSlow(value, valueStride, width, height, background, backgroundStride);
-    else
+        if(Sse2::Enable && width >= Sse2::A)
+            Sse2::EdgeBackgroundGrowRangeSlow(value, valueStride, width, height, background, backgroundStride);
+        else
 #endif
 #ifdef SIMD_VMX_ENABLE
-    if(Vmx::Enable && width >= Vmx::A)
-        Vmx::EdgeBackgroundGrowRangeSlow(value, valueStride, width, height, background, backgroundStride);
-    else
+        if(Vmx::Enable && width >= Vmx::A)
+            Vmx::EdgeBackgroundGrowRangeSlow(value, valueStride, width, height, background, backgroundStride);
+        else
 #endif
 #ifdef SIMD_NEON_ENABLE
-    if (Neon::Enable && width >= Neon::A)
-        Neon::EdgeBackgroundGrowRangeSlow(value, valueStride, width, height, background, backgroundStride);
-    else
+        if (Neon::Enable && width >= Neon::A)
+            Neon::EdgeBackgroundGrowRangeSlow(value, valueStride, width, height, background, backgroundStride);
+        else
 #endif
-        Base::EdgeBackgroundGrowRangeSlow(value, valueStride, width, height, background, backgroundStride);
+            Base::EdgeBackgroundGrowRangeSlow(value, valueStride, width, height, background, backgroundStride);
+    };
+    ParallelTiles(width, height, 2, [&](size_t begin, size_t end)
+    {
+        kernel(value + begin*valueStride, end - begin, background + begin*backgroundStride);
+    });
 }
 
 SIMD_API void SimdEdgeBackgroundGrowRangeFast(const uint8_t * value, size_t valueStride, size_t width, size_t height,
                                  uint8_t * background, size_t backgroundStride)
 {
+    auto kernel = [=](const uint8_t * value, size_t height, uint8_t * background)
+    {
 #ifdef SIMD_AVX512BW_ENABLE
-    if (Avx512bw::Enable)
-        Avx512bw::EdgeBackgroundGrowRangeFast(value, valueStride, width, height, background, backgroundStride);
-    else
+        if (Avx512bw::Enable)
+            Avx512bw::EdgeBackgroundGrowRangeFast(value, valueStride, width, height, background, backgroundStride);
+        else
 #endif
-#ifdef SIMD_AVX2_ENABLE
-    if(Avx2::Enable && width >= Avx2::A)
-        Avx2::EdgeBackgroundGrowRangeFast(value, valueStride, width, height, background, backgroundStride);
-    else
+#ifdef SIMD_AVX2_ENABLE
+        if(Avx2::Enable && width >= Avx2::A)
+            Avx2::EdgeBackgroundGrowRangeFast(value, valueStride, width, height, background, backgroundStride);
+        else
 #endif
 #ifdef SIMD_SSE2_ENABLE
-    if(Sse2::Enable && width >= Sse2::A)
-        Sse2::EdgeBackgroundGrowRangeFast(value, valueStride, width, height, background, backgroundStride);
-    else
+        if(Sse2::Enable && width >= Sse2::A)
+            Sse2::EdgeBackgroundGrowRangeFast(value, valueStride, width, height, background, backgroundStride);
+        else
 #endif
 #ifdef SIMD_VMX_ENABLE
-    if(Vmx::Enable && width >= Vmx::A)
-        Vmx::EdgeBackgroundGrowRangeFast(value, valueStride, width, height, background, backgroundStride);
-    else
+        if(Vmx::Enable && width >= Vmx::A)
+            Vmx::EdgeBackgroundGrowRangeFast(value, valueStride, width, height, background, backgroundStride);
+        else
 #endif
 #ifdef SIMD_NEON_ENABLE
-    if (Neon::Enable && width >= Neon::A)
-        Neon::EdgeBackgroundGrowRangeFast(value, valueStride, width, height, background, backgroundStride);
-    else
+        if (Neon::Enable && width >= Neon::A)
+            Neon::EdgeBackgroundGrowRangeFast(value, valueStride, width, height, background, backgroundStride);
+        else
 #endif
-        Base::EdgeBackgroundGrowRangeFast(value, valueStride, width, height, background, backgroundStride);
+            Base::EdgeBackgroundGrowRangeFast(value, valueStride, width, height, background, backgroundStride);
+    };
+    ParallelTiles(width, height, 2, [&](size_t begin, size_t end)
+    {
+        kernel(value + begin*valueStride, end - begin, background + begin*backgroundStride);
+    });
 }
 
 SIMD_API void SimdEdgeBackgroundIncrementCount(const uint8_t * value, size_t valueStride, size_t width, size_t height,
                                   const uint8_t * backgroundValue, size_t backgroundValueStride, uint8_t * backgroundCount, size_t backgroundCountStride)
 {
+    auto kernel = [=](const uint8_t * value, size_t height, const uint8_t * backgroundValue, uint8_t * backgroundCount)
+    {
 #ifdef SIMD_AVX512BW_ENABLE
-    if (Avx512bw::Enable)
-        Avx512bw::EdgeBackgroundIncrementCount(value, valueStride, width, height, backgroundValue, backgroundValueStride, backgroundCount, backgroundCountStride);
-    else
+        if (Avx512bw::Enable)
+            Avx512bw::EdgeBackgroundIncrementCount(value, valueStride, width, height, backgroundValue, backgroundValueStride, backgroundCount, backgroundCountStride);
+        else
 #endif
 #ifdef SIMD_AVX2_ENABLE
-    if(Avx2::Enable && width >= Avx2::A)
-        Avx2::EdgeBackgroundIncrementCount(value, valueStride, width, height, backgroundValue, backgroundValueStride, backgroundCount, backgroundCountStride);
-    else
+        if(Avx2::Enable && width >= Avx2::A)
+            Avx2::EdgeBackgroundIncrementCount(value, valueStride, width, height, backgroundValue, backgroundValueStride, backgroundCount, backgroundCountStride);
+        else
 #endif
 #ifdef SIMD_SSE2_ENABLE
-    if(Sse2::Enable && width >= Sse2::A)
-        Sse2::EdgeBackgroundIncrementCount(value, valueStride, width, height, backgroundValue, backgroundValueStride, backgroundCount, backgroundCountStride);
-    else
+        if(Sse2::Enable && width >= Sse2::A)
+            Sse2::EdgeBackgroundIncrementCount(value, valueStride, width, height, backgroundValue, backgroundValueStride, backgroundCount, backgroundCountStride);
+        else
 #endif
 #ifdef SIMD_VMX_ENABLE
-    if(Vmx::Enable && width >= Vmx::A)
-        Vmx::EdgeBackgroundIncrementCount(value, valueStride, width, height, backgroundValue, backgroundValueStride, backgroundCount, backgroundCountStride);
-    else
+        if(Vmx::Enable && width >= Vmx::A)
+            Vmx::EdgeBackgroundIncrementCount(value, valueStride, width, height, backgroundValue, backgroundValueStride, backgroundCount, backgroundCountStride);
+        else
 #endif
 #ifdef SIMD_NEON_ENABLE
-    if (Neon::Enable && width >= Neon::A)
-        Neon::EdgeBackgroundIncrementCount(value, valueStride, width, height, backgroundValue, backgroundValueStride, backgroundCount, backgroundCountStride);
-    else
+        if (Neon::Enable && width >= Neon::A)
+            Neon::EdgeBackgroundIncrementCount(value, valueStride, width, height, backgroundValue, backgroundValueStride, backgroundCount, backgroundCountStride);
+        else
 #endif
-        Base::EdgeBackgroundIncrementCount(value, valueStride, width, height, backgroundValue, backgroundValueStride, backgroundCount, backgroundCountStride);
+            Base::EdgeBackgroundIncrementCount(value, valueStride, width, height, backgroundValue, backgroundValueStride, backgroundCount, backgroundCountStride);
+    };
+    ParallelTiles(width, height, 3, [&](size_t begin, size_t end)
+    {
+        kernel(value + begin*valueStride, end - begin, backgroundValue + begin*backgroundValueStride, backgroundCount + begin*backgroundCountStride);
+    });
 }
 
 SIMD_API void SimdEdgeBackgroundAdjustRange(uint8_t * backgroundCount, size_t backgroundCountStride, size_t width, size_t height,
                                uint8_t * backgroundValue, size_t backgroundValueStride, uint8_t threshold)
 {
+    auto kernel = [=](uint8_t * backgroundCount, size_t height, uint8_t * backgroundValue)
+    {
 #ifdef SIMD_AVX512BW_ENABLE
-    if (Avx512bw::Enable)
-        Avx512bw::EdgeBackgroundAdjustRange(backgroundCount, backgroundCountStride, width, height, backgroundValue, backgroundValueStride, threshold);
-    else
+        if (Avx512bw::Enable)
+            Avx512bw::EdgeBackgroundAdjustRange(backgroundCount, backgroundCountStride, width, height, backgroundValue, backgroundValueStride, threshold);
+        else
 #endif
 #ifdef SIMD_AVX2_ENABLE
-    if(Avx2::Enable && width >= Avx2::A)
-        Avx2::EdgeBackgroundAdjustRange(backgroundCount, backgroundCountStride, width, height, backgroundValue, backgroundValueStride, threshold);
-    else
+        if(Avx2::Enable && width >= Avx2::A)
+            Avx2::EdgeBackgroundAdjustRange(backgroundCount, backgroundCountStride, width, height, backgroundValue, backgroundValueStride, threshold);
+        else
 #endif
 #ifdef SIMD_SSE2_ENABLE
-    if(Sse2::Enable && width >= Sse2::A)
-        Sse2::EdgeBackgroundAdjustRange(backgroundCount, backgroundCountStride, width, height, backgroundValue, backgroundValueStride, threshold);
-    else
+        if(Sse2::Enable && width >= Sse2::A)
+            Sse2::EdgeBackgroundAdjustRange(backgroundCount, backgroundCountStride, width, height, backgroundValue, backgroundValueStride, threshold);
+        else
 #endif
 #ifdef SIMD_VMX_ENABLE
-    if(Vmx::Enable && width >= Vmx::A)
-        Vmx::EdgeBackgroundAdjustRange(backgroundCount, backgroundCountStride, width, height, backgroundValue, backgroundValueStride, threshold);
-    else
+        if(Vmx::Enable && width >= Vmx::A)
+            Vmx::EdgeBackgroundAdjustRange(backgroundCount, backgroundCountStride, width, height, backgroundValue, backgroundValueStride, threshold);
+        else
 #endif
 #ifdef SIMD_NEON_ENABLE
-    if (Neon::Enable && width >= Neon::A)
-        Neon::EdgeBackgroundAdjustRange(backgroundCount, backgroundCountStride, width, height, backgroundValue, backgroundValueStride, threshold);
-    else
+        if (Neon::Enable && width >= Neon::A)
+            Neon::EdgeBackgroundAdjustRange(backgroundCount, backgroundCountStride, width, height, backgroundValue, backgroundValueStride, threshold);
+        else
 #endif
-        Base::EdgeBackgroundAdjustRange(backgroundCount, backgroundCountStride, width, height, backgroundValue, backgroundValueStride, threshold);
+            Base::EdgeBackgroundAdjustRange(backgroundCount, backgroundCountStride, width, height, backgroundValue, backgroundValueStride, threshold);
+    };
+    ParallelTiles(width, height, 2, [&](size_t begin, size_t end)
+    {
+        kernel(backgroundCount + begin*backgroundCountStride, end - begin, backgroundValue + begin*backgroundValueStride);
+    });
 }
 
 SIMD_API void SimdEdgeBackgroundAdjustRangeMasked(uint8_t * backgroundCount, size_t backgroundCountStride, size_t width, size_t height,
                                uint8_t * backgroundValue, size_t backgroundValueStride, uint8_t threshold, const uint8_t * mask, size_t maskStride)
 {
+    auto kernel = [=](uint8_t * backgroundCount, size_t height, uint8_t * backgroundValue, const uint8_t * mask)
+    {
 #ifdef SIMD_AVX512BW_ENABLE
-    if (Avx512bw::Enable)
-        Avx512bw::EdgeBackgroundAdjustRangeMasked(backgroundCount, backgroundCountStride, width, height, backgroundValue, backgroundValueStride, threshold, mask, maskStride);
-    else
+        if (Avx512bw::Enable)
+            Avx512bw::EdgeBackgroundAdjustRangeMasked(backgroundCount, backgroundCountStride, width, height, backgroundValue, backgroundValueStride, threshold, mask, maskStride);
+        else
 #endif
 #ifdef SIMD_AVX2_ENABLE
-    if(Avx2::Enable && width >= Avx2::A)
-        Avx2::EdgeBackgroundAdjustRangeMasked(backgroundCount, backgroundCountStride, width, height, backgroundValue, backgroundValueStride, threshold, mask, maskStride);
-    else
+        if(Avx2::Enable && width >= Avx2::A)
+            Avx2::EdgeBackgroundAdjustRangeMasked(backgroundCount, backgroundCountStride, width, height, backgroundValue, backgroundValueStride, threshold, mask, maskStride);
+        else
 #endif
 #ifdef SIMD_SSE2_ENABLE
-    if(Sse2::Enable && width >= Sse2::A)
-        Sse2::EdgeBackgroundAdjustRangeMasked(backgroundCount, backgroundCountStride, width, height, backgroundValue, backgroundValueStride, threshold, mask, maskStride);
-    else
+        if(Sse2::Enable && width >= Sse2::A)
+            Sse2::EdgeBackgroundAdjustRangeMasked(backgroundCount, backgroundCountStride, width, height, backgroundValue, backgroundValueStride, threshold, mask, maskStride);
+        else
 #endif
 #ifdef SIMD_VMX_ENABLE
-    if(Vmx::Enable && width >= Vmx::A)
-        Vmx::EdgeBackgroundAdjustRangeMasked(backgroundCount, backgroundCountStride, width, height, backgroundValue, backgroundValueStride, threshold, mask, maskStride);
-    else
+        if(Vmx::Enable && width >= Vmx::A)
+            Vmx::EdgeBackgroundAdjustRangeMasked(backgroundCount, backgroundCountStride, width, height, backgroundValue, backgroundValueStride, threshold, mask, maskStride);
+        else
 #endif
 #ifdef SIMD_NEON_ENABLE
-    if (Neon::Enable && width >= Neon::A)
-        Neon::EdgeBackgroundAdjustRangeMasked(backgroundCount, backgroundCountStride, width, height, backgroundValue, backgroundValueStride, threshold, mask, maskStride);
-    else
+        if (Neon::Enable && width >= Neon::A)
+            Neon::EdgeBackgroundAdjustRangeMasked(backgroundCount, backgroundCountStride, width, height, backgroundValue, backgroundValueStride, threshold, mask, maskStride);
+        else
 #endif
-        Base::EdgeBackgroundAdjustRangeMasked(backgroundCount, backgroundCountStride, width, height, backgroundValue, backgroundValueStride, threshold, mask, maskStride);
+            Base::EdgeBackgroundAdjustRangeMasked(backgroundCount, backgroundCountStride, width, height, backgroundValue, backgroundValueStride, threshold, mask, maskStride);
+    };
+    ParallelTiles(width, height, 3, [&](size_t begin, size_t end)
+    {
+        kernel(backgroundCount + begin*backgroundCountStride, end - begin, backgroundValue + begin*backgroundValueStride, mask + begin*maskStride);
+    });
 }
 
 SIMD_API void SimdEdgeBackgroundShiftRange(const uint8_t * value, size_t valueStride, size_t width, size_t height,
                               uint8_t * background, size_t backgroundStride)
 {
-    Base::EdgeBackgroundShiftRange(value, valueStride, width, height, background, backgroundStride);
+    auto kernel = [=](const uint8_t * value, size_t height, uint8_t * background)
+    {
+        Base::EdgeBackgroundShiftRange(value, valueStride, width, height, background, backgroundStride);
+    };
+    ParallelTiles(width, height, 2, [&](size_t begin, size_t end)
+    {
+        kernel(value + begin*valueStride, end - begin, background + begin*backgroundStride);
+    });
 }
 
 SIMD_API void SimdEdgeBackgroundShiftRangeMasked(const uint8_t * value, size_t valueStride, size_t width, size_t height,
                               uint8_t * background, size_t backgroundStride, const uint8_t * mask, size_t maskStride)
 {
+    auto kernel = [=](const uint8_t * value, size_t height, uint8_t * background, const uint8_t * mask)
+    {
 #ifdef SIMD_AVX512BW_ENABLE
-    if (Avx512bw::Enable)
-        Avx512bw::EdgeBackgroundShiftRangeMasked(value, valueStride, width, height, background, backgroundStride, mask, maskStride);
-    else
+        if (Avx512bw::Enable)
+            Avx512bw::EdgeBackgroundShiftRangeMasked(value, valueStride, width, height, background, backgroundStride, mask, maskStride);
+        else
 #endif
 #ifdef SIMD_AVX2_ENABLE
-    if(Avx2::Enable && width >= Avx2::A)
-        Avx2::EdgeBackgroundShiftRangeMasked(value, valueStride, width, height, background, backgroundStride, mask, maskStride);
-    else
+        if(Avx2::Enable && width >= Avx2::A)
+            Avx2::EdgeBackgroundShiftRangeMasked(value, valueStride, width, height, background, backgroundStride, mask, maskStride);
+        else
 #endif
 #ifdef SIMD_SSE2_ENABLE
-    if(Sse2::Enable && width >= Sse2::A)
-        Sse2::EdgeBackgroundShiftRangeMasked(value, valueStride, width, height, background, backgroundStride, mask, maskStride);
-    else
+        if(Sse2::Enable && width >= Sse2::A)
+            Sse2::EdgeBackgroundShiftRangeMasked(value, valueStride, width, height, background, backgroundStride, mask, maskStride);
+        else
 #endif
 #ifdef SIMD_VMX_ENABLE
-    if(Vmx::Enable && width >= Vmx::A)
-        Vmx::EdgeBackgroundShiftRangeMasked(value, valueStride, width, height, background, backgroundStride, mask, maskStride);
-    else
+        if(Vmx::Enable && width >= Vmx::A)
+            Vmx::EdgeBackgroundShiftRangeMasked(value, valueStride, width, height, background, backgroundStride, mask, maskStride);
+        else
 #endif
 #ifdef SIMD_NEON_ENABLE
-    if (Neon::Enable && width >= Neon::A)
-        Neon::EdgeBackgroundShiftRangeMasked(value, valueStride, width, height, background, backgroundStride, mask, maskStride);
-    else
+        if (Neon::Enable && width >= Neon::A)
+            Neon::EdgeBackgroundShiftRangeMasked(value, valueStride, width, height, background, backgroundStride, mask, maskStride);
+        else
 #endif
-        Base::EdgeBackgroundShiftRangeMasked(value, valueStride, width, height, background, backgroundStride, mask, maskStride);
+            Base::EdgeBackgroundShiftRangeMasked(value, valueStride, width, height, background, backgroundStride, mask, maskStride);
+    };
+    ParallelTiles(width, height, 3, [&](size_t begin, size_t end)
+    {
+        kernel(value + begin*valueStride, end - begin, background + begin*backgroundStride, mask + begin*maskStride);
+    });
 }
 
 SIMD_API void SimdFill(uint8_t * dst, size_t stride, size_t width, size_t height, size_t pixelSize, uint8_t value)
@@ -1951,37 +2164,41 @@ SIMD_API void SimdUint8ToFloat32(const uint8_t * src, size_t size, const float *
 SIMD_API void SimdGaussianBlur3x3(const uint8_t * src, size_t srcStride, size_t width, size_t height,
                      size_t channelCount, uint8_t * dst, size_t dstStride)
 {
+    auto kernel = [=](const uint8_t * src, size_t height, uint8_t * dst, size_t dstStride)
+    {
 #ifdef SIMD_AVX512BW_ENABLE
-    if (Avx512bw::Enable && (width - 1)*channelCount >= Avx512bw::A)
-        Avx512bw::GaussianBlur3x3(src, srcStride, width, height, channelCount, dst, dstStride);
-    else
+        if (Avx512bw::Enable && (width - 1)*channelCount >= Avx512bw::A)
+            Avx512bw::GaussianBlur3x3(src, srcStride, width, height, channelCount, dst, dstStride);
+        else
 #endif
 #ifdef SIMD_AVX2_ENABLE
-    if(Avx2::Enable && (width - 1)*channelCount >= Avx2::A)
-        Avx2::GaussianBlur3x3(src, srcStride, width, height, channelCount, dst, dstStride);
-    else
+        if(Avx2::Enable && (width - 1)*channelCount >= Avx2::A)
+            Avx2::GaussianBlur3x3(src, srcStride, width, height, channelCount, dst, dstStride);
+        else
 #endif
 #ifdef SIMD_SSSE3_ENABLE
-    if(Ssse3::Enable && (width - 1)*channelCount >= Ssse3::A)
-        Ssse3::GaussianBlur3x3(src, srcStride, width, height, channelCount, dst, dstStride);
-    else
+        if(Ssse3::Enable && (width - 1)*channelCount >= Ssse3::A)
+            Ssse3::GaussianBlur3x3(src, srcStride, width, height, channelCount, dst, dstStride);
+        else
 #endif
 #ifdef SIMD_SSE2_ENABLE
-    if(Sse2::Enable && (width - 1)*channelCount >= Sse2::A)
-        Sse2::GaussianBlur3x3(src, srcStride, width, height, channelCount, dst, dstStride);
-    else
+        if(Sse2::Enable && (width - 1)*channelCount >= Sse2::A)
+            Sse2::GaussianBlur3x3(src, srcStride, width, height, channelCount, dst, dstStride);
+        else
 #endif
 #ifdef SIMD_VMX_ENABLE
-    if(Vmx::Enable && (width - 1)*channelCount >= Vmx::A)
-        Vmx::GaussianBlur3x3(src, srcStride, width, height, channelCount, dst, dstStride);
-    else
+        if(Vmx::Enable && (width - 1)*channelCount >= Vmx::A)
+            Vmx::GaussianBlur3x3(src, srcStride, width, height, channelCount, dst, dstStride);
+        else
 #endif
 #ifdef SIMD_NEON_ENABLE
-    if (Neon::Enable && (width - 1)*channelCount >= Neon::A)
-        Neon::GaussianBlur3x3(src, srcStride, width, height, channelCount, dst, dstStride);
-    else
+        if (Neon::Enable && (width - 1)*channelCount >= Neon::A)
+            Neon::GaussianBlur3x3(src, srcStride, width, height, channelCount, dst, dstStride);
+        else
 #endif
-        Base::GaussianBlur3x3(src, srcStride, width, height, channelCount, dst, dstStride);
+            Base::GaussianBlur3x3(src, srcStride, width, height, channelCount, dst, dstStride);
+    };
+    ParallelFilter(src, srcStride, width, height, 1, width*channelCount, dst, dstStride, kernel);
 }
 
 SIMD_API void SimdGrayToBgr(const uint8_t * gray, size_t width, size_t height, size_t grayStride, uint8_t * bgr, size_t bgrStride)
@@ -2657,67 +2874,75 @@ SIMD_API void SimdInterleaveBgra(const uint8_t * b, size_t bStride, const uint8_
 
 SIMD_API void SimdLaplace(const uint8_t * src, size_t srcStride, size_t width, size_t height, uint8_t * dst, size_t dstStride)
 {
+    auto kernel = [=](const uint8_t * src, size_t height, uint8_t * dst, size_t dstStride)
+    {
 #ifdef SIMD_AVX512BW_ENABLE
-    if (Avx512bw::Enable && width > Avx512bw::A)
-        Avx512bw::Laplace(src, srcStride, width, height, dst, dstStride);
-    else
+        if (Avx512bw::Enable && width > Avx512bw::A)
+            Avx512bw::Laplace(src, srcStride, width, height, dst, dstStride);
+        else
 #endif
 #ifdef SIMD_AVX2_ENABLE
-    if(Avx2::Enable && width > Avx2::A)
-        Avx2::Laplace(src, srcStride, width, height, dst, dstStride);
-    else
+        if(Avx2::Enable && width > Avx2::A)
+            Avx2::Laplace(src, srcStride, width, height, dst, dstStride);
+        else
 #endif
 #ifdef SIMD_SSSE3_ENABLE
-    if(Ssse3::Enable && width > Ssse3::A)
-        Ssse3::Laplace(src, srcStride, width, height, dst, dstStride);
-    else
+        if(Ssse3::Enable && width > Ssse3::A)
+            Ssse3::Laplace(src, srcStride, width, height, dst, dstStride);
+        else
 #endif
 #ifdef SIMD_SSE2_ENABLE
-    if(Sse2::Enable && width > Sse2::A)
-        Sse2::Laplace(src, srcStride, width, height, dst, dstStride);
-    else
+        if(Sse2::Enable && width > Sse2::A)
+            Sse2::Laplace(src, srcStride, width, height, dst, dstStride);
+        else
 #endif
 #ifdef SIMD_VMX_ENABLE
-    if(Vmx::Enable && width > Vmx::A)
-        Vmx::Laplace(src, srcStride, width, height, dst, dstStride);
-    else
+        if(Vmx::Enable && width > Vmx::A)
+            Vmx::Laplace(src, srcStride, width, height, dst, dstStride);
+        else
 #endif
 #ifdef SIMD_NEON_ENABLE
-    if (Neon::Enable && width > Neon::A)
-        Neon::Laplace(src, srcStride, width, height, dst, dstStride);
-    else
+        if (Neon::Enable && width > Neon::A)
+            Neon::Laplace(src, srcStride, width, height, dst, dstStride);
+        else
 #endif
-        Base::Laplace(src, srcStride, width, height, dst, dstStride);
+            Base::Laplace(src, srcStride, width, height, dst, dstStride);
+    };
+    ParallelFilter(src, srcStride, width, height, 1, 2 * width, dst, dstStride, kernel);
 }
 
 SIMD_API void SimdLaplaceAbs(const uint8_t * src, size_t srcStride, size_t width, size_t height, uint8_t * dst, size_t dstStride)
 {
+    auto kernel = [=](const uint8_t * src, size_t height, uint8_t * dst, size_t dstStride)
+    {
 #ifdef SIMD_AVX512BW_ENABLE
-    if (Avx512bw::Enable && width > Avx512bw::A)
-        Avx512bw::LaplaceAbs(src, srcStride, width, height, dst, dstStride);
-    else
+        if (Avx512bw::Enable && width > Avx512bw::A)
+            Avx512bw::LaplaceAbs(src, srcStride, width, height, dst, dstStride);
+        else
 #endif
 #ifdef SIMD_AVX2_ENABLE
-    if(Avx2::Enable && width > Avx2::A)
-        Avx2::LaplaceAbs(src, srcStride, width, height, dst, dstStride);
-    else
+        if(Avx2::Enable && width > Avx2::A)
+            Avx2::LaplaceAbs(src, srcStride, width, height, dst, dstStride);
+        else
 #endif
 #ifdef SIMD_SSSE3_ENABLE
-    if(Ssse3::Enable && width > Ssse3::A)
-        Ssse3::LaplaceAbs(src, srcStride, width, height, dst, dstStride);
-    else
+        if(Ssse3::Enable && width > Ssse3::A)
+            Ssse3::LaplaceAbs(src, srcStride, width, height, dst, dstStride);
+        else
 #endif
 #ifdef SIMD_VMX_ENABLE
-    if(Vmx::Enable && width > Vmx::A)
-        Vmx::LaplaceAbs(src, srcStride, width, height, dst, dstStride);
-    else
+        if(Vmx::Enable && width > Vmx::A)
+            Vmx::LaplaceAbs(src, srcStride, width, height, dst, dstStride);
+        else
 #endif
 #ifdef SIMD_NEON_ENABLE
-    if (Neon::Enable && width > Neon::A)
-        Neon::LaplaceAbs(src, srcStride, width, height, dst, dstStride);
-    else
+        if (Neon::Enable && width > Neon::A)
+            Neon::LaplaceAbs(src, srcStride, width, height, dst, dstStride);
+        else
 #endif
-        Base::LaplaceAbs(src, srcStride, width, height, dst, dstStride);
+            Base::LaplaceAbs(src, srcStride, width, height, dst, dstStride);
+    };
+    ParallelFilter(src, srcStride, width, height, 1, 2 * width, dst, dstStride, kernel);
 }
 
 SIMD_API void SimdLaplaceAbsSum(const uint8_t * src, size_t stride, size_t width, size_t height, uint64_t * sum)
@@ -2782,157 +3007,177 @@ SIMD_API void SimdLbpEstimate(const uint8_t * src, size_t srcStride, size_t widt
 
 SIMD_API void SimdMeanFilter3x3(const uint8_t * src, size_t srcStride, size_t width, size_t height, size_t channelCount, uint8_t * dst, size_t dstStride)
 {
+    auto kernel = [=](const uint8_t * src, size_t height, uint8_t * dst, size_t dstStride)
+    {
 #ifdef SIMD_AVX512BW_ENABLE
-    if (Avx512bw::Enable && (width - 1)*channelCount >= Avx512bw::A)
-        Avx512bw::MeanFilter3x3(src, srcStride, width, height, channelCount, dst, dstStride);
-    else
+        if (Avx512bw::Enable && (width - 1)*channelCount >= Avx512bw::A)
+            Avx512bw::MeanFilter3x3(src, srcStride, width, height, channelCount, dst, dstStride);
+        else
 #endif
 #ifdef SIMD_AVX2_ENABLE
-    if (Avx2::Enable && (width - 1)*channelCount >= Avx2::A)
-        Avx2::MeanFilter3x3(src, srcStride, width, height, channelCount, dst, dstStride);
-    else
+        if (Avx2::Enable && (width - 1)*channelCount >= Avx2::A)
+            Avx2::MeanFilter3x3(src, srcStride, width, height, channelCount, dst, dstStride);
+        else
 #endif
 #ifdef SIMD_SSSE3_ENABLE
-    if (Ssse3::Enable && (width - 1)*channelCount >= Ssse3::A)
-        Ssse3::MeanFilter3x3(src, srcStride, width, height, channelCount, dst, dstStride);
-    else
+        if (Ssse3::Enable && (width - 1)*channelCount >= Ssse3::A)
+            Ssse3::MeanFilter3x3(src, srcStride, width, height, channelCount, dst, dstStride);
+        else
 #endif
 #ifdef SIMD_SSE2_ENABLE
-    if (Sse2::Enable && (width - 1)*channelCount >= Sse2::A)
-        Sse2::MeanFilter3x3(src, srcStride, width, height, channelCount, dst, dstStride);
-    else
+        if (Sse2::Enable && (width - 1)*channelCount >= Sse2::A)
+            Sse2::MeanFilter3x3(src, srcStride, width, height, channelCount, dst, dstStride);
+        else
 #endif
 #ifdef SIMD_VMX_ENABLE
-    if (Vmx::Enable && (width - 1)*channelCount >= Vmx::A)
-        Vmx::MeanFilter3x3(src, srcStride, width, height, channelCount, dst, dstStride);
-    else
+        if (Vmx::Enable && (width - 1)*channelCount >= Vmx::A)
+            Vmx::MeanFilter3x3(src, srcStride, width, height, channelCount, dst, dstStride);
+        else
 #endif
 #ifdef SIMD_NEON_ENABLE
-    if (Neon::Enable && (width - 1)*channelCount >= Neon::A)
-        Neon::MeanFilter3x3(src, srcStride, width, height, channelCount, dst, dstStride);
-    else
+        if (Neon::Enable && (width - 1)*channelCount >= Neon::A)
+            Neon::MeanFilter3x3(src, srcStride, width, height, channelCount, dst, dstStride);
+        else
 #endif
-        Base::MeanFilter3x3(src, srcStride, width, height, channelCount, dst, dstStride);
+            Base::MeanFilter3x3(src, srcStride, width, height, channelCount, dst, dstStride);
+    };
+    ParallelFilter(src, srcStride, width, height, 1, width*channelCount, dst, dstStride, kernel);
 }
 
 SIMD_API void SimdMedianFilterRhomb3x3(const uint8_t * src, size_t srcStride, size_t width, size_t height, size_t channelCount, uint8_t * dst, size_t dstStride)
 {
+    auto kernel = [=](const uint8_t * src, size_t height, uint8_t * dst, size_t dstStride)
+    {
 #ifdef SIMD_AVX512BW_ENABLE
-    if (Avx512bw::Enable && (width - 1)*channelCount >= Avx512bw::A)
-        Avx512bw::MedianFilterRhomb3x3(src, srcStride, width, height, channelCount, dst, dstStride);
-    else
+        if (Avx512bw::Enable && (width - 1)*channelCount >= Avx512bw::A)
+            Avx512bw::MedianFilterRhomb3x3(src, srcStride, width, height, channelCount, dst, dstStride);
+        else
 #endif
 #ifdef SIMD_AVX2_ENABLE
-    if(Avx2::Enable && (width - 1)*channelCount >= Avx2::A)
-        Avx2::MedianFilterRhomb3x3(src, srcStride, width, height, channelCount, dst, dstStride);
-    else
+        if(Avx2::Enable && (width - 1)*channelCount >= Avx2::A)
+            Avx2::MedianFilterRhomb3x3(src, srcStride, width, height, channelCount, dst, dstStride);
+        else
 #endif
 #ifdef SIMD_SSE2_ENABLE
-    if(Sse2::Enable && (width - 1)*channelCount >= Sse2::A)
-        Sse2::MedianFilterRhomb3x3(src, srcStride, width, height, channelCount, dst, dstStride);
-    else
+        if(Sse2::Enable && (width - 1)*channelCount >= Sse2::A)
+            Sse2::MedianFilterRhomb3x3(src, srcStride, width, height, channelCount, dst, dstStride);
+        else
 #endif
 #ifdef SIMD_VMX_ENABLE
-    if(Vmx::Enable && (width - 1)*channelCount >= Vmx::A)
-        Vmx::MedianFilterRhomb3x3(src, srcStride, width, height, channelCount, dst, dstStride);
-    else
+        if(Vmx::Enable && (width - 1)*channelCount >= Vmx::A)
+            Vmx::MedianFilterRhomb3x3(src, srcStride, width, height, channelCount, dst, dstStride);
+        else
 #endif
 #ifdef SIMD_NEON_ENABLE
-    if (Neon::Enable && (width - 1)*channelCount >= Neon::A)
-        Neon::MedianFilterRhomb3x3(src, srcStride, width, height, channelCount, dst, dstStride);
-    else
+        if (Neon::Enable && (width - 1)*channelCount >= Neon::A)
+            Neon::MedianFilterRhomb3x3(src, srcStride, width, height, channelCount, dst, dstStride);
+        else
 #endif
-        Base::MedianFilterRhomb3x3(src, srcStride, width, height, channelCount, dst, dstStride);
+            Base::MedianFilterRhomb3x3(src, srcStride, width, height, channelCount, dst, dstStride);
+    };
+    ParallelFilter(src, srcStride, width, height, 1, width*channelCount, dst, dstStride, kernel);
 }
 
 SIMD_API void SimdMedianFilterRhomb5x5(const uint8_t * src, size_t srcStride, size_t width, size_t height, size_t channelCount, uint8_t * dst, size_t dstStride)
 {
+    auto kernel = [=](const uint8_t * src, size_t height, uint8_t * dst, size_t dstStride)
+    {
 #ifdef SIMD_AVX512BW_ENABLE
-    if (Avx512bw::Enable && (width - 2)*channelCount >= Avx512bw::A)
-        Avx512bw::MedianFilterRhomb5x5(src, srcStride, width, height, channelCount, dst, dstStride);
-    else
+        if (Avx512bw::Enable && (width - 2)*channelCount >= Avx512bw::A)
+            Avx512bw::MedianFilterRhomb5x5(src, srcStride, width, height, channelCount, dst, dstStride);
+        else
 #endif
 #ifdef SIMD_AVX2_ENABLE
-    if(Avx2::Enable && (width - 2)*channelCount >= Avx2::A)
-        Avx2::MedianFilterRhomb5x5(src, srcStride, width, height, channelCount, dst, dstStride);
-    else
+        if(Avx2::Enable && (width - 2)*channelCount >= Avx2::A)
+            Avx2::MedianFilterRhomb5x5(src, srcStride, width, height, channelCount, dst, dstStride);
+        else
 #endif
 #ifdef SIMD_SSE2_ENABLE
-    if(Sse2::Enable && (width - 2)*channelCount >= Sse2::A)
-        Sse2::MedianFilterRhomb5x5(src, srcStride, width, height, channelCount, dst, dstStride);
-    else
+        if(Sse2::Enable && (width - 2)*channelCount >= Sse2::A)
+            Sse2::MedianFilterRhomb5x5(src, srcStride, width, height, channelCount, dst, dstStride);
+        else
 #endif
 #ifdef SIMD_VMX_ENABLE
-    if(Vmx::Enable && (width - 2)*channelCount >= Vmx::A)
-        Vmx::MedianFilterRhomb5x5(src, srcStride, width, height, channelCount, dst, dstStride);
-    else
+        if(Vmx::Enable && (width - 2)*channelCount >= Vmx::A)
+            Vmx::MedianFilterRhomb5x5(src, srcStride, width, height, channelCount, dst, dstStride);
+        else
 #endif
 #ifdef SIMD_NEON_ENABLE
-    if (Neon::Enable && (width - 2)*channelCount >= Neon::A)
-        Neon::MedianFilterRhomb5x5(src, srcStride, width, height, channelCount, dst, dstStride);
-    else
+        if (Neon::Enable && (width - 2)*channelCount >= Neon::A)
+            Neon::MedianFilterRhomb5x5(src, srcStride, width, height, channelCount, dst, dstStride);
+        else
 #endif
-        Base::MedianFilterRhomb5x5(src, srcStride, width, height, channelCount, dst, dstStride);
+            Base::MedianFilterRhomb5x5(src, srcStride, width, height, channelCount, dst, dstStride);
+    };
+    ParallelFilter(src, srcStride, width, height, 2, width*channelCount, dst, dstStride, kernel);
 }
 
 SIMD_API void SimdMedianFilterSquare3x3(const uint8_t * src, size_t srcStride, size_t width, size_t height, size_t channelCount, uint8_t * dst, size_t dstStride)
 {
+    auto kernel = [=](const uint8_t * src, size_t height, uint8_t * dst, size_t dstStride)
+    {
 #ifdef SIMD_AVX512BW_ENABLE
-    if (Avx512bw::Enable && (width - 1)*channelCount >= Avx512bw::A)
-        Avx512bw::MedianFilterSquare3x3(src, srcStride, width, height, channelCount, dst, dstStride);
-    else
+        if (Avx512bw::Enable && (width - 1)*channelCount >= Avx512bw::A)
+            Avx512bw::MedianFilterSquare3x3(src, srcStride, width, height, channelCount, dst, dstStride);
+        else
 #endif
 #ifdef SIMD_AVX2_ENABLE
-    if(Avx2::Enable && (width - 1)*channelCount >= Avx2::A)
-        Avx2::MedianFilterSquare3x3(src, srcStride, width, height, channelCount, dst, dstStride);
-    else
+        if(Avx2::Enable && (width - 1)*channelCount >= Avx2::A)
+            Avx2::MedianFilterSquare3x3(src, srcStride, width, height, channelCount, dst, dstStride);
+        else
 #endif
 #ifdef SIMD_SSE2_ENABLE
-    if(Sse2::Enable && (width - 1)*channelCount >= Sse2::A)
-        Sse2::MedianFilterSquare3x3(src, srcStride, width, height, channelCount, dst, dstStride);
-    else
+        if(Sse2::Enable && (width - 1)*channelCount >= Sse2::A)
+            Sse2::MedianFilterSquare3x3(src, srcStride, width, height, channelCount, dst, dstStride);
+        else
 #endif
 #ifdef SIMD_VMX_ENABLE
-    if(Vmx::Enable && (width - 1)*channelCount >= Vmx::A)
-        Vmx::MedianFilterSquare3x3(src, srcStride, width, height, channelCount, dst, dstStride);
-    else
+        if(Vmx::Enable && (width - 1)*channelCount >= Vmx::A)
+            Vmx::MedianFilterSquare3x3(src, srcStride, width, height, channelCount, dst, dstStride);
+        else
 #endif
 #ifdef SIMD_NEON_ENABLE
-    if (Neon::Enable && (width - 1)*channelCount >= Neon::A)
-        Neon::MedianFilterSquare3x3(src, srcStride, width, height, channelCount, dst, dstStride);
-    else
+        if (Neon::Enable && (width - 1)*channelCount >= Neon::A)
+            Neon::MedianFilterSquare3x3(src, srcStride, width, height, channelCount, dst, dstStride);
+        else
 #endif
-        Base::MedianFilterSquare3x3(src, srcStride, width, height, channelCount, dst, dstStride);
+            Base::MedianFilterSquare3x3(src, srcStride, width, height, channelCount, dst, dstStride);
+    };
+    ParallelFilter(src, srcStride, width, height, 1, width*channelCount, dst, dstStride, kernel);
 }
 
 SIMD_API void SimdMedianFilterSquare5x5(const uint8_t * src, size_t srcStride, size_t width, size_t height, size_t channelCount, uint8_t * dst, size_t dstStride)
 {
+    auto kernel = [=](const uint8_t * src, size_t height, uint8_t * dst, size_t dstStride)
+    {
 #ifdef SIMD_AVX512BW_ENABLE
-    if (Avx512bw::Enable && (width - 2)*channelCount >= Avx512bw::A)
-        Avx512bw::MedianFilterSquare5x5(src, srcStride, width, height, channelCount, dst, dstStride);
-    else
+        if (Avx512bw::Enable && (width - 2)*channelCount >= Avx512bw::A)
+            Avx512bw::MedianFilterSquare5x5(src, srcStride, width, height, channelCount, dst, dstStride);
+        else
 #endif
 #ifdef SIMD_AVX2_ENABLE
-    if(Avx2::Enable && (width - 2)*channelCount >= Avx2::A)
-        Avx2::MedianFilterSquare5x5(src, srcStride, width, height, channelCount, dst, dstStride);
-    else
+        if(Avx2::Enable && (width - 2)*channelCount >= Avx2::A)
+            Avx2::MedianFilterSquare5x5(src, srcStride, width, height, channelCount, dst, dstStride);
+        else
 #endif
 #ifdef SIMD_SSE2_ENABLE
-    if(Sse2::Enable && (width - 2)*channelCount >= Sse2::A)
-        Sse2::MedianFilterSquare5x5(src, srcStride, width, height, channelCount, dst, dstStride);
-    else
+        if(Sse2::Enable && (width - 2)*channelCount >= Sse2::A)
+            Sse2::MedianFilterSquare5x5(src, srcStride, width, height, channelCount, dst, dstStride);
+        else
 #endif
 #ifdef SIMD_VMX_ENABLE
-    if(Vmx::Enable && (width - 2)*channelCount >= Vmx::A)
-        Vmx::MedianFilterSquare5x5(src, srcStride, width, height, channelCount, dst, dstStride);
-    else
+        if(Vmx::Enable && (width - 2)*channelCount >= Vmx::A)
+            Vmx::MedianFilterSquare5x5(src, srcStride, width, height, channelCount, dst, dstStride);
+        else
 #endif
 #ifdef SIMD_NEON_ENABLE
-    if (Neon::Enable && (width - 2)*channelCount >= Neon::A)
-        Neon::MedianFilterSquare5x5(src, srcStride, width, height, channelCount, dst, dstStride);
-    else
+        if (Neon::Enable && (width - 2)*channelCount >= Neon::A)
+            Neon::MedianFilterSquare5x5(src, srcStride, width, height, channelCount, dst, dstStride);
+        else
 #endif
-        Base::MedianFilterSquare5x5(src, srcStride, width, height, channelCount, dst, dstStride);
+            Base::MedianFilterSquare5x5(src, srcStride, width, height, channelCount, dst, dstStride);
+    };
+    ParallelFilter(src, srcStride, width, height, 2, width*channelCount, dst, dstStride, kernel);
 }
 
 SIMD_API void SimdNeuralConvert(const uint8_t * src, size_t srcStride, size_t width, size_t height, float * dst, size_t dstStride, int inversion)
@@ -2973,6 +3218,22 @@ SIMD_API void SimdNeuralProductSum(const float * a, const float * b, size_t size
     simdNeuralProductSum(a, b, size, sum);
 }
 
+typedef void(*SimdNeuralProductSum16fPtr) (const float * a, const uint16_t * b, size_t size, float * sum);
+SimdNeuralProductSum16fPtr simdNeuralProductSum16f = SIMD_FUNC2(NeuralProductSum16f, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC);
+
+SIMD_API void SimdNeuralProductSum16f(const float * a, const uint16_t * b, size_t size, float * sum)
+{
+    simdNeuralProductSum16f(a, b, size, sum);
+}
+
+typedef void(*SimdNeuralProductSum8iPtr) (size_t M, size_t N, size_t K, const int8_t * a, const uint8_t * b, int32_t * c);
+SimdNeuralProductSum8iPtr simdNeuralProductSum8i = SIMD_FUNC2(NeuralProductSum8i, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC);
+
+SIMD_API void SimdNeuralProductSum8i(size_t M, size_t N, size_t K, const int8_t * a, const uint8_t * b, int32_t * c)
+{
+    simdNeuralProductSum8i(M, N, K, a, b, c);
+}
+
 typedef void(*SimdNeuralAddVectorMultipliedByValuePtr) (const float * src, size_t size, const float * value, float * dst);
 SimdNeuralAddVectorMultipliedByValuePtr simdNeuralAddVectorMultipliedByValue = SIMD_FUNC5(NeuralAddVectorMultipliedByValue, SIMD_AVX512F_FUNC, SIMD_AVX2_FUNC, SIMD_AVX_FUNC, SIMD_SSE_FUNC, SIMD_NEON_FUNC);
 
@@ -3464,6 +3725,29 @@ SIMD_API void SimdNeuralConvolutionForward(const float * src, size_t srcWidth, s
     simdNeuralConvolutionForward(src, srcWidth, srcHeight, srcDepth, weight, kernelX, kernelY, padX, padY, strideX, strideY, dilationX, dilationY, buffer, size, dst, dstWidth, dstHeight, dstDepth, add);
 }
 
+typedef void*(*SimdNeuralConvolutionInitPtr) (size_t srcWidth, size_t srcHeight, size_t srcDepth, const float * weight, size_t kernelX, size_t kernelY, 
+    size_t padX, size_t padY, size_t strideX, size_t strideY, size_t dilationX, size_t dilationY, size_t dstWidth, size_t dstHeight, size_t dstDepth,
+    const float * bias, SimdNeuralActivationType activation, const float * slope);
+volatile SimdNeuralConvolutionInitPtr simdNeuralConvolutionInit = SIMD_FUNC4(NeuralConvolutionInit, SIMD_AVX512F_FUNC, SIMD_AVX2_FUNC, SIMD_AVX_FUNC, SIMD_SSE3_FUNC);
+
+SIMD_API void * SimdNeuralConvolutionInit(size_t srcWidth, size_t srcHeight, size_t srcDepth, const float * weight, size_t kernelX, size_t kernelY, 
+    size_t padX, size_t padY, size_t strideX, size_t strideY, size_t dilationX, size_t dilationY, size_t dstWidth, size_t dstHeight, size_t dstDepth,
+    const float * bias, SimdNeuralActivationType activation, const float * slope)
+{
+    return simdNeuralConvolutionInit(srcWidth, srcHeight, srcDepth, weight, kernelX, kernelY, padX, padY, strideX, strideY, dilationX, dilationY, dstWidth, dstHeight, dstDepth,
+        bias, activation, slope);
+}
+
+SIMD_API void SimdNeuralConvolutionRun(const void * context, const float * src, void * buffer, size_t * size, float * dst, int add)
+{
+    Base::NeuralConvolutionRun(context, src, buffer, size, dst, add);
+}
+
+SIMD_API void SimdNeuralConvolutionFree(void * context)
+{
+    Base::NeuralConvolutionFree(context);
+}
+
 SIMD_API void SimdOperationBinary8u(const uint8_t * a, size_t aStride, const uint8_t * b, size_t bStride,
                size_t width, size_t height, size_t channelCount, uint8_t * dst, size_t dstStride, SimdOperationBinary8uType type)
 {
@@ -3805,40 +4089,42 @@ SIMD_API void SimdReorder64bit(const uint8_t * src, size_t size, uint8_t * dst)
         Base::Reorder64bit(src, size, dst);
 }
 
+static Dispatch<decltype(&Base::ResizeBilinear)> g_resizeBilinear("SimdResizeBilinear", Base::ResizeBilinear,
+{
+    SIMD_AVX512BW_DISPATCH(ResizeBilinear, Avx512bw::A)
+    SIMD_AVX2_DISPATCH(ResizeBilinear, Avx2::A)
+    SIMD_SSSE3_DISPATCH(ResizeBilinear, Ssse3::A)
+    SIMD_SSE2_DISPATCH(ResizeBilinear, Sse2::A)
+    SIMD_VMX_DISPATCH(ResizeBilinear, Vmx::A)
+    SIMD_NEON_DISPATCH(ResizeBilinear, Neon::A)
+});
+
+static Dispatch<decltype(&Base::ResizeBilinearRows)> g_resizeBilinearRows("SimdResizeBilinear", Base::ResizeBilinearRows,
+{
+    SIMD_AVX512BW_DISPATCH(ResizeBilinearRows, Avx512bw::A)
+    SIMD_AVX2_DISPATCH(ResizeBilinearRows, Avx2::A)
+    SIMD_SSSE3_DISPATCH(ResizeBilinearRows, Ssse3::A)
+    SIMD_SSE2_DISPATCH(ResizeBilinearRows, Sse2::A)
+});
+
 SIMD_API void SimdResizeBilinear(const uint8_t *src, size_t srcWidth, size_t srcHeight, size_t srcStride,
     uint8_t *dst, size_t dstWidth, size_t dstHeight, size_t dstStride, size_t channelCount)
 {
-#ifdef SIMD_AVX512BW_ENABLE
-    if (Avx512bw::Enable && dstWidth >= Avx512bw::A)
-        Avx512bw::ResizeBilinear(src, srcWidth, srcHeight, srcStride, dst, dstWidth, dstHeight, dstStride, channelCount);
-    else
-#endif
-#ifdef SIMD_AVX2_ENABLE
-    if(Avx2::Enable && dstWidth >= Avx2::A)
-        Avx2::ResizeBilinear(src, srcWidth, srcHeight, srcStride, dst, dstWidth, dstHeight, dstStride, channelCount);
-    else
-#endif
-#ifdef SIMD_SSSE3_ENABLE
-    if(Ssse3::Enable && dstWidth >= Ssse3::A)
-        Ssse3::ResizeBilinear(src, srcWidth, srcHeight, srcStride, dst, dstWidth, dstHeight, dstStride, channelCount);
-    else
-#endif
-#ifdef SIMD_SSE2_ENABLE
-    if(Sse2::Enable && dstWidth >= Sse2::A)
-        Sse2::ResizeBilinear(src, srcWidth, srcHeight, srcStride, dst, dstWidth, dstHeight, dstStride, channelCount);
-    else
-#endif
-#ifdef SIMD_VMX_ENABLE
-    if(Vmx::Enable && dstWidth >= Vmx::A)
-        Vmx::ResizeBilinear(src, srcWidth, srcHeight, srcStride, dst, dstWidth, dstHeight, dstStride, channelCount);
-    else
-#endif
-#ifdef SIMD_NEON_ENABLE
-    if (Neon::Enable && dstWidth >= Neon::A)
-        Neon::ResizeBilinear(src, srcWidth, srcHeight, srcStride, dst, dstWidth, dstHeight, dstStride, channelCount);
+    if (ThreadNumber() > 1 && g_resizeBilinearRows.Info() == g_resizeBilinear.Info())
+    {
+        ParallelRows(dstWidth*channelCount, dstHeight, 1, [&](size_t begin, size_t end)
+        {
+            g_resizeBilinearRows(dstWidth)(src, srcWidth, srcHeight, srcStride, dst, dstWidth, dstHeight, dstStride, channelCount, begin, end);
+        });
+    }
     else
-#endif
-        Base::ResizeBilinear(src, srcWidth, srcHeight, srcStride, dst, dstWidth, dstHeight, dstStride, channelCount);
+        g_resizeBilinear(dstWidth)(src, srcWidth, srcHeight, srcStride, dst, dstWidth, dstHeight, dstStride, channelCount);
+}
+
+SIMD_API void SimdResizeBilinearRows(const uint8_t *src, size_t srcWidth, size_t srcHeight, size_t srcStride,
+    uint8_t *dst, size_t dstWidth, size_t dstHeight, size_t dstStride, size_t channelCount, size_t yBegin, size_t yEnd)
+{
+    g_resizeBilinearRows(dstWidth)(src, srcWidth, srcHeight, srcStride, dst, dstWidth, dstHeight, dstStride, channelCount, yBegin, yEnd);
 }
 
 SIMD_API void SimdSegmentationChangeIndex(uint8_t * mask, size_t stride, size_t width, size_t height, uint8_t oldIndex, uint8_t newIndex)
@@ -3970,6 +4256,31 @@ SIMD_API void SimdSegmentationShrinkRegion(const uint8_t * mask, size_t stride,
         Base::SegmentationShrinkRegion(mask, stride, width, height, index, left, top, right, bottom);
 }
 
+SIMD_API size_t SimdSegmentationLabel(uint8_t * mask, size_t maskStride, size_t width, size_t height, const uint8_t * difference, size_t differenceStride,
+    uint8_t seedIndex, uint8_t emptyIndex, uint8_t invalidIndex, uint8_t differenceThreshold, size_t areaMin, uint8_t indexMin, ptrdiff_t * rects)
+{
+#ifdef SIMD_AVX512BW_ENABLE
+    if (Avx512bw::Enable && width >= Avx512bw::A)
+        return Avx512bw::SegmentationLabel(mask, maskStride, width, height, difference, differenceStride,
+            seedIndex, emptyIndex, invalidIndex, differenceThreshold, areaMin, indexMin, rects);
+    else
+#endif
+#ifdef SIMD_AVX2_ENABLE
+    if (Avx2::Enable && width >= Avx2::A)
+        return Avx2::SegmentationLabel(mask, maskStride, width, height, difference, differenceStride,
+            seedIndex, emptyIndex, invalidIndex, differenceThreshold, areaMin, indexMin, rects);
+    else
+#endif
+#ifdef SIMD_SSE2_ENABLE
+    if (Sse2::Enable && width >= Sse2::DA)
+        return Sse2::SegmentationLabel(mask, maskStride, width, height, difference, differenceStride,
+            seedIndex, emptyIndex, invalidIndex, differenceThreshold, areaMin, indexMin, rects);
+    else
+#endif
+        return Base::SegmentationLabel(mask, maskStride, width, height, difference, differenceStride,
+            seedIndex, emptyIndex, invalidIndex, differenceThreshold, areaMin, indexMin, rects);
+}
+
 SIMD_API void SimdShiftBilinear(const uint8_t * src, size_t srcStride, size_t width, size_t height, size_t channelCount,
     const uint8_t * bkg, size_t bkgStride, const double * shiftX, const double * shiftY,
     size_t cropLeft, size_t cropTop, size_t cropRight, size_t cropBottom, uint8_t * dst, size_t dstStride)
@@ -4010,67 +4321,75 @@ SIMD_API void SimdShiftBilinear(const uint8_t * src, size_t srcStride, size_t wi
 
 SIMD_API void SimdSobelDx(const uint8_t * src, size_t srcStride, size_t width, size_t height, uint8_t * dst, size_t dstStride)
 {
+    auto kernel = [=](const uint8_t * src, size_t height, uint8_t * dst, size_t dstStride)
+    {
 #ifdef SIMD_AVX512BW_ENABLE
-    if (Avx512bw::Enable && width > Avx512bw::A)
-        Avx512bw::SobelDx(src, srcStride, width, height, dst, dstStride);
-    else
+        if (Avx512bw::Enable && width > Avx512bw::A)
+            Avx512bw::SobelDx(src, srcStride, width, height, dst, dstStride);
+        else
 #endif
 #ifdef SIMD_AVX2_ENABLE
-    if(Avx2::Enable && width > Avx2::A)
-        Avx2::SobelDx(src, srcStride, width, height, dst, dstStride);
-    else
+        if(Avx2::Enable && width > Avx2::A)
+            Avx2::SobelDx(src, srcStride, width, height, dst, dstStride);
+        else
 #endif
 #ifdef SIMD_SSSE3_ENABLE
-    if(Ssse3::Enable && width > Ssse3::A)
-        Ssse3::SobelDx(src, srcStride, width, height, dst, dstStride);
-    else
+        if(Ssse3::Enable && width > Ssse3::A)
+            Ssse3::SobelDx(src, srcStride, width, height, dst, dstStride);
+        else
 #endif
 #ifdef SIMD_SSE2_ENABLE
-    if(Sse2::Enable && width > Sse2::A)
-        Sse2::SobelDx(src, srcStride, width, height, dst, dstStride);
-    else
+        if(Sse2::Enable && width > Sse2::A)
+            Sse2::SobelDx(src, srcStride, width, height, dst, dstStride);
+        else
 #endif
 #ifdef SIMD_VMX_ENABLE
-    if(Vmx::Enable && width > Vmx::A)
-        Vmx::SobelDx(src, srcStride, width, height, dst, dstStride);
-    else
+        if(Vmx::Enable && width > Vmx::A)
+            Vmx::SobelDx(src, srcStride, width, height, dst, dstStride);
+        else
 #endif
 #ifdef SIMD_NEON_ENABLE
-    if (Neon::Enable && width > Neon::A)
-        Neon::SobelDx(src, srcStride, width, height, dst, dstStride);
-    else
+        if (Neon::Enable && width > Neon::A)
+            Neon::SobelDx(src, srcStride, width, height, dst, dstStride);
+        else
 #endif
-        Base::SobelDx(src, srcStride, width, height, dst, dstStride);
+            Base::SobelDx(src, srcStride, width, height, dst, dstStride);
+    };
+    ParallelFilter(src, srcStride, width, height, 1, 2 * width, dst, dstStride, kernel);
 }
 
 SIMD_API void SimdSobelDxAbs(const uint8_t * src, size_t srcStride, size_t width, size_t height, uint8_t * dst, size_t dstStride)
 {
+    auto kernel = [=](const uint8_t * src, size_t height, uint8_t * dst, size_t dstStride)
+    {
 #ifdef SIMD_AVX512BW_ENABLE
-    if (Avx512bw::Enable && width > Avx512bw::A)
-        Avx512bw::SobelDxAbs(src, srcStride, width, height, dst, dstStride);
-    else
+        if (Avx512bw::Enable && width > Avx512bw::A)
+            Avx512bw::SobelDxAbs(src, srcStride, width, height, dst, dstStride);
+        else
 #endif
 #ifdef SIMD_AVX2_ENABLE
-    if(Avx2::Enable && width > Avx2::A)
-        Avx2::SobelDxAbs(src, srcStride, width, height, dst, dstStride);
-    else
+        if(Avx2::Enable && width > Avx2::A)
+            Avx2::SobelDxAbs(src, srcStride, width, height, dst, dstStride);
+        else
 #endif
 #ifdef SIMD_SSSE3_ENABLE
-    if(Ssse3::Enable && width > Ssse3::A)
-        Ssse3::SobelDxAbs(src, srcStride, width, height, dst, dstStride);
-    else
+        if(Ssse3::Enable && width > Ssse3::A)
+            Ssse3::SobelDxAbs(src, srcStride, width, height, dst, dstStride);
+        else
 #endif
 #ifdef SIMD_VMX_ENABLE
-    if(Vmx::Enable && width > Vmx::A)
-        Vmx::SobelDxAbs(src, srcStride, width, height, dst, dstStride);
-    else
+        if(Vmx::Enable && width > Vmx::A)
+            Vmx::SobelDxAbs(src, srcStride, width, height, dst, dstStride);
+        else
 #endif
 #ifdef SIMD_NEON_ENABLE
-    if (Neon::Enable && width > Neon::A)
-        Neon::SobelDxAbs(src, srcStride, width, height, dst, dstStride);
-    else
+        if (Neon::Enable && width > Neon::A)
+            Neon::SobelDxAbs(src, srcStride, width, height, dst, dstStride);
+        else
 #endif
-        Base::SobelDxAbs(src, srcStride, width, height, dst, dstStride);
+            Base::SobelDxAbs(src, srcStride, width, height, dst, dstStride);
+    };
+    ParallelFilter(src, srcStride, width, height, 1, 2 * width, dst, dstStride, kernel);
 }
 
 SIMD_API void SimdSobelDxAbsSum(const uint8_t * src, size_t stride, size_t width, size_t height, uint64_t * sum)
@@ -4105,67 +4424,75 @@ SIMD_API void SimdSobelDxAbsSum(const uint8_t * src, size_t stride, size_t width
 
 SIMD_API void SimdSobelDy(const uint8_t * src, size_t srcStride, size_t width, size_t height, uint8_t * dst, size_t dstStride)
 {
+    auto kernel = [=](const uint8_t * src, size_t height, uint8_t * dst, size_t dstStride)
+    {
 #ifdef SIMD_AVX512BW_ENABLE
-    if (Avx512bw::Enable && width > Avx512bw::A)
-        Avx512bw::SobelDy(src, srcStride, width, height, dst, dstStride);
-    else
+        if (Avx512bw::Enable && width > Avx512bw::A)
+            Avx512bw::SobelDy(src, srcStride, width, height, dst, dstStride);
+        else
 #endif
 #ifdef SIMD_AVX2_ENABLE
-    if(Avx2::Enable && width > Avx2::A)
-        Avx2::SobelDy(src, srcStride, width, height, dst, dstStride);
-    else
+        if(Avx2::Enable && width > Avx2::A)
+            Avx2::SobelDy(src, srcStride, width, height, dst, dstStride);
+        else
 #endif
 #ifdef SIMD_SSSE3_ENABLE
-    if(Ssse3::Enable && width > Ssse3::A)
-        Ssse3::SobelDy(src, srcStride, width, height, dst, dstStride);
-    else
+        if(Ssse3::Enable && width > Ssse3::A)
+            Ssse3::SobelDy(src, srcStride, width, height, dst, dstStride);
+        else
 #endif
 #ifdef SIMD_SSE2_ENABLE
-    if(Sse2::Enable && width > Sse2::A)
-        Sse2::SobelDy(src, srcStride, width, height, dst, dstStride);
-    else
+        if(Sse2::Enable && width > Sse2::A)
+            Sse2::SobelDy(src, srcStride, width, height, dst, dstStride);
+        else
 #endif
 #ifdef SIMD_VMX_ENABLE
-    if(Vmx::Enable && width > Vmx::A)
-        Vmx::SobelDy(src, srcStride, width, height, dst, dstStride);
-    else
+        if(Vmx::Enable && width > Vmx::A)
+            Vmx::SobelDy(src, srcStride, width, height, dst, dstStride);
+        else
 #endif
 #ifdef SIMD_NEON_ENABLE
-    if (Neon::Enable && width > Neon::A)
-        Neon::SobelDy(src, srcStride, width, height, dst, dstStride);
-    else
+        if (Neon::Enable && width > Neon::A)
+            Neon::SobelDy(src, srcStride, width, height, dst, dstStride);
+        else
 #endif
-        Base::SobelDy(src, srcStride, width, height, dst, dstStride);
+            Base::SobelDy(src, srcStride, width, height, dst, dstStride);
+    };
+    ParallelFilter(src, srcStride, width, height, 1, 2 * width, dst, dstStride, kernel);
 }
 
 SIMD_API void SimdSobelDyAbs(const uint8_t * src, size_t srcStride, size_t width, size_t height, uint8_t * dst, size_t dstStride)
 {
+    auto kernel = [=](const uint8_t * src, size_t height, uint8_t * dst, size_t dstStride)
+    {
 #ifdef SIMD_AVX512BW_ENABLE
-    if (Avx512bw::Enable && width > Avx512bw::A)
-        Avx512bw::SobelDyAbs(src, srcStride, width, height, dst, dstStride);
-    else
+        if (Avx512bw::Enable && width > Avx512bw::A)
+            Avx512bw::SobelDyAbs(src, srcStride, width, height, dst, dstStride);
+        else
 #endif
 #ifdef SIMD_AVX2_ENABLE
-    if(Avx2::Enable && width > Avx2::A)
-        Avx2::SobelDyAbs(src, srcStride, width, height, dst, dstStride);
-    else
+        if(Avx2::Enable && width > Avx2::A)
+            Avx2::SobelDyAbs(src, srcStride, width, height, dst, dstStride);
+        else
 #endif
 #ifdef SIMD_SSSE3_ENABLE
-    if(Ssse3::Enable && width > Ssse3::A)
-        Ssse3::SobelDyAbs(src, srcStride, width, height, dst, dstStride);
-    else
+        if(Ssse3::Enable && width > Ssse3::A)
+            Ssse3::SobelDyAbs(src, srcStride, width, height, dst, dstStride);
+        else
 #endif
 #ifdef SIMD_VMX_ENABLE
-    if(Vmx::Enable && width > Vmx::A)
-        Vmx::SobelDyAbs(src, srcStride, width, height, dst, dstStride);
-    else
+        if(Vmx::Enable && width > Vmx::A)
+            Vmx::SobelDyAbs(src, srcStride, width, height, dst, dstStride);
+        else
 #endif
 #ifdef SIMD_NEON_ENABLE
-    if (Neon::Enable && width > Neon::A)
-        Neon::SobelDyAbs(src, srcStride, width, height, dst, dstStride);
-    else
+        if (Neon::Enable && width > Neon::A)
+            Neon::SobelDyAbs(src, srcStride, width, height, dst, dstStride);
+        else
 #endif
-        Base::SobelDyAbs(src, srcStride, width, height, dst, dstStride);
+            Base::SobelDyAbs(src, srcStride, width, height, dst, dstStride);
+    };
+    ParallelFilter(src, srcStride, width, height, 1, 2 * width, dst, dstStride, kernel);
 }
 
 SIMD_API void SimdSobelDyAbsSum(const uint8_t * src, size_t stride, size_t width, size_t height, uint64_t * sum)
@@ -4289,76 +4616,36 @@ SIMD_API void SimdContourAnchors(const uint8_t * src, size_t srcStride, size_t w
         Base::ContourAnchors(src, srcStride, width, height, step, threshold, dst, dstStride);
 }
 
+static Dispatch<decltype(&Base::SquaredDifferenceSum)> g_squaredDifferenceSum("SimdSquaredDifferenceSum", Base::SquaredDifferenceSum,
+{
+    SIMD_AVX512BW_DISPATCH(SquaredDifferenceSum, 0)
+    SIMD_AVX2_DISPATCH(SquaredDifferenceSum, Avx2::A)
+    SIMD_SSSE3_DISPATCH(SquaredDifferenceSum, Ssse3::A)
+    SIMD_SSE2_DISPATCH(SquaredDifferenceSum, Sse2::A)
+    SIMD_VMX_DISPATCH(SquaredDifferenceSum, Vmx::A)
+    SIMD_NEON_DISPATCH(SquaredDifferenceSum, Neon::A)
+});
+
 SIMD_API void SimdSquaredDifferenceSum(const uint8_t *a, size_t aStride, const uint8_t *b, size_t bStride,
                           size_t width, size_t height, uint64_t * sum)
 {
-#ifdef SIMD_AVX512BW_ENABLE
-    if (Avx512bw::Enable)
-        Avx512bw::SquaredDifferenceSum(a, aStride, b, bStride, width, height, sum);
-    else
-#endif
-#ifdef SIMD_AVX2_ENABLE
-    if(Avx2::Enable && width >= Avx2::A)
-        Avx2::SquaredDifferenceSum(a, aStride, b, bStride, width, height, sum);
-    else
-#endif
-#ifdef SIMD_SSSE3_ENABLE
-    if(Ssse3::Enable && width >= Ssse3::A)
-        Ssse3::SquaredDifferenceSum(a, aStride, b, bStride, width, height, sum);
-    else
-#endif
-#ifdef SIMD_SSE2_ENABLE
-    if(Sse2::Enable && width >= Sse2::A)
-        Sse2::SquaredDifferenceSum(a, aStride, b, bStride, width, height, sum);
-    else
-#endif
-#ifdef SIMD_VMX_ENABLE
-    if(Vmx::Enable && width >= Vmx::A)
-        Vmx::SquaredDifferenceSum(a, aStride, b, bStride, width, height, sum);
-    else
-#endif
-#ifdef SIMD_NEON_ENABLE
-    if (Neon::Enable && width >= Neon::A)
-        Neon::SquaredDifferenceSum(a, aStride, b, bStride, width, height, sum);
-    else
-#endif
-        Base::SquaredDifferenceSum(a, aStride, b, bStride, width, height, sum);
+    g_squaredDifferenceSum(width)(a, aStride, b, bStride, width, height, sum);
 }
 
+static Dispatch<decltype(&Base::SquaredDifferenceSumMasked)> g_squaredDifferenceSumMasked("SimdSquaredDifferenceSumMasked", Base::SquaredDifferenceSumMasked,
+{
+    SIMD_AVX512BW_DISPATCH(SquaredDifferenceSumMasked, 0)
+    SIMD_AVX2_DISPATCH(SquaredDifferenceSumMasked, Avx2::A)
+    SIMD_SSSE3_DISPATCH(SquaredDifferenceSumMasked, Ssse3::A)
+    SIMD_SSE2_DISPATCH(SquaredDifferenceSumMasked, Sse2::A)
+    SIMD_VMX_DISPATCH(SquaredDifferenceSumMasked, Vmx::A)
+    SIMD_NEON_DISPATCH(SquaredDifferenceSumMasked, Neon::A)
+});
+
 SIMD_API void SimdSquaredDifferenceSumMasked(const uint8_t *a, size_t aStride, const uint8_t *b, size_t bStride,
                           const uint8_t *mask, size_t maskStride, uint8_t index, size_t width, size_t height, uint64_t * sum)
 {
-#ifdef SIMD_AVX512BW_ENABLE
-    if (Avx512bw::Enable)
-        Avx512bw::SquaredDifferenceSumMasked(a, aStride, b, bStride, mask, maskStride, index, width, height, sum);
-    else
-#endif
-#ifdef SIMD_AVX2_ENABLE
-    if(Avx2::Enable && width >= Avx2::A)
-        Avx2::SquaredDifferenceSumMasked(a, aStride, b, bStride, mask, maskStride, index, width, height, sum);
-    else
-#endif
-#ifdef SIMD_SSSE3_ENABLE
-    if(Ssse3::Enable && width >= Ssse3::A)
-        Ssse3::SquaredDifferenceSumMasked(a, aStride, b, bStride, mask, maskStride, index, width, height, sum);
-    else
-#endif
-#ifdef SIMD_SSE2_ENABLE
-    if(Sse2::Enable && width >= Sse2::A)
-        Sse2::SquaredDifferenceSumMasked(a, aStride, b, bStride, mask, maskStride, index, width, height, sum);
-    else
-#endif
-#ifdef SIMD_VMX_ENABLE
-    if(Vmx::Enable && width >= Vmx::A)
-        Vmx::SquaredDifferenceSumMasked(a, aStride, b, bStride, mask, maskStride, index, width, height, sum);
-    else
-#endif
-#ifdef SIMD_NEON_ENABLE
-    if (Neon::Enable && width >= Neon::A)
-        Neon::SquaredDifferenceSumMasked(a, aStride, b, bStride, mask, maskStride, index, width, height, sum);
-    else
-#endif
-        Base::SquaredDifferenceSumMasked(a, aStride, b, bStride, mask, maskStride, index, width, height, sum);
+    g_squaredDifferenceSumMasked(width)(a, aStride, b, bStride, mask, maskStride, index, width, height, sum);
 }
 
 typedef void (* SimdSquaredDifferenceSum32fPtr) (const float * a, const float * b, size_t size, float * sum);
@@ -4559,64 +4846,32 @@ SIMD_API void SimdGetAbsDxColSums(const uint8_t * src, size_t stride, size_t wid
         Base::GetAbsDxColSums(src, stride, width, height, sums);
 }
 
+static Dispatch<decltype(&Base::ValueSum)> g_valueSum("SimdValueSum", Base::ValueSum,
+{
+    SIMD_AVX512BW_DISPATCH(ValueSum, 0)
+    SIMD_AVX2_DISPATCH(ValueSum, Avx2::A)
+    SIMD_SSE2_DISPATCH(ValueSum, Sse2::A)
+    SIMD_VMX_DISPATCH(ValueSum, Vmx::A)
+    SIMD_NEON_DISPATCH(ValueSum, Neon::A)
+});
+
 SIMD_API void SimdValueSum(const uint8_t * src, size_t stride, size_t width, size_t height, uint64_t * sum)
 {
-#ifdef SIMD_AVX512BW_ENABLE
-    if (Avx512bw::Enable)
-        Avx512bw::ValueSum(src, stride, width, height, sum);
-    else
-#endif
-#ifdef SIMD_AVX2_ENABLE
-    if(Avx2::Enable && width >= Avx2::A)
-        Avx2::ValueSum(src, stride, width, height, sum);
-    else
-#endif
-#ifdef SIMD_SSE2_ENABLE
-    if(Sse2::Enable && width >= Sse2::A)
-        Sse2::ValueSum(src, stride, width, height, sum);
-    else
-#endif
-#ifdef SIMD_VMX_ENABLE
-    if(Vmx::Enable && width >= Vmx::A)
-        Vmx::ValueSum(src, stride, width, height, sum);
-    else
-#endif
-#ifdef SIMD_NEON_ENABLE
-    if (Neon::Enable && width >= Neon::A)
-        Neon::ValueSum(src, stride, width, height, sum);
-    else
-#endif
-        Base::ValueSum(src, stride, width, height, sum);
+    g_valueSum(width)(src, stride, width, height, sum);
 }
 
+static Dispatch<decltype(&Base::SquareSum)> g_squareSum("SimdSquareSum", Base::SquareSum,
+{
+    SIMD_AVX512BW_DISPATCH(SquareSum, 0)
+    SIMD_AVX2_DISPATCH(SquareSum, Avx2::A)
+    SIMD_SSE2_DISPATCH(SquareSum, Sse2::A)
+    SIMD_VMX_DISPATCH(SquareSum, Vmx::A)
+    SIMD_NEON_DISPATCH(SquareSum, Neon::A)
+});
+
 SIMD_API void SimdSquareSum(const uint8_t * src, size_t stride, size_t width, size_t height, uint64_t * sum)
 {
-#ifdef SIMD_AVX512BW_ENABLE
-    if (Avx512bw::Enable)
-        Avx512bw::SquareSum(src, stride, width, height, sum);
-    else
-#endif
-#ifdef SIMD_AVX2_ENABLE
-    if(Avx2::Enable && width >= Avx2::A)
-        Avx2::SquareSum(src, stride, width, height, sum);
-    else
-#endif
-#ifdef SIMD_SSE2_ENABLE
-    if(Sse2::Enable && width >= Sse2::A)
-        Sse2::SquareSum(src, stride, width, height, sum);
-    else
-#endif
-#ifdef SIMD_VMX_ENABLE
-    if(Vmx::Enable && width >= Vmx::A)
-        Vmx::SquareSum(src, stride, width, height, sum);
-    else
-#endif
-#ifdef SIMD_NEON_ENABLE
-    if (Neon::Enable && width >= Neon::A)
-        Neon::SquareSum(src, stride, width, height, sum);
-    else
-#endif
-        Base::SquareSum(src, stride, width, height, sum);
+    g_squareSum(width)(src, stride, width, height, sum);
 }
 
 SIMD_API void SimdCorrelationSum(const uint8_t * a, size_t aStride, const uint8_t * b, size_t bStride, size_t width, size_t height, uint64_t * sum)
@@ -4777,6 +5032,38 @@ SIMD_API void SimdTextureBoostedUv(const uint8_t * src, size_t srcStride, size_t
         Base::TextureBoostedUv(src, srcStride, width, height, boost, dst, dstStride);
 }
 
+SIMD_API void SimdTextureFeatureDifference(const uint8_t * gray, size_t grayStride, size_t width, size_t height, uint8_t saturation, uint8_t boost,
+    const uint8_t * grayLo, size_t grayLoStride, const uint8_t * grayHi, size_t grayHiStride, uint16_t grayWeight,
+    uint8_t * dx, size_t dxStride, const uint8_t * dxLo, size_t dxLoStride, const uint8_t * dxHi, size_t dxHiStride, uint16_t dxWeight,
+    uint8_t * dy, size_t dyStride, const uint8_t * dyLo, size_t dyLoStride, const uint8_t * dyHi, size_t dyHiStride, uint16_t dyWeight,
+    const uint8_t * mask, size_t maskStride, uint8_t * difference, size_t differenceStride)
+{
+#ifdef SIMD_AVX512BW_ENABLE
+    if (Avx512bw::Enable)
+        Avx512bw::TextureFeatureDifference(gray, grayStride, width, height, saturation, boost, grayLo, grayLoStride, grayHi, grayHiStride, grayWeight,
+            dx, dxStride, dxLo, dxLoStride, dxHi, dxHiStride, dxWeight, dy, dyStride, dyLo, dyLoStride, dyHi, dyHiStride, dyWeight,
+            mask, maskStride, difference, differenceStride);
+    else
+#endif
+#ifdef SIMD_AVX2_ENABLE
+    if (Avx2::Enable && width >= Avx2::A)
+        Avx2::TextureFeatureDifference(gray, grayStride, width, height, saturation, boost, grayLo, grayLoStride, grayHi, grayHiStride, grayWeight,
+            dx, dxStride, dxLo, dxLoStride, dxHi, dxHiStride, dxWeight, dy, dyStride, dyLo, dyLoStride, dyHi, dyHiStride, dyWeight,
+            mask, maskStride, difference, differenceStride);
+    else
+#endif
+#ifdef SIMD_SSE2_ENABLE
+    if (Sse2::Enable && width >= Sse2::A)
+        Sse2::TextureFeatureDifference(gray, grayStride, width, height, saturation, boost, grayLo, grayLoStride, grayHi, grayHiStride, grayWeight,
+            dx, dxStride, dxLo, dxLoStride, dxHi, dxHiStride, dxWeight, dy, dyStride, dyLo, dyLoStride, dyHi, dyHiStride, dyWeight,
+            mask, maskStride, difference, differenceStride);
+    else
+#endif
+        Base::TextureFeatureDifference(gray, grayStride, width, height, saturation, boost, grayLo, grayLoStride, grayHi, grayHiStride, grayWeight,
+            dx, dxStride, dxLo, dxLoStride, dxHi, dxHiStride, dxWeight, dy, dyStride, dyLo, dyLoStride, dyHi, dyHiStride, dyWeight,
+            mask, maskStride, difference, differenceStride);
+}
+
 SIMD_API void SimdTextureGetDifferenceSum(const uint8_t * src, size_t srcStride, size_t width, size_t height,
                              const uint8_t * lo, size_t loStride, const uint8_t * hi, size_t hiStride, int64_t * sum)
 {
@@ -4842,32 +5129,72 @@ SIMD_API void SimdTexturePerformCompensation(const uint8_t * src, size_t srcStri
 SIMD_API void SimdYuv420pToBgr(const uint8_t * y, size_t yStride, const uint8_t * u, size_t uStride, const uint8_t * v, size_t vStride,
                  size_t width, size_t height, uint8_t * bgr, size_t bgrStride)
 {
+    auto kernel = [=](const uint8_t * y, const uint8_t * u, const uint8_t * v, size_t height, uint8_t * bgr)
+    {
 #ifdef SIMD_AVX512BW_ENABLE
-    if (Avx512bw::Enable)
-        Avx512bw::Yuv420pToBgr(y, yStride, u, uStride, v, vStride, width, height, bgr, bgrStride);
-    else
+        if (Avx512bw::Enable)
+            Avx512bw::Yuv420pToBgr(y, yStride, u, uStride, v, vStride, width, height, bgr, bgrStride);
+        else
 #endif
 #ifdef SIMD_AVX2_ENABLE
-    if(Avx2::Enable && width >= Avx2::DA)
-        Avx2::Yuv420pToBgr(y, yStride, u, uStride, v, vStride, width, height, bgr, bgrStride);
-    else
+        if(Avx2::Enable && width >= Avx2::DA)
+            Avx2::Yuv420pToBgr(y, yStride, u, uStride, v, vStride, width, height, bgr, bgrStride);
+        else
 #endif
 #ifdef SIMD_SSSE3_ENABLE
-    if(Ssse3::Enable && width >= Ssse3::DA)
-        Ssse3::Yuv420pToBgr(y, yStride, u, uStride, v, vStride, width, height, bgr, bgrStride);
-    else
+        if(Ssse3::Enable && width >= Ssse3::DA)
+            Ssse3::Yuv420pToBgr(y, yStride, u, uStride, v, vStride, width, height, bgr, bgrStride);
+        else
 #endif
 #ifdef SIMD_VMX_ENABLE
-    if(Vmx::Enable && width >= Vmx::DA)
-        Vmx::Yuv420pToBgr(y, yStride, u, uStride, v, vStride, width, height, bgr, bgrStride);
-    else
+        if(Vmx::Enable && width >= Vmx::DA)
+            Vmx::Yuv420pToBgr(y, yStride, u, uStride, v, vStride, width, height, bgr, bgrStride);
+        else
 #endif
 #ifdef SIMD_NEON_ENABLE
-    if (Neon::Enable && width >= Neon::DA)
-        Neon::Yuv420pToBgr(y, yStride, u, uStride, v, vStride, width, height, bgr, bgrStride);
-    else
+        if (Neon::Enable && width >= Neon::DA)
+            Neon::Yuv420pToBgr(y, yStride, u, uStride, v, vStride, width, height, bgr, bgrStride);
+        else
+#endif
+            Base::Yuv420pToBgr(y, yStride, u, uStride, v, vStride, width, height, bgr, bgrStride);
+    };
+    ParallelRows(width, height, 2, [&](size_t begin, size_t end)
+    {
+        kernel(y + begin*yStride, u + begin / 2 * uStride, v + begin / 2 * vStride, end - begin, bgr + begin*bgrStride);
+    });
+}
+
+SIMD_API void SimdNv12ToBgr(const uint8_t * y, size_t yStride, const uint8_t * uv, size_t uvStride,
+                 size_t width, size_t height, uint8_t * bgr, size_t bgrStride)
+{
+    auto kernel = [=](const uint8_t * y, const uint8_t * uv, size_t height, uint8_t * bgr)
+    {
+#ifdef SIMD_AVX512BW_ENABLE
+        if (Avx512bw::Enable)
+            Avx512bw::Nv12ToBgr(y, yStride, uv, uvStride, width, height, bgr, bgrStride);
+        else
+#endif
+#ifdef SIMD_AVX2_ENABLE
+        if(Avx2::Enable && width >= Avx2::DA)
+            Avx2::Nv12ToBgr(y, yStride, uv, uvStride, width, height, bgr, bgrStride);
+        else
+#endif
+#ifdef SIMD_SSSE3_ENABLE
+        if(Ssse3::Enable && width >= Ssse3::DA)
+            Ssse3::Nv12ToBgr(y, yStride, uv, uvStride, width, height, bgr, bgrStride);
+        else
 #endif
-        Base::Yuv420pToBgr(y, yStride, u, uStride, v, vStride, width, height, bgr, bgrStride);
+#ifdef SIMD_NEON_ENABLE
+        if (Neon::Enable && width >= Neon::DA)
+            Neon::Nv12ToBgr(y, yStride, uv, uvStride, width, height, bgr, bgrStride);
+        else
+#endif
+            Base::Nv12ToBgr(y, yStride, uv, uvStride, width, height, bgr, bgrStride);
+    };
+    ParallelRows(width, height, 2, [&](size_t begin, size_t end)
+    {
+        kernel(y + begin*yStride, uv + begin / 2 * uvStride, end - begin, bgr + begin*bgrStride);
+    });
 }
 
 SIMD_API void SimdYuv422pToBgr(const uint8_t * y, size_t yStride, const uint8_t * u, size_t uStride, const uint8_t * v, size_t vStride,
@@ -4935,32 +5262,72 @@ SIMD_API void SimdYuv444pToBgr(const uint8_t * y, size_t yStride, const uint8_t
 SIMD_API void SimdYuv420pToBgra(const uint8_t * y, size_t yStride, const uint8_t * u, size_t uStride, const uint8_t * v, size_t vStride,
                   size_t width, size_t height, uint8_t * bgra, size_t bgraStride, uint8_t alpha)
 {
+    auto kernel = [=](const uint8_t * y, const uint8_t * u, const uint8_t * v, size_t height, uint8_t * bgra)
+    {
 #ifdef SIMD_AVX512BW_ENABLE
-    if (Avx512bw::Enable)
-        Avx512bw::Yuv420pToBgra(y, yStride, u, uStride, v, vStride, width, height, bgra, bgraStride, alpha);
-    else
+        if (Avx512bw::Enable)
+            Avx512bw::Yuv420pToBgra(y, yStride, u, uStride, v, vStride, width, height, bgra, bgraStride, alpha);
+        else
 #endif
 #ifdef SIMD_AVX2_ENABLE
-    if(Avx2::Enable && width >= Avx2::DA)
-        Avx2::Yuv420pToBgra(y, yStride, u, uStride, v, vStride, width, height, bgra, bgraStride, alpha);
-    else
+        if(Avx2::Enable && width >= Avx2::DA)
+            Avx2::Yuv420pToBgra(y, yStride, u, uStride, v, vStride, width, height, bgra, bgraStride, alpha);
+        else
 #endif
 #ifdef SIMD_SSE2_ENABLE
-    if(Sse2::Enable && width >= Sse2::DA)
-        Sse2::Yuv420pToBgra(y, yStride, u, uStride, v, vStride, width, height, bgra, bgraStride, alpha);
-    else
+        if(Sse2::Enable && width >= Sse2::DA)
+            Sse2::Yuv420pToBgra(y, yStride, u, uStride, v, vStride, width, height, bgra, bgraStride, alpha);
+        else
 #endif
 #ifdef SIMD_VMX_ENABLE
-    if(Vmx::Enable && width >= Vmx::DA)
-        Vmx::Yuv420pToBgra(y, yStride, u, uStride, v, vStride, width, height, bgra, bgraStride, alpha);
-    else
+        if(Vmx::Enable && width >= Vmx::DA)
+            Vmx::Yuv420pToBgra(y, yStride, u, uStride, v, vStride, width, height, bgra, bgraStride, alpha);
+        else
 #endif
 #ifdef SIMD_NEON_ENABLE
-    if (Neon::Enable && width >= Neon::DA)
-        Neon::Yuv420pToBgra(y, yStride, u, uStride, v, vStride, width, height, bgra, bgraStride, alpha);
-    else
+        if (Neon::Enable && width >= Neon::DA)
+            Neon::Yuv420pToBgra(y, yStride, u, uStride, v, vStride, width, height, bgra, bgraStride, alpha);
+        else
+#endif
+            Base::Yuv420pToBgra(y, yStride, u, uStride, v, vStride, width, height, bgra, bgraStride, alpha);
+    };
+    ParallelRows(width, height, 2, [&](size_t begin, size_t end)
+    {
+        kernel(y + begin*yStride, u + begin / 2 * uStride, v + begin / 2 * vStride, end - begin, bgra + begin*bgraStride);
+    });
+}
+
+SIMD_API void SimdNv12ToBgra(const uint8_t * y, size_t yStride, const uint8_t * uv, size_t uvStride,
+                  size_t width, size_t height, uint8_t * bgra, size_t bgraStride, uint8_t alpha)
+{
+    auto kernel = [=](const uint8_t * y, const uint8_t * uv, size_t height, uint8_t * bgra)
+    {
+#ifdef SIMD_AVX512BW_ENABLE
+        if (Avx512bw::Enable)
+            Avx512bw::Nv12ToBgra(y, yStride, uv, uvStride, width, height, bgra, bgraStride, alpha);
+        else
+#endif
+#ifdef SIMD_AVX2_ENABLE
+        if(Avx2::Enable && width >= Avx2::DA)
+            Avx2::Nv12ToBgra(y, yStride, uv, uvStride, width, height, bgra, bgraStride, alpha);
+        else
 #endif
-        Base::Yuv420pToBgra(y, yStride, u, uStride, v, vStride, width, height, bgra, bgraStride, alpha);
+#ifdef SIMD_SSE2_ENABLE
+        if(Sse2::Enable && width >= Sse2::DA)
+            Sse2::Nv12ToBgra(y, yStride, uv, uvStride, width, height, bgra, bgraStride, alpha);
+        else
+#endif
+#ifdef SIMD_NEON_ENABLE
+        if (Neon::Enable && width >= Neon::DA)
+            Neon::Nv12ToBgra(y, yStride, uv, uvStride, width, height, bgra, bgraStride, alpha);
+        else
+#endif
+            Base::Nv12ToBgra(y, yStride, uv, uvStride, width, height, bgra, bgraStride, alpha);
+    };
+    ParallelRows(width, height, 2, [&](size_t begin, size_t end)
+    {
+        kernel(y + begin*yStride, uv + begin / 2 * uvStride, end - begin, bgra + begin*bgraStride);
+    });
 }
 
 SIMD_API void SimdYuv422pToBgra(const uint8_t * y, size_t yStride, const uint8_t * u, size_t uStride, const uint8_t * v, size_t vStride,
@@ -4997,32 +5364,39 @@ SIMD_API void SimdYuv422pToBgra(const uint8_t * y, size_t yStride, const uint8_t
 SIMD_API void SimdYuv444pToBgra(const uint8_t * y, size_t yStride, const uint8_t * u, size_t uStride, const uint8_t * v, size_t vStride,
                   size_t width, size_t height, uint8_t * bgra, size_t bgraStride, uint8_t alpha)
 {
+    auto kernel = [=](const uint8_t * y, const uint8_t * u, const uint8_t * v, size_t height, uint8_t * bgra)
+    {
 #ifdef SIMD_AVX512BW_ENABLE
-    if (Avx512bw::Enable)
-        Avx512bw::Yuv444pToBgra(y, yStride, u, uStride, v, vStride, width, height, bgra, bgraStride, alpha);
-    else
+        if (Avx512bw::Enable)
+            Avx512bw::Yuv444pToBgra(y, yStride, u, uStride, v, vStride, width, height, bgra, bgraStride, alpha);
+        else
 #endif
 #ifdef SIMD_AVX2_ENABLE
-    if(Avx2::Enable && width >= Avx2::A)
-        Avx2::Yuv444pToBgra(y, yStride, u, uStride, v, vStride, width, height, bgra, bgraStride, alpha);
-    else
+        if(Avx2::Enable && width >= Avx2::A)
+            Avx2::Yuv444pToBgra(y, yStride, u, uStride, v, vStride, width, height, bgra, bgraStride, alpha);
+        else
 #endif
 #ifdef SIMD_SSE2_ENABLE
-    if(Sse2::Enable && width >= Sse2::A)
-        Sse2::Yuv444pToBgra(y, yStride, u, uStride, v, vStride, width, height, bgra, bgraStride, alpha);
-    else
+        if(Sse2::Enable && width >= Sse2::A)
+            Sse2::Yuv444pToBgra(y, yStride, u, uStride, v, vStride, width, height, bgra, bgraStride, alpha);
+        else
 #endif
 #ifdef SIMD_VMX_ENABLE
-    if(Vmx::Enable && width >= Vmx::A)
-        Vmx::Yuv444pToBgra(y, yStride, u, uStride, v, vStride, width, height, bgra, bgraStride, alpha);
-    else
+        if(Vmx::Enable && width >= Vmx::A)
+            Vmx::Yuv444pToBgra(y, yStride, u, uStride, v, vStride, width, height, bgra, bgraStride, alpha);
+        else
 #endif
 #ifdef SIMD_NEON_ENABLE
-    if (Neon::Enable && width >= Neon::A)
-        Neon::Yuv444pToBgra(y, yStride, u, uStride, v, vStride, width, height, bgra, bgraStride, alpha);
-    else
+        if (Neon::Enable && width >= Neon::A)
+            Neon::Yuv444pToBgra(y, yStride, u, uStride, v, vStride, width, height, bgra, bgraStride, alpha);
+        else
 #endif
-        Base::Yuv444pToBgra(y, yStride, u, uStride, v, vStride, width, height, bgra, bgraStride, alpha);
+            Base::Yuv444pToBgra(y, yStride, u, uStride, v, vStride, width, height, bgra, bgraStride, alpha);
+    };
+    ParallelRows(width, height, 1, [&](size_t begin, size_t end)
+    {
+        kernel(y + begin*yStride, u + begin*uStride, v + begin*vStride, end - begin, bgra + begin*bgraStride);
+    });
 }
 
 SIMD_API void SimdYuv444pToHsl(const uint8_t * y, size_t yStride, const uint8_t * u, size_t uStride, const uint8_t * v, size_t vStride,
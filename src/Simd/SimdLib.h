@@ -196,10 +196,28 @@ typedef enum
     SimdDetectionInfoFeatureMask = 3,
     /*! A flag which defines existence of tilted features in the HAAR cascade. */
     SimdDetectionInfoHasTilted = 4,
-    /*! A flag which defines possibility to use 16-bit integers for calculation. */
+    /*! A flag which defines possibility to use 16-bit integers for calculation of LBP cascade. */
     SimdDetectionInfoCanInt16 = 8,
+    /*! A flag which defines possibility to use 16-bit integers for calculation of HAAR cascade. 
+        Its results can slightly differ from 32-bit float detection, so it has to be requested explicitly. */
+    SimdDetectionInfoCanHaarInt16 = 16,
 } SimdDetectionInfoFlags;
 
+/*! @ingroup c_types
+    Describes types of activation function which can be applied to the output of convolution (see function ::SimdNeuralConvolutionInit).
+*/
+typedef enum
+{
+    /*! Identity: f(x) = x. */
+    SimdNeuralActivationIdentity,
+    /*! Hyperbolic tangent: f(x) = tanh(x*slope) (see ::SimdNeuralRoughTanh). */
+    SimdNeuralActivationTanh,
+    /*! Sigmoid: f(x) = 1/(1 + exp(-x*slope)) (see ::SimdNeuralRoughSigmoid2). */
+    SimdNeuralActivationSigmoid,
+    /*! Rectified linear unit (leaky if slope > 0): f(x) = max(x*slope, x) (see ::SimdNeuralRelu). */
+    SimdNeuralActivationRelu,
+} SimdNeuralActivationType;
+
 /*! @ingroup c_types
     Describes type of algorithm used for image reducing (downscale in 2 times) (see function Simd::ReduceGray).
 */
@@ -274,6 +292,45 @@ extern "C"
     */
     SIMD_API int SimdCpuInfo();
 
+    /*! @ingroup info
+
+        \fn int SimdDispatchInfo(const char * name);
+
+        \short Gets info about SIMD extension which is used by given function of %Simd Library.
+
+        Some functions use dispatch tables instead of checking of available SIMD extensions at every call.
+        These tables are resolved once at loading of the library. Only the following functions use dispatch tables:
+        ::SimdAbsDifferenceSum, ::SimdAbsDifferenceSumMasked, ::SimdCrc32c, ::SimdDetectionHaarDetect16ii, ::SimdDetectionHaarDetect16ip, 
+        ::SimdDetectionHaarDetect32fi, ::SimdDetectionHaarDetect32fp, ::SimdDetectionLbpDetect16ii, ::SimdDetectionLbpDetect16ip, 
+        ::SimdDetectionLbpDetect32fi, ::SimdDetectionLbpDetect32fp, ::SimdResizeBilinear, ::SimdSquaredDifferenceSum, ::SimdSquaredDifferenceSumMasked, ::SimdSquareSum, ::SimdValueSum.
+        All other functions of the library still check available SIMD extensions at every call (or resolve a function pointer once without
+        any width thresholds), they are not affected by ::SimdSetDispatchMask and this function returns -1 for them.
+
+        \note See enumeration ::SimdCpuInfoFlags and function ::SimdSetDispatchMask.
+
+        \param [in] name - a name of the function (for example "SimdResizeBilinear").
+        \return a bit (1 << ::SimdCpuInfoFlags) of SIMD extension which is used by the function to process images with sufficient width,
+            0 if the function uses base (scalar) implementation and -1 if the function does not use dispatch table.
+    */
+    SIMD_API int SimdDispatchInfo(const char * name);
+
+    /*! @ingroup info
+
+        \fn int SimdSetDispatchMask(const char * name, int mask);
+
+        \short Restricts SIMD extensions which can be used by given function of %Simd Library.
+
+        The function rebuilds dispatch table of given function (see ::SimdDispatchInfo). It is useful for A/B performance testing.
+        Functions which do not use dispatch tables (all functions except the ones listed in ::SimdDispatchInfo) are not affected.
+        It is safe to call this function while other threads call the dispatched function.
+
+        \param [in] name - a name of the function (for example "SimdResizeBilinear"). If it is NULL then the mask is applied to all functions which use dispatch tables.
+        \param [in] mask - a bit mask of allowed SIMD extensions (see ::SimdCpuInfoFlags). 
+            0 restricts the function to base (scalar) implementation, -1 restores default behaviour.
+        \return a number of functions whose dispatch tables were changed.
+    */
+    SIMD_API int SimdSetDispatchMask(const char * name, int mask);
+
     /*! @ingroup memory
 
         \fn void * SimdAllocate(size_t size, size_t align);
@@ -324,6 +381,55 @@ extern "C"
     */
     SIMD_API size_t SimdAlignment();
 
+    /*! @ingroup thread
+
+        \fn void SimdSetThreadNumber(size_t threadNumber);
+
+        \short Sets number of threads used by %Simd Library to parallelize some algorithms.
+
+        The algorithms which support multithreading split the image into horizontal bands and process them with using of 
+        the persistent thread pool (see Simd::ThreadPool). The result is the same as in single-thread mode.
+        Small images are always processed in the calling thread.
+
+        \note Multithreading is supported by functions ::SimdAbsGradientSaturatedSum, ::SimdBgraToGray, ::SimdBgraToYuv420p, ::SimdBgraToYuv444p, 
+            ::SimdBgrToGray, ::SimdBgrToYuv420p, ::SimdGaussianBlur3x3, ::SimdLaplace, ::SimdLaplaceAbs, ::SimdMeanFilter3x3, 
+            ::SimdMedianFilterRhomb3x3, ::SimdMedianFilterRhomb5x5, ::SimdMedianFilterSquare3x3, ::SimdMedianFilterSquare5x5, 
+            ::SimdNv12ToBgr, ::SimdNv12ToBgra, ::SimdSobelDx, ::SimdSobelDxAbs, ::SimdSobelDy, ::SimdSobelDyAbs, 
+            ::SimdResizeBilinear, ::SimdYuv420pToBgr, ::SimdYuv420pToBgra, ::SimdYuv444pToBgra.
+
+        Per-pixel functions of background model (::SimdBackgroundGrowRangeSlow, ::SimdBackgroundGrowRangeFast, ::SimdBackgroundIncrementCount, 
+            ::SimdBackgroundAdjustRange, ::SimdBackgroundAdjustRangeMasked, ::SimdBackgroundShiftRange, ::SimdBackgroundShiftRangeMasked, 
+            ::SimdBackgroundInitMask and corresponding ::SimdEdgeBackgroundGrowRangeSlow etc.) split the image into cache-sized tiles of rows, 
+            which are dynamically distributed among the threads.
+
+        \param [in] threadNumber - a number of threads. By default it is equal to 1 (no multithreading).
+    */
+    SIMD_API void SimdSetThreadNumber(size_t threadNumber);
+
+    /*! @ingroup thread
+
+        \fn size_t SimdGetThreadNumber();
+
+        \short Gets number of threads used by %Simd Library to parallelize some algorithms (see function ::SimdSetThreadNumber).
+
+        \return a number of threads.
+    */
+    SIMD_API size_t SimdGetThreadNumber();
+
+    /*! @ingroup thread
+
+        \fn size_t SimdSetLocalThreadNumber(size_t threadNumber);
+
+        \short Overrides number of threads used by %Simd Library for the calls made from the current thread only.
+
+        It allows to limit (or to extend) parallelization of one pipeline stage without changing of the global setting 
+        (see function ::SimdSetThreadNumber), which is used by other threads.
+
+        \param [in] threadNumber - a number of threads. Zero value restores using of the global setting.
+        \return a previous value of the override for the current thread.
+    */
+    SIMD_API size_t SimdSetLocalThreadNumber(size_t threadNumber);
+
     /*! @ingroup hash
 
         \fn uint32_t SimdCrc32c(const void * src, size_t size);
@@ -1558,6 +1664,7 @@ extern "C"
 
         This function supports OpenCV HAAR and LBP cascades type.
         Tree based cascades and old cascade formats are not supported.
+        Also it loads cascades in binary format which were saved with using function ::SimdDetectionSaveBinary.
 
         \note This function is used for implementation of Simd::Detection.
 
@@ -1567,6 +1674,39 @@ extern "C"
     */
     SIMD_API void * SimdDetectionLoadA(const char * path);
 
+    /*! @ingroup object_detection
+
+        \fn void * SimdDetectionLoadBinary(const void * buffer, size_t size);
+
+        \short Loads a classifier cascade in binary format from memory buffer.
+
+        The binary format is saved with using function ::SimdDetectionSaveBinary. 
+        Its loading does not need any parsing, so the buffer can be a memory mapped file.
+        The buffer is verified by checksum, and all indices of stages, classifiers, nodes and features are checked 
+        against sizes of the loaded arrays, so a corrupted or truncated buffer is rejected.
+
+        \param [in] buffer - a pointer to memory buffer with cascade in binary format.
+        \param [in] size - a size of the buffer.
+        \return a pointer to loaded cascade. On error it returns NULL.
+                This pointer is used in functions ::SimdDetectionInfo and ::SimdDetectionInit, and must be released with using function ::SimdDetectionFree.
+    */
+    SIMD_API void * SimdDetectionLoadBinary(const void * buffer, size_t size);
+
+    /*! @ingroup object_detection
+
+        \fn int SimdDetectionSaveBinary(const void * data, const char * path);
+
+        \short Saves a classifier cascade to file in binary format.
+
+        The binary format depends on platform (byte order and structure alignment). 
+        Saved file can be loaded with using functions ::SimdDetectionLoadA and ::SimdDetectionLoadBinary.
+
+        \param [in] data - a pointer to cascade which was received with using of function ::SimdDetectionLoadA or ::SimdDetectionLoadBinary.
+        \param [in] path - a path to output file.
+        \return 1 on success and 0 on error.
+    */
+    SIMD_API int SimdDetectionSaveBinary(const void * data, const char * path);
+
     /*! @ingroup object_detection
 
         \fn void SimdDetectionInfo(const void * data, size_t * width, size_t * height, SimdDetectionInfoFlags * flags);
@@ -1603,10 +1743,11 @@ extern "C"
                              Its size must be equal to sum image. See function ::SimdIntegral in order to estimate this tilted integral sum.
         \param [in] tiltedStride - a row size of the tilted image.
         \param [in] throughColumn - a flag to detect objects only in even columns and rows (to increase performance).
-        \param [in] int16 - a flag use for 16-bit integer version of detection algorithm. (See ::SimdDetectionInfo).
+        \param [in] int16 - a flag use for 16-bit integer version of detection algorithm. It is applied if the cascade reports 
+            ::SimdDetectionInfoCanInt16 (LBP) or ::SimdDetectionInfoCanHaarInt16 (HAAR). (See ::SimdDetectionInfo).
         \return a pointer to hidden cascade. On error it returns NULL.
                 This pointer is used in functions ::SimdDetectionPrepare, ::SimdDetectionHaarDetect32fp, ::SimdDetectionHaarDetect32fi,
-                ::SimdDetectionLbpDetect32fp, ::SimdDetectionLbpDetect32fi, ::SimdDetectionLbpDetect16ip and ::SimdDetectionLbpDetect16ii.
+                ::SimdDetectionHaarDetect16ip, ::SimdDetectionHaarDetect16ii, ::SimdDetectionLbpDetect32fp, ::SimdDetectionLbpDetect32fi, ::SimdDetectionLbpDetect16ip and ::SimdDetectionLbpDetect16ii.
                 It must be released with using function ::SimdDetectionFree.
     */
     SIMD_API void * SimdDetectionInit(const void * data, uint8_t * sum, size_t sumStride, size_t width, size_t height,
@@ -1619,7 +1760,7 @@ extern "C"
         \short Prepares hidden classifier cascade structure to work with given input 8-bit gray image.
 
         You must call this function before calling of functions ::SimdDetectionHaarDetect32fp, ::SimdDetectionHaarDetect32fi,
-         ::SimdDetectionLbpDetect32fp, ::SimdDetectionLbpDetect32fi, ::SimdDetectionLbpDetect16ip and ::SimdDetectionLbpDetect16ii.
+         ::SimdDetectionHaarDetect16ip, ::SimdDetectionHaarDetect16ii, ::SimdDetectionLbpDetect32fp, ::SimdDetectionLbpDetect32fi, ::SimdDetectionLbpDetect16ip and ::SimdDetectionLbpDetect16ii.
 
         \note This function is used for implementation of Simd::Detection.
 
@@ -1675,6 +1816,58 @@ extern "C"
     SIMD_API void SimdDetectionHaarDetect32fi(const void * hid, const uint8_t * mask, size_t maskStride,
         ptrdiff_t left, ptrdiff_t top, ptrdiff_t right, ptrdiff_t bottom, uint8_t * dst, size_t dstStride);
 
+    /*! @ingroup object_detection
+
+        \fn void SimdDetectionHaarDetect16ip(const void * hid, const uint8_t * mask, size_t maskStride, ptrdiff_t left, ptrdiff_t top, ptrdiff_t right, ptrdiff_t bottom, uint8_t * dst, size_t dstStride);
+
+        \short Performs object detection with using of HAAR cascade classifier (uses 16-bit integer numbers, processes all points).
+
+        You must call function ::SimdDetectionPrepare before calling of this functions.
+        All restriction (input mask and bounding box) affects to left-top corner of scanning window.
+
+        \note This function is used for implementation of Simd::Detection.
+        \note Rectangle sums, feature weights, thresholds and leaves are quantised to 16 bits, so results can slightly differ from ::SimdDetectionHaarDetect32fp.
+            The variance norm of every window is computed in 32-bit float and then rounded to 16 bits (mixed integer/float path).
+
+        \param [in] hid - a pointer to hidden cascade which was received with using of function ::SimdDetectionInit.
+        \param [in] mask - a pointer to pixels data of 8-bit image with mask. The mask restricts detection region.
+        \param [in] maskStride - a row size of the mask image.
+        \param [in] left - a left side of bounding box which restricts detection region.
+        \param [in] top - a top side of bounding box which restricts detection region.
+        \param [in] right - a right side of bounding box which restricts detection region.
+        \param [in] bottom - a bottom side of bounding box which restricts detection region.
+        \param [out] dst - a pointer to pixels data of 8-bit image with output result. None zero points refer to left-top corner of detected objects.
+        \param [in] dstStride - a row size of the dst image.
+    */
+    SIMD_API void SimdDetectionHaarDetect16ip(const void * hid, const uint8_t * mask, size_t maskStride,
+        ptrdiff_t left, ptrdiff_t top, ptrdiff_t right, ptrdiff_t bottom, uint8_t * dst, size_t dstStride);
+
+    /*! @ingroup object_detection
+
+        \fn void SimdDetectionHaarDetect16ii(const void * hid, const uint8_t * mask, size_t maskStride, ptrdiff_t left, ptrdiff_t top, ptrdiff_t right, ptrdiff_t bottom, uint8_t * dst, size_t dstStride);
+
+        \short Performs object detection with using of HAAR cascade classifier (uses 16-bit integer numbers, processes only even points).
+
+        You must call function ::SimdDetectionPrepare before calling of this functions.
+        All restriction (input mask and bounding box) affects to left-top corner of scanning window.
+
+        \note This function is used for implementation of Simd::Detection.
+        \note Rectangle sums, feature weights, thresholds and leaves are quantised to 16 bits, so results can slightly differ from ::SimdDetectionHaarDetect32fi.
+            The variance norm of every window is computed in 32-bit float and then rounded to 16 bits (mixed integer/float path).
+
+        \param [in] hid - a pointer to hidden cascade which was received with using of function ::SimdDetectionInit.
+        \param [in] mask - a pointer to pixels data of 8-bit image with mask. The mask restricts detection region.
+        \param [in] maskStride - a row size of the mask image.
+        \param [in] left - a left side of bounding box which restricts detection region.
+        \param [in] top - a top side of bounding box which restricts detection region.
+        \param [in] right - a right side of bounding box which restricts detection region.
+        \param [in] bottom - a bottom side of bounding box which restricts detection region.
+        \param [out] dst - a pointer to pixels data of 8-bit image with output result. None zero points refer to left-top corner of detected objects.
+        \param [in] dstStride - a row size of the dst image.
+    */
+    SIMD_API void SimdDetectionHaarDetect16ii(const void * hid, const uint8_t * mask, size_t maskStride,
+        ptrdiff_t left, ptrdiff_t top, ptrdiff_t right, ptrdiff_t bottom, uint8_t * dst, size_t dstStride);
+
     /*! @ingroup object_detection
 
         \fn void SimdDetectionLbpDetect32fp(const void * hid, const uint8_t * mask, size_t maskStride, ptrdiff_t left, ptrdiff_t top, ptrdiff_t right, ptrdiff_t bottom, uint8_t * dst, size_t dstStride);
@@ -3353,6 +3546,60 @@ extern "C"
     */
     SIMD_API void SimdNeuralProductSum(const float * a, const float * b, size_t size, float * sum);
 
+    /*! @ingroup neural
+
+        \fn void SimdNeuralProductSum16f(const float * a, const uint16_t * b, size_t size, float * sum);
+
+        \short Calculates sum of products for 32-bit float array and 16-bit float array.
+
+        All arrays must have the same size. Values of the second array are converted to 32-bit float on the fly.
+
+        For every element:
+        \verbatim
+        sum += a[i]*Float16ToFloat32(b[i]);
+        \endverbatim
+
+        \note This function is used in Simd::Neural (for layers with weights in 16-bit float format).
+
+        \param [in] a - a pointer to the 32-bit float array.
+        \param [in] b - a pointer to the 16-bit float array.
+        \param [in] size - a size of arrays.
+        \param [out] sum - a pointer to 32-bit float sum of products.
+    */
+    SIMD_API void SimdNeuralProductSum16f(const float * a, const uint16_t * b, size_t size, float * sum);
+
+    /*! @ingroup neural
+
+        \fn void SimdNeuralProductSum8i(size_t M, size_t N, size_t K, const int8_t * a, const uint8_t * b, int32_t * c);
+
+        \short Calculates product of 8-bit signed integer matrix A and 8-bit unsigned integer matrix B.
+
+        Both matrices are stored by rows: A has size M x K, B has size K x N (for example an output of im2col transformation
+        with a column per output point). The output matrix C has size M x N.
+
+        Algorithm's details:
+        \verbatim
+        for(i = 0; i < M; ++i)
+            for(j = 0; j < N; ++j)
+            {
+                c[i*N + j] = 0;
+                for(k = 0; k < K; ++k)
+                    c[i*N + j] += a[i*K + k]*b[k*N + j];
+            }
+        \endverbatim
+
+        \note Values of matrix A must be in range [-64, 64]. It excludes saturation of intermediate 16-bit sums of pairs of products in SIMD optimizations.
+            This function is used in Simd::Neural (for layers with weights in 8-bit integer format).
+
+        \param [in] M - a number of rows of matrix A.
+        \param [in] N - a number of columns of matrix B.
+        \param [in] K - a number of columns of matrix A and rows of matrix B.
+        \param [in] a - a pointer to the 8-bit signed integer matrix A.
+        \param [in] b - a pointer to the 8-bit unsigned integer matrix B.
+        \param [out] c - a pointer to the 32-bit integer output matrix C.
+    */
+    SIMD_API void SimdNeuralProductSum8i(size_t M, size_t N, size_t K, const int8_t * a, const uint8_t * b, int32_t * c);
+
     /*! @ingroup neural
 
         \fn void SimdNeuralAddVectorMultipliedByValue(const float * src, size_t size, const float * value, float * dst);
@@ -3777,6 +4024,71 @@ extern "C"
     */
     SIMD_API void SimdNeuralConvolutionForward(const float * src, size_t srcWidth, size_t srcHeight, size_t srcDepth, const float * weight, size_t kernelX, size_t kernelY, size_t padX, size_t padY, size_t strideX, size_t strideY, size_t dilationX, size_t dilationY, void * buffer, size_t * size, float * dst, size_t dstWidth, size_t dstHeight, size_t dstDepth, int add);
 
+    /*! @ingroup neural
+
+        \fn void * SimdNeuralConvolutionInit(size_t srcWidth, size_t srcHeight, size_t srcDepth, const float * weight, size_t kernelX, size_t kernelY, size_t padX, size_t padY, size_t strideX, size_t strideY, size_t dilationX, size_t dilationY, size_t dstWidth, size_t dstHeight, size_t dstDepth, const float * bias, SimdNeuralActivationType activation, const float * slope);
+
+        \short Creates context of convolution of the multichannel 32-bit float image with constant weights.
+
+        The context holds the algorithm chosen for given sizes and a copy of the weights reordered for this algorithm.
+        So the weights are not repacked at every call of ::SimdNeuralConvolutionRun (in contrast to ::SimdNeuralConvolutionForward).
+        The context can also hold a bias and an activation function. They are applied inside of the algorithm to every block of output channels 
+        (the rows of its matrix multiplication) just after its estimation (while it is still in cache) instead of separate passes over whole output image.
+        The context has to be released with using of function ::SimdNeuralConvolutionFree.
+
+        \note There is the same restriction to the size of output image as for function ::SimdNeuralConvolutionForward.
+
+        \param [in] srcWidth - a width of the input image.
+        \param [in] srcHeight - a height of the input image.
+        \param [in] srcDepth - a number of channels in the input image.
+        \param [in] weight - a pointer to the convolution weights. Total size of the weights is equal to `kernelX*kernelY*srcDepth*dstDepth`. They are copied to the context.
+        \param [in] kernelX - a width of the convolution kernel.
+        \param [in] kernelY - a height of the convolution kernel.
+        \param [in] padX - a pad to the x-coordinate of the input image.
+        \param [in] padY - a pad to the y-coordinate of the input image.
+        \param [in] strideX - a x-stride of the convolution.
+        \param [in] strideY - a y-stride of the convolution.
+        \param [in] dilationX - a x-stride of the convolution.
+        \param [in] dilationY - a y-stride of the convolution.
+        \param [in] dstWidth - a width of the output image.
+        \param [in] dstHeight - a height of the output image.
+        \param [in] dstDepth - a number of channels in the output image.
+        \param [in] bias - a pointer to the bias (one value per output channel). Its size is equal to dstDepth. It is copied to the context. Can be NULL.
+        \param [in] activation - a type of activation function applied to the output (after adding of bias).
+        \param [in] slope - a pointer to the slope parameter of activation function (see ::SimdNeuralActivationType). 
+                         Can be NULL (in this case it is equal to 0 for ::SimdNeuralActivationRelu and to 1 for other functions).
+        \return a pointer to the convolution context.
+    */
+    SIMD_API void * SimdNeuralConvolutionInit(size_t srcWidth, size_t srcHeight, size_t srcDepth, const float * weight, size_t kernelX, size_t kernelY, size_t padX, size_t padY, size_t strideX, size_t strideY, size_t dilationX, size_t dilationY, size_t dstWidth, size_t dstHeight, size_t dstDepth, const float * bias, SimdNeuralActivationType activation, const float * slope);
+
+    /*! @ingroup neural
+
+        \fn void SimdNeuralConvolutionRun(const void * context, const float * src, void * buffer, size_t * size, float * dst, int add);
+
+        \short Adds convolution of the input multichannel 32-bit float image to the output multichannel 32-bit float image with using of context created by function ::SimdNeuralConvolutionInit.
+
+        The context is not changed by this function, so it can be used in several threads at the same time (every thread needs its own temporal buffer).
+
+        \param [in] context - a pointer to the convolution context.
+        \param [in] src - a pointer to the input multichannel 32-bit float image. Total size of the input image is equal to srcWidth*srcHeight*srcDepth.
+        \param [in, out] buffer - a pointer to the external temporal buffer used by the algorithm. Can be NULL (the algorithm uses internal buffer).
+        \param [in, out] size - a pointer to the size of the external temporal buffer. If the size is too small it will contain required value. Can be NULL.
+        \param [in, out] dst - a pointer to the output multichannel 32-bit float image. Total size of the output image is equal to `dstWidth*dstHeight*dstDepth`.
+        \param [in] add - a flag which signalizes that we want add or assign value of convolution to the output image. 
+                    Bias and activation function (if they exist) are applied to the resulting sum.
+    */
+    SIMD_API void SimdNeuralConvolutionRun(const void * context, const float * src, void * buffer, size_t * size, float * dst, int add);
+
+    /*! @ingroup neural
+
+        \fn void SimdNeuralConvolutionFree(void * context);
+
+        \short Frees convolution context created by function ::SimdNeuralConvolutionInit.
+
+        \param [in] context - a pointer to the convolution context.
+    */
+    SIMD_API void SimdNeuralConvolutionFree(void * context);
+
     /*! @ingroup operation
 
         \fn void SimdOperationBinary8u(const uint8_t * a, size_t aStride, const uint8_t * b, size_t bStride, size_t width, size_t height, size_t channelCount, uint8_t * dst, size_t dstStride, SimdOperationBinary8uType type);
@@ -4059,6 +4371,34 @@ extern "C"
     SIMD_API void SimdResizeBilinear(const uint8_t *src, size_t srcWidth, size_t srcHeight, size_t srcStride,
         uint8_t *dst, size_t dstWidth, size_t dstHeight, size_t dstStride, size_t channelCount);
 
+    /*! @ingroup resizing
+
+        \fn void SimdResizeBilinearRows(const uint8_t *src, size_t srcWidth, size_t srcHeight, size_t srcStride, uint8_t *dst, size_t dstWidth, size_t dstHeight, size_t dstStride, size_t channelCount, size_t yBegin, size_t yEnd);
+
+        \short Performs resizing of input image with using bilinear interpolation for a range of output rows.
+
+        Output rows in range [yBegin, yEnd) are equal to the same rows of the result of ::SimdResizeBilinear. Other rows of the output image are not changed.
+        The function is executed in the calling thread only.
+
+        All images must have the same format (8-bit gray, 16-bit UV, 24-bit BGR or 32-bit BGRA).
+
+        \note This function has a C++ wrappers: Simd::ResizeBilinearRows(const View<A>& src, View<A>& dst, size_t yBegin, size_t yEnd).
+
+        \param [in] src - a pointer to pixels data of the original input image.
+        \param [in] srcWidth - a width of the input image.
+        \param [in] srcHeight - a height of the input image.
+        \param [in] srcStride - a row size of the input image.
+        \param [out] dst - a pointer to pixels data of the reduced output image.
+        \param [in] dstWidth - a width of the output image.
+        \param [in] dstHeight - a height of the output image.
+        \param [in] dstStride - a row size of the output image.
+        \param [in] channelCount - a channel count.
+        \param [in] yBegin - a first output row to fill.
+        \param [in] yEnd - an output row after the last row to fill. It must not exceed dstHeight.
+    */
+    SIMD_API void SimdResizeBilinearRows(const uint8_t *src, size_t srcWidth, size_t srcHeight, size_t srcStride,
+        uint8_t *dst, size_t dstWidth, size_t dstHeight, size_t dstStride, size_t channelCount, size_t yBegin, size_t yEnd);
+
     /*! @ingroup segmentation
 
         \fn void SimdSegmentationChangeIndex(uint8_t * mask, size_t stride, size_t width, size_t height, uint8_t oldIndex, uint8_t newIndex);
@@ -4153,6 +4493,39 @@ extern "C"
     SIMD_API void SimdSegmentationShrinkRegion(const uint8_t * mask, size_t stride, size_t width, size_t height, uint8_t index,
         ptrdiff_t * left, ptrdiff_t * top, ptrdiff_t * right, ptrdiff_t * bottom);
 
+    /*! @ingroup segmentation
+
+        \fn size_t SimdSegmentationLabel(uint8_t * mask, size_t maskStride, size_t width, size_t height, const uint8_t * difference, size_t differenceStride, uint8_t seedIndex, uint8_t emptyIndex, uint8_t invalidIndex, uint8_t differenceThreshold, size_t areaMin, uint8_t indexMin, ptrdiff_t * rects);
+
+        \short Labels connected regions of mask which grow from seed points.
+
+        A point belongs to a region if it has seed index or if it has empty index and its difference is greater than threshold.
+        Regions are found with using of 4-connectivity (with run-length encoding and union-find instead of point by point flood fill). 
+        Regions without seed points are not changed. Regions are numerated in order of their first (in raster order) seed point.
+        Every region which bounding box area is greater than areaMin gets next index (starting from indexMin), other regions get invalid index.
+        If number of regions exceeds (256 - indexMin) then the rest regions also get invalid index.
+        All images must have 8-bit gray pixel format. Size of difference image is equal to mask image.
+
+        \note This function has a C++ wrappers: Simd::SegmentationLabel(View<A> & mask, const View<A> & difference, uint8_t seedIndex, uint8_t emptyIndex, uint8_t invalidIndex, uint8_t differenceThreshold, size_t areaMin, uint8_t indexMin, std::vector<Rectangle<ptrdiff_t> > & rects).
+
+        \param [in, out] mask - a pointer to pixels data of 8-bit gray mask image.
+        \param [in] maskStride - a row size of the mask image.
+        \param [in] width - a mask width.
+        \param [in] height - a mask height.
+        \param [in] difference - a pointer to pixels data of 8-bit gray difference image.
+        \param [in] differenceStride - a row size of the difference image.
+        \param [in] seedIndex - seed mask index.
+        \param [in] emptyIndex - empty mask index.
+        \param [in] invalidIndex - invalid mask index.
+        \param [in] differenceThreshold - a difference threshold for growing of regions.
+        \param [in] areaMin - a maximal bounding box area of region which gets invalid index.
+        \param [in] indexMin - an index of the first region.
+        \param [out] rects - a pointer to bounding boxes (left, top, right, bottom) of numerated regions. Its size must be at least 4*(256 - indexMin).
+        \return a number of found regions with bounding box area greater than areaMin.
+    */
+    SIMD_API size_t SimdSegmentationLabel(uint8_t * mask, size_t maskStride, size_t width, size_t height, const uint8_t * difference, size_t differenceStride,
+        uint8_t seedIndex, uint8_t emptyIndex, uint8_t invalidIndex, uint8_t differenceThreshold, size_t areaMin, uint8_t indexMin, ptrdiff_t * rects);
+
     /*! @ingroup shifting
 
         \fn void SimdShiftBilinear(const uint8_t * src, size_t srcStride, size_t width, size_t height, size_t channelCount, const uint8_t * bkg, size_t bkgStride, const double * shiftX, const double * shiftY, size_t cropLeft, size_t cropTop, size_t cropRight, size_t cropBottom, uint8_t * dst, size_t dstStride);
@@ -4836,6 +5209,56 @@ extern "C"
     SIMD_API void SimdTextureBoostedUv(const uint8_t * src, size_t srcStride, size_t width, size_t height,
         uint8_t boost, uint8_t * dst, size_t dstStride);
 
+    /*! @ingroup texture_estimation
+
+        \fn void SimdTextureFeatureDifference(const uint8_t * gray, size_t grayStride, size_t width, size_t height, uint8_t saturation, uint8_t boost, const uint8_t * grayLo, size_t grayLoStride, const uint8_t * grayHi, size_t grayHiStride, uint16_t grayWeight, uint8_t * dx, size_t dxStride, const uint8_t * dxLo, size_t dxLoStride, const uint8_t * dxHi, size_t dxHiStride, uint16_t dxWeight, uint8_t * dy, size_t dyStride, const uint8_t * dyLo, size_t dyLoStride, const uint8_t * dyHi, size_t dyHiStride, uint16_t dyWeight, const uint8_t * mask, size_t maskStride, uint8_t * difference, size_t differenceStride);
+
+        \short Calculates boosted saturated gradients and total feature difference of gray, dx and dy in one pass.
+
+        All images must have the same width, height and format (8-bit gray).
+
+        It is equal to sequential call of ::SimdTextureBoostedSaturatedGradient (gray -> dx, dy), filling of difference by zero, 
+        three calls of ::SimdAddFeatureDifference (for gray, dx and dy features) and bitwise AND of difference with mask, 
+        but reads every input image only once.
+
+        \note This function has a C++ wrappers: Simd::TextureFeatureDifference(const View<A>& gray, uint8_t saturation, uint8_t boost, const View<A>& grayLo, const View<A>& grayHi, uint16_t grayWeight, View<A>& dx, const View<A>& dxLo, const View<A>& dxHi, uint16_t dxWeight, View<A>& dy, const View<A>& dyLo, const View<A>& dyHi, uint16_t dyWeight, const View<A>& mask, View<A>& difference).
+
+        \param [in] gray - a pointer to pixels data of source 8-bit gray image.
+        \param [in] grayStride - a row size of gray image.
+        \param [in] width - an image width.
+        \param [in] height - an image height.
+        \param [in] saturation - a saturation of gradient.
+        \param [in] boost - a boost coefficient.
+        \param [in] grayLo - a pointer to pixels data of image with lower bound of gray feature.
+        \param [in] grayLoStride - a row size of grayLo image.
+        \param [in] grayHi - a pointer to pixels data of image with upper bound of gray feature.
+        \param [in] grayHiStride - a row size of grayHi image.
+        \param [in] grayWeight - a gray feature weight (unsigned 8.8 fixed point value).
+        \param [out] dx - a pointer to pixels data of image with boosted saturated gradient along x axis.
+        \param [in] dxStride - a row size of dx image.
+        \param [in] dxLo - a pointer to pixels data of image with lower bound of dx feature.
+        \param [in] dxLoStride - a row size of dxLo image.
+        \param [in] dxHi - a pointer to pixels data of image with upper bound of dx feature.
+        \param [in] dxHiStride - a row size of dxHi image.
+        \param [in] dxWeight - a dx feature weight (unsigned 8.8 fixed point value).
+        \param [out] dy - a pointer to pixels data of image with boosted saturated gradient along y axis.
+        \param [in] dyStride - a row size of dy image.
+        \param [in] dyLo - a pointer to pixels data of image with lower bound of dy feature.
+        \param [in] dyLoStride - a row size of dyLo image.
+        \param [in] dyHi - a pointer to pixels data of image with upper bound of dy feature.
+        \param [in] dyHiStride - a row size of dyHi image.
+        \param [in] dyWeight - a dy feature weight (unsigned 8.8 fixed point value).
+        \param [in] mask - a pointer to pixels data of 8-bit gray mask image. It can be NULL (then the mask is not applied).
+        \param [in] maskStride - a row size of mask image.
+        \param [out] difference - a pointer to pixels data of image with total feature difference.
+        \param [in] differenceStride - a row size of difference image.
+    */
+    SIMD_API void SimdTextureFeatureDifference(const uint8_t * gray, size_t grayStride, size_t width, size_t height, uint8_t saturation, uint8_t boost,
+        const uint8_t * grayLo, size_t grayLoStride, const uint8_t * grayHi, size_t grayHiStride, uint16_t grayWeight,
+        uint8_t * dx, size_t dxStride, const uint8_t * dxLo, size_t dxLoStride, const uint8_t * dxHi, size_t dxHiStride, uint16_t dxWeight,
+        uint8_t * dy, size_t dyStride, const uint8_t * dyLo, size_t dyLoStride, const uint8_t * dyHi, size_t dyHiStride, uint16_t dyWeight,
+        const uint8_t * mask, size_t maskStride, uint8_t * difference, size_t differenceStride);
+
     /*! @ingroup texture_estimation
 
         \fn void SimdTextureGetDifferenceSum(const uint8_t * src, size_t srcStride, size_t width, size_t height, const uint8_t * lo, size_t loStride, const uint8_t * hi, size_t hiStride, int64_t * sum);
@@ -4915,6 +5338,30 @@ extern "C"
     SIMD_API void SimdYuv420pToBgr(const uint8_t * y, size_t yStride, const uint8_t * u, size_t uStride, const uint8_t * v, size_t vStride,
         size_t width, size_t height, uint8_t * bgr, size_t bgrStride);
 
+    /*! @ingroup yuv_conversion
+
+        \fn void SimdNv12ToBgr(const uint8_t * y, size_t yStride, const uint8_t * uv, size_t uvStride, size_t width, size_t height, uint8_t * bgr, size_t bgrStride);
+
+        \short Converts NV12 image to 24-bit BGR image.
+
+        The input Y and output BGR images must have the same width and height.
+        The input UV image contains interleaved U and V components and has half size relative to Y component.
+        Chroma is read directly from the UV plane, so no intermediate U and V planes are required.
+
+        \note This function has a C++ wrappers: Simd::Nv12ToBgr(const View<A>& y, const View<A>& uv, View<A>& bgr);
+
+        \param [in] y - a pointer to pixels data of input 8-bit image with Y color plane.
+        \param [in] yStride - a row size of the y image.
+        \param [in] uv - a pointer to pixels data of input 16-bit image with interleaved U and V color planes.
+        \param [in] uvStride - a row size of the uv image.
+        \param [in] width - an image width.
+        \param [in] height - an image height.
+        \param [out] bgr - a pointer to pixels data of output 24-bit BGR image.
+        \param [in] bgrStride - a row size of the bgr image.
+    */
+    SIMD_API void SimdNv12ToBgr(const uint8_t * y, size_t yStride, const uint8_t * uv, size_t uvStride,
+        size_t width, size_t height, uint8_t * bgr, size_t bgrStride);
+
     /*! @ingroup yuv_conversion
 
         \fn void SimdYuv422pToBgr(const uint8_t * y, size_t yStride, const uint8_t * u, size_t uStride, const uint8_t * v, size_t vStride, size_t width, size_t height, uint8_t * bgr, size_t bgrStride);
@@ -4990,6 +5437,31 @@ extern "C"
     SIMD_API void SimdYuv420pToBgra(const uint8_t * y, size_t yStride, const uint8_t * u, size_t uStride, const uint8_t * v, size_t vStride,
         size_t width, size_t height, uint8_t * bgra, size_t bgraStride, uint8_t alpha);
 
+    /*! @ingroup yuv_conversion
+
+        \fn void SimdNv12ToBgra(const uint8_t * y, size_t yStride, const uint8_t * uv, size_t uvStride, size_t width, size_t height, uint8_t * bgra, size_t bgraStride, uint8_t alpha);
+
+        \short Converts NV12 image to 32-bit BGRA image.
+
+        The input Y and output BGRA images must have the same width and height.
+        The input UV image contains interleaved U and V components and has half size relative to Y component.
+        Chroma is read directly from the UV plane, so no intermediate U and V planes are required.
+
+        \note This function has a C++ wrappers: Simd::Nv12ToBgra(const View<A>& y, const View<A>& uv, View<A>& bgra, uint8_t alpha).
+
+        \param [in] y - a pointer to pixels data of input 8-bit image with Y color plane.
+        \param [in] yStride - a row size of the y image.
+        \param [in] uv - a pointer to pixels data of input 16-bit image with interleaved U and V color planes.
+        \param [in] uvStride - a row size of the uv image.
+        \param [in] width - an image width.
+        \param [in] height - an image height.
+        \param [out] bgra - a pointer to pixels data of output 32-bit BGRA image.
+        \param [in] bgraStride - a row size of the bgra image.
+        \param [in] alpha - a value of alpha channel.
+    */
+    SIMD_API void SimdNv12ToBgra(const uint8_t * y, size_t yStride, const uint8_t * uv, size_t uvStride,
+        size_t width, size_t height, uint8_t * bgra, size_t bgraStride, uint8_t alpha);
+
     /*! @ingroup yuv_conversion
 
         \fn void SimdYuv422pToBgra(const uint8_t * y, size_t yStride, const uint8_t * u, size_t uStride, const uint8_t * v, size_t vStride, size_t width, size_t height, uint8_t * bgra, size_t bgraStride, uint8_t alpha);
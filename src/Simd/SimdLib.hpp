@@ -2563,6 +2563,37 @@ namespace Simd
         }
     }
 
+    /*! @ingroup resizing
+
+        \fn void ResizeBilinearRows(const View<A>& src, View<A>& dst, size_t yBegin, size_t yEnd)
+
+        \short Performs resizing of input image with using bilinear interpolation for a range of output rows.
+
+        Output rows in range [yBegin, yEnd) are equal to the same rows of the result of Simd::ResizeBilinear. Other rows of the output image are not changed.
+        All images must have the same format (8-bit gray, 16-bit UV, 24-bit BGR or 32-bit BGRA).
+
+        \note This function is a C++ wrapper for function ::SimdResizeBilinearRows.
+
+        \param [in] src - an original input image.
+        \param [out] dst - a reduced output image.
+        \param [in] yBegin - a first output row to fill.
+        \param [in] yEnd - an output row after the last row to fill.
+    */
+    template<template<class> class A> SIMD_INLINE void ResizeBilinearRows(const View<A>& src, View<A>& dst, size_t yBegin, size_t yEnd)
+    {
+        assert(src.format == dst.format && src.ChannelSize() == 1 && yBegin <= yEnd && yEnd <= dst.height);
+
+        if (EqualSize(src, dst))
+        {
+            Copy(src.Region(0, yBegin, src.width, yEnd), dst.Region(0, yBegin, dst.width, yEnd).Ref());
+        }
+        else
+        {
+            SimdResizeBilinearRows(src.data, src.width, src.height, src.stride,
+                dst.data, dst.width, dst.height, dst.stride, src.ChannelCount(), yBegin, yEnd);
+        }
+    }
+
     /*! @ingroup segmentation
 
         \fn void SegmentationChangeIndex(View<A> & mask, uint8_t oldIndex, uint8_t newIndex)
@@ -2661,6 +2692,41 @@ namespace Simd
         SimdSegmentationShrinkRegion(mask.data, mask.stride, mask.width, mask.height, index, &rect.left, &rect.top, &rect.right, &rect.bottom);
     }
 
+    /*! @ingroup segmentation
+
+        \fn size_t SegmentationLabel(View<A> & mask, const View<A> & difference, uint8_t seedIndex, uint8_t emptyIndex, uint8_t invalidIndex, uint8_t differenceThreshold, size_t areaMin, uint8_t indexMin, std::vector<Rectangle<ptrdiff_t> > & rects)
+
+        \short Labels connected regions of mask which grow from seed points.
+
+        All images must have the same width, height and 8-bit gray pixel format.
+
+        \note This function is a C++ wrapper for function ::SimdSegmentationLabel.
+
+        \param [in, out] mask - a 8-bit gray mask image.
+        \param [in] difference - a 8-bit gray difference image.
+        \param [in] seedIndex - seed mask index.
+        \param [in] emptyIndex - empty mask index.
+        \param [in] invalidIndex - invalid mask index.
+        \param [in] differenceThreshold - a difference threshold for growing of regions.
+        \param [in] areaMin - a maximal bounding box area of region which gets invalid index.
+        \param [in] indexMin - an index of the first region.
+        \param [out] rects - bounding boxes of numerated regions (region with index (indexMin + i) has bounding box rects[i]).
+        \return a number of found regions with bounding box area greater than areaMin.
+    */
+    template<template<class> class A> SIMD_INLINE size_t SegmentationLabel(View<A> & mask, const View<A> & difference, uint8_t seedIndex, uint8_t emptyIndex,
+        uint8_t invalidIndex, uint8_t differenceThreshold, size_t areaMin, uint8_t indexMin, std::vector<Rectangle<ptrdiff_t> > & rects)
+    {
+        assert(Compatible(mask, difference) && mask.format == View<A>::Gray8);
+
+        std::vector<ptrdiff_t> buffer(4 * (256 - indexMin));
+        size_t count = SimdSegmentationLabel(mask.data, mask.stride, mask.width, mask.height, difference.data, difference.stride,
+            seedIndex, emptyIndex, invalidIndex, differenceThreshold, areaMin, indexMin, buffer.data());
+        rects.resize(std::min<size_t>(count, 256 - indexMin));
+        for (size_t i = 0; i < rects.size(); ++i)
+            rects[i] = Rectangle<ptrdiff_t>(buffer[4 * i + 0], buffer[4 * i + 1], buffer[4 * i + 2], buffer[4 * i + 3]);
+        return count;
+    }
+
     /*! @ingroup shifting
 
         \fn void ShiftBilinear(const View<A> & src, const View<A> & bkg, const Point<double> & shift, const Rectangle<ptrdiff_t> & crop, View<A> & dst)
@@ -3289,6 +3355,48 @@ namespace Simd
         SimdTextureBoostedUv(src.data, src.stride, src.width, src.height, boost, dst.data, dst.stride);
     }
 
+    /*! @ingroup texture_estimation
+
+        \fn void TextureFeatureDifference(const View<A>& gray, uint8_t saturation, uint8_t boost, const View<A>& grayLo, const View<A>& grayHi, uint16_t grayWeight, View<A>& dx, const View<A>& dxLo, const View<A>& dxHi, uint16_t dxWeight, View<A>& dy, const View<A>& dyLo, const View<A>& dyHi, uint16_t dyWeight, const View<A>& mask, View<A>& difference)
+
+        \short Calculates boosted saturated gradients and total feature difference of gray, dx and dy in one pass.
+
+        All images must have the same width, height and format (8-bit gray).
+
+        It is equal to sequential call of Simd::TextureBoostedSaturatedGradient (gray -> dx, dy), filling of difference by zero,
+        three calls of Simd::AddFeatureDifference (for gray, dx and dy features) and bitwise AND of difference with mask.
+
+        \note This function is a C++ wrapper for function ::SimdTextureFeatureDifference.
+
+        \param [in] gray - a source 8-bit gray image.
+        \param [in] saturation - a saturation of gradient.
+        \param [in] boost - a boost coefficient.
+        \param [in] grayLo - an image with lower bound of gray feature.
+        \param [in] grayHi - an image with upper bound of gray feature.
+        \param [in] grayWeight - a gray feature weight (unsigned 8.8 fixed point value).
+        \param [out] dx - an image with boosted saturated gradient along x axis.
+        \param [in] dxLo - an image with lower bound of dx feature.
+        \param [in] dxHi - an image with upper bound of dx feature.
+        \param [in] dxWeight - a dx feature weight (unsigned 8.8 fixed point value).
+        \param [out] dy - an image with boosted saturated gradient along y axis.
+        \param [in] dyLo - an image with lower bound of dy feature.
+        \param [in] dyHi - an image with upper bound of dy feature.
+        \param [in] dyWeight - a dy feature weight (unsigned 8.8 fixed point value).
+        \param [in] mask - a mask image. It can be empty (then the mask is not applied).
+        \param [out] difference - an image with total feature difference.
+    */
+    template<template<class> class A> SIMD_INLINE void TextureFeatureDifference(const View<A>& gray, uint8_t saturation, uint8_t boost,
+        const View<A>& grayLo, const View<A>& grayHi, uint16_t grayWeight, View<A>& dx, const View<A>& dxLo, const View<A>& dxHi, uint16_t dxWeight,
+        View<A>& dy, const View<A>& dyLo, const View<A>& dyHi, uint16_t dyWeight, const View<A>& mask, View<A>& difference)
+    {
+        assert(Compatible(gray, grayLo, grayHi, difference) && gray.format == View<A>::Gray8 && gray.height >= 3 && gray.width >= 3);
+        assert(Compatible(gray, dx, dxLo, dxHi) && Compatible(gray, dy, dyLo, dyHi) && (mask.data == NULL || Compatible(gray, mask)));
+
+        SimdTextureFeatureDifference(gray.data, gray.stride, gray.width, gray.height, saturation, boost,
+            grayLo.data, grayLo.stride, grayHi.data, grayHi.stride, grayWeight, dx.data, dx.stride, dxLo.data, dxLo.stride, dxHi.data, dxHi.stride, dxWeight,
+            dy.data, dy.stride, dyLo.data, dyLo.stride, dyHi.data, dyHi.stride, dyWeight, mask.data, mask.stride, difference.data, difference.stride);
+    }
+
     /*! @ingroup texture_estimation
 
         \fn void TextureGetDifferenceSum(const View<A>& src, const View<A>& lo, const View<A>& hi, int64_t & sum)
@@ -3368,6 +3476,30 @@ namespace Simd
         SimdYuv420pToBgr(y.data, y.stride, u.data, u.stride, v.data, v.stride, y.width, y.height, bgr.data, bgr.stride);
     }
 
+    /*! @ingroup yuv_conversion
+
+        \fn void Nv12ToBgr(const View<A>& y, const View<A>& uv, View<A>& bgr)
+
+        \short Converts NV12 image to 24-bit BGR image.
+
+        The input Y and output BGR images must have the same width and height.
+        The input UV image has half size relative to Y component.
+
+        \note This function is a C++ wrapper for function ::SimdNv12ToBgr.
+
+        \param [in] y - an input 8-bit image with Y color plane.
+        \param [in] uv - an input 16-bit image with interleaved U and V color planes.
+        \param [out] bgr - an output 24-bit BGR image.
+    */
+    template<template<class> class A> SIMD_INLINE void Nv12ToBgr(const View<A>& y, const View<A>& uv, View<A>& bgr)
+    {
+        assert(y.width == 2 * uv.width && y.height == 2 * uv.height && uv.format == View<A>::Uv16);
+        assert(y.width == bgr.width && y.height == bgr.height);
+        assert(y.format == View<A>::Gray8 && bgr.format == View<A>::Bgr24);
+
+        SimdNv12ToBgr(y.data, y.stride, uv.data, uv.stride, y.width, y.height, bgr.data, bgr.stride);
+    }
+
     /*! @ingroup yuv_conversion
 
         \fn void Yuv422pToBgr(const View<A>& y, const View<A>& u, const View<A>& v, View<A>& bgr)
@@ -3443,6 +3575,31 @@ namespace Simd
         SimdYuv420pToBgra(y.data, y.stride, u.data, u.stride, v.data, v.stride, y.width, y.height, bgra.data, bgra.stride, alpha);
     }
 
+    /*! @ingroup yuv_conversion
+
+        \fn void Nv12ToBgra(const View<A>& y, const View<A>& uv, View<A>& bgra, uint8_t alpha = 0xFF)
+
+        \short Converts NV12 image to 32-bit BGRA image.
+
+        The input Y and output BGRA images must have the same width and height.
+        The input UV image has half size relative to Y component.
+
+        \note This function is a C++ wrapper for function ::SimdNv12ToBgra.
+
+        \param [in] y - an input 8-bit image with Y color plane.
+        \param [in] uv - an input 16-bit image with interleaved U and V color planes.
+        \param [out] bgra - an output 32-bit BGRA image.
+        \param [in] alpha - a value of alpha channel. It is equal to 255 by default.
+    */
+    template<template<class> class A> SIMD_INLINE void Nv12ToBgra(const View<A>& y, const View<A>& uv, View<A>& bgra, uint8_t alpha = 0xFF)
+    {
+        assert(y.width == 2 * uv.width && y.height == 2 * uv.height && uv.format == View<A>::Uv16);
+        assert(y.width == bgra.width && y.height == bgra.height);
+        assert(y.format == View<A>::Gray8 && bgra.format == View<A>::Bgra32);
+
+        SimdNv12ToBgra(y.data, y.stride, uv.data, uv.stride, y.width, y.height, bgra.data, bgra.stride, alpha);
+    }
+
     /*! @ingroup yuv_conversion
 
         \fn void Yuv422pToBgra(const View<A>& y, const View<A>& u, const View<A>& v, View<A>& bgra, uint8_t alpha = 0xFF)
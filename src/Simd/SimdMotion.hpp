@@ -28,9 +28,11 @@
 #include "Simd/SimdRectangle.hpp"
 #include "Simd/SimdFrame.hpp"
 #include "Simd/SimdDrawing.hpp"
+#include "Simd/SimdParallel.hpp"
 
 #include <vector>
 #include <stack>
+#include <chrono>
 
 #ifndef SIMD_CHECK_PERFORMANCE
 #define SIMD_CHECK_PERFORMANCE()
@@ -68,6 +70,12 @@ namespace Simd
         struct Metadata
         {
             Objects objects;
+            bool sabotage; // the scene is unstable (camera is covered or moved, global illumination is changed).
+
+            Metadata()
+                : sabotage(false)
+            {
+            }
         };
 
         struct Model
@@ -98,6 +106,8 @@ namespace Simd
 
         struct Options
         {
+            int FrameReduceCount; // number of 2x reductions of input frame before processing (0 - full resolution).
+
             int TextureGradientSaturation;
             int TextureGradientBoost;
 
@@ -109,6 +119,12 @@ namespace Simd
 
             double BackgroundGrowTime;
             double BackgroundIncrementTime;
+            int BackgroundSabotageCounterMax;
+
+            int StabilityDifferenceOn; // mean absolute difference (on the coarsest level) to enter sabotage state.
+            int StabilityDifferenceOff; // mean absolute difference (on the coarsest level) to leave sabotage state.
+            int StabilityContrastOn; // contrast (max - min on the coarsest level) to enter sabotage state.
+            int StabilityContrastOff; // contrast (max - min on the coarsest level) to leave sabotage state.
 
             int DebugDrawLevel;
             int DebugDrawBottomRight; // 0 - empty; 1 = difference; 2 - texture.gray.value; 3 - texture.dx.value; 4 - texture.dy.value;
@@ -116,6 +132,8 @@ namespace Simd
 
             Options()
             {
+                FrameReduceCount = 0;
+
                 TextureGradientSaturation = 16;
                 TextureGradientBoost = 4;
 
@@ -127,6 +145,12 @@ namespace Simd
 
                 BackgroundGrowTime = 1.0;
                 BackgroundIncrementTime = 1.0;
+                BackgroundSabotageCounterMax = 3;
+
+                StabilityDifferenceOn = 48;
+                StabilityDifferenceOff = 24;
+                StabilityContrastOn = 4;
+                StabilityContrastOff = 8;
 
                 DebugDrawLevel = 1;
                 DebugDrawBottomRight = 1;
@@ -137,6 +161,7 @@ namespace Simd
         struct Detector
         {
             Detector()
+                : _threadNumber(1)
             {
             }
 
@@ -146,6 +171,11 @@ namespace Simd
 
             bool SetOptions(const Options & options)
             {
+                if (options.FrameReduceCount != _options.FrameReduceCount)
+                {
+                    _scene.model.inputSize = Size();
+                    _scene.model.frameSize = Size();
+                }
                 _options = options;
                 return true;
             }
@@ -156,6 +186,12 @@ namespace Simd
                 return true;
             }
 
+            bool SetThreadNumber(size_t threadNumber)
+            {
+                _threadNumber = std::max<size_t>(threadNumber, 1);
+                return true;
+            }
+
             bool NextFrame(const Frame & input, Metadata & metadata, Frame * output = NULL)
             {
                 SIMD_CHECK_PERFORMANCE();
@@ -170,14 +206,20 @@ namespace Simd
 
                 EstimateTextures();
 
-                EstimateDifference();
+                EstimateStability();
 
-                PerformSegmentation();
+                EstimateDifference();
 
-                _scene.stability.sceneState = Stability::Stable;
+                if (_scene.stability.sceneState == Stability::Sabotage)
+                    _scene.segmentation.movingRegions.clear();
+                else
+                    PerformSegmentation();
 
                 UpdateBackground();
 
+                metadata.objects.clear();
+                metadata.sabotage = _scene.stability.sceneState == Stability::Sabotage;
+
                 DebugAnnotation();
 
                 return true;
@@ -186,15 +228,12 @@ namespace Simd
         private:
             Options _options;
             Simd::Motion::Model _model;
-
-            typedef std::pair<size_t, size_t> Scanline;
-            typedef std::vector<Scanline> Scanlines;
+            size_t _threadNumber;
 
             struct SearchRegion
             {
                 Rect rect; // rectangle on corresponding pyramid level (scale)
                 int scale; // pyramid level
-                Scanlines scanlines;
 
                 SearchRegion()
                     : scale(0)
@@ -211,6 +250,7 @@ namespace Simd
 
             struct Model
             {
+                Size inputSize;
                 Size frameSize;
                 Points roi;
 
@@ -242,35 +282,33 @@ namespace Simd
             typedef std::shared_ptr<MovingRegion> MovingRegionPtr;
             typedef std::vector<MovingRegionPtr> MovingRegionPtrs;
 
+            typedef std::vector<View> Views;
+
             struct Texture
             {
                 struct Bound
                 {
-                    Pyramid value;
-                    Pyramid count;
-
-                    void Create(const Size & size, size_t levelCount)
-                    {
-                        value.Recreate(size, levelCount);
-                        count.Recreate(size, levelCount);
-                    }
+                    Views value;
+                    Views count;
                 };
 
-                struct Feature
+                struct Feature // all images are references to the level blocks.
                 {
-                    Pyramid value;
+                    Views value;
                     Bound lo;
                     Bound hi;
                     uint16_t weight;
+                };
 
-                    void Create(const Size & size, size_t levelCount, int weight_)
-                    {
-                        value.Recreate(size, levelCount);
-                        lo.Create(size, levelCount);
-                        hi.Create(size, levelCount);
-                        weight = uint16_t(weight_ * 256);
-                    }
+                struct Block // background model of all features on one pyramid level (rows of features are interleaved).
+                {
+                    View value;
+                    View loValue;
+                    View loCount;
+                    View hiValue;
+                    View hiCount;
                 };
+                typedef std::vector<Block> Blocks;
 
                 enum FeatureType
                 {
@@ -286,16 +324,61 @@ namespace Simd
                 typedef std::vector<Feature *> Features;
                 Features features;
 
+                Blocks blocks;
+
                 void Create(const Size & size, size_t levelCount, const Options & options)
                 {
-                    gray.Create(size, levelCount, options.DifferenceGrayFeatureWeight);
-                    dx.Create(size, levelCount, options.DifferenceDxFeatureWeight);
-                    dy.Create(size, levelCount, options.DifferenceDyFeatureWeight);
+                    gray.weight = uint16_t(options.DifferenceGrayFeatureWeight * 256);
+                    dx.weight = uint16_t(options.DifferenceDxFeatureWeight * 256);
+                    dy.weight = uint16_t(options.DifferenceDyFeatureWeight * 256);
 
                     features.clear();
                     features.push_back(&gray);
                     features.push_back(&dx);
                     features.push_back(&dy);
+
+                    blocks.clear();
+                    blocks.resize(levelCount);
+                    for (size_t i = 0; i < features.size(); ++i)
+                    {
+                        Feature & feature = *features[i];
+                        feature.value.resize(levelCount);
+                        feature.lo.value.resize(levelCount);
+                        feature.lo.count.resize(levelCount);
+                        feature.hi.value.resize(levelCount);
+                        feature.hi.count.resize(levelCount);
+                    }
+
+                    Size levelSize = size;
+                    for (size_t level = 0; level < levelCount; ++level)
+                    {
+                        size_t featureWidth = Simd::AlignHi(levelSize.x, Simd::Alignment());
+                        size_t blockWidth = featureWidth*features.size();
+                        Block & block = blocks[level];
+                        block.value.Recreate(blockWidth, levelSize.y, View::Gray8);
+                        block.loValue.Recreate(blockWidth, levelSize.y, View::Gray8);
+                        block.loCount.Recreate(blockWidth, levelSize.y, View::Gray8);
+                        block.hiValue.Recreate(blockWidth, levelSize.y, View::Gray8);
+                        block.hiCount.Recreate(blockWidth, levelSize.y, View::Gray8);
+                        Simd::Fill(block.value, 0);
+                        Simd::Fill(block.loValue, 0);
+                        Simd::Fill(block.loCount, 0);
+                        Simd::Fill(block.hiValue, 255);
+                        Simd::Fill(block.hiCount, 0);
+
+                        for (size_t i = 0; i < features.size(); ++i)
+                        {
+                            Feature & feature = *features[i];
+                            size_t offset = i*featureWidth;
+                            feature.value[level] = block.value.Region(offset, 0, offset + levelSize.x, levelSize.y);
+                            feature.lo.value[level] = block.loValue.Region(offset, 0, offset + levelSize.x, levelSize.y);
+                            feature.lo.count[level] = block.loCount.Region(offset, 0, offset + levelSize.x, levelSize.y);
+                            feature.hi.value[level] = block.hiValue.Region(offset, 0, offset + levelSize.x, levelSize.y);
+                            feature.hi.count[level] = block.hiCount.Region(offset, 0, offset + levelSize.x, levelSize.y);
+                        }
+
+                        levelSize = Simd::Scale(levelSize);
+                    }
                 }
             };
 
@@ -343,6 +426,8 @@ namespace Simd
                 int kMovingRegionThreshold;
                 int kMovingRegionMinShortage;
 
+                View reference; // gray image of the coarsest level at the last background update.
+
                 Stability()
                     : state(Empty)
                     , sceneState(Unknown)
@@ -374,6 +459,7 @@ namespace Simd
             {
                 Frame input, *output;
                 View gray;
+                Pyramid reduced;
 
                 Pyramid buffer;
 
@@ -391,11 +477,16 @@ namespace Simd
 
                 void Create(const Options & options)
                 {
-                    gray.Recreate(model.frameSize, View::Gray8);
+                    if (options.FrameReduceCount > 1)
+                        reduced.Recreate(Simd::Scale(model.inputSize), options.FrameReduceCount - 1);
                     buffer.Recreate(model.frameSize, model.levelCount);
                     texture.Create(model.frameSize, model.levelCount, options);
                     difference.Recreate(model.frameSize, model.levelCount);
                     segmentation.mask.Recreate(model.frameSize, model.levelCount);
+                    stability.reference.Recreate(texture.gray.value.back().Size(), View::Gray8);
+                    stability.state = Stability::Empty;
+                    background = Background();
+                    segmentation.movingRegions.clear();
                 }
             };
 
@@ -405,18 +496,45 @@ namespace Simd
 
                 _scene.input = input;
                 _scene.output = output;
-                Simd::Convert(input, Frame(_scene.gray).Ref());
+
+                View & gray = _scene.texture.gray.value[0];
+                if (_options.FrameReduceCount == 0)
+                    Simd::Convert(input, Frame(gray).Ref());
+                else
+                {
+                    View src;
+                    if (input.format == Frame::Nv12 || input.format == Frame::Yuv420p || input.format == Frame::Gray8)
+                        src = input.planes[0];
+                    else
+                    {
+                        if (_scene.gray.Size() != input.Size())
+                            _scene.gray.Recreate(input.Size(), View::Gray8);
+                        Simd::Convert(input, Frame(_scene.gray).Ref());
+                        src = _scene.gray;
+                    }
+                    for (int i = 0; i < _options.FrameReduceCount; ++i)
+                    {
+                        View & dst = i == _options.FrameReduceCount - 1 ? gray : _scene.reduced[i];
+                        Simd::ReduceGray4x4(src, dst);
+                        src = dst;
+                    }
+                }
 
                 return true;
             }
 
-            bool Calibrate(const Size & frameSize)
+            bool Calibrate(const Size & inputSize)
             {
                 Model & model = _scene.model;
 
-                if (model.frameSize == frameSize)
+                if (model.inputSize == inputSize)
                     return true;
 
+                model.inputSize = inputSize;
+                Size frameSize = inputSize;
+                for (int i = 0; i < _options.FrameReduceCount; ++i)
+                    frameSize = Simd::Scale(frameSize);
+
                 if (model.frameSize == Size())
                 {
                     model.frameSize = frameSize;
@@ -429,7 +547,7 @@ namespace Simd
                 }
 
                 GenerateSearchRegion(model);
-                GenerateSearchRegionScanlines(model);
+                GenerateRoiMask(model);
 
                 _scene.Create(_options);
 
@@ -449,7 +567,7 @@ namespace Simd
                 model.searchRegions.push_back(SearchRegion(rect, level));
             }
 
-            void GenerateSearchRegionScanlines(Model & model)
+            void GenerateRoiMask(Model & model)
             {
                 static const uint8_t ROI_EMPTY = 0;
                 static const uint8_t ROI_NON_EMPTY = 255;
@@ -458,86 +576,88 @@ namespace Simd
                 Simd::Fill(model.roiMask, ROI_EMPTY);
                 DrawFilledPolygon(model.roiMask[0], model.roi, ROI_NON_EMPTY);
                 Simd::Build(model.roiMask, SimdReduce4x4);
-
-                for (size_t i = 0; i < model.searchRegions.size(); ++i)
-                {
-                    SearchRegion & region = model.searchRegions[i];
-                    int scale = region.scale;
-
-                    assert(scale < (int)model.roiMask.Size());
-
-                    const View & view = model.roiMask[region.scale];
-                    const Rect & rect = region.rect;
-                    for (ptrdiff_t row = rect.Top(); row < rect.Bottom(); ++row)
-                    {
-                        ptrdiff_t offset = row * view.stride + rect.Left();
-                        ptrdiff_t end = offset + rect.Width();
-                        for (; offset < end;)
-                        {
-                            if (view.data[offset])
-                            {
-                                Scanline scanline;
-                                scanline.first = offset;
-                                while (++offset < end && view.data[offset]);
-                                scanline.second = offset;
-                                region.scanlines.push_back(scanline);
-                            }
-                            else
-                                ++offset;
-                        }
-                    }
-                }
             }
 
             bool EstimateTextures()
             {
                 SIMD_CHECK_PERFORMANCE();
 
-                Texture & texture = _scene.texture;
+                Views & gray = _scene.texture.gray.value;
+                for (size_t level = 1; level < gray.size(); ++level)
+                    Simd::ReduceGray4x4(gray[level - 1], gray[level]);
 
-                Simd::Copy(_scene.gray, texture.gray.value[0]);
-                Simd::Build(texture.gray.value, SimdReduce4x4);
+                return true;
+            }
 
-                for (size_t i = 0; i < texture.gray.value.Size(); ++i)
+            bool EstimateStability()
+            {
+                SIMD_CHECK_PERFORMANCE();
+
+                Stability & stability = _scene.stability;
+                if (stability.state == Stability::Empty)
                 {
-                    Simd::TextureBoostedSaturatedGradient(texture.gray.value[i],
-                        _options.TextureGradientSaturation, _options.TextureGradientBoost,
-                        texture.dx.value[i], texture.dy.value[i]);
+                    stability.sceneState = Stability::Unknown;
+                    return true;
                 }
 
+                const View & gray = _scene.texture.gray.value.back();
+                uint8_t min, max, average;
+                Simd::GetStatistic(gray, min, max, average);
+                uint64_t sum;
+                Simd::AbsDifferenceSum(gray, stability.reference, sum);
+                int contrast = max - min;
+                int difference = int(sum / gray.Area());
+
+                if (stability.sabotage)
+                    stability.sabotage = difference >= _options.StabilityDifferenceOff || contrast <= _options.StabilityContrastOff;
+                else
+                    stability.sabotage = difference > _options.StabilityDifferenceOn || contrast < _options.StabilityContrastOn;
+                stability.sceneState = stability.sabotage ? Stability::Sabotage : Stability::Stable;
+
                 return true;
             }
 
+            void UpdateStabilityReference()
+            {
+                Stability & stability = _scene.stability;
+                Simd::Copy(_scene.texture.gray.value.back(), stability.reference);
+                stability.state = Stability::Ready;
+            }
+
             bool EstimateDifference()
             {
                 SIMD_CHECK_PERFORMANCE();
 
-                const Texture & texture = _scene.texture;
+                Texture & texture = _scene.texture;
                 Pyramid & difference = _scene.difference;
                 Pyramid & buffer = _scene.buffer;
-                for (size_t i = 0; i < difference.Size(); ++i)
-                {
-                    Simd::Fill(difference[i], 0);
-                    for (size_t j = 0; j < texture.features.size(); ++j)
-                    {
-                        const Texture::Feature & feature = *texture.features[j];
-                        Simd::AddFeatureDifference(feature.value[i], feature.lo.value[i], feature.hi.value[i], feature.weight, difference[i]);
-                    }
-                }
+                const Pyramid & roiMask = _scene.model.roiMask;
+                const bool propagate = _options.DifferencePropagateForward;
+                const bool masked = _options.DifferenceRoiMaskEnable;
 
-                if (_options.DifferencePropagateForward)
+                // Gradients, feature difference and ROI mask are computed in one pass per level.
+                // With forward propagation all levels are masked after it (as before).
+                Execute(difference.Size(), [&](size_t i)
+                {
+                    Simd::TextureFeatureDifference(texture.gray.value[i], _options.TextureGradientSaturation, _options.TextureGradientBoost,
+                        texture.gray.lo.value[i], texture.gray.hi.value[i], texture.gray.weight,
+                        texture.dx.value[i], texture.dx.lo.value[i], texture.dx.hi.value[i], texture.dx.weight,
+                        texture.dy.value[i], texture.dy.lo.value[i], texture.dy.hi.value[i], texture.dy.weight,
+                        masked && !propagate ? roiMask[i] : View(), difference[i]);
+                });
+
+                if (propagate)
                 {
                     for (size_t i = 1; i < difference.Size(); ++i)
                     {
                         Simd::ReduceGray4x4(difference[i - 1], buffer[i]);
                         Simd::OperationBinary8u(difference[i], buffer[i], difference[i], SimdOperationBinary8uMaximum);
                     }
-                }
-
-                if (_options.DifferenceRoiMaskEnable)
-                {
-                    for (size_t i = 0; i < difference.Size(); ++i)
-                        Simd::OperationBinary8u(difference[i], _scene.model.roiMask[i], difference[i], SimdOperationBinary8uAnd);
+                    if (masked)
+                    {
+                        for (size_t i = 0; i < difference.Size(); ++i)
+                            Simd::OperationBinary8u(difference[i], roiMask[i], difference[i], SimdOperationBinary8uAnd);
+                    }
                 }
 
                 return true;
@@ -545,11 +665,7 @@ namespace Simd
 
             bool PerformSegmentation()
             {
-                Point neighbours[4];
-                neighbours[0] = Point(-1, 0);
-                neighbours[1] = Point(0, -1);
-                neighbours[2] = Point(1, 0);
-                neighbours[3] = Point(0, 1);
+                SIMD_CHECK_PERFORMANCE();
 
                 Segmentation & segmentation = _scene.segmentation;
                 const Model & model = _scene.model;
@@ -568,72 +684,48 @@ namespace Simd
                     Simd::FillFrame(mask, Rect(1, 1, mask.width - 1, mask.height - 1), Segmentation::MaskInvalid);
                 }
 
+                bool result = true;
                 for (size_t i = 0; i < model.searchRegions.size(); ++i)
                 {
                     const SearchRegion & searchRegion = model.searchRegions[i];
                     int level = searchRegion.scale;
                     const View & difference = _scene.difference.At(level);
                     View & mask = segmentation.mask.At(level);
-                    Rect roi = searchRegion.rect;
+                    const Rect & rect = searchRegion.rect;
 
-                    for (size_t i = 0; i < searchRegion.scanlines.size(); ++i)
-                    {
-                        const Scanline & scanline = searchRegion.scanlines[i];
-                        for (size_t offset = scanline.first; offset < scanline.second; ++offset)
-                        {
-                            if (difference.data[offset] > segmentation.differenceCreationMin && mask.data[offset] == Segmentation::MaskNotVisited)
-                                mask.data[offset] = Segmentation::MaskSeed;
-                        }
-                    }
+                    View seed = _scene.buffer.At(level).Region(rect);
+                    Simd::Binarization(difference.Region(rect), segmentation.differenceCreationMin, Segmentation::MaskSeed, Segmentation::MaskNotVisited, seed, SimdCompareGreater);
+                    Simd::OperationBinary8u(seed, model.roiMask.At(level).Region(rect), seed, SimdOperationBinary8uAnd);
+                    Simd::OperationBinary8u(seed, mask.Region(rect), mask.Region(rect).Ref(), SimdOperationBinary8uMaximum);
+
+                    if (segmentation.movingRegions.size() + Segmentation::MaskIndexSize > UINT8_MAX)
+                        return false;
+                    uint8_t indexMin = uint8_t(segmentation.movingRegions.size() + Segmentation::MaskIndexSize);
 
-                    ShrinkRoi(mask, roi, Segmentation::MaskSeed);
-                    roi &= searchRegion.rect;
+                    Rects rects;
+                    size_t count = Simd::SegmentationLabel(mask, difference, Segmentation::MaskSeed, Segmentation::MaskNotVisited, Segmentation::MaskInvalid,
+                        segmentation.differenceExpansionMin, segmentation.movingRegionAreaMin, indexMin, rects);
+                    if (count > rects.size())
+                        result = false;
 
-                    for (ptrdiff_t y = roi.top; y < roi.bottom; ++y)
+                    for (size_t j = 0; j < rects.size(); ++j)
                     {
-                        for (ptrdiff_t x = roi.left; x < roi.right; ++x)
+                        uint8_t label = uint8_t(indexMin + j);
+                        uint8_t index = uint8_t(Segmentation::MaskIndexSize + segmentation.movingRegions.size());
+                        if (index != label)
+                            Simd::SegmentationChangeIndex(mask.Region(rects[j]).Ref(), label, index);
+
+                        MovingRegionPtr region(new MovingRegion(index, rects[j], level, time));
+                        ComputeIndex(segmentation, *region);
+                        if (!region->rect.Empty())
                         {
-                            if (mask.At<uint8_t>(x, y) == Segmentation::MaskSeed)
-                            {
-                                std::stack<Point> stack;
-                                stack.push(Point(x, y));
-                                if (segmentation.movingRegions.size() + Segmentation::MaskIndexSize > UINT8_MAX)
-                                    return false;
-                                MovingRegionPtr region(new MovingRegion(uint8_t(segmentation.movingRegions.size() + Segmentation::MaskIndexSize), Rect(), level, time));
-                                while (!stack.empty())
-                                {
-                                    Point current = stack.top();
-                                    stack.pop();
-                                    mask.At<uint8_t>(current) = region->index;
-                                    region->rect |= current;
-                                    for (size_t n = 0; n < 4; ++n)
-                                    {
-                                        Point neighbour = current + neighbours[n];
-                                        if (difference.At<uint8_t>(neighbour) > segmentation.differenceExpansionMin &&	mask.At<uint8_t>(neighbour) <= Segmentation::MaskSeed)
-                                            stack.push(neighbour);
-                                    }
-                                }
-
-                                if (region->rect.Area() <= segmentation.movingRegionAreaMin)
-                                    Simd::SegmentationChangeIndex(segmentation.mask[region->level].Region(region->rect).Ref(), region->index, Segmentation::MaskInvalid);
-                                else
-                                {
-                                    ComputeIndex(segmentation, *region);
-                                    if (!region->rect.Empty())
-                                    {
-                                        region->level = searchRegion.scale;
-                                        //if (motion.detectLevel)
-                                        //    region->rect = region->rect * (1 << motion.detectLevel);
-                                        region->point = region->rect.Center();
-                                        //region->inRoi = model.roi.HasPoint(region->point);
-                                        segmentation.movingRegions.push_back(region);
-                                    }
-                                }
-                            }
+                            region->level = searchRegion.scale;
+                            region->point = region->rect.Center();
+                            segmentation.movingRegions.push_back(region);
                         }
                     }
                 }
-                return true;
+                return result;
             }
 
             SIMD_INLINE void ShrinkRoi(const View & mask, Rect & roi, uint8_t index)
@@ -731,16 +823,35 @@ namespace Simd
                 }
             };
 
-            template <typename Updater> void Apply(Texture::Features & features, const Updater & updater)
+            template <typename Updater> void Apply(const Updater & updater)
             {
-                for (size_t i = 0; i < features.size(); ++i)
+                Texture::Blocks & blocks = _scene.texture.blocks;
+                size_t bandCount = _threadNumber;
+                Execute(blocks.size()*bandCount, [&](size_t i)
                 {
-                    Texture::Feature & feature = *features[i];
-                    for (size_t j = 0; j < feature.value.Size(); ++j)
-                    {
-                        updater(feature.value[j], feature.lo.value[j], feature.lo.count[j], feature.hi.value[j], feature.hi.count[j]);
-                    }
-                }
+                    Texture::Block & block = blocks[i / bandCount];
+                    size_t band = i % bandCount, width = block.value.width, height = block.value.height;
+                    size_t top = height*band / bandCount, bottom = height*(band + 1) / bandCount;
+                    if (top == bottom)
+                        return;
+                    View value = block.value.Region(0, top, width, bottom);
+                    View loValue = block.loValue.Region(0, top, width, bottom);
+                    View loCount = block.loCount.Region(0, top, width, bottom);
+                    View hiValue = block.hiValue.Region(0, top, width, bottom);
+                    View hiCount = block.hiCount.Region(0, top, width, bottom);
+                    updater(value, loValue, loCount, hiValue, hiCount);
+                });
+            }
+
+            template<class Function> void Execute(size_t count, const Function & function)
+            {
+                size_t threadNumber = std::min<size_t>(_threadNumber, count);
+                std::atomic<size_t> next(0);
+                Parallel(0, threadNumber, [&](size_t thread, size_t begin, size_t end)
+                {
+                    for (size_t i = next++; i < count; i = next++)
+                        function(i);
+                }, threadNumber);
             }
 
             bool UpdateBackground()
@@ -757,13 +868,14 @@ namespace Simd
                     switch (stabilityState)
                     {
                     case Stability::Stable:
-                        Apply(_scene.texture.features, IncrementCountUpdater());
+                        Apply(IncrementCountUpdater());
                         ++background.count;
                         background.incrementCounterTime += time - background.lastFrameTime;
 
                         if (background.count >= 127 || (background.incrementCounterTime > _options.BackgroundIncrementTime && background.count >= 8))
                         {
-                            Apply(_scene.texture.features, AdjustRangeUpdater());
+                            Apply(AdjustRangeUpdater());
+                            UpdateStabilityReference();
 
                             background.incrementCounterTime = 0;
                             background.count = 0;
@@ -771,12 +883,14 @@ namespace Simd
                         break;
                     case Stability::Sabotage:
                         background.sabotageCounter++;
-                        if (background.sabotageCounter > 0)//_sabotageCounterMax)
+                        if (background.sabotageCounter > _options.BackgroundSabotageCounterMax)
                         {
                             InitBackground();
                         }
                         break;
-
+                    case Stability::Unknown:
+                        InitBackground();
+                        break;
                     default:
                         assert(0);
                     }
@@ -795,7 +909,7 @@ namespace Simd
                     }
                     else
                     {
-                        Apply(_scene.texture.features, GrowRangeUpdater());
+                        Apply(GrowRangeUpdater());
 
                         if (stabilityState != Stability::Stable && _scene.stability.state != Stability::Empty)
                         {
@@ -825,12 +939,14 @@ namespace Simd
             {
                 Background & background = _scene.background;
 
-                Apply(_scene.texture.features, InitUpdater());
+                Apply(InitUpdater());
+                UpdateStabilityReference();
 
                 background.expandEndTime = _scene.input.timestamp + _options.BackgroundGrowTime;
                 background.state = Background::Grow;
                 background.count = 0;
                 background.incrementCounterTime = 0;
+                background.sabotageCounter = 0;
             }
 
             bool DebugAnnotation()
@@ -858,7 +974,7 @@ namespace Simd
                         for (size_t i = 0; i < _scene.segmentation.movingRegions.size(); ++i)
                         {
                             const MovingRegion & region = *_scene.segmentation.movingRegions[i];
-                            Simd::DrawRectangle(output->planes[0], region.rect, color, 1);
+                            Simd::DrawRectangle(output->planes[0], region.rect * (1 << _options.FrameReduceCount), color, 1);
                         }
                     }
                 }
@@ -868,6 +984,115 @@ namespace Simd
 
             Scene _scene;
         };
+
+        typedef std::vector<Frame> Frames;
+        typedef std::vector<Metadata> Metadatas;
+
+        struct Engine
+        {
+            struct Latency
+            {
+                Time last;
+                Time average;
+                Time max;
+                size_t count;
+
+                Latency()
+                    : last(0)
+                    , average(0)
+                    , max(0)
+                    , count(0)
+                {
+                }
+
+                void Add(const Time & value)
+                {
+                    last = value;
+                    max = std::max(max, value);
+                    average = (average*count + value) / (count + 1);
+                    count++;
+                }
+            };
+
+            Engine(size_t threadNumber = std::thread::hardware_concurrency())
+                : _threadNumber(std::max<size_t>(threadNumber, 1))
+            {
+            }
+
+            size_t AddStream(const Options & options = Options(), const Model & model = Model())
+            {
+                StreamPtr stream(new Stream());
+                stream->detector.SetOptions(options);
+                stream->detector.SetModel(model);
+                stream->detector.SetThreadNumber(_threadNumber);
+                _streams.push_back(stream);
+                return _streams.size() - 1;
+            }
+
+            size_t StreamCount() const
+            {
+                return _streams.size();
+            }
+
+            const Latency & StreamLatency(size_t index) const
+            {
+                return _streams[index]->latency;
+            }
+
+            bool NextFrames(const Frames & inputs, Metadatas & metadatas, Frames * outputs = NULL)
+            {
+                SIMD_CHECK_PERFORMANCE();
+
+                if (inputs.size() != _streams.size() || (outputs && outputs->size() != _streams.size()))
+                    return false;
+
+                metadatas.resize(_streams.size());
+                Clock::time_point start = Clock::now();
+                Execute(_streams.size(), [&](size_t i)
+                {
+                    Stream & stream = *_streams[i];
+                    stream.result = true;
+                    if (inputs[i].format == Frame::None)
+                    {
+                        metadatas[i] = Metadata();
+                        return;
+                    }
+                    stream.result = stream.detector.NextFrame(inputs[i], metadatas[i], outputs ? &(*outputs)[i] : NULL);
+                    stream.latency.Add(std::chrono::duration<Time>(Clock::now() - start).count());
+                });
+
+                bool result = true;
+                for (size_t i = 0; i < _streams.size(); ++i)
+                    result = result && _streams[i]->result;
+                return result;
+            }
+
+        private:
+            typedef std::chrono::steady_clock Clock;
+
+            struct Stream
+            {
+                Detector detector;
+                Latency latency;
+                bool result;
+            };
+            typedef std::shared_ptr<Stream> StreamPtr;
+            typedef std::vector<StreamPtr> StreamPtrs;
+
+            StreamPtrs _streams;
+            size_t _threadNumber;
+
+            template<class Function> void Execute(size_t count, const Function & function)
+            {
+                size_t threadNumber = std::min<size_t>(_threadNumber, count);
+                std::atomic<size_t> next(0);
+                Parallel(0, threadNumber, [&](size_t thread, size_t begin, size_t end)
+                {
+                    for (size_t i = next++; i < count; i = next++)
+                        function(i);
+                }, threadNumber);
+            }
+        };
     }
 }
 
@@ -341,6 +341,239 @@ namespace Simd
                 Image(hid.sum.width - 1, hid.sum.height - 1, dstStride, Image::Gray8, dst).Ref());
         }
 
+        SIMD_INLINE int16x8_t PackSaturatedI32(const int32x4_t & lo, const int32x4_t & hi)
+        {
+            return vcombine_s16(vqmovn_s32(lo), vqmovn_s32(hi));
+        }
+
+        SIMD_INLINE int32x4_t Norm16i(const uint32x4_t & sum, const uint32x4_t & sqsum, const float32x4_t & area, const float32x4_t & scale)
+        {
+            float32x4_t _sum = vcvtq_f32_u32(sum);
+            float32x4_t _sqsum = vcvtq_f32_u32(sqsum);
+            float32x4_t norm = ValidSqrt(vmlsq_f32(vmulq_f32(_sqsum, area), _sum, _sum));
+            return vcvtq_s32_f32(vmlaq_f32(vdupq_n_f32(0.5f), norm, scale));
+        }
+
+        SIMD_INLINE int16x8_t Norm16ip(const HidHaarCascade16i & hid, size_t offset)
+        {
+            float32x4_t area = vdupq_n_f32(hid.windowArea);
+            float32x4_t scale = vdupq_n_f32(hid.normScale);
+            int32x4_t lo = Norm16i(Sum32ip(hid.p, offset + 0), Sum32ip(hid.pq, offset + 0), area, scale);
+            int32x4_t hi = Norm16i(Sum32ip(hid.p, offset + F), Sum32ip(hid.pq, offset + F), area, scale);
+            return PackSaturatedI32(lo, hi);
+        }
+
+        SIMD_INLINE int16x8_t Norm16ii(const HidHaarCascade16i & hid, size_t offset)
+        {
+            float32x4_t area = vdupq_n_f32(hid.windowArea);
+            float32x4_t scale = vdupq_n_f32(hid.normScale);
+            int32x4_t lo = Norm16i(Sum32ii(hid.p, offset + 0), Sum32ii(hid.pq, offset + 0), area, scale);
+            int32x4_t hi = Norm16i(Sum32ii(hid.p, offset + HA), Sum32ii(hid.pq, offset + HA), area, scale);
+            return PackSaturatedI32(lo, hi);
+        }
+
+        SIMD_INLINE int32x4_t RectSum16i(const WeightedRect16i & rect, size_t offset, const uint32x4_t & round, const int32x4_t & shift)
+        {
+            uint32x4_t s0 = vld1q_u32(rect.p0 + offset);
+            uint32x4_t s1 = vld1q_u32(rect.p1 + offset);
+            uint32x4_t s2 = vld1q_u32(rect.p2 + offset);
+            uint32x4_t s3 = vld1q_u32(rect.p3 + offset);
+            uint32x4_t sum = vsubq_u32(vsubq_u32(s0, s1), vsubq_u32(s2, s3));
+            return (int32x4_t)vshlq_u32(vaddq_u32(sum, round), shift);
+        }
+
+        SIMD_INLINE int16x8_t WeightedSum16i(const WeightedRect16i & rect, size_t offset, const uint32x4_t & round, const int32x4_t & shift)
+        {
+            int32x4_t lo = RectSum16i(rect, offset + 0, round, shift);
+            int32x4_t hi = RectSum16i(rect, offset + F, round, shift);
+            return vmulq_s16(PackSaturatedI32(lo, hi), vdupq_n_s16(rect.weight));
+        }
+
+        SIMD_INLINE int16x8_t MulHi16i(const int16x8_t & a, const int16x8_t & b)
+        {
+            int32x4_t lo = vmull_s16(Half<0>(a), Half<0>(b));
+            int32x4_t hi = vmull_s16(Half<1>(a), Half<1>(b));
+            return vcombine_s16(vshrn_n_s32(lo, 16), vshrn_n_s32(hi, 16));
+        }
+
+        SIMD_INLINE void StageSum16i(const int16_t * leaves, int16_t threshold, const int16x8_t & sum, const int16x8_t & norm, int16x8_t & stageSum)
+        {
+            uint16x8_t mask = vcgtq_s16(sum, MulHi16i(vdupq_n_s16(threshold), norm));
+            stageSum = vaddq_s16(stageSum, vbslq_s16(mask, vdupq_n_s16(leaves[1]), vdupq_n_s16(leaves[0])));
+        }
+
+        void Detect16i(const HidHaarCascade16i & hid, size_t offset, const int16x8_t & norm, uint16x8_t & result)
+        {
+            typedef HidHaarCascade16i Hid;
+            const int16_t * leaves = hid.leaves.data();
+            const Hid::Node * node = hid.nodes.data();
+            const Hid::Stage * stages = hid.stages.data();
+            for (int i = 0, n = (int)hid.stages.size(); i < n; ++i)
+            {
+                const Hid::Stage & stage = stages[i];
+                const Hid::Node * end = node + stage.ntrees;
+                int16x8_t stageSum = vdupq_n_s16(0);
+                if (stage.hasThree)
+                {
+                    for (; node < end; ++node, leaves += 2)
+                    {
+                        const Hid::Feature & feature = hid.features[node->featureIdx];
+                        uint32x4_t round = vdupq_n_u32(1 << feature.shift >> 1);
+                        int32x4_t shift = vdupq_n_s32(-feature.shift);
+                        int16x8_t sum = vaddq_s16(WeightedSum16i(feature.rect[0], offset, round, shift), WeightedSum16i(feature.rect[1], offset, round, shift));
+                        if (feature.rect[2].p0)
+                            sum = vaddq_s16(sum, WeightedSum16i(feature.rect[2], offset, round, shift));
+                        StageSum16i(leaves, node->threshold, sum, norm, stageSum);
+                    }
+                }
+                else
+                {
+                    for (; node < end; ++node, leaves += 2)
+                    {
+                        const Hid::Feature & feature = hid.features[node->featureIdx];
+                        uint32x4_t round = vdupq_n_u32(1 << feature.shift >> 1);
+                        int32x4_t shift = vdupq_n_s32(-feature.shift);
+                        int16x8_t sum = vaddq_s16(WeightedSum16i(feature.rect[0], offset, round, shift), WeightedSum16i(feature.rect[1], offset, round, shift));
+                        StageSum16i(leaves, node->threshold, sum, norm, stageSum);
+                    }
+                }
+                result = vandq_u16(vcleq_s16(vdupq_n_s16(stage.threshold), stageSum), result);
+                int resultCount = ResultCount(result);
+                if (resultCount == 0)
+                    return;
+                else if (resultCount == 1)
+                {
+                    uint16_t _result[HA];
+                    int16_t _norm[HA];
+                    vst1q_u16(_result, result);
+                    vst1q_s16(_norm, norm);
+                    for (int j = 0; j < HA; ++j)
+                    {
+                        if (_result[j])
+                        {
+                            _result[j] = Base::Detect16i(hid, offset + j, i + 1, _norm[j]) > 0 ? 1 : 0;
+                            break;
+                        }
+                    }
+                    result = vld1q_u16(_result);
+                    return;
+                }
+            }
+        }
+
+        void DetectionHaarDetect16ip(const HidHaarCascade16i & hid, const Image & mask, const Rect & rect, Image & dst)
+        {
+            size_t width = rect.Width();
+            size_t alignedWidth = Simd::AlignLo(width, HA);
+            size_t evenWidth = Simd::AlignLo(width, 2);
+
+            Buffer<uint16_t> buffer(width);
+            for (ptrdiff_t row = rect.top; row < rect.bottom; row += 1)
+            {
+                size_t col = 0;
+                size_t p_offset = row * hid.sum.stride / sizeof(uint32_t) + rect.left;
+                size_t pq_offset = row * hid.sqsum.stride / sizeof(uint32_t) + rect.left;
+
+                UnpackMask16i(mask.data + row*mask.stride + rect.left, width, buffer.m, K8_01);
+                memset(buffer.d, 0, width * sizeof(uint16_t));
+                for (; col < alignedWidth; col += HA)
+                {
+                    uint16x8_t result = vld1q_u16(buffer.m + col);
+                    if (ResultCount(result) == 0)
+                        continue;
+                    int16x8_t norm = Norm16ip(hid, pq_offset + col);
+                    Detect16i(hid, p_offset + col, norm, result);
+                    vst1q_u16(buffer.d + col, result);
+                }
+                if (alignedWidth && evenWidth > alignedWidth + 2)
+                {
+                    col = evenWidth - HA;
+                    uint16x8_t result = vld1q_u16(buffer.m + col);
+                    if (ResultCount(result) != 0)
+                    {
+                        int16x8_t norm = Norm16ip(hid, pq_offset + col);
+                        Detect16i(hid, p_offset + col, norm, result);
+                        vst1q_u16(buffer.d + col, result);
+                    }
+                    col += HA;
+                }
+                for (; col < width; col += 1)
+                {
+                    if (buffer.m[col] == 0)
+                        continue;
+                    int16_t norm = Base::Norm16i(hid, pq_offset + col);
+                    buffer.d[col] = Base::Detect16i(hid, p_offset + col, 0, norm) > 0 ? 1 : 0;
+                }
+                PackResult16i(buffer.d, width, dst.data + row*dst.stride + rect.left);
+            }
+        }
+
+        void DetectionHaarDetect16ip(const void * _hid, const uint8_t * mask, size_t maskStride,
+            ptrdiff_t left, ptrdiff_t top, ptrdiff_t right, ptrdiff_t bottom, uint8_t * dst, size_t dstStride)
+        {
+            const HidHaarCascade16i & hid = *(HidHaarCascade16i*)_hid;
+            return DetectionHaarDetect16ip(hid,
+                Image(hid.sum.width - 1, hid.sum.height - 1, maskStride, Image::Gray8, (uint8_t*)mask),
+                Rect(left, top, right, bottom),
+                Image(hid.sum.width - 1, hid.sum.height - 1, dstStride, Image::Gray8, dst).Ref());
+        }
+
+        void DetectionHaarDetect16ii(const HidHaarCascade16i & hid, const Image & mask, const Rect & rect, Image & dst)
+        {
+            const size_t step = 2;
+            size_t width = rect.Width();
+            size_t alignedWidth = Simd::AlignLo(width, A);
+            size_t evenWidth = Simd::AlignLo(width, 2);
+
+            for (ptrdiff_t row = rect.top; row < rect.bottom; row += step)
+            {
+                size_t col = 0;
+                size_t p_offset = row * hid.isum.stride / sizeof(uint32_t) + rect.left / 2;
+                size_t pq_offset = row * hid.sqsum.stride / sizeof(uint32_t) + rect.left;
+                const uint8_t * m = mask.data + row*mask.stride + rect.left;
+                uint8_t * d = dst.data + row*dst.stride + rect.left;
+                for (; col < alignedWidth; col += A)
+                {
+                    uint16x8_t result = vandq_u16((uint16x8_t)vld1q_u8(m + col), K16_0001);
+                    if (ResultCount(result) == 0)
+                        continue;
+                    int16x8_t norm = Norm16ii(hid, pq_offset + col);
+                    Detect16i(hid, p_offset + col / 2, norm, result);
+                    vst1q_u8(d + col, (uint8x16_t)result);
+                }
+                if (alignedWidth && evenWidth > alignedWidth + 2)
+                {
+                    col = evenWidth - A;
+                    uint16x8_t result = vandq_u16((uint16x8_t)vld1q_u8(m + col), K16_0001);
+                    if (ResultCount(result) != 0)
+                    {
+                        int16x8_t norm = Norm16ii(hid, pq_offset + col);
+                        Detect16i(hid, p_offset + col / 2, norm, result);
+                        vst1q_u8(d + col, (uint8x16_t)result);
+                    }
+                    col += A;
+                }
+                for (; col < width; col += step)
+                {
+                    if (mask.At<uint8_t>(col + rect.left, row) == 0)
+                        continue;
+                    int16_t norm = Base::Norm16i(hid, pq_offset + col);
+                    if (Base::Detect16i(hid, p_offset + col / 2, 0, norm) > 0)
+                        dst.At<uint8_t>(col + rect.left, row) = 1;
+                }
+            }
+        }
+
+        void DetectionHaarDetect16ii(const void * _hid, const uint8_t * mask, size_t maskStride,
+            ptrdiff_t left, ptrdiff_t top, ptrdiff_t right, ptrdiff_t bottom, uint8_t * dst, size_t dstStride)
+        {
+            const HidHaarCascade16i & hid = *(HidHaarCascade16i*)_hid;
+            return DetectionHaarDetect16ii(hid,
+                Image(hid.sum.width - 1, hid.sum.height - 1, maskStride, Image::Gray8, (uint8_t*)mask),
+                Rect(left, top, right, bottom),
+                Image(hid.sum.width - 1, hid.sum.height - 1, dstStride, Image::Gray8, dst).Ref());
+        }
+
         const uint8x16_t K8_TBL_BITS = SIMD_VEC_SETR_EPI8(0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00);
 
         SIMD_INLINE uint8x16_t Shuffle(const uint8x16_t & src, const uint8x16_t & shuffle)
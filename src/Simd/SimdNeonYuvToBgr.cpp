@@ -97,6 +97,50 @@ namespace Simd
                 Yuv420pToBgr<false>(y, yStride, u, uStride, v, vStride, width, height, bgr, bgrStride);
         }
 
+        template <bool align> void Nv12ToBgr(const uint8_t * y, size_t yStride, const uint8_t * uv, size_t uvStride,
+            size_t width, size_t height, uint8_t * bgr, size_t bgrStride)
+        {
+            assert((width % 2 == 0) && (height % 2 == 0) && (width >= DA) && (height >= 2));
+            if (align)
+                assert(Aligned(y) && Aligned(yStride) && Aligned(uv) && Aligned(uvStride) && Aligned(bgr) && Aligned(bgrStride));
+
+            size_t bodyWidth = AlignLo(width, DA);
+            size_t tail = width - bodyWidth;
+            uint8x16x2_t _uv, _u, _v;
+            for (size_t row = 0; row < height; row += 2)
+            {
+                for (size_t colY = 0, colBgr = 0; colY < bodyWidth; colY += DA, colBgr += A6)
+                {
+                    _uv = Load2<align>(uv + colY);
+                    _u = vzipq_u8(_uv.val[0], _uv.val[0]);
+                    _v = vzipq_u8(_uv.val[1], _uv.val[1]);
+                    Yuv422pToBgr<align>(y + colY, _u, _v, bgr + colBgr);
+                    Yuv422pToBgr<align>(y + colY + yStride, _u, _v, bgr + colBgr + bgrStride);
+                }
+                if (tail)
+                {
+                    size_t offset = width - DA;
+                    _uv = Load2<false>(uv + offset);
+                    _u = vzipq_u8(_uv.val[0], _uv.val[0]);
+                    _v = vzipq_u8(_uv.val[1], _uv.val[1]);
+                    Yuv422pToBgr<false>(y + offset, _u, _v, bgr + 3 * offset);
+                    Yuv422pToBgr<false>(y + offset + yStride, _u, _v, bgr + 3 * offset + bgrStride);
+                }
+                y += 2 * yStride;
+                uv += uvStride;
+                bgr += 2 * bgrStride;
+            }
+        }
+
+        void Nv12ToBgr(const uint8_t * y, size_t yStride, const uint8_t * uv, size_t uvStride,
+            size_t width, size_t height, uint8_t * bgr, size_t bgrStride)
+        {
+            if (Aligned(y) && Aligned(yStride) && Aligned(uv) && Aligned(uvStride) && Aligned(bgr) && Aligned(bgrStride))
+                Nv12ToBgr<true>(y, yStride, uv, uvStride, width, height, bgr, bgrStride);
+            else
+                Nv12ToBgr<false>(y, yStride, uv, uvStride, width, height, bgr, bgrStride);
+        }
+
         template <bool align> void Yuv422pToBgr(const uint8_t * y, size_t yStride, const uint8_t * u, size_t uStride, const uint8_t * v, size_t vStride,
             size_t width, size_t height, uint8_t * bgr, size_t bgrStride)
         {
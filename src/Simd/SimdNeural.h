@@ -24,6 +24,7 @@
 #ifndef __SimdNeural_h__
 #define __SimdNeural_h__
 
+#include "Simd/SimdMath.h"
 #include "Simd/SimdLoad.h"
 
 namespace Simd
@@ -65,6 +66,120 @@ namespace Simd
         void * _ptr;
     };
 
+    struct NeuralConvolution
+    {
+        const size_t srcWidth, srcHeight, srcDepth, kernelX, kernelY, padX, padY, strideX, strideY, dilationX, dilationY, dstWidth, dstHeight, dstDepth;
+        const SimdNeuralActivationType activation;
+        const float slope;
+
+        NeuralConvolution(size_t srcWidth, size_t srcHeight, size_t srcDepth, size_t kernelX, size_t kernelY, size_t padX, size_t padY,
+            size_t strideX, size_t strideY, size_t dilationX, size_t dilationY, size_t dstWidth, size_t dstHeight, size_t dstDepth,
+            const float * bias, SimdNeuralActivationType activation, const float * slope)
+            : srcWidth(srcWidth), srcHeight(srcHeight), srcDepth(srcDepth), kernelX(kernelX), kernelY(kernelY), padX(padX), padY(padY)
+            , strideX(strideX), strideY(strideY), dilationX(dilationX), dilationY(dilationY), dstWidth(dstWidth), dstHeight(dstHeight), dstDepth(dstDepth)
+            , activation(activation), slope(slope ? slope[0] : (activation == SimdNeuralActivationRelu ? 0.0f : 1.0f))
+            , weight(NULL), bias(NULL)
+        {
+            if (bias)
+            {
+                this->bias = (float*)Allocate(dstDepth * sizeof(float));
+                memcpy(this->bias, bias, dstDepth * sizeof(float));
+            }
+        }
+
+        virtual ~NeuralConvolution()
+        {
+            if (weight)
+                Free(weight);
+            if (bias)
+                Free(bias);
+        }
+
+        virtual void Run(const float * src, void * buffer, size_t * size, float * dst, int add) const = 0;
+
+        virtual void Epilogue(size_t channel, size_t count, float * dst) const
+        {
+            for (size_t c = channel; c < channel + count; ++c, dst += dstWidth*dstHeight)
+                Epilogue(c, 0, dstWidth*dstHeight, dst);
+        }
+
+    protected:
+        float * weight;
+        float * bias;
+
+        SIMD_INLINE bool HasEpilogue() const
+        {
+            return bias || activation != SimdNeuralActivationIdentity;
+        }
+
+        SIMD_INLINE float Activate(float value) const
+        {
+            switch (activation)
+            {
+            case SimdNeuralActivationTanh: return Base::RoughTanh(value*slope);
+            case SimdNeuralActivationSigmoid: return Base::RoughSigmoid2(value*slope);
+            case SimdNeuralActivationRelu: return Max(value*slope, value);
+            default: return value;
+            }
+        }
+
+        void Epilogue(size_t channel, size_t offset, size_t size, float * dst) const
+        {
+            float value = bias ? bias[channel] : 0.0f;
+            for (size_t i = offset; i < size; ++i)
+                dst[i] = Activate(dst[i] + value);
+        }
+    };
+
+    namespace Base
+    {
+        SIMD_INLINE void Winograd2x3SetFilter(const float * src, size_t size, float * dst)
+        {
+            for (size_t i = 0; i < size; ++i, src += 9, dst += 1)
+            {
+                float g[4][3];
+                for (size_t c = 0; c < 3; ++c)
+                {
+                    g[0][c] = src[c];
+                    g[1][c] = (src[c] + src[3 + c] + src[6 + c])*0.5f;
+                    g[2][c] = (src[c] - src[3 + c] + src[6 + c])*0.5f;
+                    g[3][c] = src[6 + c];
+                }
+                for (size_t r = 0; r < 4; ++r)
+                {
+                    dst[(4 * r + 0)*size] = g[r][0];
+                    dst[(4 * r + 1)*size] = (g[r][0] + g[r][1] + g[r][2])*0.5f;
+                    dst[(4 * r + 2)*size] = (g[r][0] - g[r][1] + g[r][2])*0.5f;
+                    dst[(4 * r + 3)*size] = g[r][2];
+                }
+            }
+        }
+
+        SIMD_INLINE void Winograd2x3SplitInput(const float * src, size_t srcWidth, size_t srcHeight, size_t padX, size_t padY, 
+            size_t width, size_t height, float * even, float * odd)
+        {
+            for (size_t row = 0; row < height; ++row, even += width, odd += width)
+            {
+                size_t srcRow = row - padY;
+                if (srcRow < srcHeight)
+                {
+                    const float * ps = src + srcRow*srcWidth;
+                    size_t srcCol = 0 - padX;
+                    for (size_t col = 0; col < width; ++col, srcCol += 2)
+                    {
+                        even[col] = srcCol < srcWidth ? ps[srcCol] : 0;
+                        odd[col] = srcCol + 1 < srcWidth ? ps[srcCol + 1] : 0;
+                    }
+                }
+                else
+                {
+                    memset(even, 0, width * sizeof(float));
+                    memset(odd, 0, width * sizeof(float));
+                }
+            }
+        }
+    }
+
 #ifdef SIMD_AVX2_ENABLE 
     namespace Avx2
     {
@@ -32,6 +32,7 @@
 #include <numeric>
 #include <random>
 #include <iterator>
+#include <map>
 
 #ifndef SIMD_CHECK_PERFORMANCE
 #define SIMD_CHECK_PERFORMANCE()
@@ -58,6 +59,9 @@ namespace Simd
         typedef Point<ptrdiff_t> Size; /*!< \brief 2D-size (width and height). */
         typedef std::vector<uint8_t, Allocator<uint8_t>> Buffer; /*!< \brief Vector with 8-bit unsigned integer values. */
         typedef std::vector<float, Allocator<float>> Vector; /*!< \brief Vector with 32-bit float point values. */
+        typedef std::vector<uint16_t, Allocator<uint16_t>> Vector16f; /*!< \brief Vector with 16-bit float point values. */
+        typedef std::vector<int8_t, Allocator<int8_t>> Vector8i; /*!< \brief Vector with 8-bit signed integer values. */
+        typedef std::vector<int32_t, Allocator<int32_t>> Vector32i; /*!< \brief Vector with 32-bit signed integer values. */
         typedef std::vector<ptrdiff_t, Allocator<ptrdiff_t>> VectorI; /*!< \brief Vector with integer values. */
         typedef std::vector<Vector> Vectors; /*!< \brief Vector of vectors with 32-bit float point values. */
         typedef size_t Label; /*!< \brief Integer name (label) of object class. */
@@ -71,6 +75,13 @@ namespace Simd
                 memset(vector.data(), 0, vector.size() * sizeof(T));
             }
 
+            SIMD_INLINE void Transpose(const float * src, size_t rows, size_t cols, float * dst)
+            {
+                for (size_t i = 0; i < rows; ++i)
+                    for (size_t j = 0; j < cols; ++j)
+                        dst[j*rows + i] = src[i*cols + j];
+            }
+
             SIMD_INLINE int RandomUniform(int min, int max)
             {
                 static std::mt19937 gen(1);
@@ -511,6 +522,20 @@ namespace Simd
 
             virtual size_t FanDst() const = 0;
 
+            virtual void BatchForward(const Vector & src, size_t count, size_t thread)
+            {
+                size_t srcSize = _src.Volume(), dstSize = _dst.Volume();
+                Vector & dst = _common[thread].batch;
+                dst.resize(count*dstSize);
+                Vector sample(srcSize);
+                for (size_t i = 0; i < count; ++i)
+                {
+                    memcpy(sample.data(), src.data() + i*srcSize, srcSize * sizeof(float));
+                    Forward(sample, thread, Fast);
+                    memcpy(dst.data() + i*dstSize, _common[thread].dst.data(), dstSize * sizeof(float));
+                }
+            }
+
             virtual void SetThreadNumber(size_t number, bool train)
             {
                 _common.resize(number);
@@ -538,7 +563,215 @@ namespace Simd
                 , _function(f)
                 , _prev(0)
                 , _next(0)
+                , _external(0)
+                , _externalSize(0)
+                , _lower8u(0)
+                , _upper8u(0)
+                , _widened(false)
+            {
+            }
+
+            SIMD_INLINE const float * Weight() const
+            {
+                return _external ? _external : _weight.data();
+            }
+
+            SIMD_INLINE size_t WeightSize() const
             {
+                return _external ? _externalSize : (_weight16f.size() ? _weight16f.size() : (_weight8i.size() ? _weight8i.size() : _weight.size()));
+            }
+
+            virtual void ExportWeight(float * dst) const
+            {
+                if (_weight16f.size())
+                    ::SimdFloat16ToFloat32(_weight16f.data(), _weight16f.size(), dst);
+                else if (_weight8i.size())
+                {
+                    size_t rows = _scale8i.size(), cols = _weight8i.size() / rows;
+                    for (size_t i = 0; i < rows; ++i)
+                        for (size_t j = 0; j < cols; ++j)
+                            dst[i*cols + j] = _weight8i[i*cols + j] * _scale8i[i];
+                }
+                else
+                    memcpy(dst, Weight(), WeightSize() * sizeof(float));
+            }
+
+            virtual void ConvertToFloat16()
+            {
+                size_t size = WeightSize();
+                if (size && _weight16f.empty() && _weight8i.empty())
+                {
+                    ResetForward();
+                    _weight16f.resize(size);
+                    ::SimdFloat32ToFloat16(Weight(), size, _weight16f.data());
+                    Vector().swap(_weight);
+                    _external = 0;
+                    _externalSize = 0;
+                }
+            }
+
+            virtual void ImportWeight(const float * src, bool external)
+            {
+                ResetForward();
+                size_t size = WeightSize();
+                Vector16f().swap(_weight16f);
+                Vector8i().swap(_weight8i);
+                if (external)
+                {
+                    Vector().swap(_weight);
+                    _external = src;
+                    _externalSize = size;
+                }
+                else
+                {
+                    _weight.resize(size);
+                    memcpy(_weight.data(), src, size * sizeof(float));
+                    _external = 0;
+                    _externalSize = 0;
+                }
+            }
+
+            virtual void ConvertToInt8(float lower, float upper)
+            {
+            }
+
+            SIMD_INLINE bool Trainable() const
+            {
+                return _external == 0 && _weight16f.empty() && _weight8i.empty();
+            }
+
+            virtual void ResetWeight()
+            {
+                ResetForward();
+                if (!Trainable())
+                {
+                    _weight.resize(WeightSize());
+                    _external = 0;
+                    _externalSize = 0;
+                    Vector16f().swap(_weight16f);
+                    Vector8i().swap(_weight8i);
+                    Vector().swap(_scale8i);
+                    Vector().swap(_shift8i);
+                }
+            }
+
+            virtual void PrepareTrain()
+            {
+            }
+
+            virtual void SaveWeight(float * dst) const
+            {
+                ExportWeight(dst);
+            }
+
+            void QuantizeWeight(const float * weight, size_t rows, float lower, float upper)
+            {
+                lower = std::min(lower, 0.0f);
+                upper = std::max(upper, 0.0f);
+                float step = upper > lower ? (upper - lower) / 255.0f : 1.0f;
+                _lower8u = -::floor(0.5f - lower / step) * step;
+                _upper8u = _lower8u + 255.0f * step;
+
+                size_t size = WeightSize(), cols = size / rows;
+                ResetForward();
+                _weight8i.resize(size);
+                _scale8i.resize(rows);
+                _shift8i.resize(rows);
+                for (size_t i = 0; i < rows; ++i)
+                {
+                    const float * w = weight + i*cols;
+                    int8_t * q = _weight8i.data() + i*cols;
+                    float max = 0.0f;
+                    for (size_t j = 0; j < cols; ++j)
+                        max = std::max(max, ::fabs(w[j]));
+                    float scale = max > 0.0f ? max / 64.0f : 1.0f;
+                    int sum = 0;
+                    for (size_t j = 0; j < cols; ++j)
+                    {
+                        q[j] = (int8_t)std::min(std::max(::floor(w[j] / scale + 0.5f), -64.0f), 64.0f);
+                        sum += q[j];
+                    }
+                    _scale8i[i] = scale;
+                    _shift8i[i] = (_bias.size() ? _bias[i] : 0.0f) + scale * _lower8u * sum;
+                }
+                Vector().swap(_weight);
+                Vector16f().swap(_weight16f);
+                _external = 0;
+                _externalSize = 0;
+            }
+
+            void Quantize(const float * src, size_t size, uint8_t * dst) const
+            {
+                float scale = 255.0f / (_upper8u - _lower8u);
+                for (size_t i = 0; i < size; ++i)
+                    dst[i] = (uint8_t)((std::min(std::max(src[i], _lower8u), _upper8u) - _lower8u) * scale + 0.5f);
+            }
+
+            void Dequantize(const int32_t * src, size_t size, float * dst) const
+            {
+                float step = (_upper8u - _lower8u) / 255.0f;
+                for (size_t i = 0; i < _scale8i.size(); ++i)
+                {
+                    float scale = _scale8i[i] * step, shift = _shift8i[i];
+                    for (size_t j = 0; j < size; ++j)
+                        dst[j] = src[j] * scale + shift;
+                    src += size;
+                    dst += size;
+                }
+            }
+
+            virtual void PrepareForward()
+            {
+            }
+
+            const float * ForwardWeight()
+            {
+                if (_weight16f.empty())
+                    return Weight();
+                if (!_widened)
+                {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    if (!_widened)
+                    {
+                        _weight32f.resize(_weight16f.size());
+                        ::SimdFloat16ToFloat32(_weight16f.data(), _weight32f.size(), _weight32f.data());
+                        _widened = true;
+                    }
+                }
+                return _weight32f.data();
+            }
+
+            /* Batch GEMM contexts hold packed copies of the weights: they are created once for every batch size 
+               and must be dropped when the weights are changed. */
+            template<class Init> void * BatchConvolution(size_t count, const Init & init)
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                std::shared_ptr<void> & convolution = _batchConvolutions[count];
+                if (!convolution)
+                    convolution.reset(init(), ::SimdNeuralConvolutionFree);
+                return convolution.get();
+            }
+
+            void ResetForward()
+            {
+                Vector().swap(_weight32f);
+                _widened = false;
+                _batchConvolutions.clear();
+            }
+
+            bool Activation(SimdNeuralActivationType & type, float & slope) const
+            {
+                type = SimdNeuralActivationIdentity;
+                slope = 1.0f;
+                switch (_function.type)
+                {
+                case Function::Identity: return true;
+                case Function::Tanh: type = SimdNeuralActivationTanh; return true;
+                case Function::Sigmoid: type = SimdNeuralActivationSigmoid; return true;
+                case Function::Relu: type = SimdNeuralActivationRelu; slope = 0.0f; return true;
+                case Function::LeakyRelu: type = SimdNeuralActivationRelu; slope = 0.01f; return true;
+                default: return false;
+                }
             }
 
             SIMD_INLINE bool Link(Layer * prev)
@@ -558,6 +791,11 @@ namespace Simd
                 return _common[thread].dst;
             }
 
+            SIMD_INLINE const Vector & BatchDst(size_t thread) const
+            {
+                return _common[thread].batch;
+            }
+
             SIMD_INLINE const Vector & Delta(size_t thread) const
             {
                 return _common[thread].prevDelta;
@@ -571,9 +809,20 @@ namespace Simd
             Index _src, _dst;
             Vector _weight, _bias, _gWeight, _gBias;
 
+            const float * _external;
+            size_t _externalSize;
+            Vector16f _weight16f;
+            Vector8i _weight8i;
+            Vector _scale8i, _shift8i;
+            float _lower8u, _upper8u;
+            Vector _weight32f;
+            bool _widened;
+            std::map<size_t, std::shared_ptr<void>> _batchConvolutions;
+            std::mutex _mutex;
+
             struct Common
             {
-                Vector sum, dst;
+                Vector sum, dst, batch;
 
                 Vector dWeight, dBias, prevDelta;
             };
@@ -605,6 +854,11 @@ namespace Simd
                 _common[thread].dst = src;
             }
 
+            void BatchForward(const Vector & src, size_t count, size_t thread) override
+            {
+                _common[thread].batch = src;
+            }
+
             void Backward(const Vector & src, size_t thread) override
             {
             }
@@ -655,6 +909,7 @@ namespace Simd
             ConvolutionalLayer(Function::Type f, const Size & srcSize, size_t srcDepth, size_t dstDepth, const Size & coreSize,
                 bool valid = true, bool bias = true, const View & connection = View())
                 : Layer(Convolutional, f)
+                , _activated(false)
                 , _functionForward(0)
                 , _functionBackward(0)
                 , _functionSum(0)
@@ -709,6 +964,24 @@ namespace Simd
                 const Vector & padded = PaddedSrc(src, thread);
                 Vector & sum = _common[thread].sum;
                 Vector & dst = _common[thread].dst;
+                if (method == Fast && _convolution)
+                {
+                    Buffer & buffer = _specific[thread].buffer;
+                    size_t size = buffer.size();
+                    ::SimdNeuralConvolutionRun(_convolution.get(), padded.data(), buffer.data(), &size, _activated ? dst.data() : sum.data(), 0);
+                    if (size > buffer.size())
+                        buffer.resize(size);
+                    if (!_activated)
+                        _function.function(sum.data(), sum.size(), dst.data());
+                    return;
+                }
+                if (_weight8i.size())
+                {
+                    ForwardInt8(padded, thread);
+                    _function.function(sum.data(), sum.size(), dst.data());
+                    return;
+                }
+                const float * weight = ForwardWeight();
                 if (_partial)
                 {
                     Detail::SetZero(sum);
@@ -719,7 +992,7 @@ namespace Simd
                             if (!_connection.At<bool>(dc, sc))
                                 return;
 
-                            const float * pweight = _core.Get(_weight, 0, 0, _src.depth*dc + sc);
+                            const float * pweight = weight + _core.Offset(0, 0, _src.depth*dc + sc);
                             const float * psrc = _padded.Get(padded, 0, 0, sc);
                             float * psum = _dst.Get(sum, 0, 0, dc);
 
@@ -750,7 +1023,7 @@ namespace Simd
                 {
                     Buffer & buffer = _specific[thread].buffer;
                     size_t size = buffer.size();
-                    ::SimdNeuralConvolutionForward(padded.data(), _padded.width, _padded.height, _padded.depth, _weight.data(),
+                    ::SimdNeuralConvolutionForward(padded.data(), _padded.width, _padded.height, _padded.depth, weight,
                         _core.width, _core.height, 0, 0, 1, 1, 1, 1, buffer.data(), &size, sum.data(), _dst.width, _dst.height, _dst.depth, 0);
                     if (size > buffer.size())
                         buffer.resize(size);
@@ -763,6 +1036,74 @@ namespace Simd
                 _function.function(sum.data(), sum.size(), dst.data());
             }
 
+            void BatchForward(const Vector & src, size_t count, size_t thread) override
+            {
+                if (_partial)
+                {
+                    Layer::BatchForward(src, count, thread);
+                    return;
+                }
+
+                Specific & specific = _specific[thread];
+                size_t paddedSize = _padded.Volume(), area = _dst.Area(), N = count*area, K = FanSrc();
+                const float * padded = src.data();
+                if (!_valid || _weight8i.empty())
+                {
+                    Vector & batch = specific.paddedBatch;
+                    batch.resize(count*paddedSize + Im2ColTail<float>());
+                    if (_valid)
+                        memcpy(batch.data(), src.data(), count*paddedSize * sizeof(float));
+                    else
+                    {
+                        for (size_t i = 0; i < count; ++i)
+                            for (ptrdiff_t c = 0; c < _src.depth; ++c)
+                                for (ptrdiff_t y = 0; y < _src.height; ++y)
+                                    memcpy(batch.data() + i*paddedSize + _padded.Offset(_indent.x, _indent.y + y, c),
+                                        src.data() + i*_src.Volume() + _src.Offset(0, y, c), _src.width * sizeof(float));
+                    }
+                    padded = batch.data();
+                }
+                specific.sum.resize(_dst.depth*N);
+
+                bool activated = false;
+                if (_weight8i.size())
+                {
+                    specific.src8u.resize(count*paddedSize + Im2ColTail<uint8_t>());
+                    Quantize(padded, count*paddedSize, specific.src8u.data());
+                    specific.col8u.resize(K*N + Im2ColTail<uint8_t>());
+                    Im2Col(specific.src8u.data(), count, N, specific.col8u.data());
+                    specific.sum32i.resize(_dst.depth*N);
+                    ::SimdNeuralProductSum8i(_dst.depth, N, K, _weight8i.data(), specific.col8u.data(), specific.sum32i.data());
+                    Dequantize(specific.sum32i.data(), N, specific.sum.data());
+                }
+                else
+                {
+                    specific.col.resize(K*N + Im2ColTail<float>());
+                    Im2Col(padded, count, N, specific.col.data());
+                    SimdNeuralActivationType activation;
+                    float slope;
+                    activated = Activation(activation, slope);
+                    const float * weight = ForwardWeight();
+                    void * convolution = BatchConvolution(count, [&]() { return ::SimdNeuralConvolutionInit(N, 1, K, weight, 1, 1, 0, 0, 1, 1, 1, 1,
+                        N, 1, _dst.depth, _bias.size() ? _bias.data() : NULL, activation, &slope); });
+                    size_t size = specific.buffer.size();
+                    ::SimdNeuralConvolutionRun(convolution, specific.col.data(), specific.buffer.data(), &size, specific.sum.data(), 0);
+                    if (size > specific.buffer.size())
+                        specific.buffer.resize(size);
+                }
+
+                Vector & dst = _common[thread].batch;
+                dst.resize(count*_dst.Volume());
+                for (size_t i = 0; i < count; ++i)
+                    for (ptrdiff_t dc = 0; dc < _dst.depth; ++dc)
+                        memcpy(dst.data() + (i*_dst.depth + dc)*area, specific.sum.data() + (dc*count + i)*area, area * sizeof(float));
+                if (!activated)
+                {
+                    for (size_t i = 0; i < count; ++i)
+                        _function.function(dst.data() + i*_dst.Volume(), _dst.Volume(), dst.data() + i*_dst.Volume());
+                }
+            }
+
             void Backward(const Vector & currDelta, size_t thread) override
             {
                 const Vector & prevDst = _valid ? _prev->Dst(thread) : _specific[thread].paddedSrc;
@@ -879,6 +1220,69 @@ namespace Simd
                             _specific[i].paddedDelta.resize(_padded.Volume(), 0);
                     }
                 }
+                if (train)
+                    _convolution.reset();
+            }
+
+        protected:
+            virtual void ImportWeight(const float * src, bool external) override
+            {
+                _convolution.reset();
+                Layer::ImportWeight(src, external);
+            }
+
+            virtual void ConvertToFloat16() override
+            {
+                Layer::ConvertToFloat16();
+                PrepareForward();
+            }
+
+            virtual void ResetWeight() override
+            {
+                _convolution.reset();
+                Layer::ResetWeight();
+            }
+
+            virtual void PrepareTrain() override
+            {
+                ResetForward();
+                _convolution.reset();
+            }
+
+            virtual void ConvertToInt8(float lower, float upper) override
+            {
+                if (WeightSize() && _weight8i.empty())
+                {
+                    Vector weight(WeightSize());
+                    ExportWeight(weight.data());
+                    for (ptrdiff_t dc = 0; dc < _dst.depth; ++dc)
+                        for (ptrdiff_t sc = 0; sc < _src.depth; ++sc)
+                            if (!_connection.At<bool>(dc, sc))
+                                memset(_core.Get(weight, 0, 0, _src.depth*dc + sc), 0, _core.Area() * sizeof(float));
+                    _convolution.reset();
+                    QuantizeWeight(weight.data(), _dst.depth, lower, upper);
+                }
+            }
+
+            virtual void PrepareForward() override
+            {
+                ResetForward();
+                if (!_partial && _weight8i.empty())
+                {
+                    Vector weight;
+                    if (_weight16f.size())
+                    {
+                        weight.resize(_weight16f.size());
+                        ::SimdFloat16ToFloat32(_weight16f.data(), weight.size(), weight.data());
+                    }
+                    SimdNeuralActivationType activation;
+                    float slope;
+                    _activated = Activation(activation, slope);
+                    _convolution.reset(::SimdNeuralConvolutionInit(_padded.width, _padded.height, _padded.depth, weight.size() ? weight.data() : Weight(), _core.width, _core.height,
+                        0, 0, 1, 1, 1, 1, _dst.width, _dst.height, _dst.depth, _bias.size() ? _bias.data() : NULL, activation, &slope), ::SimdNeuralConvolutionFree);
+                }
+                else
+                    _convolution.reset();
             }
 
         private:
@@ -914,10 +1318,57 @@ namespace Simd
                 }
             }
 
+            template<class T> static size_t Im2ColTail()
+            {
+                return IM2COL_BLOCK / sizeof(T);
+            }
+
+            /* Rows are copied by blocks of fixed size: a block may overrun the end of the row, but it is overwritten by the next 
+               row (the matrix is filled sequentially), so source and destination buffers must have Im2ColTail() extra elements. */
+            template<class T> void Im2Col(const T * padded, size_t count, size_t stride, T * col) const
+            {
+                size_t paddedSize = _padded.Volume(), area = _dst.Area(), block = Im2ColTail<T>();
+                for (ptrdiff_t c = 0; c < _padded.depth; ++c)
+                {
+                    for (ptrdiff_t ky = 0; ky < _core.height; ++ky)
+                    {
+                        for (ptrdiff_t kx = 0; kx < _core.width; ++kx, col += stride)
+                        {
+                            for (size_t i = 0; i < count; ++i)
+                            {
+                                const T * ps = padded + i*paddedSize + _padded.Offset(kx, ky, c);
+                                T * pd = col + i*area;
+                                for (ptrdiff_t y = 0; y < _dst.height; ++y)
+                                    for (ptrdiff_t x = 0; x < _dst.width; x += block)
+                                        memcpy(pd + y*_dst.width + x, ps + y*_padded.width + x, IM2COL_BLOCK);
+                            }
+                        }
+                    }
+                }
+            }
+
+            void ForwardInt8(const Vector & padded, size_t thread)
+            {
+                Specific & specific = _specific[thread];
+                specific.src8u.resize(padded.size() + Im2ColTail<uint8_t>());
+                Quantize(padded.data(), padded.size(), specific.src8u.data());
+
+                size_t K = FanSrc(), N = _dst.Area();
+                specific.col8u.resize(K*N + Im2ColTail<uint8_t>());
+                Im2Col(specific.src8u.data(), 1, N, specific.col8u.data());
+
+                specific.sum32i.resize(_dst.depth*N);
+                ::SimdNeuralProductSum8i(_dst.depth, N, K, _weight8i.data(), specific.col8u.data(), specific.sum32i.data());
+                Dequantize(specific.sum32i.data(), N, _common[thread].sum.data());
+            }
+
+            static const size_t IM2COL_BLOCK = 16;
+
             struct Specific
             {
-                Vector paddedSrc, paddedDelta;
-                Buffer buffer;
+                Vector paddedSrc, paddedDelta, paddedBatch, col, sum;
+                Buffer buffer, src8u, col8u;
+                Vector32i sum32i;
             };
             std::vector<Specific> _specific;
 
@@ -927,6 +1378,8 @@ namespace Simd
             bool _valid;
             bool _partial;
             View _connection;
+            std::shared_ptr<void> _convolution;
+            bool _activated;
 
             typedef void(*FunctionForwardPtr)(const float * src, size_t srcStride, size_t width, size_t height, const float * weights, float * dst, size_t dstStride);
             FunctionForwardPtr _functionForward;
@@ -1209,27 +1662,33 @@ namespace Simd
                 Vector & sum = _common[thread].sum;
                 Vector & dst = _common[thread].dst;
 
-                if (method == Layer::Fast)
+                if (_weight8i.size())
                 {
-                    if (!_reordered)
+                    Specific & specific = _specific[thread];
+                    specific.src8u.resize(_src.width);
+                    specific.sum32i.resize(_dst.width);
+                    Quantize(src.data(), _src.width, specific.src8u.data());
+                    ::SimdNeuralProductSum8i(_dst.width, 1, _src.width, _weight8i.data(), specific.src8u.data(), specific.sum32i.data());
+                    Dequantize(specific.sum32i.data(), 1, sum.data());
+                    _function.function(sum.data(), sum.size(), dst.data());
+                    return;
+                }
+                else if (method == Layer::Fast || _reordered)
+                {
+                    Reorder();
+                    if (_weight16f.size())
                     {
-                        std::lock_guard<std::mutex> lock(_mutex);
-                        if (!_reordered)
-                        {
-                            Vector buffer(_weight.size());
-                            for (ptrdiff_t i = 0; i < _dst.width; ++i)
-                                for (ptrdiff_t j = 0; j < _src.width; ++j)
-                                    buffer[i*_src.width + j] = _weight[j*_dst.width + i];
-                            _weight.swap(buffer);
-                            _reordered = true;                        
-                        }
+                        for (size_t i = 0; i < sum.size(); ++i)
+                            ::SimdNeuralProductSum16f(src.data(), _weight16f.data() + i*_src.width, src.size(), &sum[i]);
+                    }
+                    else
+                    {
+                        for (size_t i = 0; i < sum.size(); ++i)
+                            ::SimdNeuralProductSum(src.data(), Weight() + i*_src.width, src.size(), &sum[i]);
                     }
-                    for (size_t i = 0; i < sum.size(); ++i)
-                        ::SimdNeuralProductSum(src.data(), &_weight[i*_src.width], src.size(), &sum[i]);
                 }
                 else
                 {
-                    assert(!_reordered);
                     Detail::SetZero(sum);
                     for (size_t i = 0; i < src.size(); i++)
                         ::SimdNeuralAddVectorMultipliedByValue(&_weight[i*_dst.width], sum.size(), &src[i], sum.data());
@@ -1240,6 +1699,55 @@ namespace Simd
                 _function.function(sum.data(), sum.size(), dst.data());
             }
 
+            void BatchForward(const Vector & src, size_t count, size_t thread) override
+            {
+                Reorder();
+
+                Vector & dst = _common[thread].batch;
+                dst.resize(count*_dst.width);
+                bool activated = false;
+                if (_weight8i.size())
+                {
+                    Specific & specific = _specific[thread];
+                    specific.src.resize(count*_src.width);
+                    specific.src8u.resize(count*_src.width);
+                    specific.sum32i.resize(count*_dst.width);
+                    specific.sum.resize(count*_dst.width);
+                    Detail::Transpose(src.data(), count, _src.width, specific.src.data());
+                    Quantize(specific.src.data(), count*_src.width, specific.src8u.data());
+                    ::SimdNeuralProductSum8i(_dst.width, count, _src.width, _weight8i.data(), specific.src8u.data(), specific.sum32i.data());
+                    Dequantize(specific.sum32i.data(), count, specific.sum.data());
+                    Detail::Transpose(specific.sum.data(), _dst.width, count, dst.data());
+                }
+                else
+                {
+                    Vector & batchSrc = _specific[thread].src;
+                    Vector & batchSum = _specific[thread].sum;
+                    Buffer & buffer = _specific[thread].buffer;
+                    batchSrc.resize(count*_src.width);
+                    batchSum.resize(count*_dst.width);
+
+                    Detail::Transpose(src.data(), count, _src.width, batchSrc.data());
+                    SimdNeuralActivationType activation;
+                    float slope;
+                    activated = Activation(activation, slope);
+                    const float * weight = ForwardWeight();
+                    void * convolution = BatchConvolution(count, [&]() { return ::SimdNeuralConvolutionInit(count, 1, _src.width, weight, 1, 1, 0, 0, 1, 1, 1, 1,
+                        count, 1, _dst.width, _bias.size() ? _bias.data() : NULL, activation, &slope); });
+                    size_t size = buffer.size();
+                    ::SimdNeuralConvolutionRun(convolution, batchSrc.data(), buffer.data(), &size, batchSum.data(), 0);
+                    if (size > buffer.size())
+                        buffer.resize(size);
+                    Detail::Transpose(batchSum.data(), _dst.width, count, dst.data());
+                }
+
+                if (!activated)
+                {
+                    for (size_t i = 0; i < count; ++i)
+                        _function.function(dst.data() + i*_dst.width, _dst.width, dst.data() + i*_dst.width);
+                }
+            }
+
             void Backward(const Vector & currDelta, size_t thread) override
             {
                 const Vector & prevDst = _prev->Dst(thread);
@@ -1269,9 +1777,105 @@ namespace Simd
                 return _dst.width;
             }
 
+            virtual void SetThreadNumber(size_t number, bool train) override
+            {
+                Layer::SetThreadNumber(number, train);
+                _specific.resize(number);
+            }
+
         protected:
+            virtual void ExportWeight(float * dst) const override
+            {
+                if (_reordered)
+                    Layer::ExportWeight(dst);
+                else
+                    Detail::Transpose(_weight.data(), _src.width, _dst.width, dst);
+            }
+
+            virtual void ImportWeight(const float * src, bool external) override
+            {
+                Layer::ImportWeight(src, external);
+                _reordered = true;
+            }
+
+            virtual void ResetWeight() override
+            {
+                Layer::ResetWeight();
+                _reordered = false;
+            }
+
+            virtual void PrepareTrain() override
+            {
+                ResetForward();
+                if (_reordered)
+                {
+                    Vector buffer(_weight.size());
+                    Detail::Transpose(_weight.data(), _dst.width, _src.width, buffer.data());
+                    _weight.swap(buffer);
+                    _reordered = false;
+                }
+            }
+
+            virtual void SaveWeight(float * dst) const override
+            {
+                if (_reordered)
+                {
+                    Vector buffer(WeightSize());
+                    ExportWeight(buffer.data());
+                    Detail::Transpose(buffer.data(), _dst.width, _src.width, dst);
+                }
+                else
+                    memcpy(dst, _weight.data(), _weight.size() * sizeof(float));
+            }
+
+            virtual void ConvertToFloat16() override
+            {
+                Reorder();
+                Layer::ConvertToFloat16();
+            }
+
+            virtual void ConvertToInt8(float lower, float upper) override
+            {
+                Reorder();
+                if (WeightSize() && _weight8i.empty())
+                {
+                    Vector weight(WeightSize());
+                    ExportWeight(weight.data());
+                    QuantizeWeight(weight.data(), _dst.width, lower, upper);
+                }
+            }
+
+            virtual void PrepareForward() override
+            {
+                ResetForward();
+            }
+
             bool _reordered;
-            std::mutex _mutex;
+
+            struct Specific
+            {
+                Vector src, sum;
+                Buffer buffer, src8u;
+                Vector32i sum32i;
+            };
+            std::vector<Specific> _specific;
+
+            void Reorder()
+            {
+                if (!_reordered)
+                {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    if (!_reordered)
+                    {
+                        Vector buffer(_weight.size());
+                        for (ptrdiff_t i = 0; i < _dst.width; ++i)
+                            for (ptrdiff_t j = 0; j < _src.width; ++j)
+                                buffer[i*_src.width + j] = _weight[j*_dst.width + i];
+                        _weight.swap(buffer);
+                        _reordered = true;
+                    }
+                }
+            }
         };
 
         /*! @ingroup cpp_neural
@@ -1488,11 +2092,11 @@ namespace Simd
                     delta[i] = -control[i] / current[i];
             }
 
-            template<TrainOptions::UpdateType type> void UpdateWeight(const TrainOptions & o, const Vector & d, Vector & g, Vector & v);
+            template<TrainOptions::UpdateType type> void UpdateWeight(const TrainOptions & o, const float * d, size_t size, float * g, float * v);
 
-            template<> SIMD_INLINE void UpdateWeight<TrainOptions::AdaptiveGradient>(const TrainOptions & o, const Vector & d, Vector & g, Vector & v)
+            template<> SIMD_INLINE void UpdateWeight<TrainOptions::AdaptiveGradient>(const TrainOptions & o, const float * d, size_t size, float * g, float * v)
             {
-                ::SimdNeuralAdaptiveGradientUpdate(d.data(), d.size(), o.batchSize, &o.alpha, &o.epsilon, g.data(), v.data());
+                ::SimdNeuralAdaptiveGradientUpdate(d, size, o.batchSize, &o.alpha, &o.epsilon, g, v);
             }
         }
 
@@ -1520,6 +2124,7 @@ namespace Simd
             void Clear()
             {
                 _layers.clear();
+                _binary.reset();
             }
 
             /*!
@@ -1596,7 +2201,9 @@ namespace Simd
                 \param [in] dst - a set of classification results.
                 \param [in] options - an options of training process.
                 \param [in] logger - a functor to log training process.
-                \return a result of the training.
+                \return a result of the training. It is False if weights of some layer are not owned 32-bit float numbers 
+                        (the network was loaded with using of Network::LoadBinary or converted with using of Network::ConvertToFloat16 
+                        or Network::ConvertToInt8). Call Network::Load to restore trainable weights.
             */
             template <class Logger> bool Train(const Vectors & src, const Vectors & dst, const TrainOptions & options, Logger logger)
             {
@@ -1605,6 +2212,14 @@ namespace Simd
                 if (src.size() != dst.size())
                     return false;
 
+                for (size_t i = 0; i < _layers.size(); ++i)
+                {
+                    if (!_layers[i]->Trainable())
+                        return false;
+                }
+                for (size_t i = 0; i < _layers.size(); ++i)
+                    _layers[i]->PrepareTrain();
+
                 options.threadNumber = std::max<size_t>(1, std::min<size_t>(options.threadNumber, std::thread::hardware_concurrency()));
 
                 for (size_t i = 0; i < _layers.size(); ++i)
@@ -1629,6 +2244,9 @@ namespace Simd
                     logger();
                 }
 
+                for (size_t i = 0; i < _layers.size(); ++i)
+                    _layers[i]->PrepareForward();
+
                 return true;
             }
 
@@ -1659,6 +2277,53 @@ namespace Simd
                 return Forward(x, thread, method);
             }
 
+            /*!
+                \short Classifies given batch of samples.
+
+                The samples are processed in blocks. Fully connected layers multiply a whole block at once (with using of GEMM),
+                so their weights are loaded once per block instead of once per sample. Blocks are distributed between threads.
+
+                \note This function changes number of threads (see Network::SetThreadNumber) if it is required. 
+
+                \param [in] src - an input batch of samples.
+                \param [out] dst - results of classification (vectors with predicted probabilities).
+                \param [in] threadNumber - a maximal number of work threads. By default it is equal to std::thread::hardware_concurrency().
+                \param [in] blockSize - a number of samples processed together. By default it is equal to 64.
+            */
+            void Predict(const Vectors & src, Vectors & dst, size_t threadNumber = std::thread::hardware_concurrency(), size_t blockSize = 64)
+            {
+                SIMD_CHECK_PERFORMANCE();
+
+                dst.resize(src.size());
+                if (src.empty())
+                    return;
+
+                blockSize = std::max<size_t>(1, blockSize);
+                threadNumber = std::max<size_t>(1, std::min<size_t>(threadNumber, (src.size() + blockSize - 1) / blockSize));
+                if (_layers.front()->_common.size() < threadNumber)
+                    SetThreadNumber(threadNumber);
+
+                size_t srcSize = _layers.front()->_dst.Volume();
+                size_t dstSize = _layers.back()->_dst.Volume();
+                Parallel(0, src.size(), [&](size_t thread, size_t begin, size_t end)
+                {
+                    Vector batch;
+                    for (size_t b = begin; b < end; b += blockSize)
+                    {
+                        size_t count = std::min(blockSize, end - b);
+                        batch.resize(count*srcSize);
+                        for (size_t i = 0; i < count; ++i)
+                        {
+                            assert(src[b + i].size() == srcSize);
+                            memcpy(batch.data() + i*srcSize, src[b + i].data(), srcSize * sizeof(float));
+                        }
+                        const Vector & result = BatchForward(batch, count, thread);
+                        for (size_t i = 0; i < count; ++i)
+                            dst[b + i].assign(result.begin() + i*dstSize, result.begin() + (i + 1)*dstSize);
+                    }
+                }, threadNumber);
+            }
+
             /*!
                 \short Loads the weights of neural network from an external buffer.
 
@@ -1675,6 +2340,8 @@ namespace Simd
                     return false;
                 typedef  Vector::value_type Type;
                 Type * ptr = (Type*)data;
+                for (size_t i = 0; i < _layers.size(); ++i)
+                    _layers[i]->ResetWeight();
                 if (train)
                 {
                     for (size_t i = 0; i < _layers.size(); ++i)
@@ -1699,6 +2366,11 @@ namespace Simd
                         ptr += layer._gBias.size();
                     }
                 }
+                else
+                {
+                    for (size_t i = 0; i < _layers.size(); ++i)
+                        _layers[i]->PrepareForward();
+                }
                 return true;
             }
 
@@ -1715,6 +2387,8 @@ namespace Simd
             {
                 SIMD_CHECK_PERFORMANCE();
 
+                for (size_t i = 0; i < _layers.size(); ++i)
+                    _layers[i]->ResetWeight();
                 if (train)
                 {
                     for (size_t i = 0; i < _layers.size(); ++i)
@@ -1739,6 +2413,11 @@ namespace Simd
                             Load(is, layer._gBias[j]);
                     }
                 }
+                else
+                {
+                    for (size_t i = 0; i < _layers.size(); ++i)
+                        _layers[i]->PrepareForward();
+                }
                 return true;
             }
 
@@ -1769,10 +2448,14 @@ namespace Simd
                 \param [out] data - a pointer to the external buffer.
                 \param [in, out] size - a pointer to the size of external buffer. Returns requred buffer size. 
                 \param [in] train - a boolean flag (True - if we need to save temporary training data, False - otherwise). By default it is equal to False.
-                \return a result of saving.
+                \return a result of saving. It is False if the network was converted with using of Network::ConvertToInt8 
+                        (8-bit integer weights are not saved). Call Network::Load to restore 32-bit float weights before saving.
             */
             bool Save(void * data, size_t * size, bool train = false) const
             {
+                if (Quantized())
+                    return false;
+
                 typedef  Vector::value_type Type;
                 Type * ptr = (Type*)data;
                 size_t requred = Requred(train);
@@ -1787,9 +2470,9 @@ namespace Simd
                 for (size_t i = 0; i < _layers.size(); ++i)
                 {
                     const Layer & layer = *_layers[i];
-                    memcpy(ptr, layer._weight.data(), layer._weight.size() * sizeof(Type));
-                    ptr += layer._weight.size();
-                    memcpy(ptr, layer._weight.data(), layer._bias.size() * sizeof(Type));
+                    layer.SaveWeight(ptr);
+                    ptr += layer.WeightSize();
+                    memcpy(ptr, layer._bias.data(), layer._bias.size() * sizeof(Type));
                     ptr += layer._bias.size();
                 }
                 if (train)
@@ -1797,9 +2480,9 @@ namespace Simd
                     for (size_t i = 0; i < _layers.size(); ++i)
                     {
                         const Layer & layer = *_layers[i];
-                        memcpy(ptr, layer._weight.data(), layer._gWeight.size() * sizeof(Type));
+                        memcpy(ptr, layer._gWeight.data(), layer._gWeight.size() * sizeof(Type));
                         ptr += layer._gWeight.size();
-                        memcpy(ptr, layer._weight.data(), layer._gBias.size() * sizeof(Type));
+                        memcpy(ptr, layer._gBias.data(), layer._gBias.size() * sizeof(Type));
                         ptr += layer._gBias.size();
                     }
                 }
@@ -1811,15 +2494,21 @@ namespace Simd
 
                 \param [out] os - a output stream.
                 \param [in] train - a boolean flag (True - if we need to save temporary training data, False - otherwise). By default it is equal to False.
-                \return a result of saving.
+                \return a result of saving. It is False if the network was converted with using of Network::ConvertToInt8 
+                        (8-bit integer weights are not saved). Call Network::Load to restore 32-bit float weights before saving.
             */
             bool Save(std::ostream & os, bool train = false) const
             {
+                if (Quantized())
+                    return false;
+
                 for (size_t i = 0; i < _layers.size(); ++i)
                 {
                     const Layer & layer = *_layers[i];
-                    for (size_t j = 0; j < layer._weight.size(); ++j)
-                        os << layer._weight[j] << " ";
+                    Vector weight(layer.WeightSize());
+                    layer.SaveWeight(weight.data());
+                    for (size_t j = 0; j < weight.size(); ++j)
+                        os << weight[j] << " ";
                     for (size_t j = 0; j < layer._bias.size(); ++j)
                         os << layer._bias[j] << " ";
                 }
@@ -1843,10 +2532,14 @@ namespace Simd
 
                 \param [in] path - a path to output file.
                 \param [in] train - a boolean flag (True - if we need to save temporary training data, False - otherwise). By default it is equal to False.
-                \return a result of saving.
+                \return a result of saving. It is False if the network was converted with using of Network::ConvertToInt8 
+                        (8-bit integer weights are not saved). Call Network::Load to restore 32-bit float weights before saving.
             */
             bool Save(const std::string & path, bool train = false) const
             {
+                if (Quantized())
+                    return false;
+
                 std::ofstream ofs(path.c_str());
                 if (ofs.is_open())
                 {
@@ -1857,6 +2550,201 @@ namespace Simd
                 return false;
             }
 
+            /*!
+                \short Converts the weights of convolutional and fully connected layers to 16-bit float point format.
+
+                It halves memory footprint of the weights of fully connected layers: they are converted back to 32-bit float on the fly during prediction. 
+                The weights of convolutional layers are converted back to 32-bit float once: they are packed to the convolution context or cached if the context is not used.
+
+                \note The converted network can be used only for prediction with using of Layer::Fast method.
+            */
+            void ConvertToFloat16()
+            {
+                for (size_t i = 0; i < _layers.size(); ++i)
+                    _layers[i]->ConvertToFloat16();
+            }
+
+            /*!
+                \short Converts the weights of convolutional and fully connected layers to 8-bit integer format (post-training quantization).
+
+                The weights are quantized with a separate scale for every output channel. The input of every layer is quantized
+                to 8-bit unsigned integers in the range of values calibrated on given samples. Products of the quantized values 
+                are accumulated in 32-bit integers (see ::SimdNeuralProductSum8i) and converted back to 32-bit float with the bias added.
+
+                \note The calibration samples have to be representative for the data of prediction: values outside of the calibrated 
+                        range are saturated. The converted network can be used only for prediction with using of Layer::Fast method
+                        and can't be saved (Network::Save and Network::SaveBinary return False).
+
+                \param [in] src - a set of calibration samples.
+            */
+            void ConvertToInt8(const Vectors & src)
+            {
+                Vector lower(_layers.size(), FLT_MAX), upper(_layers.size(), -FLT_MAX);
+                for (size_t i = 0; i < src.size(); ++i)
+                {
+                    Forward(src[i], 0, Layer::Fast);
+                    for (size_t j = 0; j < _layers.size(); ++j)
+                    {
+                        const Vector & x = j ? _layers[j - 1]->Dst(0) : src[i];
+                        for (size_t k = 0; k < x.size(); ++k)
+                        {
+                            lower[j] = std::min(lower[j], x[k]);
+                            upper[j] = std::max(upper[j], x[k]);
+                        }
+                    }
+                }
+                for (size_t j = 0; j < _layers.size() && src.size(); ++j)
+                    _layers[j]->ConvertToInt8(lower[j], upper[j]);
+            }
+
+            /*!
+                \short Loads the weights of neural network from an external buffer in binary format.
+
+                The binary format contains a header with types and shapes of all layers and checksum of the weights. 
+                The header is validated against current structure of the network. 
+
+                \note The network has to be created previously with using of methods Clear/Add. The loaded network can be used only for prediction.
+
+                \param [in] data - a pointer to the external buffer (for example a memory mapped file).
+                \param [in] size - a size of the external buffer.
+                \param [in] external - a boolean flag (True - the network refers to the weights in the external buffer without copying 
+                                        (the buffer has to be aligned and alive while the network is used), False - the weights are copied). 
+                                        By default it is equal to False.
+                \return a result of loading.
+            */
+            bool LoadBinary(const void * data, size_t size, bool external = false)
+            {
+                const uint8_t * buffer = (const uint8_t*)data;
+                const BinaryHeader * header = (const BinaryHeader*)buffer;
+                if (size < sizeof(BinaryHeader) || header->magic != BINARY_MAGIC || header->version != BINARY_VERSION ||
+                    header->layerCount != _layers.size() || header->size > size || header->size < BinaryRequred())
+                    return false;
+                if (header->checksum != ::SimdCrc32c(buffer + sizeof(BinaryHeader), (size_t)header->size - sizeof(BinaryHeader)))
+                    return false;
+                const BinaryLayer * layers = (const BinaryLayer*)(header + 1);
+                const uint64_t begin = sizeof(BinaryHeader) + sizeof(BinaryLayer)*_layers.size();
+                for (size_t i = 0; i < _layers.size(); ++i)
+                {
+                    const Layer & layer = *_layers[i];
+                    const BinaryLayer & binary = layers[i];
+                    if (binary.type != (uint32_t)layer._type || binary.function != (uint32_t)layer._function.type ||
+                        !binary.Equal(binary.src, layer._src) || !binary.Equal(binary.dst, layer._dst) ||
+                        binary.weightSize != layer.WeightSize() || binary.biasSize != layer._bias.size() ||
+                        !binary.Inside(binary.weightOffset, binary.weightSize, begin, header->size) ||
+                        !binary.Inside(binary.biasOffset, binary.biasSize, begin, header->size))
+                        return false;
+                    if (external && (size_t)(buffer + binary.weightOffset) % sizeof(float))
+                        return false;
+                }
+                for (size_t i = 0; i < _layers.size(); ++i)
+                {
+                    Layer & layer = *_layers[i];
+                    const BinaryLayer & binary = layers[i];
+                    layer.ImportWeight((const float*)(buffer + binary.weightOffset), external);
+                    memcpy(layer._bias.data(), buffer + binary.biasOffset, layer._bias.size() * sizeof(float));
+                    layer.PrepareForward();
+                }
+                return true;
+            }
+
+            /*!
+                \short Loads the weights of neural network from file in binary format.
+
+                \note The network has to be created previously with using of methods Clear/Add. The loaded network can be used only for prediction.
+                      The file is read into an aligned buffer owned by the network and the layers refer to the weights in it without copying.
+
+                \param [in] path - a path to input file.
+                \return a result of loading.
+            */
+            bool LoadBinary(const std::string & path)
+            {
+                SIMD_CHECK_PERFORMANCE();
+
+                std::ifstream ifs(path.c_str(), std::ifstream::binary);
+                if (ifs.is_open())
+                {
+                    ifs.seekg(0, std::ios::end);
+                    std::shared_ptr<Buffer> buffer(new Buffer((size_t)ifs.tellg()));
+                    ifs.seekg(0, std::ios::beg);
+                    ifs.read((char*)buffer->data(), buffer->size());
+                    ifs.close();
+                    if (LoadBinary(buffer->data(), buffer->size(), true))
+                    {
+                        _binary = buffer;
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            /*!
+                \short Saves the weights of neural network to file stream in binary format.
+
+                The weights are aligned in the stream, so the file can be memory mapped and loaded with using of Network::LoadBinary without copying.
+
+                \param [out] os - an output stream (it has to be opened in binary mode).
+                \return a result of saving. It is False if the network was converted with using of Network::ConvertToInt8 
+                        (8-bit integer weights are not saved). Call Network::Load to restore 32-bit float weights before saving.
+            */
+            bool SaveBinary(std::ostream & os) const
+            {
+                if (Quantized())
+                    return false;
+
+                size_t size = BinaryRequred();
+                Buffer buffer(size, 0);
+                BinaryHeader * header = (BinaryHeader*)buffer.data();
+                header->magic = BINARY_MAGIC;
+                header->version = BINARY_VERSION;
+                header->layerCount = (uint32_t)_layers.size();
+                header->size = size;
+                BinaryLayer * layers = (BinaryLayer*)(header + 1);
+                size_t offset = ::SimdAlign(sizeof(BinaryHeader) + sizeof(BinaryLayer)*_layers.size(), BINARY_ALIGN);
+                for (size_t i = 0; i < _layers.size(); ++i)
+                {
+                    const Layer & layer = *_layers[i];
+                    BinaryLayer & binary = layers[i];
+                    binary.type = (uint32_t)layer._type;
+                    binary.function = (uint32_t)layer._function.type;
+                    binary.Set(binary.src, layer._src);
+                    binary.Set(binary.dst, layer._dst);
+                    binary.weightSize = (uint32_t)layer.WeightSize();
+                    binary.weightOffset = offset;
+                    layer.ExportWeight((float*)(buffer.data() + offset));
+                    offset += ::SimdAlign(binary.weightSize * sizeof(float), BINARY_ALIGN);
+                    binary.biasSize = (uint32_t)layer._bias.size();
+                    binary.biasOffset = offset;
+                    memcpy(buffer.data() + offset, layer._bias.data(), binary.biasSize * sizeof(float));
+                    offset += ::SimdAlign(binary.biasSize * sizeof(float), BINARY_ALIGN);
+                }
+                assert(offset == size);
+                header->checksum = ::SimdCrc32c(buffer.data() + sizeof(BinaryHeader), size - sizeof(BinaryHeader));
+                os.write((const char*)buffer.data(), size);
+                return (bool)os;
+            }
+
+            /*!
+                \short Saves the weights of neural network to file in binary format.
+
+                \param [in] path - a path to output file.
+                \return a result of saving. It is False if the network was converted with using of Network::ConvertToInt8 
+                        (8-bit integer weights are not saved). Call Network::Load to restore 32-bit float weights before saving.
+            */
+            bool SaveBinary(const std::string & path) const
+            {
+                if (Quantized())
+                    return false;
+
+                std::ofstream ofs(path.c_str(), std::ofstream::binary);
+                if (ofs.is_open())
+                {
+                    bool result = SaveBinary(ofs);
+                    ofs.close();
+                    return result;
+                }
+                return false;
+            }
+
             /*!
                 \short Converts format of classification results.
 
@@ -1879,6 +2767,62 @@ namespace Simd
 
         private:
             LayerPtrs _layers;
+            std::shared_ptr<Buffer> _binary;
+
+            static const uint32_t BINARY_MAGIC = 0x424E4E53;
+            static const uint32_t BINARY_VERSION = 1;
+            static const size_t BINARY_ALIGN = 64;
+
+            struct BinaryHeader
+            {
+                uint32_t magic, version, layerCount, checksum;
+                uint64_t size;
+            };
+
+            struct BinaryLayer
+            {
+                uint32_t type, function, src[3], dst[3], weightSize, biasSize;
+                uint64_t weightOffset, biasOffset;
+
+                static SIMD_INLINE void Set(uint32_t * dst, const Index & src)
+                {
+                    dst[0] = (uint32_t)src.width;
+                    dst[1] = (uint32_t)src.height;
+                    dst[2] = (uint32_t)src.depth;
+                }
+
+                static SIMD_INLINE bool Equal(const uint32_t * a, const Index & b)
+                {
+                    return a[0] == (uint32_t)b.width && a[1] == (uint32_t)b.height && a[2] == (uint32_t)b.depth;
+                }
+
+                static SIMD_INLINE bool Inside(uint64_t offset, uint32_t count, uint64_t begin, uint64_t end)
+                {
+                    return offset >= begin && offset <= end && (uint64_t)count * sizeof(float) <= end - offset;
+                }
+            };
+
+            bool Quantized() const
+            {
+                for (size_t i = 0; i < _layers.size(); ++i)
+                {
+                    if (_layers[i]->_weight8i.size())
+                        return true;
+                }
+                return false;
+            }
+
+            size_t BinaryRequred() const
+            {
+                size_t requred = ::SimdAlign(sizeof(BinaryHeader) + sizeof(BinaryLayer)*_layers.size(), BINARY_ALIGN);
+                for (size_t i = 0; i < _layers.size(); ++i)
+                {
+                    const Layer & layer = *_layers[i];
+                    requred += ::SimdAlign(layer.WeightSize() * sizeof(float), BINARY_ALIGN);
+                    requred += ::SimdAlign(layer._bias.size() * sizeof(float), BINARY_ALIGN);
+                }
+                return requred;
+            }
 
             size_t Requred(bool train) const
             {
@@ -1887,7 +2831,7 @@ namespace Simd
                 for (size_t i = 0; i < _layers.size(); ++i)
                 {
                     const Layer & layer = *_layers[i];
-                    requred += (layer._weight.size() + layer._bias.size()) * sizeof(Type);
+                    requred += (layer.WeightSize() + layer._bias.size()) * sizeof(Type);
                     if (train)
                         requred += (layer._gWeight.size() + layer._gBias.size()) * sizeof(Type);
                 }
@@ -1911,6 +2855,16 @@ namespace Simd
                 return _layers.back()->Dst(thread);
             }
 
+            const Vector & BatchForward(const Vector & src, size_t count, size_t thread)
+            {
+                SIMD_CHECK_PERFORMANCE();
+
+                _layers.front()->BatchForward(src, count, thread);
+                for (size_t i = 1; i < _layers.size(); ++i)
+                    _layers[i]->BatchForward(_layers[i - 1]->BatchDst(thread), count, thread);
+                return _layers.back()->BatchDst(thread);
+            }
+
             bool Cannonical(const TrainOptions & options) const
             {
                 const Function::Type & func = _layers.back()->_function.type;
@@ -2006,24 +2960,46 @@ namespace Simd
                 }
             }
 
+            template<TrainOptions::UpdateType type> void UpdateWeight(const TrainOptions & options, Layer & layer, bool bias, size_t begin, size_t end)
+            {
+                size_t size = end - begin;
+                float * delta = (bias ? layer._common[0].dBias : layer._common[0].dWeight).data() + begin;
+                for (size_t t = 1; t < layer._common.size(); ++t)
+                {
+                    float * other = (bias ? layer._common[t].dBias : layer._common[t].dWeight).data() + begin;
+                    ::SimdNeuralAddVector(other, size, delta);
+                    memset(other, 0, size * sizeof(float));
+                }
+                float * gradient = (bias ? layer._gBias : layer._gWeight).data() + begin;
+                float * value = (bias ? layer._bias : layer._weight).data() + begin;
+                Detail::UpdateWeight<type>(options, delta, size, gradient, value);
+                memset(delta, 0, size * sizeof(float));
+            }
+
             template<TrainOptions::UpdateType type> void UpdateWeight(const TrainOptions & options)
             {
+                const size_t block = 16, parallelMin = 0x4000;
+                size_t total = 0;
                 for (size_t l = 0; l < _layers.size(); ++l)
+                    total += _layers[l]->_weight.size() + _layers[l]->_bias.size();
+
+                Parallel(0, (total + block - 1) / block, [&](size_t thread, size_t begin, size_t end)
                 {
-                    Layer & layer = *_layers[l];
-                    for (size_t t = 1; t < layer._common.size(); ++t)
-                    {
-                        ::SimdNeuralAddVector(layer._common[t].dWeight.data(), layer._common[t].dWeight.size(), layer._common[0].dWeight.data());
-                        ::SimdNeuralAddVector(layer._common[t].dBias.data(), layer._common[t].dBias.size(), layer._common[0].dBias.data());
-                    }
-                    Detail::UpdateWeight<type>(options, layer._common[0].dWeight, layer._gWeight, layer._weight);
-                    Detail::UpdateWeight<type>(options, layer._common[0].dBias, layer._gBias, layer._bias);
-                    for (size_t t = 0; t < layer._common.size(); ++t)
+                    begin = begin*block;
+                    end = std::min(end*block, total);
+                    for (size_t l = 0, offset = 0; l < _layers.size() && offset < end; ++l)
                     {
-                        Detail::SetZero(layer._common[t].dWeight);
-                        Detail::SetZero(layer._common[t].dBias);
+                        Layer & layer = *_layers[l];
+                        for (size_t bias = 0; bias < 2; ++bias)
+                        {
+                            size_t size = bias ? layer._bias.size() : layer._weight.size();
+                            size_t b = std::max(begin, offset), e = std::min(end, offset + size);
+                            if (b < e)
+                                UpdateWeight<type>(options, layer, bias != 0, b - offset, e - offset);
+                            offset += size;
+                        }
                     }
-                }
+                }, total < parallelMin ? 1 : options.threadNumber);
             }
 
             void UpdateWeight(const TrainOptions & options)
@@ -26,33 +26,355 @@
 
 #include <thread>
 #include <future>
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <exception>
+
+#if defined(__linux__) && !defined(__ANDROID__)
+#include <pthread.h>
+#include <sched.h>
+#define SIMD_PARALLEL_PINNING_ENABLE
+#endif
 
 namespace Simd
 {
+    /*! @ingroup cpp_parallel
+
+        \short The ThreadPool class is a persistent pool of work threads with work-stealing queues.
+
+        Every worker thread owns a task queue. Tasks of a batch are spread over the queues, a worker takes tasks from the front 
+        of its own queue and steals them from the back of the other queues when its own queue is empty. 
+        A thread which calls ThreadPool::Execute takes part in the execution of its batch, so nested calls do not lead to deadlock.
+
+        \note The process-wide pool used by Simd::Parallel is created on first use. Use Simd::SetThreadPool to change its parameters.
+    */
+    class ThreadPool
+    {
+    public:
+        typedef std::function<void(size_t index)> Task; /*!< A task type definition. The task gets an index of the task in the batch. */
+
+        /*!
+            Creates a new thread pool.
+
+            \param [in] size - a total number of threads which execute tasks (including the calling thread). 
+                               So the pool creates (size - 1) work threads. Use 0 for auto choose (std::thread::hardware_concurrency()).
+            \param [in] pinning - a flag to pin work threads to CPU cores. It is supported only on Linux.
+        */
+        ThreadPool(size_t size = 0, bool pinning = false)
+            : _stop(false)
+            , _pending(0)
+            , _next(0)
+        {
+            if (size == 0)
+                size = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+            _queues.reserve(size);
+            for (size_t i = 0; i < size; ++i)
+                _queues.push_back(QueuePtr(new Queue()));
+            _workers.reserve(size - 1);
+            for (size_t i = 1; i < size; ++i)
+                _workers.push_back(std::thread(&ThreadPool::Work, this, i, pinning));
+        }
+
+        /*!
+            A ThreadPool destructor. It waits finishing of all queued tasks.
+        */
+        ~ThreadPool()
+        {
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _stop = true;
+            }
+            _wakeup.notify_all();
+            for (size_t i = 0; i < _workers.size(); ++i)
+                _workers[i].join();
+        }
+
+        /*!
+            Gets a total number of threads which execute tasks (including the calling thread).
+
+            \return a size of the pool.
+        */
+        size_t Size() const
+        {
+            return _queues.size();
+        }
+
+        /*!
+            Executes a batch of tasks and waits its finishing. The calling thread also executes tasks of the batch.
+            If a task throws an exception then it will be rethrown in the calling thread (after finishing of the batch).
+
+            \param [in] count - a number of tasks in the batch.
+            \param [in] task - a task function. It is called once for every index in range [0, count).
+        */
+        void Execute(size_t count, const Task & task)
+        {
+            if (count == 0)
+                return;
+            if (count == 1 || _workers.empty())
+            {
+                for (size_t i = 0; i < count; ++i)
+                    task(i);
+                return;
+            }
+
+            Batch batch(task, count);
+            size_t start = _next++;
+            for (size_t i = 1; i < count; ++i)
+            {
+                Queue & queue = *_queues[(start + i) % _queues.size()];
+                std::lock_guard<std::mutex> lock(queue.mutex);
+                queue.items.push_back(Item(&batch, i));
+            }
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _pending += count - 1;
+            }
+            _wakeup.notify_all();
+
+            Run(Item(&batch, 0));
+            
+            Item item;
+            while (batch.remain.load(std::memory_order_acquire) && Steal(start, item))
+                Run(item);
+
+            {
+                std::unique_lock<std::mutex> lock(batch.mutex);
+                batch.finished.wait(lock, [&batch] { return batch.remain.load(std::memory_order_acquire) == 0; });
+            }
+
+            if (batch.exception)
+                std::rethrow_exception(batch.exception);
+        }
+
+    private:
+        struct Batch
+        {
+            const Task & task;
+            std::atomic<size_t> remain;
+            std::mutex mutex;
+            std::condition_variable finished;
+            std::exception_ptr exception;
+
+            Batch(const Task & t, size_t count)
+                : task(t)
+                , remain(count)
+            {
+            }
+        };
+
+        struct Item
+        {
+            Batch * batch;
+            size_t index;
+
+            Item(Batch * b = NULL, size_t i = 0)
+                : batch(b)
+                , index(i)
+            {
+            }
+        };
+
+        struct Queue
+        {
+            std::mutex mutex;
+            std::deque<Item> items;
+        };
+        typedef std::unique_ptr<Queue> QueuePtr;
+
+        std::vector<QueuePtr> _queues;
+        std::vector<std::thread> _workers;
+        std::mutex _mutex;
+        std::condition_variable _wakeup;
+        bool _stop;
+        std::atomic<size_t> _pending;
+        std::atomic<size_t> _next;
+
+        bool Pop(size_t id, Item & item)
+        {
+            Queue & queue = *_queues[id];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (queue.items.empty())
+                return false;
+            item = queue.items.front();
+            queue.items.pop_front();
+            _pending--;
+            return true;
+        }
+
+        bool Steal(size_t id, Item & item)
+        {
+            for (size_t i = 0; i < _queues.size(); ++i)
+            {
+                Queue & queue = *_queues[(id + i) % _queues.size()];
+                std::lock_guard<std::mutex> lock(queue.mutex);
+                if (queue.items.empty())
+                    continue;
+                item = queue.items.back();
+                queue.items.pop_back();
+                _pending--;
+                return true;
+            }
+            return false;
+        }
+
+        void Run(const Item & item)
+        {
+            Batch & batch = *item.batch;
+            try
+            {
+                batch.task(item.index);
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock(batch.mutex);
+                if (!batch.exception)
+                    batch.exception = std::current_exception();
+            }
+            std::lock_guard<std::mutex> lock(batch.mutex);
+            if (batch.remain.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                batch.finished.notify_all();
+        }
+
+        void Work(size_t id, bool pinning)
+        {
+            if (pinning)
+                Pin(id);
+            Item item;
+            for (;;)
+            {
+                if (Pop(id, item) || Steal(id, item))
+                    Run(item);
+                else
+                {
+                    std::unique_lock<std::mutex> lock(_mutex);
+                    _wakeup.wait(lock, [this] { return _stop || _pending.load() > 0; });
+                    if (_stop && _pending.load() == 0)
+                        return;
+                }
+            }
+        }
+
+        static void Pin(size_t id)
+        {
+#ifdef SIMD_PARALLEL_PINNING_ENABLE
+            size_t cores = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            CPU_SET(int(id % cores), &set);
+            pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#else
+            (void)id;
+#endif
+        }
+    };
+
+    /*! @ingroup cpp_parallel
+
+        An executor type definition. The executor has to call task(i) for every i in range [0, count) and return after finishing of all tasks. 
+        It allows to run Simd::Parallel on user defined threads.
+    */
+    typedef std::function<void(size_t count, const ThreadPool::Task & task)> Executor;
+
+    namespace Detail
+    {
+        struct ParallelContext
+        {
+            std::mutex mutex;
+            std::shared_ptr<ThreadPool> pool;
+            std::shared_ptr<Executor> executor;
+        };
+
+        inline ParallelContext & GetParallelContext()
+        {
+            static ParallelContext context;
+            return context;
+        }
+
+        inline void ParallelExecute(size_t count, const ThreadPool::Task & task)
+        {
+            ParallelContext & context = GetParallelContext();
+            std::shared_ptr<ThreadPool> pool;
+            std::shared_ptr<Executor> executor;
+            {
+                std::lock_guard<std::mutex> lock(context.mutex);
+                if (!context.executor && !context.pool)
+                    context.pool.reset(new ThreadPool());
+                pool = context.pool;
+                executor = context.executor;
+            }
+            if (executor)
+                (*executor)(count, task);
+            else
+                pool->Execute(count, task);
+        }
+    }
+
+    /*! @ingroup cpp_parallel
+
+        Sets parameters of the process-wide thread pool used by Simd::Parallel. 
+        The previous pool is destroyed after finishing of the tasks which are run on it.
+
+        \param [in] size - a total number of threads (including the calling thread). Use 0 for auto choose.
+        \param [in] pinning - a flag to pin work threads to CPU cores (it is supported only on Linux).
+    */
+    inline void SetThreadPool(size_t size, bool pinning = false)
+    {
+        std::shared_ptr<ThreadPool> pool(new ThreadPool(size, pinning));
+        Detail::ParallelContext & context = Detail::GetParallelContext();
+        std::lock_guard<std::mutex> lock(context.mutex);
+        context.pool.swap(pool);
+    }
+
+    /*! @ingroup cpp_parallel
+
+        Sets an user defined executor for Simd::Parallel instead of the process-wide thread pool.
+
+        \param [in] executor - an executor. Use empty executor to restore the default behaviour.
+    */
+    inline void SetExecutor(const Executor & executor)
+    {
+        Detail::ParallelContext & context = Detail::GetParallelContext();
+        std::lock_guard<std::mutex> lock(context.mutex);
+        if (executor)
+            context.executor.reset(new Executor(executor));
+        else
+            context.executor.reset();
+    }
+
+    /*! @ingroup cpp_parallel
+
+        Splits range [begin, end) to blocks and processes them in parallel with using of the process-wide thread pool 
+        (or an user defined executor, see Simd::SetExecutor).
+
+        \param [in] begin - a begin of the range.
+        \param [in] end - an end of the range.
+        \param [in] function - a function with signature void(size_t thread, size_t begin, size_t end). 
+                               The thread parameter is an index of the block. It is less than threadNumber and unique among blocks.
+        \param [in] threadNumber - a maximal number of blocks (threads).
+        \param [in] blockStepMin - a minimal step of the block size.
+    */
     template<class Function> inline void Parallel(size_t begin, size_t end, const Function & function, size_t threadNumber, size_t blockStepMin = 1)
     {
         threadNumber = std::min<size_t>(threadNumber, std::thread::hardware_concurrency());
         if (threadNumber <= 1)
             function(0, begin, end);
-        else
+        else if (begin < end)
         {
-            std::vector<std::future<void>> futures;
-
             size_t blockSize = (end - begin + threadNumber - 1) / threadNumber;
             if (blockStepMin > 1)
                 blockSize += blockSize%blockStepMin;
-            size_t blockBegin = begin;
-            size_t blockEnd = blockBegin + blockSize;
+            size_t blockCount = (end - begin + blockSize - 1) / blockSize;
 
-            for (size_t thread = 0; thread < threadNumber && blockBegin < end; ++thread)
+            Detail::ParallelExecute(blockCount, [begin, end, blockSize, &function](size_t block)
             {
-                futures.push_back(std::move(std::async(std::launch::async, [blockBegin, blockEnd, thread, &function] { function(thread, blockBegin, blockEnd); })));
-                blockBegin += blockSize;
-                blockEnd = std::min(blockBegin + blockSize, end);
-            }
-
-            for (size_t i = 0; i < futures.size(); ++i)
-                futures[i].wait();
+                size_t blockBegin = begin + block*blockSize;
+                function(block, blockBegin, std::min(blockBegin + blockSize, end));
+            });
         }
     }
 }
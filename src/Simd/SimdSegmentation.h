@@ -0,0 +1,283 @@
+/*
+* Simd Library (http://ermig1979.github.io/Simd).
+*
+* Copyright (c) 2011-2017 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#ifndef __SimdSegmentation_h__
+#define __SimdSegmentation_h__
+
+#include "Simd/SimdMemory.h"
+
+#include <vector>
+#include <algorithm>
+
+namespace Simd
+{
+    namespace Segmentation
+    {
+        SIMD_INLINE size_t FirstBit(uint32_t value)
+        {
+            assert(value);
+#if defined(_MSC_VER)
+            unsigned long index;
+            _BitScanForward(&index, value);
+            return index;
+#elif defined(__GNUC__)
+            return __builtin_ctz(value);
+#else
+            size_t index = 0;
+            for (; (value & 1) == 0; value >>= 1)
+                index++;
+            return index;
+#endif
+        }
+
+        /*
+            Labels connected components (4-connectivity) of mask with using of run-length encoding and union-find.
+            Every row is set by two bit masks: set (pixels which belong to components) and seed (pixels which start components).
+        */
+        class Labeller
+        {
+        public:
+            static const size_t BITS = 32;
+            static const uint32_t NONE = UINT32_MAX;
+
+            Labeller(size_t width, size_t height)
+                : _width(width)
+                , _height(height)
+                , _prev(0)
+                , _curr(0)
+                , _set((width + BITS - 1) / BITS)
+                , _seed((width + BITS - 1) / BITS)
+            {
+                _runs.reserve(height * 4);
+            }
+
+            uint32_t * Set()
+            {
+                return _set.data();
+            }
+
+            uint32_t * Seed()
+            {
+                return _seed.data();
+            }
+
+            void SetTail(const uint8_t * mask, const uint8_t * difference, size_t begin, uint8_t seedIndex, uint8_t emptyIndex, uint8_t differenceThreshold)
+            {
+                assert(begin % BITS == 0);
+                for (size_t i = begin / BITS; i < _set.size(); ++i)
+                {
+                    _set[i] = 0;
+                    _seed[i] = 0;
+                }
+                for (size_t col = begin; col < _width; ++col)
+                {
+                    uint32_t bit = 1u << (col % BITS);
+                    if (mask[col] == seedIndex)
+                    {
+                        _set[col / BITS] |= bit;
+                        _seed[col / BITS] |= bit;
+                    }
+                    else if (mask[col] == emptyIndex && difference[col] > differenceThreshold)
+                        _set[col / BITS] |= bit;
+                }
+            }
+
+            void AddRow(size_t row)
+            {
+                _prev = _curr;
+                _curr = _runs.size();
+                ExtractRuns(uint32_t(row));
+                MarkSeeds(uint32_t(row));
+                MergeRuns();
+            }
+
+            size_t Finish(uint8_t * mask, size_t stride, uint8_t invalidIndex, size_t areaMin, uint8_t indexMin, ptrdiff_t * rects)
+            {
+                for (size_t i = 0; i < _runs.size(); ++i)
+                {
+                    size_t root = Find(i);
+                    _runs[i].parent = uint32_t(root);
+                    if (root != i)
+                    {
+                        Run & r = _runs[root];
+                        const Run & c = _runs[i];
+                        r.left = std::min(r.left, c.left);
+                        r.right = std::max(r.right, c.right);
+                        r.bottom = std::max(r.bottom, c.bottom);
+                        r.seed = std::min(r.seed, c.seed);
+                    }
+                }
+
+                std::vector<uint32_t> roots;
+                for (size_t i = 0; i < _runs.size(); ++i)
+                {
+                    if (_runs[i].parent == i && _runs[i].seed != NONE)
+                        roots.push_back(uint32_t(i));
+                }
+                std::sort(roots.begin(), roots.end(), [this](uint32_t a, uint32_t b) { return _runs[a].seed < _runs[b].seed; });
+
+                size_t count = 0, capacity = 256 - indexMin;
+                for (size_t i = 0; i < roots.size(); ++i)
+                {
+                    Run & root = _runs[roots[i]];
+                    size_t area = size_t(root.right - root.left)*size_t(root.bottom - root.top);
+                    if (area <= areaMin)
+                        root.index = invalidIndex;
+                    else
+                    {
+                        if (count < capacity)
+                        {
+                            root.index = uint8_t(indexMin + count);
+                            rects[count * 4 + 0] = root.left;
+                            rects[count * 4 + 1] = root.top;
+                            rects[count * 4 + 2] = root.right;
+                            rects[count * 4 + 3] = root.bottom;
+                        }
+                        else
+                            root.index = invalidIndex;
+                        count++;
+                    }
+                }
+
+                for (size_t i = 0; i < _runs.size(); ++i)
+                {
+                    const Run & run = _runs[i];
+                    const Run & root = _runs[run.parent];
+                    if (root.seed != NONE)
+                        memset(mask + run.top*stride + run.begin, root.index, run.end - run.begin);
+                }
+
+                return count;
+            }
+
+        private:
+            struct Run
+            {
+                uint32_t begin, end, top, parent, seed;
+                uint32_t left, right, bottom;
+                uint8_t index;
+
+                Run(uint32_t row, uint32_t begin_, uint32_t end_, uint32_t id)
+                    : begin(begin_), end(end_), top(row), parent(id), seed(NONE)
+                    , left(begin_), right(end_), bottom(row + 1), index(0)
+                {
+                }
+            };
+            typedef std::vector<Run> Runs;
+
+            size_t _width, _height, _prev, _curr;
+            std::vector<uint32_t> _set, _seed;
+            Runs _runs;
+
+            void ExtractRuns(uint32_t row)
+            {
+                bool open = false;
+                uint32_t begin = 0;
+                for (size_t i = 0; i < _set.size(); ++i)
+                {
+                    uint32_t bits = _set[i], offset = uint32_t(i * BITS);
+                    if (open)
+                    {
+                        if (bits == UINT32_MAX)
+                            continue;
+                        size_t end = FirstBit(~bits);
+                        _runs.push_back(Run(row, begin, offset + uint32_t(end), uint32_t(_runs.size())));
+                        bits &= UINT32_MAX << end;
+                        open = false;
+                    }
+                    while (bits)
+                    {
+                        size_t first = FirstBit(bits);
+                        begin = offset + uint32_t(first);
+                        uint32_t rest = ~bits & (UINT32_MAX << first);
+                        if (rest == 0)
+                        {
+                            open = true;
+                            break;
+                        }
+                        size_t end = FirstBit(rest);
+                        _runs.push_back(Run(row, begin, offset + uint32_t(end), uint32_t(_runs.size())));
+                        bits &= UINT32_MAX << end;
+                    }
+                }
+                if (open)
+                    _runs.push_back(Run(row, begin, uint32_t(_width), uint32_t(_runs.size())));
+            }
+
+            void MarkSeeds(uint32_t row)
+            {
+                size_t r = _curr;
+                for (size_t i = 0; i < _seed.size(); ++i)
+                {
+                    uint32_t bits = _seed[i];
+                    while (bits)
+                    {
+                        uint32_t col = uint32_t(i * BITS + FirstBit(bits));
+                        bits &= bits - 1;
+                        while (_runs[r].end <= col)
+                            r++;
+                        if (_runs[r].seed == NONE)
+                            _runs[r].seed = uint32_t(row * _width + col);
+                    }
+                }
+            }
+
+            void MergeRuns()
+            {
+                for (size_t p = _prev, c = _curr, end = _runs.size(); p < _curr && c < end;)
+                {
+                    const Run & prev = _runs[p];
+                    const Run & curr = _runs[c];
+                    if (prev.begin < curr.end && curr.begin < prev.end)
+                        Union(p, c);
+                    if (prev.end < curr.end)
+                        p++;
+                    else
+                        c++;
+                }
+            }
+
+            size_t Find(size_t i)
+            {
+                while (_runs[i].parent != i)
+                {
+                    _runs[i].parent = _runs[_runs[i].parent].parent;
+                    i = _runs[i].parent;
+                }
+                return i;
+            }
+
+            void Union(size_t a, size_t b)
+            {
+                a = Find(a);
+                b = Find(b);
+                if (a < b)
+                    _runs[b].parent = uint32_t(a);
+                else if (b < a)
+                    _runs[a].parent = uint32_t(b);
+            }
+        };
+    }
+}
+
+#endif//__SimdSegmentation_h__
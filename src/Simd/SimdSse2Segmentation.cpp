@@ -24,6 +24,7 @@
 #include "Simd/SimdMemory.h"
 #include "Simd/SimdStore.h"
 #include "Simd/SimdCompare.h"
+#include "Simd/SimdSegmentation.h"
 
 namespace Simd
 {
@@ -173,6 +174,44 @@ namespace Simd
                 SegmentationPropagate2x2<false>(parent, parentStride, width, height, child, childStride,
                     difference, differenceStride, currentIndex, invalidIndex, emptyIndex, differenceThreshold);
         }
+
+        SIMD_INLINE void LabelBits(const uint8_t * mask, const uint8_t * difference, const __m128i & seedIndex, const __m128i & emptyIndex,
+            const __m128i & threshold, uint32_t & set, uint32_t & seed)
+        {
+            const __m128i _mask = Load<false>((__m128i*)mask);
+            const __m128i _seed = _mm_cmpeq_epi8(_mask, seedIndex);
+            const __m128i _grow = _mm_and_si128(_mm_cmpeq_epi8(_mask, emptyIndex), Greater8u(Load<false>((__m128i*)difference), threshold));
+            set = _mm_movemask_epi8(_mm_or_si128(_seed, _grow));
+            seed = _mm_movemask_epi8(_seed);
+        }
+
+        size_t SegmentationLabel(uint8_t * mask, size_t maskStride, size_t width, size_t height, const uint8_t * difference, size_t differenceStride,
+            uint8_t seedIndex, uint8_t emptyIndex, uint8_t invalidIndex, uint8_t differenceThreshold, size_t areaMin, uint8_t indexMin, ptrdiff_t * rects)
+        {
+            __m128i _seedIndex = _mm_set1_epi8((char)seedIndex);
+            __m128i _emptyIndex = _mm_set1_epi8((char)emptyIndex);
+            __m128i _threshold = _mm_set1_epi8((char)differenceThreshold);
+            size_t alignedWidth = Simd::AlignLo(width, DA);
+            Segmentation::Labeller labeller(width, height);
+            uint32_t * set = labeller.Set();
+            uint32_t * seed = labeller.Seed();
+            for (size_t row = 0; row < height; ++row)
+            {
+                const uint8_t * m = mask + row*maskStride;
+                const uint8_t * d = difference + row*differenceStride;
+                for (size_t col = 0; col < alignedWidth; col += DA)
+                {
+                    uint32_t set0, seed0, set1, seed1;
+                    LabelBits(m + col, d + col, _seedIndex, _emptyIndex, _threshold, set0, seed0);
+                    LabelBits(m + col + A, d + col + A, _seedIndex, _emptyIndex, _threshold, set1, seed1);
+                    set[col / DA] = set0 | (set1 << A);
+                    seed[col / DA] = seed0 | (seed1 << A);
+                }
+                labeller.SetTail(m, d, alignedWidth, seedIndex, emptyIndex, differenceThreshold);
+                labeller.AddRow(row);
+            }
+            return labeller.Finish(mask, maskStride, invalidIndex, areaMin, indexMin, rects);
+        }
     }
 #endif//SIMD_SSE2_ENABLE
 }
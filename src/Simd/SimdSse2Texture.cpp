@@ -148,6 +148,104 @@ namespace Simd
                 TextureBoostedUv<false>(src, srcStride, width, height, boost, dst, dstStride);
         }
 
+        template <bool align> SIMD_INLINE __m128i TextureFeatureDifference(const uint8_t * value, const uint8_t * lo, const uint8_t * hi, size_t offset, __m128i weight)
+        {
+            const __m128i _value = Load<align>((__m128i*)(value + offset));
+            const __m128i _lo = Load<align>((__m128i*)(lo + offset));
+            const __m128i _hi = Load<align>((__m128i*)(hi + offset));
+            const __m128i featureDifference = _mm_max_epu8(_mm_subs_epu8(_value, _hi), _mm_subs_epu8(_lo, _value));
+            const __m128i differenceLo = _mm_unpacklo_epi8(featureDifference, K_ZERO);
+            const __m128i differenceHi = _mm_unpackhi_epi8(featureDifference, K_ZERO);
+            return _mm_packus_epi16(_mm_mulhi_epu16(_mm_mullo_epi16(differenceLo, differenceLo), weight),
+                _mm_mulhi_epu16(_mm_mullo_epi16(differenceHi, differenceHi), weight));
+        }
+
+        template <bool align> SIMD_INLINE void TextureFeatureDifference(const uint8_t * gray, const uint8_t * grayLo, const uint8_t * grayHi, __m128i grayWeight,
+            const uint8_t * dx, const uint8_t * dxLo, const uint8_t * dxHi, __m128i dxWeight, const uint8_t * dy, const uint8_t * dyLo, const uint8_t * dyHi, __m128i dyWeight,
+            const uint8_t * mask, uint8_t * difference, size_t offset)
+        {
+            __m128i sum = TextureFeatureDifference<align>(gray, grayLo, grayHi, offset, grayWeight);
+            sum = _mm_adds_epu8(sum, TextureFeatureDifference<align>(dx, dxLo, dxHi, offset, dxWeight));
+            sum = _mm_adds_epu8(sum, TextureFeatureDifference<align>(dy, dyLo, dyHi, offset, dyWeight));
+            if (mask)
+                sum = _mm_and_si128(sum, Load<align>((__m128i*)(mask + offset)));
+            Store<align>((__m128i*)(difference + offset), sum);
+        }
+
+        template<bool align> void TextureFeatureDifference(const uint8_t * gray, size_t grayStride, size_t width, size_t height, uint8_t saturation, uint8_t boost,
+            const uint8_t * grayLo, size_t grayLoStride, const uint8_t * grayHi, size_t grayHiStride, uint16_t grayWeight,
+            uint8_t * dx, size_t dxStride, const uint8_t * dxLo, size_t dxLoStride, const uint8_t * dxHi, size_t dxHiStride, uint16_t dxWeight,
+            uint8_t * dy, size_t dyStride, const uint8_t * dyLo, size_t dyLoStride, const uint8_t * dyHi, size_t dyHiStride, uint16_t dyWeight,
+            const uint8_t * mask, size_t maskStride, uint8_t * difference, size_t differenceStride)
+        {
+            assert(width >= A && height >= 3 && int(2)*saturation*boost <= 0xFF);
+
+            size_t alignedWidth = AlignLo(width, A);
+            __m128i _saturation = _mm_set1_epi16(saturation);
+            __m128i _boost = _mm_set1_epi16(boost);
+            __m128i _grayWeight = _mm_set1_epi16((short)grayWeight);
+            __m128i _dxWeight = _mm_set1_epi16((short)dxWeight);
+            __m128i _dyWeight = _mm_set1_epi16((short)dyWeight);
+
+            for (size_t row = 0; row < height; ++row)
+            {
+                if (row == 0 || row == height - 1)
+                {
+                    memset(dx, 0, width);
+                    memset(dy, 0, width);
+                }
+                else
+                {
+                    for (size_t col = 0; col < alignedWidth; col += A)
+                        TextureBoostedSaturatedGradient<align>(gray + col, dx + col, dy + col, grayStride, _saturation, _boost);
+                    if (width != alignedWidth)
+                        TextureBoostedSaturatedGradient<false>(gray + width - A, dx + width - A, dy + width - A, grayStride, _saturation, _boost);
+
+                    dx[0] = 0;
+                    dy[0] = 0;
+                    dx[width - 1] = 0;
+                    dy[width - 1] = 0;
+                }
+
+                for (size_t col = 0; col < alignedWidth; col += A)
+                    TextureFeatureDifference<align>(gray, grayLo, grayHi, _grayWeight, dx, dxLo, dxHi, _dxWeight, dy, dyLo, dyHi, _dyWeight, mask, difference, col);
+                if (width != alignedWidth)
+                    TextureFeatureDifference<false>(gray, grayLo, grayHi, _grayWeight, dx, dxLo, dxHi, _dxWeight, dy, dyLo, dyHi, _dyWeight, mask, difference, width - A);
+
+                gray += grayStride;
+                grayLo += grayLoStride;
+                grayHi += grayHiStride;
+                dx += dxStride;
+                dxLo += dxLoStride;
+                dxHi += dxHiStride;
+                dy += dyStride;
+                dyLo += dyLoStride;
+                dyHi += dyHiStride;
+                if (mask)
+                    mask += maskStride;
+                difference += differenceStride;
+            }
+        }
+
+        void TextureFeatureDifference(const uint8_t * gray, size_t grayStride, size_t width, size_t height, uint8_t saturation, uint8_t boost,
+            const uint8_t * grayLo, size_t grayLoStride, const uint8_t * grayHi, size_t grayHiStride, uint16_t grayWeight,
+            uint8_t * dx, size_t dxStride, const uint8_t * dxLo, size_t dxLoStride, const uint8_t * dxHi, size_t dxHiStride, uint16_t dxWeight,
+            uint8_t * dy, size_t dyStride, const uint8_t * dyLo, size_t dyLoStride, const uint8_t * dyHi, size_t dyHiStride, uint16_t dyWeight,
+            const uint8_t * mask, size_t maskStride, uint8_t * difference, size_t differenceStride)
+        {
+            if (Aligned(gray) && Aligned(grayStride) && Aligned(grayLo) && Aligned(grayLoStride) && Aligned(grayHi) && Aligned(grayHiStride) &&
+                Aligned(dx) && Aligned(dxStride) && Aligned(dxLo) && Aligned(dxLoStride) && Aligned(dxHi) && Aligned(dxHiStride) &&
+                Aligned(dy) && Aligned(dyStride) && Aligned(dyLo) && Aligned(dyLoStride) && Aligned(dyHi) && Aligned(dyHiStride) &&
+                Aligned(mask) && Aligned(maskStride) && Aligned(difference) && Aligned(differenceStride))
+                TextureFeatureDifference<true>(gray, grayStride, width, height, saturation, boost, grayLo, grayLoStride, grayHi, grayHiStride, grayWeight,
+                    dx, dxStride, dxLo, dxLoStride, dxHi, dxHiStride, dxWeight, dy, dyStride, dyLo, dyLoStride, dyHi, dyHiStride, dyWeight,
+                    mask, maskStride, difference, differenceStride);
+            else
+                TextureFeatureDifference<false>(gray, grayStride, width, height, saturation, boost, grayLo, grayLoStride, grayHi, grayHiStride, grayWeight,
+                    dx, dxStride, dxLo, dxLoStride, dxHi, dxHiStride, dxWeight, dy, dyStride, dyLo, dyLoStride, dyHi, dyHiStride, dyWeight,
+                    mask, maskStride, difference, differenceStride);
+        }
+
         template <bool align> SIMD_INLINE void TextureGetDifferenceSum(const uint8_t * src, const uint8_t * lo, const uint8_t * hi,
             __m128i & positive, __m128i & negative, const __m128i & mask)
         {
@@ -24,6 +24,7 @@
 #include "Simd/SimdMemory.h"
 #include "Simd/SimdExtract.h"
 #include "Simd/SimdStore.h"
+#include "Simd/SimdNeural.h"
 
 namespace Simd
 {
@@ -358,7 +359,7 @@ namespace Simd
                     sums[1] = _mm_add_ps(sums[1], _mm_mul_ps(a1, Load<align>(b)));
                 }
 
-                template <bool align> void Execute(size_t M, size_t N, size_t K, const float * a, const float * b, float * c)
+                template <bool align> void Execute(size_t M, size_t N, size_t K, const float * a, const float * b, float * c, const NeuralConvolution * epilogue)
                 {
                     size_t M2 = Simd::AlignLo(M, 2);
                     size_t N4 = Simd::AlignLo(N, 4);
@@ -409,6 +410,8 @@ namespace Simd
                             pc0[j] += ExtractSum(sums[0]);
                             pc1[j] += ExtractSum(sums[1]);
                         }
+                        if (epilogue)
+                            epilogue->Epilogue(i, 2, c + i*N);
                     }
                     for (; i < M; ++i)
                     {
@@ -449,15 +452,17 @@ namespace Simd
                             }
                             pc[j] += ExtractSum(sum);
                         }
+                        if (epilogue)
+                            epilogue->Epilogue(i, 1, c + i*N);
                     }
                 }
 
-                void Execute(size_t M, size_t N, size_t K, const float * a, const float * b, float * c)
+                void Execute(size_t M, size_t N, size_t K, const float * a, const float * b, float * c, const NeuralConvolution * epilogue = NULL)
                 {
                     if (Aligned(K, F))
-                        Execute<true>(M, N, K, a, b, c);
+                        Execute<true>(M, N, K, a, b, c, epilogue);
                     else
-                        Execute<false>(M, N, K, a, b, c);
+                        Execute<false>(M, N, K, a, b, c, epilogue);
                 }
             }
 
@@ -686,7 +691,7 @@ namespace Simd
                     AddSums4(sums, 4, mask, c, N);
                 }
 
-                template <bool align> void Execute4x4(size_t M, size_t N, size_t K, const float * a, const float * b, float * c)
+                template <bool align> void Execute4x4(size_t M, size_t N, size_t K, const float * a, const float * b, float * c, const NeuralConvolution * epilogue)
                 {
                     size_t M4 = Simd::AlignLo(M, 4);
                     size_t N4 = Simd::AlignLo(N, 4);
@@ -700,6 +705,8 @@ namespace Simd
                             Kernel4x4<align>(N, K, a + i*K, b + j*K, c + i*N + j, NULL);
                         if (N4 < N)
                             Kernel4x4<align>(N, K, a + i*K, b + j*K, c + i*N + j, tail);
+                        if (epilogue)
+                            epilogue->Epilogue(i, 4, c + i*N);
                     }
                     if (M4 < M)
                     {
@@ -708,6 +715,8 @@ namespace Simd
                             KernelMx4<align>(N, K, a + i*K, b + j*K, c + i*N + j, NULL, M - M4);
                         if (N4 < N)
                             KernelMx4<align>(N, K, a + i*K, b + j*K, c + i*N + j, tail, M - M4);
+                        if (epilogue)
+                            epilogue->Epilogue(i, M - M4, c + i*N);
                     }
                 }
 
@@ -777,7 +786,7 @@ namespace Simd
                     AddSums8(sums, 4, mask, c, N);
                 }
 
-                template <bool align> void Execute4x8(size_t M, size_t N, size_t K, const float * a, const float * b, float * c)
+                template <bool align> void Execute4x8(size_t M, size_t N, size_t K, const float * a, const float * b, float * c, const NeuralConvolution * epilogue)
                 {
                     size_t M4 = Simd::AlignLo(M, 4);
                     size_t N8 = Simd::AlignLo(N, 8);
@@ -791,6 +800,8 @@ namespace Simd
                             Kernel4x8<align>(N, K, a + i*K, b + j*K, c + i*N + j, NULL);
                         if (N8 < N)
                             Kernel4x8<align>(N, K, a + i*K, b + j*K, c + i*N + j, tail);
+                        if (epilogue)
+                            epilogue->Epilogue(i, 4, c + i*N);
                     }
                     if (M4 < M)
                     {
@@ -799,17 +810,19 @@ namespace Simd
                             KernelMx8<align>(N, K, a + i*K, b + j*K, c + i*N + j, NULL, M - M4);
                         if (N8 < N)
                             KernelMx8<align>(N, K, a + i*K, b + j*K, c + i*N + j, tail, M - M4);
+                        if (epilogue)
+                            epilogue->Epilogue(i, M - M4, c + i*N);
                     }
                 }
 
-                void Execute(size_t M, size_t N, size_t K, const float * a, const float * b, float * c, size_t cellA, size_t cellB)
+                void Execute(size_t M, size_t N, size_t K, const float * a, const float * b, float * c, size_t cellA, size_t cellB, const NeuralConvolution * epilogue = NULL)
                 {
                     if (cellA == 4)
                     {
                         if (cellB == 4)
-                            Execute4x4<false>(M, N, K, a, b, c);
+                            Execute4x4<false>(M, N, K, a, b, c, epilogue);
                         if (cellB == 8)
-                            Execute4x8<false>(M, N, K, a, b, c);
+                            Execute4x8<false>(M, N, K, a, b, c, epilogue);
                     }
                 }
             }
@@ -845,7 +858,7 @@ namespace Simd
                 }
 
                 template <bool align, size_t kernelX, size_t kernelY> void AddConvolution(const float * src, size_t srcWidth, size_t srcHeight, size_t srcDepth,
-                    const float * weight, float * dst, size_t dstWidth, size_t dstHeight, size_t dstDepth)
+                    const float * weight, float * dst, size_t dstWidth, size_t dstHeight, size_t dstDepth, const NeuralConvolution * epilogue)
                 {
                     size_t alignedWidth = AlignLo(dstWidth, F);
                     __m128 tailMask = RightNotZero(dstWidth - alignedWidth);
@@ -879,20 +892,22 @@ namespace Simd
                             }
                         }
                     }
+                    if (epilogue)
+                        epilogue->Epilogue(0, dstDepth, dst);
                 }
 
                 void Execute(const float * src, size_t srcWidth, size_t srcHeight, size_t srcDepth,
-                    const float * weight, size_t kernelX, size_t kernelY, float * dst, size_t dstWidth, size_t dstHeight, size_t dstDepth)
+                    const float * weight, size_t kernelX, size_t kernelY, float * dst, size_t dstWidth, size_t dstHeight, size_t dstDepth, const NeuralConvolution * epilogue = NULL)
                 {
                     assert(kernelX == kernelY);
                     if (kernelX == 2)
-                        AddConvolution<false, 2, 2>(src, srcWidth, srcHeight, srcDepth, weight, dst, dstWidth, dstHeight, dstDepth);
+                        AddConvolution<false, 2, 2>(src, srcWidth, srcHeight, srcDepth, weight, dst, dstWidth, dstHeight, dstDepth, epilogue);
                     else if (kernelX == 3)
-                        AddConvolution<false, 3, 3>(src, srcWidth, srcHeight, srcDepth, weight, dst, dstWidth, dstHeight, dstDepth);
+                        AddConvolution<false, 3, 3>(src, srcWidth, srcHeight, srcDepth, weight, dst, dstWidth, dstHeight, dstDepth, epilogue);
                     else if (kernelX == 4)
-                        AddConvolution<false, 4, 4>(src, srcWidth, srcHeight, srcDepth, weight, dst, dstWidth, dstHeight, dstDepth);
+                        AddConvolution<false, 4, 4>(src, srcWidth, srcHeight, srcDepth, weight, dst, dstWidth, dstHeight, dstDepth, epilogue);
                     else if (kernelX == 5)
-                        AddConvolution<false, 5, 5>(src, srcWidth, srcHeight, srcDepth, weight, dst, dstWidth, dstHeight, dstDepth);
+                        AddConvolution<false, 5, 5>(src, srcWidth, srcHeight, srcDepth, weight, dst, dstWidth, dstHeight, dstDepth, epilogue);
                     else
                         assert(0);
                 }
@@ -1030,6 +1045,136 @@ namespace Simd
             private:
                 void * _data;
             };
+
+            void PrepareB(const Opt & opt, const float * src, size_t srcWidth, size_t srcHeight, size_t srcDepth, size_t kernelX, size_t kernelY,
+                size_t padX, size_t padY, size_t strideX, size_t strideY, size_t dilationX, size_t dilationY, Data & data, size_t dstWidth, size_t dstHeight)
+            {
+                if (opt.sizeB)
+                {
+                    switch (opt.alg)
+                    {
+                    case Opt::Ver0: Ver0::PrepareB(src, srcWidth, srcHeight, srcDepth, kernelX, kernelY, padX, padY, strideX, strideY, dilationX, dilationY, dstWidth, dstHeight, data.b); break;
+                    case Opt::Ver1: Ver1::PrepareB(src, srcWidth, srcHeight, srcDepth, kernelX, kernelY, padX, padY, strideX, strideY, dilationX, dilationY, dstWidth, dstHeight, opt.cellB, data.t, data.b); break;
+                    case Opt::Ver2: Ver2::PrepareB(src, srcWidth, srcHeight, srcDepth, padX, padY, data.b, opt.paddedW, opt.paddedH); break;
+                    default: break;
+                    }
+                }
+                else
+                    data.b = (float*)src;
+            }
+
+            void Execute(const Opt & opt, size_t srcDepth, const float * weight, size_t kernelX, size_t kernelY, const Data & data, 
+                float * dst, size_t dstWidth, size_t dstHeight, size_t dstDepth, const NeuralConvolution * epilogue = NULL)
+            {
+                switch (opt.alg)
+                {
+                case Opt::Ver0: Ver0::Execute(dstDepth, opt.N, opt.K, weight, data.b, dst, epilogue); break;
+                case Opt::Ver1: Ver1::Execute(dstDepth, opt.N, opt.K, weight, data.b, dst, opt.cellA, opt.cellB, epilogue); break;
+                case Opt::Ver2: Ver2::Execute(data.b, opt.paddedW, opt.paddedH, srcDepth, weight, kernelX, kernelY, dst, dstWidth, dstHeight, dstDepth, epilogue); break;
+                default: break;
+                }
+            }
+
+            void Forward(const Opt & opt, const float * src, size_t srcWidth, size_t srcHeight, size_t srcDepth, const float * weight, size_t kernelX, size_t kernelY,
+                size_t padX, size_t padY, size_t strideX, size_t strideY, size_t dilationX, size_t dilationY, Data & data, float * dst, size_t dstWidth, size_t dstHeight, size_t dstDepth)
+            {
+                PrepareB(opt, src, srcWidth, srcHeight, srcDepth, kernelX, kernelY, padX, padY, strideX, strideY, dilationX, dilationY, data, dstWidth, dstHeight);
+                Execute(opt, srcDepth, weight, kernelX, kernelY, data, dst, dstWidth, dstHeight, dstDepth);
+            }
+
+            template <SimdNeuralActivationType type> SIMD_INLINE __m128 Activate(__m128 value, const __m128 * params);
+
+            template <> SIMD_INLINE __m128 Activate<SimdNeuralActivationIdentity>(__m128 value, const __m128 * params)
+            {
+                return value;
+            }
+
+            template <> SIMD_INLINE __m128 Activate<SimdNeuralActivationTanh>(__m128 value, const __m128 * params)
+            {
+                __m128 x = _mm_andnot_ps(params[4], _mm_mul_ps(value, params[0]));
+                __m128 x2 = _mm_mul_ps(x, x);
+                __m128 x4 = _mm_mul_ps(x2, x2);
+                __m128 pe = _mm_add_ps(_mm_add_ps(params[2], x), _mm_add_ps(_mm_mul_ps(x2, params[5]), _mm_mul_ps(x4, params[6])));
+                __m128 ne = _mm_rcp_ps(pe);
+                __m128 absTanh = _mm_mul_ps(_mm_sub_ps(pe, ne), _mm_rcp_ps(_mm_add_ps(pe, ne)));
+                return _mm_xor_ps(absTanh, _mm_and_ps(params[4], _mm_cmpgt_ps(params[4], value)));
+            }
+
+            template <> SIMD_INLINE __m128 Activate<SimdNeuralActivationSigmoid>(__m128 value, const __m128 * params)
+            {
+                __m128 e1 = _mm_max_ps(params[3], _mm_sub_ps(params[2], _mm_mul_ps(value, params[1])));
+                __m128 e2 = _mm_mul_ps(e1, e1);
+                __m128 e4 = _mm_mul_ps(e2, e2);
+                __m128 e8 = _mm_mul_ps(e4, e4);
+                __m128 e16 = _mm_mul_ps(e8, e8);
+                __m128 e32 = _mm_mul_ps(e16, e16);
+                __m128 e64 = _mm_mul_ps(e32, e32);
+                return _mm_rcp_ps(_mm_add_ps(params[2], _mm_mul_ps(e64, e64)));
+            }
+
+            template <> SIMD_INLINE __m128 Activate<SimdNeuralActivationRelu>(__m128 value, const __m128 * params)
+            {
+                return _mm_max_ps(_mm_mul_ps(params[0], value), value);
+            }
+
+            struct Convolution : public NeuralConvolution
+            {
+                Convolution(size_t srcWidth, size_t srcHeight, size_t srcDepth, const float * weight, size_t kernelX, size_t kernelY, size_t padX, size_t padY,
+                    size_t strideX, size_t strideY, size_t dilationX, size_t dilationY, size_t dstWidth, size_t dstHeight, size_t dstDepth,
+                    const float * bias, SimdNeuralActivationType activation, const float * slope)
+                    : NeuralConvolution(srcWidth, srcHeight, srcDepth, kernelX, kernelY, padX, padY, strideX, strideY, dilationX, dilationY, dstWidth, dstHeight, dstDepth,
+                        bias, activation, slope)
+                    , _opt(srcWidth, srcHeight, srcDepth, kernelX, kernelY, padX, padY, strideX, strideY, dilationX, dilationY, dstWidth, dstHeight, dstDepth)
+                {
+                    size_t size = _opt.sizeA ? _opt.sizeA : _opt.M*_opt.K;
+                    this->weight = (float*)Allocate(AlignHi(size, F) * sizeof(float));
+                    if (_opt.alg == Opt::Ver1)
+                        Ver1::PrepareA(weight, _opt.M, _opt.K, _opt.cellA, this->weight);
+                    else
+                        memcpy(this->weight, weight, size * sizeof(float));
+                }
+
+                virtual void Run(const float * src, void * buffer, size_t * size, float * dst, int add) const
+                {
+                    if (!add)
+                        memset(dst, 0, dstWidth*dstHeight*dstDepth * sizeof(float));
+
+                    Data data(0, _opt.sizeB, _opt.sizeT, buffer, size);
+
+                    PrepareB(_opt, src, srcWidth, srcHeight, srcDepth, kernelX, kernelY, padX, padY, strideX, strideY, dilationX, dilationY, data, dstWidth, dstHeight);
+                    Execute(_opt, srcDepth, weight, kernelX, kernelY, data, dst, dstWidth, dstHeight, dstDepth, HasEpilogue() ? this : NULL);
+                }
+
+            private:
+                template <SimdNeuralActivationType type> void Epilogue(size_t channel, size_t count, float * dst) const
+                {
+                    size_t size = dstWidth*dstHeight, aligned = AlignLo(size, F);
+                    __m128 params[7] = { _mm_set1_ps(slope), _mm_set1_ps(slope*0.0078125f), _mm_set1_ps(1.0f), _mm_set1_ps(0.5f), _mm_set1_ps(-0.0f), _mm_set1_ps(0.5658f), _mm_set1_ps(0.1430f) };
+                    for (size_t c = channel; c < channel + count; ++c)
+                    {
+                        __m128 _bias = _mm_set1_ps(bias ? bias[c] : 0.0f);
+                        size_t i = 0;
+                        for (; i < aligned; i += F)
+                            Store<false>(dst + i, Ncf::Activate<type>(_mm_add_ps(Load<false>(dst + i), _bias), params));
+                        NeuralConvolution::Epilogue(c, i, size, dst);
+                        dst += size;
+                    }
+                }
+
+                virtual void Epilogue(size_t channel, size_t count, float * dst) const
+                {
+                    switch (activation)
+                    {
+                    case SimdNeuralActivationIdentity: Epilogue<SimdNeuralActivationIdentity>(channel, count, dst); break;
+                    case SimdNeuralActivationTanh: Epilogue<SimdNeuralActivationTanh>(channel, count, dst); break;
+                    case SimdNeuralActivationSigmoid: Epilogue<SimdNeuralActivationSigmoid>(channel, count, dst); break;
+                    case SimdNeuralActivationRelu: Epilogue<SimdNeuralActivationRelu>(channel, count, dst); break;
+                    default: assert(0);
+                    }
+                }
+
+                Opt _opt;
+            };
         }
 
         void NeuralConvolutionForward(const float * src, size_t srcWidth, size_t srcHeight, size_t srcDepth,
@@ -1060,26 +1205,16 @@ namespace Simd
             else
                 data.a = (float*)weight;
 
-            if (opt.sizeB)
-            {
-                switch (opt.alg)
-                {
-                case Opt::Ver0: Ver0::PrepareB(src, srcWidth, srcHeight, srcDepth, kernelX, kernelY, padX, padY, strideX, strideY, dilationX, dilationY, dstWidth, dstHeight, data.b); break;
-                case Opt::Ver1: Ver1::PrepareB(src, srcWidth, srcHeight, srcDepth, kernelX, kernelY, padX, padY, strideX, strideY, dilationX, dilationY, dstWidth, dstHeight, opt.cellB, data.t, data.b); break;
-                case Opt::Ver2: Ver2::PrepareB(src, srcWidth, srcHeight, srcDepth, padX, padY, data.b, opt.paddedW, opt.paddedH); break;
-                default: break;
-                }
-            }
-            else
-                data.b = (float*)src;
+            Forward(opt, src, srcWidth, srcHeight, srcDepth, data.a, kernelX, kernelY, padX, padY, strideX, strideY, dilationX, dilationY,
+                data, dst, dstWidth, dstHeight, dstDepth);
+        }
 
-            switch (opt.alg)
-            {
-            case Opt::Ver0: Ver0::Execute(opt.M, opt.N, opt.K, data.a, data.b, dst); break;
-            case Opt::Ver1: Ver1::Execute(opt.M, opt.N, opt.K, data.a, data.b, dst, opt.cellA, opt.cellB); break;
-            case Opt::Ver2: Ver2::Execute(data.b, opt.paddedW, opt.paddedH, srcDepth, weight, kernelX, kernelY, dst, dstWidth, dstHeight, dstDepth); break;
-            default: break;
-            }
+        void * NeuralConvolutionInit(size_t srcWidth, size_t srcHeight, size_t srcDepth, const float * weight, size_t kernelX, size_t kernelY,
+            size_t padX, size_t padY, size_t strideX, size_t strideY, size_t dilationX, size_t dilationY, size_t dstWidth, size_t dstHeight, size_t dstDepth,
+            const float * bias, SimdNeuralActivationType activation, const float * slope)
+        {
+            return new Ncf::Convolution(srcWidth, srcHeight, srcDepth, weight, kernelX, kernelY, padX, padY, strideX, strideY, dilationX, dilationY, dstWidth, dstHeight, dstDepth,
+                bias, activation, slope);
         }
     }
 #endif// SIMD_SSE3_ENABLE
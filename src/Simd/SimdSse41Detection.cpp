@@ -334,6 +334,227 @@ namespace Simd
                 Image(hid.sum.width - 1, hid.sum.height - 1, dstStride, Image::Gray8, dst).Ref());
         }
 
+        SIMD_INLINE __m128i Norm16i(const __m128i & sum, const __m128i & sqsum, const __m128 & area, const __m128 & scale)
+        {
+            __m128 _sum = _mm_cvtepi32_ps(sum);
+            __m128 _sqsum = _mm_cvtepi32_ps(sqsum);
+            __m128 norm = ValidSqrt(_mm_sub_ps(_mm_mul_ps(_sqsum, area), _mm_mul_ps(_sum, _sum)));
+            return _mm_cvtps_epi32(_mm_mul_ps(norm, scale));
+        }
+
+        SIMD_INLINE __m128i Norm16ip(const HidHaarCascade16i & hid, size_t offset)
+        {
+            __m128 area = _mm_set1_ps(hid.windowArea);
+            __m128 scale = _mm_set1_ps(hid.normScale);
+            __m128i lo = Norm16i(Sum32ip(hid.p, offset + 0), Sum32ip(hid.pq, offset + 0), area, scale);
+            __m128i hi = Norm16i(Sum32ip(hid.p, offset + 4), Sum32ip(hid.pq, offset + 4), area, scale);
+            return _mm_packs_epi32(lo, hi);
+        }
+
+        SIMD_INLINE __m128i Norm16ii(const HidHaarCascade16i & hid, size_t offset)
+        {
+            __m128 area = _mm_set1_ps(hid.windowArea);
+            __m128 scale = _mm_set1_ps(hid.normScale);
+            __m128i lo = Norm16i(Sum32ii(hid.p, offset + 0), Sum32ii(hid.pq, offset + 0), area, scale);
+            __m128i hi = Norm16i(Sum32ii(hid.p, offset + 8), Sum32ii(hid.pq, offset + 8), area, scale);
+            return _mm_packs_epi32(lo, hi);
+        }
+
+        SIMD_INLINE __m128i RectSum16i(const WeightedRect16i & rect, size_t offset, const __m128i & round, const __m128i & shift)
+        {
+            __m128i s0 = _mm_loadu_si128((__m128i*)(rect.p0 + offset));
+            __m128i s1 = _mm_loadu_si128((__m128i*)(rect.p1 + offset));
+            __m128i s2 = _mm_loadu_si128((__m128i*)(rect.p2 + offset));
+            __m128i s3 = _mm_loadu_si128((__m128i*)(rect.p3 + offset));
+            __m128i sum = _mm_sub_epi32(_mm_sub_epi32(s0, s1), _mm_sub_epi32(s2, s3));
+            return _mm_srl_epi32(_mm_add_epi32(sum, round), shift);
+        }
+
+        SIMD_INLINE __m128i WeightedSum16i(const WeightedRect16i & rect, size_t offset, const __m128i & round, const __m128i & shift)
+        {
+            __m128i lo = RectSum16i(rect, offset + 0, round, shift);
+            __m128i hi = RectSum16i(rect, offset + 4, round, shift);
+            return _mm_mullo_epi16(_mm_packs_epi32(lo, hi), _mm_set1_epi16(rect.weight));
+        }
+
+        SIMD_INLINE void StageSum16i(const int16_t * leaves, int16_t threshold, const __m128i & sum, const __m128i & norm, __m128i & stageSum)
+        {
+            __m128i mask = _mm_cmpgt_epi16(sum, _mm_mulhi_epi16(_mm_set1_epi16(threshold), norm));
+            stageSum = _mm_add_epi16(stageSum, _mm_blendv_epi8(_mm_set1_epi16(leaves[0]), _mm_set1_epi16(leaves[1]), mask));
+        }
+
+        void Detect16i(const HidHaarCascade16i & hid, size_t offset, const __m128i & norm, __m128i & result)
+        {
+            typedef HidHaarCascade16i Hid;
+            const int16_t * leaves = hid.leaves.data();
+            const Hid::Node * node = hid.nodes.data();
+            const Hid::Stage * stages = hid.stages.data();
+            for (int i = 0, n = (int)hid.stages.size(); i < n; ++i)
+            {
+                const Hid::Stage & stage = stages[i];
+                const Hid::Node * end = node + stage.ntrees;
+                __m128i stageSum = _mm_setzero_si128();
+                if (stage.hasThree)
+                {
+                    for (; node < end; ++node, leaves += 2)
+                    {
+                        const Hid::Feature & feature = hid.features[node->featureIdx];
+                        __m128i round = _mm_set1_epi32(1 << feature.shift >> 1);
+                        __m128i shift = _mm_cvtsi32_si128(feature.shift);
+                        __m128i sum = _mm_add_epi16(WeightedSum16i(feature.rect[0], offset, round, shift), WeightedSum16i(feature.rect[1], offset, round, shift));
+                        if (feature.rect[2].p0)
+                            sum = _mm_add_epi16(sum, WeightedSum16i(feature.rect[2], offset, round, shift));
+                        StageSum16i(leaves, node->threshold, sum, norm, stageSum);
+                    }
+                }
+                else
+                {
+                    for (; node < end; ++node, leaves += 2)
+                    {
+                        const Hid::Feature & feature = hid.features[node->featureIdx];
+                        __m128i round = _mm_set1_epi32(1 << feature.shift >> 1);
+                        __m128i shift = _mm_cvtsi32_si128(feature.shift);
+                        __m128i sum = _mm_add_epi16(WeightedSum16i(feature.rect[0], offset, round, shift), WeightedSum16i(feature.rect[1], offset, round, shift));
+                        StageSum16i(leaves, node->threshold, sum, norm, stageSum);
+                    }
+                }
+                result = _mm_andnot_si128(_mm_cmpgt_epi16(_mm_set1_epi16(stage.threshold), stageSum), result);
+                int resultCount = ResultCount(result);
+                if (resultCount == 0)
+                    return;
+                else if (resultCount == 1)
+                {
+                    uint16_t SIMD_ALIGNED(16) _result[HA];
+                    int16_t SIMD_ALIGNED(16) _norm[HA];
+                    _mm_store_si128((__m128i*)_result, result);
+                    _mm_store_si128((__m128i*)_norm, norm);
+                    for (int j = 0; j < HA; ++j)
+                    {
+                        if (_result[j])
+                        {
+                            _result[j] = Base::Detect16i(hid, offset + j, i + 1, _norm[j]) > 0 ? 1 : 0;
+                            break;
+                        }
+                    }
+                    result = _mm_load_si128((__m128i*)_result);
+                    return;
+                }
+            }
+        }
+
+        void DetectionHaarDetect16ip(const HidHaarCascade16i & hid, const Image & mask, const Rect & rect, Image & dst)
+        {
+            size_t width = rect.Width();
+            size_t alignedWidth = Simd::AlignLo(width, HA);
+            size_t evenWidth = Simd::AlignLo(width, 2);
+
+            Buffer<uint16_t> buffer(width);
+            for (ptrdiff_t row = rect.top; row < rect.bottom; row += 1)
+            {
+                size_t col = 0;
+                size_t p_offset = row * hid.sum.stride / sizeof(uint32_t) + rect.left;
+                size_t pq_offset = row * hid.sqsum.stride / sizeof(uint32_t) + rect.left;
+
+                UnpackMask16i(mask.data + row*mask.stride + rect.left, width, buffer.m, K8_01);
+                memset(buffer.d, 0, width * sizeof(uint16_t));
+                for (; col < alignedWidth; col += HA)
+                {
+                    __m128i result = _mm_loadu_si128((__m128i*)(buffer.m + col));
+                    if (_mm_testz_si128(result, K16_0001))
+                        continue;
+                    __m128i norm = Norm16ip(hid, pq_offset + col);
+                    Detect16i(hid, p_offset + col, norm, result);
+                    _mm_storeu_si128((__m128i*)(buffer.d + col), result);
+                }
+                if (alignedWidth && evenWidth > alignedWidth + 2)
+                {
+                    col = evenWidth - HA;
+                    __m128i result = _mm_loadu_si128((__m128i*)(buffer.m + col));
+                    if (!_mm_testz_si128(result, K16_0001))
+                    {
+                        __m128i norm = Norm16ip(hid, pq_offset + col);
+                        Detect16i(hid, p_offset + col, norm, result);
+                        _mm_storeu_si128((__m128i*)(buffer.d + col), result);
+                    }
+                    col += HA;
+                }
+                for (; col < width; col += 1)
+                {
+                    if (buffer.m[col] == 0)
+                        continue;
+                    int16_t norm = Base::Norm16i(hid, pq_offset + col);
+                    buffer.d[col] = Base::Detect16i(hid, p_offset + col, 0, norm) > 0 ? 1 : 0;
+                }
+                PackResult16i(buffer.d, width, dst.data + row*dst.stride + rect.left);
+            }
+        }
+
+        void DetectionHaarDetect16ip(const void * _hid, const uint8_t * mask, size_t maskStride,
+            ptrdiff_t left, ptrdiff_t top, ptrdiff_t right, ptrdiff_t bottom, uint8_t * dst, size_t dstStride)
+        {
+            const HidHaarCascade16i & hid = *(HidHaarCascade16i*)_hid;
+            return DetectionHaarDetect16ip(hid,
+                Image(hid.sum.width - 1, hid.sum.height - 1, maskStride, Image::Gray8, (uint8_t*)mask),
+                Rect(left, top, right, bottom),
+                Image(hid.sum.width - 1, hid.sum.height - 1, dstStride, Image::Gray8, dst).Ref());
+        }
+
+        void DetectionHaarDetect16ii(const HidHaarCascade16i & hid, const Image & mask, const Rect & rect, Image & dst)
+        {
+            const size_t step = 2;
+            size_t width = rect.Width();
+            size_t alignedWidth = Simd::AlignLo(width, A);
+            size_t evenWidth = Simd::AlignLo(width, 2);
+
+            for (ptrdiff_t row = rect.top; row < rect.bottom; row += step)
+            {
+                size_t col = 0;
+                size_t p_offset = row * hid.isum.stride / sizeof(uint32_t) + rect.left / 2;
+                size_t pq_offset = row * hid.sqsum.stride / sizeof(uint32_t) + rect.left;
+                const uint8_t * m = mask.data + row*mask.stride + rect.left;
+                uint8_t * d = dst.data + row*dst.stride + rect.left;
+                for (; col < alignedWidth; col += A)
+                {
+                    __m128i result = _mm_and_si128(_mm_loadu_si128((__m128i*)(m + col)), K16_0001);
+                    if (_mm_testz_si128(result, K16_0001))
+                        continue;
+                    __m128i norm = Norm16ii(hid, pq_offset + col);
+                    Detect16i(hid, p_offset + col / 2, norm, result);
+                    _mm_storeu_si128((__m128i*)(d + col), result);
+                }
+                if (alignedWidth && evenWidth > alignedWidth + 2)
+                {
+                    col = evenWidth - A;
+                    __m128i result = _mm_and_si128(_mm_loadu_si128((__m128i*)(m + col)), K16_0001);
+                    if (!_mm_testz_si128(result, K16_0001))
+                    {
+                        __m128i norm = Norm16ii(hid, pq_offset + col);
+                        Detect16i(hid, p_offset + col / 2, norm, result);
+                        _mm_storeu_si128((__m128i*)(d + col), result);
+                    }
+                    col += A;
+                }
+                for (; col < width; col += step)
+                {
+                    if (mask.At<uint8_t>(col + rect.left, row) == 0)
+                        continue;
+                    int16_t norm = Base::Norm16i(hid, pq_offset + col);
+                    if (Base::Detect16i(hid, p_offset + col / 2, 0, norm) > 0)
+                        dst.At<uint8_t>(col + rect.left, row) = 1;
+                }
+            }
+        }
+
+        void DetectionHaarDetect16ii(const void * _hid, const uint8_t * mask, size_t maskStride,
+            ptrdiff_t left, ptrdiff_t top, ptrdiff_t right, ptrdiff_t bottom, uint8_t * dst, size_t dstStride)
+        {
+            const HidHaarCascade16i & hid = *(HidHaarCascade16i*)_hid;
+            return DetectionHaarDetect16ii(hid,
+                Image(hid.sum.width - 1, hid.sum.height - 1, maskStride, Image::Gray8, (uint8_t*)mask),
+                Rect(left, top, right, bottom),
+                Image(hid.sum.width - 1, hid.sum.height - 1, dstStride, Image::Gray8, dst).Ref());
+        }
+
         const __m128i K8_SHUFFLE_BITS = SIMD_MM_SETR_EPI8(0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00);
 
         SIMD_INLINE __m128i IntegralSum32i(const __m128i & s0, const __m128i & s1, const __m128i & s2, const __m128i & s3)
@@ -139,11 +139,18 @@ namespace Test
 
     TEST_ADD_GROUP(DetectionHaarDetect32fp);
     TEST_ADD_GROUP(DetectionHaarDetect32fi);
+    TEST_ADD_GROUP(DetectionHaarDetect16ip);
+    TEST_ADD_GROUP(DetectionHaarDetect16ii);
     TEST_ADD_GROUP(DetectionLbpDetect32fp);
     TEST_ADD_GROUP(DetectionLbpDetect32fi);
     TEST_ADD_GROUP(DetectionLbpDetect16ip);
     TEST_ADD_GROUP(DetectionLbpDetect16ii);
     TEST_ADD_GROUP_ONLY_SPECIAL(Detection);
+    TEST_ADD_GROUP_ONLY_SPECIAL(DetectionBinary);
+    TEST_ADD_GROUP_ONLY_SPECIAL(DetectionHaarInt16);
+    TEST_ADD_GROUP_ONLY_SPECIAL(DetectionGroup);
+
+    TEST_ADD_GROUP_ONLY_SPECIAL(Dispatch);
 
     TEST_ADD_GROUP(AlphaBlending);
     TEST_ADD_GROUP_ONLY_SPECIAL(DrawLine);
@@ -172,6 +179,7 @@ namespace Test
     TEST_ADD_GROUP(Float32ToFloat16);
     TEST_ADD_GROUP(Float16ToFloat32);
     TEST_ADD_GROUP(SquaredDifferenceSum16f);
+    TEST_ADD_GROUP(NeuralProductSum16f);
 
     TEST_ADD_GROUP(Float32ToUint8);
     TEST_ADD_GROUP(Uint8ToFloat32);
@@ -226,9 +234,13 @@ namespace Test
     TEST_ADD_GROUP(InterleaveBgra);
 
     TEST_ADD_GROUP_ONLY_SPECIAL(Motion);
+    TEST_ADD_GROUP_ONLY_SPECIAL(MotionEngine);
+    TEST_ADD_GROUP_ONLY_SPECIAL(MotionStability);
+    TEST_ADD_GROUP_ONLY_SPECIAL(MotionReduce);
 
     TEST_ADD_GROUP(NeuralConvert);
     TEST_ADD_GROUP(NeuralProductSum);
+    TEST_ADD_GROUP(NeuralProductSum8i);
     TEST_ADD_GROUP(NeuralAddVectorMultipliedByValue);
     TEST_ADD_GROUP(NeuralAddVector);
     TEST_ADD_GROUP(NeuralAddValue);
@@ -258,14 +270,25 @@ namespace Test
     TEST_ADD_GROUP(NeuralPooling1x1Max3x3);
     TEST_ADD_GROUP(NeuralPooling2x2Max2x2);
     TEST_ADD_GROUP(NeuralPooling2x2Max3x3);
-    TEST_ADD_GROUP(NeuralConvolutionForward);
+    TEST_ADD_GROUP_EX(NeuralConvolutionForward);
+    TEST_ADD_GROUP(NeuralConvolutionRun);
     TEST_ADD_GROUP_ONLY_SPECIAL(NeuralPredict);
+    TEST_ADD_GROUP_ONLY_SPECIAL(NeuralBinary);
+    TEST_ADD_GROUP_ONLY_SPECIAL(NeuralFloat16);
+    TEST_ADD_GROUP_ONLY_SPECIAL(NeuralInt8);
     TEST_ADD_GROUP_ONLY_SPECIAL(NeuralTrain);
+    TEST_ADD_GROUP_ONLY_SPECIAL(NeuralTrainParallel);
+
+    TEST_ADD_GROUP(Nv12ToBgr);
+    TEST_ADD_GROUP(Nv12ToBgra);
 
     TEST_ADD_GROUP(OperationBinary8u);
     TEST_ADD_GROUP(OperationBinary16i);
     TEST_ADD_GROUP(VectorProduct);
 
+    TEST_ADD_GROUP_ONLY_SPECIAL(Parallel);
+    TEST_ADD_GROUP_ONLY_SPECIAL(ParallelRows);
+
     TEST_ADD_GROUP(ReduceGray2x2);
     TEST_ADD_GROUP(ReduceGray3x3);
     TEST_ADD_GROUP(ReduceGray4x4);
@@ -276,11 +299,13 @@ namespace Test
     TEST_ADD_GROUP(Reorder64bit);
 
     TEST_ADD_GROUP_EX(ResizeBilinear);
+    TEST_ADD_GROUP(ResizeBilinearRows);
 
     TEST_ADD_GROUP(SegmentationShrinkRegion);
     TEST_ADD_GROUP(SegmentationFillSingleHoles);
     TEST_ADD_GROUP(SegmentationChangeIndex);
     TEST_ADD_GROUP(SegmentationPropagate2x2);
+    TEST_ADD_GROUP(SegmentationLabel);
 
     TEST_ADD_GROUP(ShiftBilinear);
     TEST_ADD_GROUP_ONLY_SPECIAL(ShiftDetectorRand);
@@ -305,6 +330,7 @@ namespace Test
 
     TEST_ADD_GROUP(TextureBoostedSaturatedGradient);
     TEST_ADD_GROUP(TextureBoostedUv);
+    TEST_ADD_GROUP(TextureFeatureDifference);
     TEST_ADD_GROUP(TextureGetDifferenceSum);
     TEST_ADD_GROUP(TexturePerformCompensation);
 
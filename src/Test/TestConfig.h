@@ -81,6 +81,7 @@ namespace Test
     typedef std::vector<Point> Points;
     typedef Point Size;
     typedef Simd::Rectangle<ptrdiff_t> Rect;
+    typedef std::vector<Rect> Rects;
     typedef uint32_t Histogram[Simd::HISTOGRAM_SIZE];
     typedef std::vector<int> Ints;
     typedef std::vector<uint32_t> Sums;
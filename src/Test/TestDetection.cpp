@@ -300,6 +300,64 @@ namespace Test
         return result;
     }
 
+    bool DetectionHaarDetect16ipAutoTest()
+    {
+        bool result = true;
+
+        result = result && DetectionDetectAutoTest(0, 0, 1, FUNC_D(Simd::Base::DetectionHaarDetect16ip), FUNC_D(SimdDetectionHaarDetect16ip));
+
+#ifdef SIMD_SSE41_ENABLE
+        if (Simd::Sse41::Enable)
+            result = result && DetectionDetectAutoTest(0, 0, 1, FUNC_D(Simd::Sse41::DetectionHaarDetect16ip), FUNC_D(SimdDetectionHaarDetect16ip));
+#endif
+
+#ifdef SIMD_AVX2_ENABLE
+        if (Simd::Avx2::Enable)
+            result = result && DetectionDetectAutoTest(0, 0, 1, FUNC_D(Simd::Avx2::DetectionHaarDetect16ip), FUNC_D(SimdDetectionHaarDetect16ip));
+#endif
+
+#ifdef SIMD_AVX512BW_ENABLE
+        if (Simd::Avx512bw::Enable)
+            result = result && DetectionDetectAutoTest(0, 0, 1, FUNC_D(Simd::Avx512bw::DetectionHaarDetect16ip), FUNC_D(SimdDetectionHaarDetect16ip));
+#endif
+
+#ifdef SIMD_NEON_ENABLE
+        if (Simd::Neon::Enable)
+            result = result && DetectionDetectAutoTest(0, 0, 1, FUNC_D(Simd::Neon::DetectionHaarDetect16ip), FUNC_D(SimdDetectionHaarDetect16ip));
+#endif
+
+        return result;
+    }
+
+    bool DetectionHaarDetect16iiAutoTest()
+    {
+        bool result = true;
+
+        result = result && DetectionDetectAutoTest(0, 1, 1, FUNC_D(Simd::Base::DetectionHaarDetect16ii), FUNC_D(SimdDetectionHaarDetect16ii));
+
+#ifdef SIMD_SSE41_ENABLE
+        if (Simd::Sse41::Enable)
+            result = result && DetectionDetectAutoTest(0, 1, 1, FUNC_D(Simd::Sse41::DetectionHaarDetect16ii), FUNC_D(SimdDetectionHaarDetect16ii));
+#endif
+
+#ifdef SIMD_AVX2_ENABLE
+        if (Simd::Avx2::Enable)
+            result = result && DetectionDetectAutoTest(0, 1, 1, FUNC_D(Simd::Avx2::DetectionHaarDetect16ii), FUNC_D(SimdDetectionHaarDetect16ii));
+#endif
+
+#ifdef SIMD_AVX512BW_ENABLE
+        if (Simd::Avx512bw::Enable)
+            result = result && DetectionDetectAutoTest(0, 1, 1, FUNC_D(Simd::Avx512bw::DetectionHaarDetect16ii), FUNC_D(SimdDetectionHaarDetect16ii));
+#endif
+
+#ifdef SIMD_NEON_ENABLE
+        if (Simd::Neon::Enable)
+            result = result && DetectionDetectAutoTest(0, 1, 1, FUNC_D(Simd::Neon::DetectionHaarDetect16ii), FUNC_D(SimdDetectionHaarDetect16ii));
+#endif
+
+        return result;
+    }
+
     bool DetectionLbpDetect32fpAutoTest()
     {
         bool result = true;
@@ -522,6 +580,16 @@ namespace Test
         return DetectionDetectDataTest(create, 0, 1, 0, FUNC_D(SimdDetectionHaarDetect32fi));
     }
 
+    bool DetectionHaarDetect16ipDataTest(bool create)
+    {
+        return DetectionDetectDataTest(create, 0, 0, 1, FUNC_D(SimdDetectionHaarDetect16ip));
+    }
+
+    bool DetectionHaarDetect16iiDataTest(bool create)
+    {
+        return DetectionDetectDataTest(create, 0, 1, 1, FUNC_D(SimdDetectionHaarDetect16ii));
+    }
+
     bool DetectionLbpDetect32fpDataTest(bool create)
     {
         return DetectionDetectDataTest(create, 1, 0, 0, FUNC_D(SimdDetectionLbpDetect32fp));
@@ -547,6 +615,7 @@ namespace Test
 
 #ifdef TEST_PERFORMANCE_TEST_ENABLE
 #define SIMD_CHECK_PERFORMANCE() TEST_PERFORMANCE_TEST_(__FUNCTION__)
+#define SIMD_CHECK_PERFORMANCE_(name) TEST_PERFORMANCE_TEST_(name)
 #endif
 
 #include "Simd/SimdDetection.hpp"
@@ -592,6 +661,46 @@ namespace Test
 #endif
     }
 
+    static bool DetectionMotionSpecialTest(Detection & detection, bool haarInt16)
+    {
+        View src = GetSample(Size(W, H), true);
+        detection.Init(src.Size(), 1.1, Size(0, 0), Size(INT_MAX, INT_MAX), View(), -1, haarInt16);
+
+        Objects full, motion, empty;
+        detection.Detect(src, full);
+        detection.Detect(src, motion, 3, 0.2, true, Detection::Rects(1, Rect(src.Size())));
+        detection.Detect(src, empty, 3, 0.2, true, Detection::Rects());
+
+        bool result = full.size() == motion.size() && empty.empty();
+        for (size_t i = 0; i < full.size() && result; ++i)
+            result = full[i].rect == motion[i].rect && full[i].weight == motion[i].weight;
+        if (!result)
+        {
+            TEST_LOG_SS(Error, "Detection with full frame motion region (" << motion.size() << " objects) or without motion regions (" 
+                << empty.size() << " objects) differs from detection without motion mask (" << full.size() << " objects)!");
+            return result;
+        }
+
+        Detection::Rects regions;
+        for (size_t i = 0; i < full.size(); ++i)
+        {
+            const Rect & r = full[i].rect;
+            regions.push_back(Rect(r.left - r.Width(), r.top - r.Height(), r.right + r.Width(), r.bottom + r.Height()));
+        }
+        Objects parts;
+        detection.Detect(src, parts, 3, 0.2, true, regions);
+
+        result = full.size() == parts.size();
+        for (size_t i = 0; i < full.size() && result; ++i)
+            result = full[i].rect == parts[i].rect && full[i].weight == parts[i].weight;
+        if (!result)
+        {
+            TEST_LOG_SS(Error, "Detection with motion regions around found objects (" << parts.size() 
+                << " objects) differs from detection without motion mask (" << full.size() << " objects)!");
+        }
+        return result;
+    }
+
     bool DetectionSpecialTest()
     {
         Detection detection;
@@ -616,7 +725,11 @@ namespace Test
             DetectionSpecialTest(detection, om, 8);
 
         bool result = true;
-        if (os.size() != om.size())
+        if (std::thread::hardware_concurrency() < 2)
+        {
+            TEST_LOG_SS(Info, "Comparison of single and multi thread detection is skipped.");
+        }
+        else if (os.size() != om.size())
             result = false;
         else
         {
@@ -647,7 +760,329 @@ namespace Test
             }
         }
 
+        result = result && DetectionMotionSpecialTest(detection, false);
+        result = result && DetectionMotionSpecialTest(detection, true);
+
         return result;
     }
-}
 
+    static bool DetectionBinaryLoad(const String & name, Detection & xml, Detection & bin, Detection & mem, int tag)
+    {
+        String path = ROOT_PATH + "/data/cascade/" + name + ".xml";
+        double time = GetTime();
+        void * data = SimdDetectionLoadA(path.c_str());
+        double xmlTime = GetTime() - time;
+        if (data == NULL || !xml.Load(path, tag))
+        {
+            TEST_LOG_SS(Error, "Can't load cascade '" << path << "' !");
+            return false;
+        }
+
+        String binPath = name + ".bin";
+        bool result = SimdDetectionSaveBinary(data, binPath.c_str()) != 0;
+        SimdDetectionFree(data);
+        if (!result)
+        {
+            TEST_LOG_SS(Error, "Can't save cascade '" << binPath << "' !");
+            return false;
+        }
+
+        time = GetTime();
+        result = bin.Load(binPath, tag);
+        double binTime = GetTime() - time;
+
+        std::ifstream ifs(binPath.c_str(), std::ios::binary);
+        std::vector<char> buffer((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+        result = result && mem.LoadBinary(buffer.data(), buffer.size(), tag);
+        if (!result)
+        {
+            TEST_LOG_SS(Error, "Can't load binary cascade '" << binPath << "' !");
+            return false;
+        }
+
+        std::vector<char> corrupted(buffer);
+        corrupted[corrupted.size() / 2] ^= 0x10;
+        void * invalid = SimdDetectionLoadBinary(corrupted.data(), corrupted.size());
+        if (invalid == NULL)
+            invalid = SimdDetectionLoadBinary(buffer.data(), buffer.size() - 1);
+        if (invalid != NULL)
+        {
+            SimdDetectionFree(invalid);
+            TEST_LOG_SS(Error, "Corrupted binary cascade '" << binPath << "' was loaded!");
+            return false;
+        }
+
+        TEST_LOG_SS(Info, "Load " << name << " : XML - " << xmlTime * 1000 << " ms, binary - " << binTime * 1000 << " ms (" << buffer.size() << " bytes).");
+
+        return result;
+    }
+
+    static bool DetectionBinaryCompare(const Objects & control, const Objects & current, const String & desc)
+    {
+        bool result = control.size() == current.size();
+        for (size_t i = 0; i < control.size() && result; ++i)
+            result = control[i].rect == current[i].rect && control[i].weight == current[i].weight && control[i].tag == current[i].tag;
+        if (!result)
+        {
+            TEST_LOG_SS(Error, "Detection with " << desc << " cascades (" << current.size() 
+                << " objects) differs from detection with XML cascades (" << control.size() << " objects)!");
+        }
+        return result;
+    }
+
+    bool DetectionBinarySpecialTest()
+    {
+        bool result = true;
+
+        Detection xml, bin, mem;
+        result = result && DetectionBinaryLoad("haar_face_0", xml, bin, mem, 0);
+        result = result && DetectionBinaryLoad("haar_face_1", xml, bin, mem, 1);
+        result = result && DetectionBinaryLoad("lbp_face", xml, bin, mem, 2);
+        if (!result)
+            return result;
+
+        View src = GetSample(Size(W, H), true);
+        xml.Init(src.Size(), 1.2);
+        bin.Init(src.Size(), 1.2);
+        mem.Init(src.Size(), 1.2);
+
+        Objects ox, ob, om;
+        xml.Detect(src, ox);
+        bin.Detect(src, ob);
+        mem.Detect(src, om);
+
+        result = result && DetectionBinaryCompare(ox, ob, "binary file");
+        result = result && DetectionBinaryCompare(ox, om, "memory buffer");
+
+        return result;
+    }
+
+    static bool DetectionHaarInt16Detect(const void * data, const View & src, int int16, View & dst)
+    {
+        size_t w, h;
+        SimdDetectionInfoFlags flags;
+        SimdDetectionInfo(data, &w, &h, &flags);
+
+        View sum(src.width + 1, src.height + 1, View::Int32);
+        View sqsum(src.width + 1, src.height + 1, View::Int32);
+        View tilted(src.width + 1, src.height + 1, View::Int32);
+        if (flags&SimdDetectionInfoHasTilted)
+            Simd::Integral(src, sum, sqsum, tilted);
+        else
+            Simd::Integral(src, sum, sqsum);
+
+        void * hid = SimdDetectionInit(data, sum.data, sum.stride, sum.width, sum.height,
+            sqsum.data, sqsum.stride, tilted.data, tilted.stride, 0, int16);
+        if (hid == NULL)
+            return false;
+        SimdDetectionPrepare(hid);
+
+        View mask(src.Size(), View::Gray8);
+        Simd::Fill(mask, 255);
+        dst.Recreate(src.Size(), View::Gray8);
+        Simd::Fill(dst, 0);
+        if (src.width > w && src.height > h)
+        {
+            if (int16)
+                SimdDetectionHaarDetect16ip(hid, mask.data, mask.stride, 0, 0, src.width - w, src.height - h, dst.data, dst.stride);
+            else
+                SimdDetectionHaarDetect32fp(hid, mask.data, mask.stride, 0, 0, src.width - w, src.height - h, dst.data, dst.stride);
+        }
+        SimdDetectionFree(hid);
+        return true;
+    }
+
+    static bool DetectionHaarInt16SpecialTest(const String & name)
+    {
+        bool result = true;
+
+        String path = ROOT_PATH + "/data/cascade/" + name + ".xml";
+        void * data = SimdDetectionLoadA(path.c_str());
+        if (data == NULL)
+        {
+            TEST_LOG_SS(Error, "Can't load cascade '" << path << "' !");
+            return false;
+        }
+
+        SimdDetectionInfoFlags flags;
+        SimdDetectionInfo(data, NULL, NULL, &flags);
+        if ((flags & SimdDetectionInfoCanInt16) || !(flags & SimdDetectionInfoCanHaarInt16))
+        {
+            TEST_LOG_SS(Error, "HAAR cascade '" << path << "' must report only SimdDetectionInfoCanHaarInt16 flag!");
+            SimdDetectionFree(data);
+            return false;
+        }
+
+        View src = GetSample(Size(W, H), true);
+
+        size_t both = 0, only32f = 0, only16i = 0;
+        const double scales[] = { 1.0, 1.5, 2.0, 3.0 };
+        for (size_t i = 0; i < sizeof(scales) / sizeof(scales[0]) && result; ++i)
+        {
+            View scaled(Size(Size(W, H) / scales[i]), View::Gray8), dst32f, dst16i;
+            Simd::ResizeBilinear(src, scaled);
+            if (!DetectionHaarInt16Detect(data, scaled, 0, dst32f) || !DetectionHaarInt16Detect(data, scaled, 1, dst16i))
+            {
+                TEST_LOG_SS(Error, "Can't init haar cascade '" << name << "' !");
+                result = false;
+                break;
+            }
+            for (size_t row = 0; row < scaled.height; ++row)
+            {
+                for (size_t col = 0; col < scaled.width; ++col)
+                {
+                    bool a = dst32f.At<uint8_t>(col, row) != 0, b = dst16i.At<uint8_t>(col, row) != 0;
+                    both += a && b ? 1 : 0;
+                    only32f += a && !b ? 1 : 0;
+                    only16i += !a && b ? 1 : 0;
+                }
+            }
+        }
+
+        const double jaccardMin = 0.9;
+        double jaccard = both + only32f + only16i > 0 ? double(both) / double(both + only32f + only16i) : 1.0;
+        TEST_LOG_SS(Info, "Haar cascade '" << name << "': 32-bit float and 16-bit integer detections agree in " << both
+            << " windows, " << only32f << " windows only in 32-bit float, " << only16i << " windows only in 16-bit integer (Jaccard index " << jaccard << ").");
+        if (result && jaccard < jaccardMin)
+        {
+            TEST_LOG_SS(Error, "Jaccard index of 16-bit integer and 32-bit float detections with haar cascade '" << name << "' is " << jaccard << " < " << jaccardMin << " !");
+            result = false;
+        }
+
+        const Point shift(3, 5);
+        View full, part;
+        if (result && (!DetectionHaarInt16Detect(data, src, 1, full) || !DetectionHaarInt16Detect(data, src.Region(shift, src.Size()), 1, part)))
+        {
+            TEST_LOG_SS(Error, "Can't init haar cascade '" << name << "' !");
+            result = false;
+        }
+        if (result)
+        {
+            size_t differences = 0;
+            for (size_t row = 0; row < part.height; ++row)
+                for (size_t col = 0; col < part.width; ++col)
+                    differences += (part.At<uint8_t>(col, row) != 0) != (full.At<uint8_t>(col + shift.x, row + shift.y) != 0) ? 1 : 0;
+            if (differences)
+            {
+                TEST_LOG_SS(Error, "16-bit integer detection with haar cascade '" << name << "' depends on image offset: " << differences << " windows differ!");
+                result = false;
+            }
+        }
+
+        SimdDetectionFree(data);
+
+        return result;
+    }
+
+    bool DetectionHaarInt16SpecialTest()
+    {
+        bool result = true;
+
+        result = result && DetectionHaarInt16SpecialTest("haar_face_0");
+        result = result && DetectionHaarInt16SpecialTest("haar_face_1");
+
+        return result;
+    }
+
+    static void DetectionGroupControl(const Objects & src, Objects & dst, int groupSizeMin, double sizeDifferenceMax)
+    {
+        std::vector<int> labels(src.size(), -1);
+        Objects buffer;
+        for (size_t i = 0; i < src.size(); ++i)
+        {
+            if (labels[i] >= 0)
+                continue;
+            labels[i] = (int)buffer.size();
+            std::vector<size_t> stack(1, i);
+            while (stack.size())
+            {
+                const Rect & r1 = src[stack.back()].rect;
+                stack.pop_back();
+                for (size_t j = 0; j < src.size(); ++j)
+                {
+                    const Rect & r2 = src[j].rect;
+                    double delta = sizeDifferenceMax*(std::min(r1.Width(), r2.Width()) + std::min(r1.Height(), r2.Height()))*0.5;
+                    if (labels[j] < 0 && std::abs(r1.left - r2.left) <= delta && std::abs(r1.top - r2.top) <= delta &&
+                        std::abs(r1.right - r2.right) <= delta && std::abs(r1.bottom - r2.bottom) <= delta)
+                    {
+                        labels[j] = labels[i];
+                        stack.push_back(j);
+                    }
+                }
+            }
+            buffer.push_back(Detection::Object(Rect(), 0, src[i].tag));
+        }
+        for (size_t i = 0; i < src.size(); ++i)
+        {
+            buffer[labels[i]].rect += src[i].rect;
+            buffer[labels[i]].weight++;
+        }
+        for (size_t i = 0; i < buffer.size(); i++)
+            buffer[i].rect = buffer[i].rect / double(buffer[i].weight);
+
+        dst.clear();
+        for (size_t i = 0; i < buffer.size(); i++)
+        {
+            const Rect & r1 = buffer[i].rect;
+            int n1 = buffer[i].weight;
+            if (n1 < groupSizeMin)
+                continue;
+            bool suppressed = false;
+            for (size_t j = 0; j < buffer.size() && !suppressed; j++)
+            {
+                const Rect & r2 = buffer[j].rect;
+                int n2 = buffer[j].weight;
+                int dx = Simd::Round(r2.Width() * sizeDifferenceMax);
+                int dy = Simd::Round(r2.Height() * sizeDifferenceMax);
+                suppressed = j != i && n2 >= groupSizeMin && (n2 > std::max(3, n1) || n1 < 3) &&
+                    r1.left >= r2.left - dx && r1.top >= r2.top - dy && r1.right <= r2.right + dx && r1.bottom <= r2.bottom + dy;
+            }
+            if (!suppressed)
+                dst.push_back(buffer[i]);
+        }
+    }
+
+    bool DetectionGroupSpecialTest()
+    {
+        bool result = true;
+
+        Objects src;
+        for (int i = 0; i < 400; ++i)
+        {
+            ptrdiff_t size = 24 + Random(200), x = Random(int(W - size)), y = Random(int(H - size));
+            for (int j = 0, n = Random(40); j < n; ++j)
+            {
+                ptrdiff_t s = size + Random(int(size / 5)) - size / 10;
+                ptrdiff_t l = x + Random(int(s / 5)) - s / 10, t = y + Random(int(s / 5)) - s / 10;
+                src.push_back(Detection::Object(Rect(l, t, l + s, t + s), 1, 0));
+            }
+        }
+        for (int i = 0; i < 2000; ++i)
+        {
+            ptrdiff_t s = 24 + Random(200), l = Random(int(W - s)), t = Random(int(H - s));
+            src.push_back(Detection::Object(Rect(l, t, l + s, t + s), 1, 0));
+        }
+
+        Detection detection;
+        Objects control, current;
+        double time = GetTime();
+        DetectionGroupControl(src, control, 3, 0.2);
+        double controlTime = GetTime() - time;
+        time = GetTime();
+        detection.Group(src, current, 3, 0.2);
+        double currentTime = GetTime() - time;
+
+        TEST_LOG_SS(Info, "Group " << src.size() << " elementary detections to " << current.size() << " objects : Detection::Group - "
+            << currentTime * 1000 << " ms, control (all pairs) - " << controlTime * 1000 << " ms.");
+
+        result = control.size() == current.size();
+        for (size_t i = 0; i < control.size() && result; ++i)
+            result = control[i].rect == current[i].rect && control[i].weight == current[i].weight;
+        if (!result)
+        {
+            TEST_LOG_SS(Error, "Detection::Group (" << current.size() << " objects) differs from control grouping (" << control.size() << " objects)!");
+        }
+
+        return result;
+    }
+}
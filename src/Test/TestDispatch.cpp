@@ -0,0 +1,147 @@
+/*
+* Tests for Simd Library (http://ermig1979.github.io/Simd).
+*
+* Copyright (c) 2011-2017 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#include "Test/TestUtils.h"
+#include "Test/TestPerformance.h"
+
+namespace Test
+{
+    namespace
+    {
+        const char * DISPATCH_NAMES[] = 
+        {
+            "SimdAbsDifferenceSum", "SimdAbsDifferenceSumMasked", "SimdCrc32c", "SimdDetectionHaarDetect16ii", "SimdDetectionHaarDetect16ip",
+            "SimdDetectionHaarDetect32fi", "SimdDetectionHaarDetect32fp", "SimdDetectionLbpDetect16ii", "SimdDetectionLbpDetect16ip",
+            "SimdDetectionLbpDetect32fi", "SimdDetectionLbpDetect32fp",
+            "SimdResizeBilinear", "SimdSquaredDifferenceSum", "SimdSquaredDifferenceSumMasked", "SimdSquareSum", "SimdValueSum",
+        };
+        const size_t DISPATCH_SIZE = sizeof(DISPATCH_NAMES) / sizeof(DISPATCH_NAMES[0]);
+
+        String IsaName(int info)
+        {
+            static const char * names[] = { "Sse", "Sse2", "Sse3", "Ssse3", "Sse41", "Sse42", "Avx", "Avx2", "Avx512f", "Avx512bw", "Vmx", "Vsx", "Neon", "Msa" };
+            for (int i = 0; i <= SimdCpuInfoMsa; ++i)
+                if (info == (1 << i))
+                    return names[i];
+            return "Base";
+        }
+
+        uint64_t SquaredDifferenceSum16x16(const View & a, const View & b, size_t count, const String & desc)
+        {
+            uint64_t sum = 0, total = 0;
+            TEST_PERFORMANCE_TEST(desc);
+            for (size_t i = 0; i < count; ++i)
+            {
+                size_t x = (i * 16) % (a.width - 16), y = (i * 16 / (a.width - 16) * 16) % (a.height - 16);
+                SimdSquaredDifferenceSum(a.data + y*a.stride + x, a.stride, b.data + y*b.stride + x, b.stride, 16, 16, &sum);
+                total += sum;
+            }
+            return total;
+        }
+    }
+
+    bool DispatchSpecialTest()
+    {
+        bool result = true;
+
+        TEST_LOG_SS(Info, "Test of dispatch tables.");
+
+        const int cpuInfo = SimdCpuInfo();
+        std::vector<int> defaults(DISPATCH_SIZE);
+        for (size_t i = 0; i < DISPATCH_SIZE && result; ++i)
+        {
+            defaults[i] = SimdDispatchInfo(DISPATCH_NAMES[i]);
+            TEST_LOG_SS(Info, DISPATCH_NAMES[i] << " uses " << IsaName(defaults[i]) << ".");
+            if (defaults[i] < 0 || (defaults[i] & ~cpuInfo))
+            {
+                TEST_LOG_SS(Error, DISPATCH_NAMES[i] << " : wrong dispatch info " << defaults[i] << " (CPU info " << cpuInfo << ")!");
+                result = false;
+            }
+        }
+
+        if (result && (SimdDispatchInfo("SimdUnknownFunction") != -1 || SimdSetDispatchMask("SimdUnknownFunction", 0) != 0))
+        {
+            TEST_LOG_SS(Error, "Wrong processing of unknown function name!");
+            result = false;
+        }
+
+        if (result && (SimdDispatchInfo("SimdNeuralProductSum") != -1 || SimdSetDispatchMask("SimdNeuralProductSum", 0) != 0))
+        {
+            TEST_LOG_SS(Error, "Wrong processing of function without dispatch table!");
+            result = false;
+        }
+
+        View a(W, H, View::Gray8, NULL, TEST_ALIGN(W)), b(W, H, View::Gray8, NULL, TEST_ALIGN(W));
+        FillRandom(a);
+        FillRandom(b);
+        const size_t count = 100000;
+        uint64_t control = SquaredDifferenceSum16x16(a, b, count, "SquaredDifferenceSum16x16<" + IsaName(defaults[10]) + ">");
+        for (int isa = 0; isa <= SimdCpuInfoMsa && result; ++isa)
+        {
+            if ((cpuInfo & (1 << isa)) == 0 || SimdSetDispatchMask("SimdSquaredDifferenceSum", 1 << isa) != 1)
+                continue;
+            int info = SimdDispatchInfo("SimdSquaredDifferenceSum");
+            if (info && info != (1 << isa))
+            {
+                TEST_LOG_SS(Error, "SimdSquaredDifferenceSum : mask " << (1 << isa) << " gives dispatch info " << info << "!");
+                result = false;
+            }
+            if (SquaredDifferenceSum16x16(a, b, count, "SquaredDifferenceSum16x16<" + IsaName(info) + ">") != control)
+            {
+                TEST_LOG_SS(Error, "SimdSquaredDifferenceSum : wrong result for " << IsaName(info) << "!");
+                result = false;
+            }
+        }
+
+        if (result && SimdSetDispatchMask(NULL, 0) != (int)DISPATCH_SIZE)
+        {
+            TEST_LOG_SS(Error, "SimdSetDispatchMask(NULL, 0) must change all dispatch tables!");
+            result = false;
+        }
+        for (size_t i = 0; i < DISPATCH_SIZE && result; ++i)
+        {
+            if (SimdDispatchInfo(DISPATCH_NAMES[i]) != 0)
+            {
+                TEST_LOG_SS(Error, DISPATCH_NAMES[i] << " does not use base implementation for zero mask!");
+                result = false;
+            }
+        }
+        if (result && SquaredDifferenceSum16x16(a, b, count, "SquaredDifferenceSum16x16<Base>") != control)
+        {
+            TEST_LOG_SS(Error, "SimdSquaredDifferenceSum : wrong result for Base!");
+            result = false;
+        }
+
+        SimdSetDispatchMask(NULL, -1);
+        for (size_t i = 0; i < DISPATCH_SIZE && result; ++i)
+        {
+            if (SimdDispatchInfo(DISPATCH_NAMES[i]) != defaults[i])
+            {
+                TEST_LOG_SS(Error, DISPATCH_NAMES[i] << " : default dispatch table was not restored!");
+                result = false;
+            }
+        }
+
+        return result;
+    }
+}
@@ -262,6 +262,82 @@ namespace Test
         return result;
     }
 
+    struct FuncPS
+    {
+        typedef void(*FuncPtr)(const float * a, const uint16_t * b, size_t size, float * sum);
+
+        FuncPtr func;
+        String description;
+
+        FuncPS(const FuncPtr & f, const String & d) : func(f), description(d) {}
+
+        void Call(const View & a, const View & b, float * sum) const
+        {
+            TEST_PERFORMANCE_TEST(description);
+            func((const float*)a.data, (const uint16_t*)b.data, a.width, sum);
+        }
+    };
+
+#define FUNC_PS(function) FuncPS(function, #function)
+
+    bool NeuralProductSum16fAutoTest(int size, float eps, const FuncPS & f1, const FuncPS & f2)
+    {
+        bool result = true;
+
+        TEST_LOG_SS(Info, "Test " << f1.description << " & " << f2.description << " [" << size << "].");
+
+        View a(size, 1, View::Float, NULL, TEST_ALIGN(size));
+        FillRandom32f(a, -10.0, 10.0);
+
+        View bOrigin(size, 1, View::Float, NULL, TEST_ALIGN(size));
+        FillRandom32f(bOrigin, -10.0, 10.0);
+        View b(size, 1, View::Int16, NULL, TEST_ALIGN(size));
+        ::SimdFloat32ToFloat16((float*)bOrigin.data, b.width, (uint16_t*)b.data);
+        ::SimdFloat16ToFloat32((uint16_t*)b.data, b.width, (float*)bOrigin.data);
+
+        float s1, s2, s3;
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(f1.Call(a, b, &s1));
+
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(f2.Call(a, b, &s2));
+
+        ::SimdNeuralProductSum((float*)a.data, (float*)bOrigin.data, a.width, &s3);
+
+        result = result && Compare(s1, s2, eps, true, "s1 & s2");
+        result = result && Compare(s2, s3, eps, true, "s2 & s3");
+
+        return result;
+    }
+
+    bool NeuralProductSum16fAutoTest(float eps, const FuncPS & f1, const FuncPS & f2)
+    {
+        bool result = true;
+
+        result = result && NeuralProductSum16fAutoTest(W*H, eps, f1, f2);
+        result = result && NeuralProductSum16fAutoTest(W*H - O, eps, f1, f2);
+        result = result && NeuralProductSum16fAutoTest(O - 1, eps, f1, f2);
+
+        return result;
+    }
+
+    bool NeuralProductSum16fAutoTest()
+    {
+        bool result = true;
+
+        result = result && NeuralProductSum16fAutoTest(EPS, FUNC_PS(Simd::Base::NeuralProductSum16f), FUNC_PS(SimdNeuralProductSum16f));
+
+#ifdef SIMD_AVX2_ENABLE
+        if (Simd::Avx2::Enable)
+            result = result && NeuralProductSum16fAutoTest(EPS, FUNC_PS(Simd::Avx2::NeuralProductSum16f), FUNC_PS(SimdNeuralProductSum16f));
+#endif
+
+#ifdef SIMD_AVX512BW_ENABLE
+        if (Simd::Avx512bw::Enable)
+            result = result && NeuralProductSum16fAutoTest(EPS, FUNC_PS(Simd::Avx512bw::NeuralProductSum16f), FUNC_PS(SimdNeuralProductSum16f));
+#endif
+
+        return result;
+    }
+
     //-----------------------------------------------------------------------
 
     bool Float32ToFloat16DataTest(bool create, size_t size, const FuncSH & f)
@@ -415,4 +491,58 @@ namespace Test
 
         return result;
     }
+
+    bool NeuralProductSum16fDataTest(bool create, int size, float eps, const FuncPS & f)
+    {
+        bool result = true;
+
+        Data data(f.description);
+
+        TEST_LOG_SS(Info, (create ? "Create" : "Verify") << " test " << f.description << " [" << size << "].");
+
+        View a(size, 1, View::Float, NULL, TEST_ALIGN(size));
+        View b(size, 1, View::Int16, NULL, TEST_ALIGN(size));
+
+        float s1, s2;
+
+        if (create)
+        {
+            FillRandom32f(a, -10.0, 10.0);
+
+            View bOrigin(size, 1, View::Float, NULL, TEST_ALIGN(size));
+            FillRandom32f(bOrigin, -10.0, 10.0);
+            ::SimdFloat32ToFloat16((float*)bOrigin.data, b.width, (uint16_t*)b.data);
+
+            TEST_SAVE(a);
+            TEST_SAVE(b);
+
+            f.Call(a, b, &s1);
+
+            TEST_SAVE(s1);
+        }
+        else
+        {
+            TEST_LOAD(a);
+            TEST_LOAD(b);
+
+            TEST_LOAD(s1);
+
+            f.Call(a, b, &s2);
+
+            TEST_SAVE(s2);
+
+            result = result && Compare(s1, s2, eps, true);
+        }
+
+        return result;
+    }
+
+    bool NeuralProductSum16fDataTest(bool create)
+    {
+        bool result = true;
+
+        result = result && NeuralProductSum16fDataTest(create, DH, EPS, FUNC_PS(SimdNeuralProductSum16f));
+
+        return result;
+    }
 }
@@ -96,4 +96,225 @@ namespace Test
 
         return true;
     }
+
+    void FillMotionFrame(Frame & frame, const View & background, size_t stream, size_t index)
+    {
+        Simd::Copy(background, frame.planes[0]);
+        ptrdiff_t size = frame.height / 8, step = 4 + stream;
+        ptrdiff_t x = (index*step) % (frame.width - size), y = frame.height / 2 - size / 2;
+        Simd::FillBgr(frame.planes[0].Region(x, y, x + size, y + size).Ref(), 255, 255, 255);
+        frame.timestamp = index*0.04;
+    }
+
+    bool MotionEngineSpecialTest()
+    {
+        bool result = true;
+
+        const size_t streamCount = 8, frameCount = 100, threadNumber = std::thread::hardware_concurrency();
+
+        TEST_LOG_SS(Info, "Test Simd::Motion::Engine for " << streamCount << " streams [" << W << ", " << H << "] and " << threadNumber << " threads.");
+
+        View background(W, H, View::Bgr24);
+        FillRandom(background, 0, 64);
+
+        Simd::Motion::Engine engine(threadNumber);
+        std::vector<Simd::Motion::Detector> detectors(streamCount);
+        for (size_t i = 0; i < streamCount; ++i)
+            engine.AddStream();
+
+        Simd::Motion::Frames inputs(streamCount), outputs(streamCount), controls(streamCount);
+        for (size_t i = 0; i < streamCount; ++i)
+        {
+            inputs[i].Recreate(W, H, Frame::Bgr24);
+            outputs[i].Recreate(W, H, Frame::Bgr24);
+            controls[i].Recreate(W, H, Frame::Bgr24);
+        }
+
+        Simd::Motion::Metadatas metadatas(streamCount);
+        for (size_t f = 0; f < frameCount && result; ++f)
+        {
+            Simd::Motion::Frames frames(streamCount);
+            for (size_t i = 0; i < streamCount; ++i)
+            {
+                FillMotionFrame(inputs[i], background, i, f);
+                Simd::Copy(inputs[i].planes[0], outputs[i].planes[0]);
+                Simd::Copy(inputs[i].planes[0], controls[i].planes[0]);
+                if ((f + i) % 7 != 3)
+                    frames[i] = inputs[i];
+                metadatas[i].sabotage = true;
+                metadatas[i].objects.resize(1);
+            }
+
+            {
+                TEST_PERFORMANCE_TEST("Engine");
+                result = engine.NextFrames(frames, metadatas, &outputs);
+            }
+
+            for (size_t i = 0; i < streamCount && result; ++i)
+            {
+                Simd::Motion::Metadata metadata;
+                if (frames[i].format != Frame::None)
+                {
+                    TEST_PERFORMANCE_TEST("Detector");
+                    detectors[i].NextFrame(inputs[i], metadata, &controls[i]);
+                }
+                if (!Compare(outputs[i].planes[0], controls[i].planes[0], 0, true, 64))
+                {
+                    TEST_LOG_SS(Error, "Engine output of stream " << i << " at frame " << f << " differs from the output of single detector!");
+                    result = false;
+                }
+                if (metadatas[i].sabotage != metadata.sabotage || metadatas[i].objects.size() != metadata.objects.size())
+                {
+                    TEST_LOG_SS(Error, "Engine metadata of stream " << i << " at frame " << f << " differs from the metadata of single detector!");
+                    result = false;
+                }
+            }
+        }
+
+        for (size_t i = 0; i < streamCount; ++i)
+        {
+            const Simd::Motion::Engine::Latency & latency = engine.StreamLatency(i);
+            TEST_LOG_SS(Info, std::fixed << std::setprecision(3) << "Stream " << i << " latency: last = " << latency.last * 1000.0
+                << " ms, average = " << latency.average * 1000.0 << " ms, max = " << latency.max * 1000.0 << " ms.");
+        }
+
+#ifdef TEST_PERFORMANCE_TEST_ENABLE
+        TEST_LOG_SS(Info, PerformanceMeasurerStorage::s_storage.TextReport(false, true));
+        PerformanceMeasurerStorage::s_storage.Clear();
+#endif
+
+        return result;
+    }
+
+    void FillStabilityScene(View & view, const uint8_t * levels)
+    {
+        size_t w = view.width / 2, h = view.height / 2;
+        for (size_t i = 0; i < 4; ++i)
+        {
+            size_t x = (i & 1)*w, y = (i >> 1)*h;
+            Simd::FillBgr(view.Region(x, y, x + w, y + h).Ref(), levels[i], levels[i], levels[i]);
+        }
+    }
+
+    bool MotionStabilitySpecialTest()
+    {
+        bool result = true;
+
+        const size_t frameCount = 150, coverBegin = 50, moveBegin = 80, settleTime = 5;
+
+        TEST_LOG_SS(Info, "Test scene stability of Simd::Motion::Detector [" << W << ", " << H << "].");
+
+        const uint8_t levelsA[4] = { 32, 224, 96, 160 }, levelsB[4] = { 224, 32, 160, 96 };
+        View sceneA(W, H, View::Bgr24), sceneB(W, H, View::Bgr24), cover(W, H, View::Bgr24);
+        FillStabilityScene(sceneA, levelsA);
+        FillStabilityScene(sceneB, levelsB);
+        Simd::FillBgr(cover, 128, 128, 128);
+
+        Simd::Motion::Detector detector;
+        Frame input(W, H, Frame::Bgr24);
+        for (size_t f = 0; f < frameCount && result; ++f)
+        {
+            const View & scene = f < coverBegin ? sceneA : (f < moveBegin ? cover : sceneB);
+            FillMotionFrame(input, scene, 0, f);
+
+            Simd::Motion::Metadata metadata;
+            detector.NextFrame(input, metadata);
+
+            bool expected = f == coverBegin || f == moveBegin;
+            bool ignored = (f > coverBegin && f < moveBegin) || (f > moveBegin && f < moveBegin + settleTime);
+            if (!ignored && metadata.sabotage != expected)
+            {
+                TEST_LOG_SS(Error, "Frame " << f << ": sabotage = " << metadata.sabotage << " but expected " << expected << "!");
+                result = false;
+            }
+        }
+
+        return result;
+    }
+
+    bool MotionReduceSpecialTest()
+    {
+        bool result = true;
+
+        const size_t frameCount = 50;
+
+        TEST_LOG_SS(Info, "Test Simd::Motion::Detector with reduced NV12 input [" << W << ", " << H << "].");
+
+        View background(W, H, View::Gray8);
+        FillRandom(background, 0, 64);
+
+        Simd::Motion::Options options;
+        options.DebugAnnotateMovingRegions = false;
+        options.DebugDrawBottomRight = 1;
+        options.DebugDrawLevel = 0;
+
+        Simd::Motion::Detector full, reduced, switched, restarted;
+        options.FrameReduceCount = 2;
+        switched.SetOptions(options);
+        options.FrameReduceCount = 1;
+        full.SetOptions(options);
+        restarted.SetOptions(options);
+        options.FrameReduceCount = 0;
+        reduced.SetOptions(options);
+
+        Frame input(W, H, Frame::Nv12), control(Simd::Scale(input.Size()), Frame::Gray8);
+        Frame output(input.Size(), Frame::Bgr24), controlOutput(control.Size(), Frame::Bgr24);
+        Frame switchedOutput(input.Size(), Frame::Bgr24), restartedOutput(input.Size(), Frame::Bgr24);
+        Simd::Fill(input.planes[1], 128);
+        for (size_t f = 0; f < frameCount && result; ++f)
+        {
+            ptrdiff_t size = H / 8, x = (f * 8) % (W - size), y = H / 2 - size / 2;
+            Simd::Copy(background, input.planes[0]);
+            Simd::Fill(input.planes[0].Region(x, y, x + size, y + size).Ref(), 255);
+            input.timestamp = f*0.04;
+
+            Simd::ReduceGray4x4(input.planes[0], control.planes[0]);
+            control.timestamp = input.timestamp;
+
+            Simd::Fill(output.planes[0], 0);
+            Simd::Fill(controlOutput.planes[0], 0);
+
+            Simd::Motion::Metadata metadata, controlMetadata;
+            {
+                TEST_PERFORMANCE_TEST("Nv12Reduced");
+                full.NextFrame(input, metadata, &output);
+            }
+            reduced.NextFrame(control, controlMetadata, &controlOutput);
+
+            View difference = output.planes[0].Region(control.Size(), View::BottomRight);
+            View controlDifference = controlOutput.planes[0].Region(control.Size(), View::BottomRight);
+            if (!Compare(difference, controlDifference, 0, true, 64) || metadata.sabotage != controlMetadata.sabotage)
+            {
+                TEST_LOG_SS(Error, "Detector with reduced NV12 input differs from detector with reduced gray input at frame " << f << "!");
+                result = false;
+            }
+
+            if (f == frameCount / 2)
+            {
+                options.FrameReduceCount = 1;
+                switched.SetOptions(options);
+            }
+            Simd::Fill(switchedOutput.planes[0], 0);
+            Simd::Motion::Metadata switchedMetadata;
+            switched.NextFrame(input, switchedMetadata, &switchedOutput);
+            if (f >= frameCount / 2)
+            {
+                Simd::Fill(restartedOutput.planes[0], 0);
+                Simd::Motion::Metadata restartedMetadata;
+                restarted.NextFrame(input, restartedMetadata, &restartedOutput);
+                if (!Compare(switchedOutput.planes[0], restartedOutput.planes[0], 0, true, 64) || switchedMetadata.objects.size() != restartedMetadata.objects.size())
+                {
+                    TEST_LOG_SS(Error, "Detector after change of FrameReduceCount differs from new detector at frame " << f << "!");
+                    result = false;
+                }
+            }
+        }
+
+#ifdef TEST_PERFORMANCE_TEST_ENABLE
+        TEST_LOG_SS(Info, PerformanceMeasurerStorage::s_storage.TextReport(false, true));
+        PerformanceMeasurerStorage::s_storage.Clear();
+#endif
+
+        return result;
+    }
 }
@@ -229,6 +229,88 @@ namespace Test
         return result;
     }
 
+    namespace
+    {
+        struct FuncPS8i
+        {
+            typedef void(*FuncPtr)(size_t M, size_t N, size_t K, const int8_t * a, const uint8_t * b, int32_t * c);
+
+            FuncPtr func;
+            String description;
+
+            FuncPS8i(const FuncPtr & f, const String & d) : func(f), description(d) {}
+
+            void Call(size_t M, size_t N, size_t K, const View & a, const View & b, View & c) const
+            {
+                TEST_PERFORMANCE_TEST(description);
+                func(M, N, K, (int8_t*)a.data, b.data, (int32_t*)c.data);
+            }
+        };
+    }
+#define FUNC_PS8I(function) FuncPS8i(function, #function)
+
+    void FillRandom8i(View & a)
+    {
+        FillRandom(a, 0, 128);
+        for (size_t i = 0; i < a.width; ++i)
+            a.data[i] -= 64;
+    }
+
+    bool NeuralProductSum8iAutoTest(size_t M, size_t N, size_t K, const FuncPS8i & f1, const FuncPS8i & f2)
+    {
+        bool result = true;
+
+        TEST_LOG_SS(Info, "Test " << f1.description << " & " << f2.description << " [" << M << ", " << N << ", " << K << "].");
+
+        View a(M*K, 1, View::Gray8, NULL, TEST_ALIGN(M*K));
+        FillRandom8i(a);
+
+        View b(N*K, 1, View::Gray8, NULL, TEST_ALIGN(N*K));
+        FillRandom(b);
+
+        View c1(M*N, 1, View::Int32, NULL, TEST_ALIGN(M*N));
+        View c2(M*N, 1, View::Int32, NULL, TEST_ALIGN(M*N));
+
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(f1.Call(M, N, K, a, b, c1));
+
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(f2.Call(M, N, K, a, b, c2));
+
+        result = result && Compare(c1, c2, 0, true, 32);
+
+        return result;
+    }
+
+    bool NeuralProductSum8iAutoTest(const FuncPS8i & f1, const FuncPS8i & f2)
+    {
+        bool result = true;
+
+        result = result && NeuralProductSum8iAutoTest(256, 1, 1024, f1, f2);
+        result = result && NeuralProductSum8iAutoTest(64, 196, 288, f1, f2);
+        result = result && NeuralProductSum8iAutoTest(30, 99, 75, f1, f2);
+        result = result && NeuralProductSum8iAutoTest(13, 17, 25, f1, f2);
+
+        return result;
+    }
+
+    bool NeuralProductSum8iAutoTest()
+    {
+        bool result = true;
+
+        result = result && NeuralProductSum8iAutoTest(FUNC_PS8I(Simd::Base::NeuralProductSum8i), FUNC_PS8I(SimdNeuralProductSum8i));
+
+#ifdef SIMD_AVX2_ENABLE
+        if (Simd::Avx2::Enable)
+            result = result && NeuralProductSum8iAutoTest(FUNC_PS8I(Simd::Avx2::NeuralProductSum8i), FUNC_PS8I(SimdNeuralProductSum8i));
+#endif
+
+#ifdef SIMD_AVX512BW_ENABLE
+        if (Simd::Avx512bw::Enable)
+            result = result && NeuralProductSum8iAutoTest(FUNC_PS8I(Simd::Avx512bw::NeuralProductSum8i), FUNC_PS8I(SimdNeuralProductSum8i));
+#endif
+
+        return result;
+    }
+
     namespace
     {
         struct FuncAVMV
@@ -1773,7 +1855,7 @@ namespace Test
     }
 #define FUNC_CF(function) FuncCF(function, #function)
 
-    bool NeuralConvolutionForwardAutoTest(const Index & srcIndex, const Size & kernel, const Size & pad, const Size & stride, const Size & dilation, int add, float eps, FuncCF f1, FuncCF f2)
+    template<class Func1, class Func2> bool NeuralConvolutionForwardAutoTest(const Index & srcIndex, const Size & kernel, const Size & pad, const Size & stride, const Size & dilation, int add, float eps, Func1 f1, Func2 f2)
     {
         bool result = true;
 
@@ -1829,6 +1911,8 @@ namespace Test
         result = result && NeuralConvolutionForwardAutoTest(Index(16, 16, 256), _3, _1, _1, _1, 1, eps, f1, f2);
         result = result && NeuralConvolutionForwardAutoTest(Index(8, 8, 512), _3, _1, _1, _1, 1, eps, f1, f2);
         result = result && NeuralConvolutionForwardAutoTest(Index(4, 4, 1024), _3, _1, _1, _1, 1, eps, f1, f2);
+        result = result && NeuralConvolutionForwardAutoTest(Index(29, 31, 48), _3, _1, _1, _1, 1, eps, f1, f2);
+        result = result && NeuralConvolutionForwardAutoTest(Index(15, 17, 40), _3, _0, _1, _1, 0, eps, f1, f2);
 
         result = result && NeuralConvolutionForwardAutoTest(Index(256, 256, 10), _5, _2, _1, _1, 1, eps, f1, f2);
         result = result && NeuralConvolutionForwardAutoTest(Index(128, 128, 20), _5, _2, _1, _1, 1, eps, f1, f2);
@@ -1874,6 +1958,133 @@ namespace Test
         return result;
     }
 
+    namespace
+    {
+        struct FuncCR
+        {
+            typedef void*(*FuncPtr)(size_t srcWidth, size_t srcHeight, size_t srcDepth, const float * weight, size_t kernelX, size_t kernelY, 
+                size_t padX, size_t padY, size_t strideX, size_t strideY, size_t dilationX, size_t dilationY, size_t dstWidth, size_t dstHeight, size_t dstDepth,
+                const float * bias, SimdNeuralActivationType activation, const float * slope);
+
+            FuncPtr func;
+            String description;
+            bool bias;
+            SimdNeuralActivationType activation;
+            float slope;
+
+            FuncCR(const FuncPtr & f, const String & d) : func(f), description(d), bias(false), activation(SimdNeuralActivationIdentity), slope(1.0f) {}
+
+            void Update(const Index & srcIndex, const Size & kernel, const Size & pad, const Size & stride, const Size & dilation, const Index & dstIndex, int add)
+            {
+                std::stringstream ss;
+                ss << description;
+                ss << "[" << srcIndex.width << "x" << srcIndex.height << "x" << srcIndex.depth;
+                ss << "-" << kernel.x << "x" << kernel.y << "-" << pad.x << "-" << stride.x << "]";
+                if (bias || activation != SimdNeuralActivationIdentity)
+                    ss << "[" << (bias ? "b" : "") << activation << "]";
+                description = ss.str();
+            }
+
+            void Call(const Vector & src, const Index & srcIndex, const Vector & weight, const Size & kernel, const Size & pad, const Size & stride, const Size & dilation,
+                Vector & buffer, const Vector & dstSrc, Vector & dstDst, const Index & dstIndex, int add) const
+            {
+                void * context = func(srcIndex.width, srcIndex.height, srcIndex.depth, weight.data(), kernel.x, kernel.y, 
+                    pad.x, pad.y, stride.x, stride.y, dilation.x, dilation.y, dstIndex.width, dstIndex.height, dstIndex.depth, 
+                    bias ? weight.data() : NULL, activation, &slope);
+                if (add)
+                    memcpy(dstDst.data(), dstSrc.data(), dstDst.size() * sizeof(float));
+                size_t size = buffer.size() * sizeof(float);
+                {
+                    TEST_PERFORMANCE_TEST(description);
+                    SimdNeuralConvolutionRun(context, src.data(), buffer.data(), &size, dstDst.data(), add);
+                }
+                SimdNeuralConvolutionFree(context);
+            }
+        };
+    }
+#define FUNC_CR(function) FuncCR(function, #function)
+
+    bool NeuralConvolutionRunAutoTest(float eps, const FuncCF & f1, const FuncCR & f2)
+    {
+        bool result = true;
+        Size _0(0, 0), _1(1, 1), _2(2, 2), _3(3, 3), _5(5, 5);
+
+        result = result && NeuralConvolutionForwardAutoTest(Index(64, 64, 192), _1, _0, _1, _1, 0, eps, f1, f2);
+        result = result && NeuralConvolutionForwardAutoTest(Index(64, 64, 64), _3, _1, _1, _1, 1, eps, f1, f2);
+        result = result && NeuralConvolutionForwardAutoTest(Index(16, 16, 256), _3, _1, _1, _1, 0, eps, f1, f2);
+        result = result && NeuralConvolutionForwardAutoTest(Index(32, 32, 80), _5, _2, _1, _1, 1, eps, f1, f2);
+        result = result && NeuralConvolutionForwardAutoTest(Index(4, 4, 640), _5, _2, _1, _1, 1, eps, f1, f2);
+
+        return result;
+    }
+
+    bool NeuralConvolutionRunAutoTest(float eps, FuncCR f1, FuncCR f2)
+    {
+        bool result = true;
+        Size _0(0, 0), _1(1, 1), _2(2, 2), _3(3, 3), _5(5, 5);
+        const SimdNeuralActivationType types[4] = { SimdNeuralActivationIdentity, SimdNeuralActivationTanh, SimdNeuralActivationSigmoid, SimdNeuralActivationRelu };
+        const float slopes[4] = { 1.0f, 1.0f, 1.0f, 0.01f };
+
+        for (size_t i = 0; i < 4; ++i)
+        {
+            f1.bias = f2.bias = true;
+            f1.activation = f2.activation = types[i];
+            f1.slope = f2.slope = slopes[i];
+            result = result && NeuralConvolutionForwardAutoTest(Index(32, 32, 64), _1, _0, _1, _1, 0, eps, f1, f2);
+            result = result && NeuralConvolutionForwardAutoTest(Index(64, 64, 16), _3, _1, _1, _1, 0, eps, f1, f2);
+            result = result && NeuralConvolutionForwardAutoTest(Index(17, 15, 30), _3, _1, _1, _1, 1, eps, f1, f2);
+            result = result && NeuralConvolutionForwardAutoTest(Index(23, 21, 40), _3, _1, _1, _1, 0, eps, f1, f2);
+            result = result && NeuralConvolutionForwardAutoTest(Index(8, 8, 80), _5, _2, _1, _1, 0, eps, f1, f2);
+        }
+
+        return result;
+    }
+
+    bool NeuralConvolutionRunAutoTest()
+    {
+        bool result = true;
+
+        result = result && NeuralConvolutionRunAutoTest(EPS, FUNC_CF(Simd::Base::NeuralConvolutionForward), FUNC_CR(Simd::Base::NeuralConvolutionInit));
+
+        result = result && NeuralConvolutionRunAutoTest(EPS, FUNC_CF(SimdNeuralConvolutionForward), FUNC_CR(SimdNeuralConvolutionInit));
+
+        result = result && NeuralConvolutionRunAutoTest(EPS, FUNC_CR(Simd::Base::NeuralConvolutionInit), FUNC_CR(SimdNeuralConvolutionInit));
+
+#ifdef SIMD_SSE3_ENABLE
+        if (Simd::Sse3::Enable)
+        {
+            result = result && NeuralConvolutionRunAutoTest(EPS, FUNC_CF(Simd::Sse3::NeuralConvolutionForward), FUNC_CR(Simd::Sse3::NeuralConvolutionInit));
+            result = result && NeuralConvolutionRunAutoTest(EPS, FUNC_CR(Simd::Base::NeuralConvolutionInit), FUNC_CR(Simd::Sse3::NeuralConvolutionInit));
+        }
+#endif
+
+#ifdef SIMD_AVX_ENABLE
+        if (Simd::Avx::Enable)
+        {
+            result = result && NeuralConvolutionRunAutoTest(EPS, FUNC_CF(Simd::Avx::NeuralConvolutionForward), FUNC_CR(Simd::Avx::NeuralConvolutionInit));
+            result = result && NeuralConvolutionRunAutoTest(EPS, FUNC_CR(Simd::Base::NeuralConvolutionInit), FUNC_CR(Simd::Avx::NeuralConvolutionInit));
+        }
+#endif
+
+#ifdef SIMD_AVX2_ENABLE
+        if (Simd::Avx2::Enable)
+        {
+            result = result && NeuralConvolutionRunAutoTest(EPS, FUNC_CF(Simd::Avx2::NeuralConvolutionForward), FUNC_CR(Simd::Avx2::NeuralConvolutionInit));
+            result = result && NeuralConvolutionRunAutoTest(EPS, FUNC_CR(Simd::Base::NeuralConvolutionInit), FUNC_CR(Simd::Avx2::NeuralConvolutionInit));
+        }
+#endif
+
+#ifdef SIMD_AVX512F_ENABLE
+        if (Simd::Avx512f::Enable)
+        {
+            result = result && NeuralConvolutionRunAutoTest(EPS, FUNC_CF(Simd::Avx512f::NeuralConvolutionForward), FUNC_CR(Simd::Avx512f::NeuralConvolutionInit));
+            result = result && NeuralConvolutionRunAutoTest(EPS, FUNC_CR(Simd::Base::NeuralConvolutionInit), FUNC_CR(Simd::Avx512f::NeuralConvolutionInit));
+        }
+#endif
+
+        return result;
+    }
+
     //-----------------------------------------------------------------------
 
     bool NeuralConvertDataTest(bool create, int width, int height, float eps, const FuncC1 & f)
@@ -1976,6 +2187,58 @@ namespace Test
         return result;
     }
 
+    bool NeuralProductSum8iDataTest(bool create, size_t M, size_t N, size_t K, const FuncPS8i & f)
+    {
+        bool result = true;
+
+        Data data(f.description);
+
+        TEST_LOG_SS(Info, (create ? "Create" : "Verify") << " test " << f.description << " [" << M << ", " << N << ", " << K << "].");
+
+        View a(M*K, 1, View::Gray8, NULL, TEST_ALIGN(M*K));
+        View b(N*K, 1, View::Gray8, NULL, TEST_ALIGN(N*K));
+
+        View c1(M*N, 1, View::Int32, NULL, TEST_ALIGN(M*N));
+        View c2(M*N, 1, View::Int32, NULL, TEST_ALIGN(M*N));
+
+        if (create)
+        {
+            FillRandom8i(a);
+            FillRandom(b);
+
+            TEST_SAVE(a);
+            TEST_SAVE(b);
+
+            f.Call(M, N, K, a, b, c1);
+
+            TEST_SAVE(c1);
+        }
+        else
+        {
+            TEST_LOAD(a);
+            TEST_LOAD(b);
+
+            TEST_LOAD(c1);
+
+            f.Call(M, N, K, a, b, c2);
+
+            TEST_SAVE(c2);
+
+            result = result && Compare(c1, c2, 0, true, 32);
+        }
+
+        return result;
+    }
+
+    bool NeuralProductSum8iDataTest(bool create)
+    {
+        bool result = true;
+
+        result = result && NeuralProductSum8iDataTest(create, 30, 99, 75, FUNC_PS8I(SimdNeuralProductSum8i));
+
+        return result;
+    }
+
     bool NeuralAddVectorMultipliedByValueDataTest(bool create, int size, float eps, const FuncAVMV & f)
     {
         bool result = true;
@@ -2631,7 +2894,7 @@ namespace Test
         return NeuralPoolingMaxDataTest(create, Size(DW, DH), Size(2, 2), Size(3, 3), Size(0, 0), EPS, FUNC_M(SimdNeuralPooling2x2Max3x3));
     }
 
-    bool NeuralConvolutionForwardDataTest(bool create, const Index & srcIndex, const Size & kernel, const Size & pad, const Size & stride, const Size & dilation, int add, float eps, FuncCF f)
+    template<class Func> bool NeuralConvolutionForwardDataTest(bool create, const Index & srcIndex, const Size & kernel, const Size & pad, const Size & stride, const Size & dilation, int add, float eps, Func f)
     {
         bool result = true;
 
@@ -2689,6 +2952,66 @@ namespace Test
         Size _1(1, 1), _3(3, 3);
         return NeuralConvolutionForwardDataTest(create, Index(64, 64, 4), _3, _1, _1, _1, 1, EPS, FUNC_CF(SimdNeuralConvolutionForward));
     }
+
+    bool NeuralConvolutionRunDataTest(bool create)
+    {
+        Size _1(1, 1), _3(3, 3);
+        return NeuralConvolutionForwardDataTest(create, Index(64, 64, 4), _3, _1, _1, _1, 1, EPS, FUNC_CR(SimdNeuralConvolutionInit));
+    }
+
+    bool NeuralConvolutionForwardSpecialTest(const Index & srcIndex, const Size & kernel, const Size & pad, const FuncCF & f1, const FuncCF & f2)
+    {
+        Size _1(1, 1);
+        Index dstIndex = FuncCF::DstIndex(srcIndex, kernel, pad, _1, _1);
+
+        Vector src(srcIndex.Volume());
+        Vector weight(kernel.x*kernel.y*srcIndex.depth*dstIndex.depth);
+        Vector dstSrc(dstIndex.Volume());
+        Vector dstDst1(dstIndex.Volume());
+        Vector dstDst2(dstIndex.Volume());
+        Vector buffer(dstIndex.Area()*srcIndex.depth*kernel.x*kernel.y * 2 + dstIndex.Area() * 2);
+
+        FillRandom32f(src, 0, 1);
+        FillRandom32f(weight, -1, 1);
+
+        const FuncCF * funcs[2] = { &f1, &f2 };
+        Vector * dsts[2] = { &dstDst1, &dstDst2 };
+        double times[2];
+        for (size_t i = 0; i < 2; ++i)
+        {
+            size_t count = 0;
+            double start = GetTime();
+            do
+            {
+                funcs[i]->Call(src, srcIndex, weight, kernel, pad, _1, _1, buffer, dstSrc, *dsts[i], dstIndex, 0);
+                count++;
+            } while (GetTime() - start < MINIMAL_TEST_EXECUTION_TIME);
+            times[i] = (GetTime() - start) / count;
+        }
+
+        double flop = 2.0*dstIndex.Volume()*srcIndex.depth*kernel.x*kernel.y;
+        TEST_LOG_SS(Info, "Convolution " << srcIndex.width << "x" << srcIndex.height << "x" << srcIndex.depth << "-" << kernel.x << "x" << kernel.y << "-" << pad.x 
+            << ": " << f1.description << " " << times[0] * 1000 << " ms (" << flop / times[0] * 0.000000001 << " GFLOPS), "
+            << f2.description << " " << times[1] * 1000 << " ms (" << flop / times[1] * 0.000000001 << " GFLOPS).");
+
+        return Compare(dstDst1, dstDst2, EPS, true, 32, false);
+    }
+
+    bool NeuralConvolutionForwardSpecialTest()
+    {
+        bool result = true;
+        Size _1(1, 1), _3(3, 3);
+
+        FuncCF f1 = FUNC_CF(Simd::Base::NeuralConvolutionForward), f2 = FUNC_CF(SimdNeuralConvolutionForward);
+
+        result = result && NeuralConvolutionForwardSpecialTest(Index(56, 56, 64), _3, _1, f1, f2);
+        result = result && NeuralConvolutionForwardSpecialTest(Index(28, 28, 128), _3, _1, f1, f2);
+        result = result && NeuralConvolutionForwardSpecialTest(Index(14, 14, 256), _3, _1, f1, f2);
+        result = result && NeuralConvolutionForwardSpecialTest(Index(7, 7, 512), _3, _1, f1, f2);
+        result = result && NeuralConvolutionForwardSpecialTest(Index(64, 64, 16), _3, _1, f1, f2);
+
+        return result;
+    }
 }
 
 //-----------------------------------------------------------------------------
@@ -2947,11 +3270,276 @@ namespace Test
         Error error = Check(net, sample, 0.5, false);
         TEST_LOG_SS(Info, std::setprecision(6) << "Predict error : (value = " << error.first << " ; count = " << error.second << ")." << std::endl);
 
+        Vectors batch;
+        net.Predict(sample.src, batch);
+        for (size_t i = 0; i < sample.src.size(); ++i)
+        {
+            const Vector & single = net.Predict(sample.src[i]);
+            for (size_t j = 0; j < single.size(); ++j)
+            {
+                if (::fabs(single[j] - batch[i][j]) > EPS)
+                {
+                    TEST_LOG_SS(Error, "Batch prediction error at sample " << i << ", output " << j << ": " << batch[i][j] << " != " << single[j] << " !");
+                    return false;
+                }
+            }
+        }
+
+#ifdef TEST_PERFORMANCE_TEST_ENABLE
+        TEST_LOG_SS(Info, PerformanceMeasurerStorage::s_storage.TextReport(false, true));
+        PerformanceMeasurerStorage::s_storage.Clear();
+#endif
+
+        return true;
+    }
+
+    bool NeuralBinarySpecialTest()
+    {
+        Network text, binary;
+        if (!CreateNetwork(text, false, false) || !CreateNetwork(binary, false, false))
+        {
+            TEST_LOG_SS(Error, "Can't create Simd::Neural::Network!");
+            return false;
+        }
+
+        String path = ROOT_PATH + "/data/network/digit.txt";
+        if (!text.Load(path))
+        {
+            TEST_LOG_SS(Error, "Can't load Simd::Neural::Network from file '" << path << "'!");
+            return false;
+        }
+
+        std::stringstream ss;
+        if (!text.SaveBinary(ss))
+        {
+            TEST_LOG_SS(Error, "Can't save Simd::Neural::Network in binary format!");
+            return false;
+        }
+        String data = ss.str();
+        Simd::Neural::Buffer buffer(data.begin(), data.end());
+
+        {
+            TEST_PERFORMANCE_TEST("LoadBinary (external)");
+            if (!binary.LoadBinary(buffer.data(), buffer.size(), true))
+            {
+                TEST_LOG_SS(Error, "Can't load Simd::Neural::Network in binary format!");
+                return false;
+            }
+        }
+
+        TrainSample sample;
+        if (!LoadDigits(text, true, sample))
+            return false;
+
+        for (size_t i = 0; i < sample.src.size(); ++i)
+        {
+            Vector a = text.Predict(sample.src[i]);
+            const Vector & b = binary.Predict(sample.src[i]);
+            for (size_t j = 0; j < a.size(); ++j)
+            {
+                if (a[j] != b[j])
+                {
+                    TEST_LOG_SS(Error, "Binary network prediction error at sample " << i << ", output " << j << ": " << b[j] << " != " << a[j] << " !");
+                    return false;
+                }
+            }
+        }
+
+        if (binary.Train(sample.src, sample.dst, TrainOptions(), [](){}))
+        {
+            TEST_LOG_SS(Error, "Simd::Neural::Network with external weights is trained!");
+            return false;
+        }
+
+        size_t size = 0;
+        binary.Save(NULL, &size, false);
+        Simd::Neural::Buffer raw(size);
+        if (!binary.Save(raw.data(), &size, false) || !text.Load(raw.data(), raw.size(), false))
+        {
+            TEST_LOG_SS(Error, "Can't resave Simd::Neural::Network loaded in binary format!");
+            return false;
+        }
+        for (size_t i = 0; i < sample.src.size(); ++i)
+        {
+            const Vector & a = text.Predict(sample.src[i]);
+            const Vector & b = binary.Predict(sample.src[i]);
+            for (size_t j = 0; j < a.size(); ++j)
+            {
+                if (a[j] != b[j])
+                {
+                    TEST_LOG_SS(Error, "Resaved network prediction error at sample " << i << ", output " << j << ": " << a[j] << " != " << b[j] << " !");
+                    return false;
+                }
+            }
+        }
+
+        buffer[buffer.size() / 2] ^= 1;
+        if (binary.LoadBinary(buffer.data(), buffer.size(), false))
+        {
+            TEST_LOG_SS(Error, "Simd::Neural::Network with wrong checksum is loaded!");
+            return false;
+        }
+
+        TEST_LOG_SS(Info, "Size of binary network: " << data.size() << " bytes.");
+
+#ifdef TEST_PERFORMANCE_TEST_ENABLE
+        TEST_LOG_SS(Info, PerformanceMeasurerStorage::s_storage.TextReport(false, true));
+        PerformanceMeasurerStorage::s_storage.Clear();
+#endif
+
+        return true;
+    }
+
+    bool NeuralFloat16SpecialTest()
+    {
+        Network net32f, net16f;
+        if (!CreateNetwork(net32f, false, false) || !CreateNetwork(net16f, false, false))
+        {
+            TEST_LOG_SS(Error, "Can't create Simd::Neural::Network!");
+            return false;
+        }
+
+        String path = ROOT_PATH + "/data/network/digit.txt";
+        if (!net32f.Load(path) || !net16f.Load(path))
+        {
+            TEST_LOG_SS(Error, "Can't load Simd::Neural::Network from file '" << path << "'!");
+            return false;
+        }
+        net16f.ConvertToFloat16();
+
+        TrainSample sample;
+        if (!LoadDigits(net32f, true, sample))
+            return false;
+
+        float difference = 0;
+        for (size_t i = 0; i < sample.src.size(); ++i)
+        {
+            Vector a = net32f.Predict(sample.src[i]);
+            const Vector & b = net16f.Predict(sample.src[i]);
+            for (size_t j = 0; j < a.size(); ++j)
+                difference = std::max(difference, ::fabs(a[j] - b[j]));
+        }
+
+        Vectors batch32f, batch16f;
+        {
+            TEST_PERFORMANCE_TEST("Predict batch 32f");
+            net32f.Predict(sample.src, batch32f);
+        }
+        {
+            TEST_PERFORMANCE_TEST("Predict batch 16f");
+            net16f.Predict(sample.src, batch16f);
+        }
+        for (size_t i = 0; i < sample.src.size(); ++i)
+            for (size_t j = 0; j < batch32f[i].size(); ++j)
+                difference = std::max(difference, ::fabs(batch32f[i][j] - batch16f[i][j]));
+
+        Error error32f = Check(net32f, sample, 0.5, false);
+        Error error16f = Check(net16f, sample, 0.5, false);
+        TEST_LOG_SS(Info, std::setprecision(6) << "Predict error 32f: (value = " << error32f.first << " ; count = " << error32f.second << ").");
+        TEST_LOG_SS(Info, std::setprecision(6) << "Predict error 16f: (value = " << error16f.first << " ; count = " << error16f.second << ").");
+        TEST_LOG_SS(Info, "Maximal difference of predictions: " << difference << ".");
+
 #ifdef TEST_PERFORMANCE_TEST_ENABLE
         TEST_LOG_SS(Info, PerformanceMeasurerStorage::s_storage.TextReport(false, true));
         PerformanceMeasurerStorage::s_storage.Clear();
 #endif
 
+        if (difference > 0.01f)
+        {
+            TEST_LOG_SS(Error, "Too big difference of predictions of 32-bit and 16-bit float networks!");
+            return false;
+        }
+
+        return true;
+    }
+
+    SIMD_INLINE size_t Decision(const Vector & v, float positive)
+    {
+        size_t index = std::max_element(v.begin(), v.end()) - v.begin();
+        return v[index] < positive ? v.size() : index;
+    }
+
+    bool NeuralInt8SpecialTest()
+    {
+        Network net32f, net8i;
+        if (!CreateNetwork(net32f, false, false) || !CreateNetwork(net8i, false, false))
+        {
+            TEST_LOG_SS(Error, "Can't create Simd::Neural::Network!");
+            return false;
+        }
+
+        String path = ROOT_PATH + "/data/network/digit.txt";
+        if (!net32f.Load(path) || !net8i.Load(path))
+        {
+            TEST_LOG_SS(Error, "Can't load Simd::Neural::Network from file '" << path << "'!");
+            return false;
+        }
+
+        TrainSample sample;
+        if (!LoadDigits(net32f, true, sample))
+            return false;
+
+        Vectors calibration;
+        for (size_t i = 0; i < sample.src.size(); i += 16)
+            calibration.push_back(sample.src[i]);
+        net8i.ConvertToInt8(calibration);
+
+        std::stringstream ss;
+        if (net8i.Save(ss) || net8i.SaveBinary(ss))
+        {
+            TEST_LOG_SS(Error, "Saving of Simd::Neural::Network with 8-bit integer weights has to be rejected!");
+            return false;
+        }
+
+        float difference = 0;
+        double sum = 0;
+        size_t agreement = 0;
+        for (size_t i = 0; i < sample.src.size(); ++i)
+        {
+            Vector a = net32f.Predict(sample.src[i]);
+            const Vector & b = net8i.Predict(sample.src[i]);
+            for (size_t j = 0; j < a.size(); ++j)
+            {
+                difference = std::max(difference, ::fabs(a[j] - b[j]));
+                sum += ::fabs(a[j] - b[j]);
+            }
+            if (Decision(a, 0.5f) == Decision(b, 0.5f))
+                agreement++;
+        }
+
+        Vectors batch32f, batch8i;
+        {
+            TEST_PERFORMANCE_TEST("Predict batch 32f");
+            net32f.Predict(sample.src, batch32f);
+        }
+        {
+            TEST_PERFORMANCE_TEST("Predict batch 8i");
+            net8i.Predict(sample.src, batch8i);
+        }
+        for (size_t i = 0; i < sample.src.size(); ++i)
+            for (size_t j = 0; j < batch32f[i].size(); ++j)
+                difference = std::max(difference, ::fabs(batch32f[i][j] - batch8i[i][j]));
+
+        Error error32f = Check(net32f, sample, 0.5, false);
+        Error error8i = Check(net8i, sample, 0.5, false);
+        size_t count = sample.src.size(), size = net32f.OutputIndex().Volume();
+        TEST_LOG_SS(Info, "Int8 network is calibrated on " << calibration.size() << " from " << count << " samples.");
+        TEST_LOG_SS(Info, std::setprecision(6) << "Predict error 32f: (value = " << error32f.first << " ; count = " << error32f.second << ").");
+        TEST_LOG_SS(Info, std::setprecision(6) << "Predict error 8i: (value = " << error8i.first << " ; count = " << error8i.second << ").");
+        TEST_LOG_SS(Info, "Maximal difference of predictions: " << difference << ", average: " << sum / (count*size) << ".");
+        TEST_LOG_SS(Info, "Agreement of predicted classes: " << agreement << " from " << count << " (" << std::setprecision(4) << 100.0*agreement / count << "%).");
+
+#ifdef TEST_PERFORMANCE_TEST_ENABLE
+        TEST_LOG_SS(Info, PerformanceMeasurerStorage::s_storage.TextReport(false, true));
+        PerformanceMeasurerStorage::s_storage.Clear();
+#endif
+
+        if (agreement < count * 99 / 100)
+        {
+            TEST_LOG_SS(Error, "Too low agreement of predictions of 32-bit float and 8-bit integer networks!");
+            return false;
+        }
+
         return true;
     }
 
@@ -3006,6 +3594,54 @@ namespace Test
 
         net.Train(data.train.src, data.train.dst, options, logger);
 
+#ifdef TEST_PERFORMANCE_TEST_ENABLE
+        TEST_LOG_SS(Info, PerformanceMeasurerStorage::s_storage.TextReport(false, true));
+        PerformanceMeasurerStorage::s_storage.Clear();
+#endif
+
+        return true;
+    }
+
+    bool NeuralTrainParallelSpecialTest()
+    {
+        using namespace Simd::Neural;
+        Network net;
+        TEST_ADD_LAYER(net, (new ConvolutionalLayer(Function::Relu, Size(16, 16), 1, 12, Size(5, 5))));
+        TEST_ADD_LAYER(net, (new MaxPoolingLayer(Function::Relu, Size(12, 12), 12, Size(2, 2), Size(2, 2))));
+        TEST_ADD_LAYER(net, (new FullyConnectedLayer(Function::Relu, 6 * 6 * 12, 1024)));
+        TEST_ADD_LAYER(net, (new FullyConnectedLayer(Function::Sigmoid, 1024, 10)));
+
+        TrainSample sample;
+        if (!LoadDigits(net, true, sample))
+            return false;
+
+        TrainData data;
+        Prepare(sample, 8, data);
+
+        std::vector<size_t> threads;
+        size_t threadMax = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+        for (size_t number = 1; number < threadMax; number *= 2)
+            threads.push_back(number);
+        threads.push_back(threadMax);
+
+        double time1 = 0;
+        for (size_t i = 0; i < threads.size(); ++i)
+        {
+            TrainOptions options;
+            options.epochFinish = 1;
+            options.threadNumber = threads[i];
+
+            double start = GetTime();
+            net.Train(data.train.src, data.train.dst, options, Logger());
+            double time = GetTime() - start;
+            if (i == 0)
+                time1 = time;
+
+            Error check = Check(net, data.check, options.threshold, true);
+            TEST_LOG_SS(Info, std::setprecision(3) << std::fixed << "Train epoch in " << threads[i] << " threads: " << time * 1000 << " ms, " 
+                << data.train.src.size() / time << " samples/s, speedup " << time1 / time << ", check (value = " << check.first << " ; count = " << check.second << ").");
+        }
+
 #ifdef TEST_PERFORMANCE_TEST_ENABLE
         TEST_LOG_SS(Info, PerformanceMeasurerStorage::s_storage.TextReport(false, true));
         PerformanceMeasurerStorage::s_storage.Clear();
@@ -0,0 +1,243 @@
+/*
+* Tests for Simd Library (http://ermig1979.github.io/Simd).
+*
+* Copyright (c) 2011-2017 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#include "Test/TestUtils.h"
+#include "Test/TestPerformance.h"
+#include "Test/TestData.h"
+
+namespace Test
+{
+    namespace
+    {
+        struct Func1
+        {
+            typedef void(*FuncPtr)(const uint8_t * y, size_t yStride, const uint8_t * uv, size_t uvStride,
+                size_t width, size_t height, uint8_t * bgr, size_t bgrStride);
+
+            FuncPtr func;
+            String description;
+
+            Func1(const FuncPtr & f, const String & d) : func(f), description(d) {}
+
+            void Call(const View & y, const View & uv, View & dst) const
+            {
+                TEST_PERFORMANCE_TEST(description);
+                func(y.data, y.stride, uv.data, uv.stride, y.width, y.height, dst.data, dst.stride);
+            }
+        };
+    }
+
+#define FUNC1(function) Func1(function, #function)
+
+    namespace
+    {
+        struct Func2
+        {
+            typedef void(*FuncPtr)(const uint8_t * y, size_t yStride, const uint8_t * uv, size_t uvStride,
+                size_t width, size_t height, uint8_t * bgra, size_t bgraStride, uint8_t alpha);
+
+            FuncPtr func;
+            String description;
+
+            Func2(const FuncPtr & f, const String & d) : func(f), description(d) {}
+
+            void Call(const View & y, const View & uv, View & dst) const
+            {
+                TEST_PERFORMANCE_TEST(description);
+                func(y.data, y.stride, uv.data, uv.stride, y.width, y.height, dst.data, dst.stride, 0xFF);
+            }
+        };
+    }
+
+#define FUNC2(function) Func2(function, #function)
+
+    template <class Func>
+    bool Nv12ToAnyAutoTest(int width, int height, View::Format dstType, const Func & f1, const Func & f2)
+    {
+        bool result = true;
+
+        TEST_LOG_SS(Info, "Test " << f1.description << " & " << f2.description << " [" << width << ", " << height << "].");
+
+        View y(width, height, View::Gray8, NULL, TEST_ALIGN(width));
+        FillRandom(y);
+        View uv(width / 2, height / 2, View::Uv16, NULL, TEST_ALIGN(width));
+        FillRandom(uv);
+
+        View dst1(width, height, dstType, NULL, TEST_ALIGN(width));
+        View dst2(width, height, dstType, NULL, TEST_ALIGN(width));
+
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(f1.Call(y, uv, dst1));
+
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(f2.Call(y, uv, dst2));
+
+        result = result && Compare(dst1, dst2, 0, true, 64);
+
+        if (result)
+        {
+            View u(width / 2, height / 2, View::Gray8, NULL, TEST_ALIGN(width));
+            View v(width / 2, height / 2, View::Gray8, NULL, TEST_ALIGN(width));
+            Simd::DeinterleaveUv(uv, u, v);
+            if (dstType == View::Bgra32)
+                Simd::Yuv420pToBgra(y, u, v, dst2);
+            else
+                Simd::Yuv420pToBgr(y, u, v, dst2);
+            result = result && Compare(dst1, dst2, 0, true, 64);
+        }
+
+        return result;
+    }
+
+    template <class Func>
+    bool Nv12ToAnyAutoTest(View::Format dstType, const Func & f1, const Func & f2)
+    {
+        bool result = true;
+
+        result = result && Nv12ToAnyAutoTest(W, H, dstType, f1, f2);
+        result = result && Nv12ToAnyAutoTest(W + O * 2, H - O * 2, dstType, f1, f2);
+        result = result && Nv12ToAnyAutoTest(W - O * 2, H + O * 2, dstType, f1, f2);
+
+        return result;
+    }
+
+    bool Nv12ToBgrAutoTest()
+    {
+        bool result = true;
+
+        result = result && Nv12ToAnyAutoTest(View::Bgr24, FUNC1(Simd::Base::Nv12ToBgr), FUNC1(SimdNv12ToBgr));
+
+#ifdef SIMD_SSSE3_ENABLE
+        if (Simd::Ssse3::Enable)
+            result = result && Nv12ToAnyAutoTest(View::Bgr24, FUNC1(Simd::Ssse3::Nv12ToBgr), FUNC1(SimdNv12ToBgr));
+#endif 
+
+#ifdef SIMD_AVX2_ENABLE
+        if (Simd::Avx2::Enable)
+            result = result && Nv12ToAnyAutoTest(View::Bgr24, FUNC1(Simd::Avx2::Nv12ToBgr), FUNC1(SimdNv12ToBgr));
+#endif 
+
+#ifdef SIMD_AVX512BW_ENABLE
+        if (Simd::Avx512bw::Enable)
+            result = result && Nv12ToAnyAutoTest(View::Bgr24, FUNC1(Simd::Avx512bw::Nv12ToBgr), FUNC1(SimdNv12ToBgr));
+#endif 
+
+#ifdef SIMD_NEON_ENABLE
+        if (Simd::Neon::Enable)
+            result = result && Nv12ToAnyAutoTest(View::Bgr24, FUNC1(Simd::Neon::Nv12ToBgr), FUNC1(SimdNv12ToBgr));
+#endif 
+
+        return result;
+    }
+
+    bool Nv12ToBgraAutoTest()
+    {
+        bool result = true;
+
+        result = result && Nv12ToAnyAutoTest(View::Bgra32, FUNC2(Simd::Base::Nv12ToBgra), FUNC2(SimdNv12ToBgra));
+
+#ifdef SIMD_SSE2_ENABLE
+        if (Simd::Sse2::Enable)
+            result = result && Nv12ToAnyAutoTest(View::Bgra32, FUNC2(Simd::Sse2::Nv12ToBgra), FUNC2(SimdNv12ToBgra));
+#endif 
+
+#ifdef SIMD_AVX2_ENABLE
+        if (Simd::Avx2::Enable)
+            result = result && Nv12ToAnyAutoTest(View::Bgra32, FUNC2(Simd::Avx2::Nv12ToBgra), FUNC2(SimdNv12ToBgra));
+#endif 
+
+#ifdef SIMD_AVX512BW_ENABLE
+        if (Simd::Avx512bw::Enable)
+            result = result && Nv12ToAnyAutoTest(View::Bgra32, FUNC2(Simd::Avx512bw::Nv12ToBgra), FUNC2(SimdNv12ToBgra));
+#endif 
+
+#ifdef SIMD_NEON_ENABLE
+        if (Simd::Neon::Enable)
+            result = result && Nv12ToAnyAutoTest(View::Bgra32, FUNC2(Simd::Neon::Nv12ToBgra), FUNC2(SimdNv12ToBgra));
+#endif 
+
+        return result;
+    }
+
+    //-----------------------------------------------------------------------
+
+    template <class Func>
+    bool Nv12ToAnyDataTest(bool create, int width, int height, View::Format dstType, const Func & f)
+    {
+        bool result = true;
+
+        Data data(f.description);
+
+        TEST_LOG_SS(Info, (create ? "Create" : "Verify") << " test " << f.description << " [" << width << ", " << height << "].");
+
+        View y(width, height, View::Gray8, NULL, TEST_ALIGN(width));
+        View uv(width / 2, height / 2, View::Uv16, NULL, TEST_ALIGN(width));
+
+        View dst1(width, height, dstType, NULL, TEST_ALIGN(width));
+        View dst2(width, height, dstType, NULL, TEST_ALIGN(width));
+
+        if (create)
+        {
+            FillRandom(y);
+            FillRandom(uv);
+
+            TEST_SAVE(y);
+            TEST_SAVE(uv);
+
+            f.Call(y, uv, dst1);
+
+            TEST_SAVE(dst1);
+        }
+        else
+        {
+            TEST_LOAD(y);
+            TEST_LOAD(uv);
+
+            TEST_LOAD(dst1);
+
+            f.Call(y, uv, dst2);
+
+            TEST_SAVE(dst2);
+
+            result = result && Compare(dst1, dst2, 0, true, 64);
+        }
+
+        return result;
+    }
+
+    bool Nv12ToBgrDataTest(bool create)
+    {
+        bool result = true;
+
+        result = result && Nv12ToAnyDataTest(create, DW, DH, View::Bgr24, FUNC1(SimdNv12ToBgr));
+
+        return result;
+    }
+
+    bool Nv12ToBgraDataTest(bool create)
+    {
+        bool result = true;
+
+        result = result && Nv12ToAnyDataTest(create, DW, DH, View::Bgra32, FUNC2(SimdNv12ToBgra));
+
+        return result;
+    }
+}
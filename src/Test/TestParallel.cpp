@@ -0,0 +1,306 @@
+/*
+* Tests for Simd Library (http://ermig1979.github.io/Simd).
+*
+* Copyright (c) 2011-2017 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#include "Test/TestUtils.h"
+#include "Test/TestPerformance.h"
+
+#include "Simd/SimdParallel.hpp"
+#include "Simd/SimdLib.hpp"
+
+#include <list>
+
+namespace Test
+{
+    bool ParallelSum(size_t size, size_t threadNumber, size_t blockStepMin, const String & desc)
+    {
+        std::vector<int> buffer(size, 0);
+        {
+            TEST_PERFORMANCE_TEST(desc);
+            Simd::Parallel(0, size, [&](size_t thread, size_t begin, size_t end)
+            {
+                for (size_t i = begin; i < end; ++i)
+                    buffer[i] += int(thread + 1);
+            }, threadNumber, blockStepMin);
+        }
+        for (size_t i = 0; i < size; ++i)
+        {
+            if (buffer[i] == 0)
+            {
+                TEST_LOG_SS(Error, desc << " : element " << i << " was not processed!");
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool ParallelNested(size_t threadNumber)
+    {
+        std::atomic<size_t> count(0);
+        Simd::Parallel(0, threadNumber, [&](size_t, size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; ++i)
+            {
+                Simd::Parallel(0, 100, [&](size_t, size_t b, size_t e)
+                {
+                    count += e - b;
+                }, threadNumber);
+            }
+        }, threadNumber);
+        if (count != threadNumber * 100)
+        {
+            TEST_LOG_SS(Error, "Nested parallel : processed " << count << " instead of " << threadNumber * 100 << " !");
+            return false;
+        }
+        return true;
+    }
+
+    namespace
+    {
+        const uint8_t ROWS_GUARD = 0xA5;
+
+        struct RowsData
+        {
+            std::list<View> guarded;
+            View gray, bgra, bgr, y, u, v, uf, vf, dst8, dst16, dstBgra, dstBgr, dstY, dstU, dstV, dstUf, dstVf;
+
+            RowsData(size_t w, size_t h)
+                : gray(w, h, View::Gray8), bgra(w, h, View::Bgra32), bgr(w, h, View::Bgr24)
+                , y(w, h, View::Gray8), u(w / 2, h / 2, View::Gray8), v(w / 2, h / 2, View::Gray8), uf(w, h, View::Gray8), vf(w, h, View::Gray8)
+                , dst8(Guarded(w, h, View::Gray8)), dst16(Guarded(w, h, View::Int16)), dstBgra(Guarded(w, h, View::Bgra32)), dstBgr(Guarded(w, h, View::Bgr24))
+                , dstY(Guarded(w, h, View::Gray8)), dstU(Guarded(w / 2, h / 2, View::Gray8)), dstV(Guarded(w / 2, h / 2, View::Gray8))
+                , dstUf(Guarded(w, h, View::Gray8)), dstVf(Guarded(w, h, View::Gray8))
+            {
+                FillRandom(gray);
+                FillRandom(bgra);
+                FillRandom(bgr);
+                FillRandom(y);
+                FillRandom(u);
+                FillRandom(v);
+                FillRandom(uf);
+                FillRandom(vf);
+            }
+
+            View Guarded(size_t w, size_t h, View::Format f)
+            {
+                guarded.emplace_back(w, h + 1, f);
+                Simd::Fill(guarded.back(), ROWS_GUARD);
+                return guarded.back().Region(0, 0, w, h);
+            }
+
+            bool GuardsIntact() const
+            {
+                for (std::list<View>::const_iterator it = guarded.begin(); it != guarded.end(); ++it)
+                {
+                    const uint8_t * guard = it->data + (it->height - 1)*it->stride;
+                    for (size_t i = 0, n = it->width*it->PixelSize(); i < n; ++i)
+                        if (guard[i] != ROWS_GUARD)
+                            return false;
+                }
+                return true;
+            }
+        };
+
+        View Even(const View & view)
+        {
+            return view.Region(0, 0, view.width & ~1, view.height & ~1);
+        }
+
+        typedef std::function<void(RowsData & d)> RowsFunc;
+        typedef std::vector<View RowsData::*> RowsOutputs;
+
+        struct RowsCase
+        {
+            String name;
+            RowsFunc func;
+            RowsOutputs outputs;
+
+            RowsCase(const String & n, const RowsFunc & f, View RowsData::* o0, View RowsData::* o1 = NULL, View RowsData::* o2 = NULL, View RowsData::* o3 = NULL)
+                : name(n)
+                , func(f)
+            {
+                outputs.push_back(o0);
+                if (o1)
+                    outputs.push_back(o1);
+                if (o2)
+                    outputs.push_back(o2);
+                if (o3)
+                    outputs.push_back(o3);
+            }
+        };
+        typedef std::vector<RowsCase> RowsCases;
+
+        RowsCases GetRowsCases()
+        {
+            RowsCases cases;
+            cases.push_back(RowsCase("AbsGradientSaturatedSum", [](RowsData & d) { Simd::AbsGradientSaturatedSum(d.gray, d.dst8); }, &RowsData::dst8));
+            cases.push_back(RowsCase("GaussianBlur3x3", [](RowsData & d) { Simd::GaussianBlur3x3(d.bgra, d.dstBgra); }, &RowsData::dstBgra));
+            cases.push_back(RowsCase("MeanFilter3x3", [](RowsData & d) { Simd::MeanFilter3x3(d.gray, d.dst8); }, &RowsData::dst8));
+            cases.push_back(RowsCase("MedianFilterRhomb3x3", [](RowsData & d) { Simd::MedianFilterRhomb3x3(d.gray, d.dst8); }, &RowsData::dst8));
+            cases.push_back(RowsCase("MedianFilterRhomb5x5", [](RowsData & d) { Simd::MedianFilterRhomb5x5(d.gray, d.dst8); }, &RowsData::dst8));
+            cases.push_back(RowsCase("MedianFilterSquare3x3", [](RowsData & d) { Simd::MedianFilterSquare3x3(d.gray, d.dst8); }, &RowsData::dst8));
+            cases.push_back(RowsCase("MedianFilterSquare5x5", [](RowsData & d) { Simd::MedianFilterSquare5x5(d.bgr, d.dstBgr); }, &RowsData::dstBgr));
+            cases.push_back(RowsCase("SobelDx", [](RowsData & d) { Simd::SobelDx(d.gray, d.dst16); }, &RowsData::dst16));
+            cases.push_back(RowsCase("SobelDxAbs", [](RowsData & d) { Simd::SobelDxAbs(d.gray, d.dst16); }, &RowsData::dst16));
+            cases.push_back(RowsCase("SobelDy", [](RowsData & d) { Simd::SobelDy(d.gray, d.dst16); }, &RowsData::dst16));
+            cases.push_back(RowsCase("SobelDyAbs", [](RowsData & d) { Simd::SobelDyAbs(d.gray, d.dst16); }, &RowsData::dst16));
+            cases.push_back(RowsCase("Laplace", [](RowsData & d) { Simd::Laplace(d.gray, d.dst16); }, &RowsData::dst16));
+            cases.push_back(RowsCase("LaplaceAbs", [](RowsData & d) { Simd::LaplaceAbs(d.gray, d.dst16); }, &RowsData::dst16));
+            cases.push_back(RowsCase("BgraToGray", [](RowsData & d) { Simd::BgraToGray(d.bgra, d.dst8); }, &RowsData::dst8));
+            cases.push_back(RowsCase("BgrToGray", [](RowsData & d) { Simd::BgrToGray(d.bgr, d.dst8); }, &RowsData::dst8));
+            cases.push_back(RowsCase("BgraToYuv420p", [](RowsData & d) { View y = Even(d.dstY); Simd::BgraToYuv420p(Even(d.bgra), y, d.dstU, d.dstV); }, &RowsData::dstY, &RowsData::dstU, &RowsData::dstV));
+            cases.push_back(RowsCase("BgraToYuv444p", [](RowsData & d) { Simd::BgraToYuv444p(d.bgra, d.dstY, d.dstUf, d.dstVf); }, &RowsData::dstY, &RowsData::dstUf, &RowsData::dstVf));
+            cases.push_back(RowsCase("BgrToYuv420p", [](RowsData & d) { View y = Even(d.dstY); Simd::BgrToYuv420p(Even(d.bgr), y, d.dstU, d.dstV); }, &RowsData::dstY, &RowsData::dstU, &RowsData::dstV));
+            cases.push_back(RowsCase("ResizeBilinear", [](RowsData & d) { Simd::ResizeBilinear(d.u, d.dstUf); Simd::ResizeBilinear(d.y, d.dstU); }, &RowsData::dstUf, &RowsData::dstU));
+            cases.push_back(RowsCase("Yuv420pToBgr", [](RowsData & d) { View bgr = Even(d.dstBgr); Simd::Yuv420pToBgr(Even(d.y), d.u, d.v, bgr); }, &RowsData::dstBgr));
+            cases.push_back(RowsCase("Yuv420pToBgra", [](RowsData & d) { View bgra = Even(d.dstBgra); Simd::Yuv420pToBgra(Even(d.y), d.u, d.v, bgra); }, &RowsData::dstBgra));
+            cases.push_back(RowsCase("Yuv444pToBgra", [](RowsData & d) { Simd::Yuv444pToBgra(d.y, d.uf, d.vf, d.dstBgra); }, &RowsData::dstBgra));
+            cases.push_back(RowsCase("BackgroundGrowRangeSlow", [](RowsData & d) { Simd::Copy(d.uf, d.dstUf); Simd::Copy(d.vf, d.dstVf);
+                Simd::BackgroundGrowRangeSlow(d.gray, d.dstUf, d.dstVf); }, &RowsData::dstUf, &RowsData::dstVf));
+            cases.push_back(RowsCase("BackgroundIncrementCount", [](RowsData & d) { Simd::Copy(d.y, d.dstY); Simd::Copy(d.y, d.dst8);
+                Simd::BackgroundIncrementCount(d.gray, d.uf, d.vf, d.dstY, d.dst8); }, &RowsData::dstY, &RowsData::dst8));
+            cases.push_back(RowsCase("BackgroundAdjustRangeMasked", [](RowsData & d) { Simd::Copy(d.y, d.dstY); Simd::Copy(d.uf, d.dstUf); Simd::Copy(d.y, d.dst8); Simd::Copy(d.vf, d.dstVf);
+                Simd::BackgroundAdjustRange(d.dstY, d.dstUf, d.dst8, d.dstVf, 0x80, d.gray); }, &RowsData::dstY, &RowsData::dstUf, &RowsData::dst8, &RowsData::dstVf));
+            cases.push_back(RowsCase("BackgroundInitMask", [](RowsData & d) { Simd::Copy(d.y, d.dst8); Simd::BackgroundInitMask(d.gray, 0x40, 0xFF, d.dst8); }, &RowsData::dst8));
+            cases.push_back(RowsCase("EdgeBackgroundIncrementCount", [](RowsData & d) { Simd::Copy(d.y, d.dst8);
+                Simd::EdgeBackgroundIncrementCount(d.gray, d.uf, d.dst8); }, &RowsData::dst8));
+            cases.push_back(RowsCase("EdgeBackgroundShiftRangeMasked", [](RowsData & d) { Simd::Copy(d.y, d.dstY);
+                Simd::EdgeBackgroundShiftRange(d.gray, d.dstY, d.uf); }, &RowsData::dstY));
+            return cases;
+        }
+
+        uint32_t Crc32c(const View & view)
+        {
+            uint32_t crc = 0;
+            for (size_t row = 0; row < view.height; ++row)
+                crc = crc * 31 + ::SimdCrc32c(view.data + row*view.stride, view.width*view.PixelSize());
+            return crc;
+        }
+
+        uint32_t Crc32c(const RowsData & data, const RowsOutputs & outputs)
+        {
+            uint32_t crc = 0;
+            for (size_t i = 0; i < outputs.size(); ++i)
+                crc = crc * 31 + Crc32c(data.*outputs[i]);
+            return crc;
+        }
+    }
+
+    bool ParallelRowsSpecialTest(size_t width, size_t height, const std::vector<size_t> & threadNumbers, size_t repeats)
+    {
+        bool result = true;
+
+        RowsData data(width, height);
+        RowsCases cases = GetRowsCases();
+
+        TEST_LOG_SS(Info, "Test row-band multithreading for size [" << width << "," << height << "].");
+
+        for (size_t c = 0; c < cases.size() && result; ++c)
+        {
+            const RowsCase & test = cases[c];
+            ::SimdSetThreadNumber(1);
+            test.func(data);
+            uint32_t control = Crc32c(data, test.outputs);
+            for (size_t t = 0; t <= threadNumbers.size() && result; ++t)
+            {
+                bool local = t == threadNumbers.size();
+                size_t threadNumber = local ? threadNumbers.back() : threadNumbers[t];
+                ::SimdSetThreadNumber(local ? 1 : threadNumber);
+                ::SimdSetLocalThreadNumber(local ? threadNumber : 0);
+                String desc = test.name + "<" + ToString(threadNumber) + (local ? "-local>" : ">");
+                for (size_t i = 0; i < repeats; ++i)
+                {
+                    TEST_PERFORMANCE_TEST(desc);
+                    test.func(data);
+                }
+                ::SimdSetLocalThreadNumber(0);
+                if (Crc32c(data, test.outputs) != control)
+                {
+                    TEST_LOG_SS(Error, desc << " : result is not equal to single-thread result for size [" << width << "," << height << "]!");
+                    result = false;
+                }
+                else if (!data.GuardsIntact())
+                {
+                    TEST_LOG_SS(Error, desc << " : output buffer overrun for size [" << width << "," << height << "]!");
+                    result = false;
+                }
+            }
+        }
+        ::SimdSetThreadNumber(1);
+
+        return result;
+    }
+
+    bool ParallelRowsSpecialTest()
+    {
+        bool result = true;
+
+        const size_t threadNumberMax = std::max<size_t>(std::thread::hardware_concurrency(), 4);
+        std::vector<size_t> powers, odd;
+        for (size_t threadNumber = 2; threadNumber <= threadNumberMax; threadNumber *= 2)
+            powers.push_back(threadNumber);
+        odd.push_back(3);
+        odd.push_back(7);
+        odd.push_back(17);
+
+        result = result && ParallelRowsSpecialTest(3840, 2160, powers, 10);
+        result = result && ParallelRowsSpecialTest(256, 273, odd, 1);
+        result = result && ParallelRowsSpecialTest(1920, 1081, odd, 1);
+
+        return result;
+    }
+
+    bool ParallelSpecialTest()
+    {
+        bool result = true;
+
+        const size_t threadNumber = std::thread::hardware_concurrency();
+
+        Simd::SetThreadPool(0, false);
+        for (size_t i = 0; i < 10000 && result; ++i)
+            result = ParallelSum(1000, threadNumber, 1, "ThreadPool");
+
+        Simd::SetThreadPool(threadNumber, true);
+        for (size_t i = 0; i < 10000 && result; ++i)
+            result = ParallelSum(1000, threadNumber, 2, "ThreadPool<pinning>");
+
+        result = result && ParallelNested(threadNumber);
+
+        Simd::SetExecutor([](size_t count, const Simd::ThreadPool::Task & task)
+        {
+            std::vector<std::future<void>> futures;
+            for (size_t i = 0; i < count; ++i)
+                futures.push_back(std::async(std::launch::async, [i, &task] { task(i); }));
+            for (size_t i = 0; i < futures.size(); ++i)
+                futures[i].wait();
+        });
+        for (size_t i = 0; i < 1000 && result; ++i)
+            result = ParallelSum(1000, threadNumber, 1, "std::async");
+        Simd::SetExecutor(Simd::Executor());
+
+        Simd::SetThreadPool(0, false);
+
+        TEST_LOG_SS(Info, "Hardware concurrency: " << threadNumber << ".");
+
+        return result;
+    }
+}
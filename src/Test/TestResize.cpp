@@ -261,4 +261,170 @@ namespace Test
 
         return result;
     }
+
+    //-----------------------------------------------------------------------
+
+    namespace
+    {
+        struct FuncR
+        {
+            typedef void(*FuncPtr)(
+                const uint8_t *src, size_t srcWidth, size_t srcHeight, size_t srcStride,
+                uint8_t *dst, size_t dstWidth, size_t dstHeight, size_t dstStride, size_t channelCount, size_t yBegin, size_t yEnd);
+
+            FuncPtr func;
+            String description;
+
+            FuncR(const FuncPtr & f, const String & d) : func(f), description(d) {}
+
+            void Call(const View & src, View & dst, size_t yBegin, size_t yEnd) const
+            {
+                TEST_PERFORMANCE_TEST(description);
+                func(src.data, src.width, src.height, src.stride,
+                    dst.data, dst.width, dst.height, dst.stride, View::PixelSize(src.format), yBegin, yEnd);
+            }
+        };
+    }
+
+#define ARGS_R(format, width, height, k, function1, function2) \
+    format, width, height, k, \
+    FuncR(function1.func, function1.description + ColorDescription(format)), \
+    FuncR(function2.func, function2.description + ColorDescription(format))
+
+#define FUNC_R(function) \
+    FuncR(function, std::string(#function))
+
+    bool ResizeRowsAutoTest(View::Format format, int width, int height, double k, const FuncR & f1, const FuncR & f2)
+    {
+        bool result = true;
+
+        TEST_LOG_SS(Info, "Test " << f1.description << " & " << f2.description
+            << " [" << size_t(width*k) << ", " << size_t(height*k) << "] -> [" << width << ", " << height << "].");
+
+        View s(size_t(width*k), size_t(height*k), format, NULL, TEST_ALIGN(size_t(k*width)));
+        FillRandom(s);
+
+        View d1(width, height, format, NULL, TEST_ALIGN(width));
+        View d2(width, height, format, NULL, TEST_ALIGN(width));
+        View d3(width, height, format, NULL, TEST_ALIGN(width));
+        FillRandom(d1);
+        Simd::Copy(d1, d2);
+
+        const size_t yBegin = height / 3, yEnd = height * 3 / 4;
+
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(f1.Call(s, d1, yBegin, yEnd));
+
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(f2.Call(s, d2, yBegin, yEnd));
+
+        result = result && Compare(d1, d2, 0, true, 64);
+
+        if (result)
+        {
+            SimdResizeBilinear(s.data, s.width, s.height, s.stride, d3.data, d3.width, d3.height, d3.stride, View::PixelSize(format));
+            result = result && Compare(d2.Region(0, yBegin, width, yEnd), d3.Region(0, yBegin, width, yEnd), 0, true, 64, 0, "rows");
+        }
+
+        return result;
+    }
+
+    bool ResizeRowsAutoTest(const FuncR & f1, const FuncR & f2)
+    {
+        bool result = true;
+
+        for (View::Format format = View::Gray8; format <= View::Bgra32; format = View::Format(format + 1))
+        {
+            result = result && ResizeRowsAutoTest(ARGS_R(format, W, H, 0.9, f1, f2));
+            result = result && ResizeRowsAutoTest(ARGS_R(format, W + O, H - O, 1.3, f1, f2));
+            result = result && ResizeRowsAutoTest(ARGS_R(format, W - O, H + O, 0.7, f1, f2));
+        }
+
+        return result;
+    }
+
+    bool ResizeBilinearRowsAutoTest()
+    {
+        bool result = true;
+
+        result = result && ResizeRowsAutoTest(FUNC_R(Simd::Base::ResizeBilinearRows), FUNC_R(SimdResizeBilinearRows));
+
+#ifdef SIMD_SSE2_ENABLE
+        if (Simd::Sse2::Enable)
+            result = result && ResizeRowsAutoTest(FUNC_R(Simd::Sse2::ResizeBilinearRows), FUNC_R(SimdResizeBilinearRows));
+#endif 
+
+#ifdef SIMD_SSSE3_ENABLE
+        if (Simd::Ssse3::Enable)
+            result = result && ResizeRowsAutoTest(FUNC_R(Simd::Ssse3::ResizeBilinearRows), FUNC_R(SimdResizeBilinearRows));
+#endif 
+
+#ifdef SIMD_AVX2_ENABLE
+        if (Simd::Avx2::Enable)
+            result = result && ResizeRowsAutoTest(FUNC_R(Simd::Avx2::ResizeBilinearRows), FUNC_R(SimdResizeBilinearRows));
+#endif 
+
+#ifdef SIMD_AVX512BW_ENABLE
+        if (Simd::Avx512bw::Enable)
+            result = result && ResizeRowsAutoTest(FUNC_R(Simd::Avx512bw::ResizeBilinearRows), FUNC_R(SimdResizeBilinearRows));
+#endif 
+
+        return result;
+    }
+
+    //-----------------------------------------------------------------------
+
+    bool ResizeRowsDataTest(bool create, int width, int height, View::Format format, const FuncR & f)
+    {
+        bool result = true;
+
+        Data data(f.description);
+
+        TEST_LOG_SS(Info, (create ? "Create" : "Verify") << " test " << f.description << " [" << width << ", " << height << "].");
+
+        const double k = 0.7;
+        const size_t yBegin = height / 3, yEnd = height * 3 / 4;
+
+        View s(size_t(width*k), size_t(height*k), format, NULL, TEST_ALIGN(size_t(k*width)));
+
+        View d1(width, height, format, NULL, TEST_ALIGN(width));
+        View d2(width, height, format, NULL, TEST_ALIGN(width));
+
+        if (create)
+        {
+            FillRandom(s);
+            TEST_SAVE(s);
+
+            Simd::Fill(d1, 0);
+            f.Call(s, d1, yBegin, yEnd);
+
+            TEST_SAVE(d1);
+        }
+        else
+        {
+            TEST_LOAD(s);
+
+            TEST_LOAD(d1);
+
+            Simd::Fill(d2, 0);
+            f.Call(s, d2, yBegin, yEnd);
+
+            TEST_SAVE(d2);
+
+            result = result && Compare(d1, d2, 0, true, 64);
+        }
+
+        return result;
+    }
+
+    bool ResizeBilinearRowsDataTest(bool create)
+    {
+        bool result = true;
+
+        FuncR f = FUNC_R(SimdResizeBilinearRows);
+        for (View::Format format = View::Gray8; format <= View::Bgra32; format = View::Format(format + 1))
+        {
+            result = result && ResizeRowsDataTest(create, DW, DH, format, FuncR(f.func, f.description + Data::Description(format)));
+        }
+
+        return result;
+    }
 }
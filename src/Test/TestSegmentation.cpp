@@ -383,6 +383,206 @@ namespace Test
         return result;
     }
 
+    namespace
+    {
+        struct FuncL
+        {
+            typedef size_t(*FuncPtr)(uint8_t * mask, size_t maskStride, size_t width, size_t height, const uint8_t * difference, size_t differenceStride,
+                uint8_t seedIndex, uint8_t emptyIndex, uint8_t invalidIndex, uint8_t differenceThreshold, size_t areaMin, uint8_t indexMin, ptrdiff_t * rects);
+            FuncPtr func;
+            String description;
+
+            FuncL(const FuncPtr & f, const String & d) : func(f), description(d) {}
+
+            void Call(const View & src, const View & difference, uint8_t seedIndex, uint8_t emptyIndex, uint8_t invalidIndex, uint8_t differenceThreshold,
+                size_t areaMin, uint8_t indexMin, View & dst, Rects & rects, size_t & count) const
+            {
+                Simd::Copy(src, dst);
+                std::vector<ptrdiff_t> buffer(4 * (256 - indexMin));
+                {
+                    TEST_PERFORMANCE_TEST(description);
+                    count = func(dst.data, dst.stride, dst.width, dst.height, difference.data, difference.stride,
+                        seedIndex, emptyIndex, invalidIndex, differenceThreshold, areaMin, indexMin, buffer.data());
+                }
+                rects.resize(std::min<size_t>(count, 256 - indexMin));
+                for (size_t i = 0; i < rects.size(); ++i)
+                    rects[i] = Rect(buffer[4 * i + 0], buffer[4 * i + 1], buffer[4 * i + 2], buffer[4 * i + 3]);
+            }
+        };
+    }
+
+#define FUNC_L(func) FuncL(func, #func)
+
+    void FillSeedMask(View & mask, uint8_t seedIndex, uint8_t emptyIndex, uint8_t invalidIndex)
+    {
+        Simd::Fill(mask, emptyIndex);
+        for (size_t row = 0; row < mask.height; ++row)
+        {
+            for (size_t col = 0; col < mask.width; ++col)
+            {
+                if (row == 0 || col == 0 || row == mask.height - 1 || col == mask.width - 1)
+                    mask.At<uint8_t>(col, row) = invalidIndex;
+                else if (Random(256) == 0)
+                    mask.At<uint8_t>(col, row) = seedIndex;
+            }
+        }
+    }
+
+    bool Compare(const Rects & a, const Rects & b, bool printError)
+    {
+        if (a.size() != b.size())
+        {
+            if (printError)
+                TEST_LOG_SS(Error, "There are different rectangle count: " << a.size() << " != " << b.size() << ".");
+            return false;
+        }
+        for (size_t i = 0; i < a.size(); ++i)
+        {
+            if (!Compare(a[i], b[i], printError))
+                return false;
+        }
+        return true;
+    }
+
+    size_t SegmentationLabelReference(const View & src, const View & difference, uint8_t seedIndex, uint8_t emptyIndex, uint8_t invalidIndex,
+        uint8_t differenceThreshold, size_t areaMin, uint8_t indexMin, View & dst, Rects & rects)
+    {
+        Simd::Copy(src, dst);
+        View used(src.width, src.height, View::Gray8);
+        Simd::Fill(used, 0);
+        rects.clear();
+        size_t count = 0, capacity = 256 - indexMin;
+        for (ptrdiff_t y = 0; y < (ptrdiff_t)src.height; ++y)
+        {
+            for (ptrdiff_t x = 0; x < (ptrdiff_t)src.width; ++x)
+            {
+                if (src.At<uint8_t>(x, y) != seedIndex || used.At<uint8_t>(x, y))
+                    continue;
+                Points region, stack(1, Point(x, y));
+                Rect rect(x, y, x + 1, y + 1);
+                used.At<uint8_t>(x, y) = 1;
+                while (stack.size())
+                {
+                    Point p = stack.back();
+                    stack.pop_back();
+                    region.push_back(p);
+                    rect |= Rect(p.x, p.y, p.x + 1, p.y + 1);
+                    const Point neighbours[4] = { Point(p.x - 1, p.y), Point(p.x + 1, p.y), Point(p.x, p.y - 1), Point(p.x, p.y + 1) };
+                    for (size_t i = 0; i < 4; ++i)
+                    {
+                        Point n = neighbours[i];
+                        if (n.x < 0 || n.y < 0 || n.x >= (ptrdiff_t)src.width || n.y >= (ptrdiff_t)src.height || used.At<uint8_t>(n.x, n.y))
+                            continue;
+                        uint8_t index = src.At<uint8_t>(n.x, n.y);
+                        if (index == seedIndex || (index == emptyIndex && difference.At<uint8_t>(n.x, n.y) > differenceThreshold))
+                        {
+                            used.At<uint8_t>(n.x, n.y) = 1;
+                            stack.push_back(n);
+                        }
+                    }
+                }
+                uint8_t index = invalidIndex;
+                if (size_t(rect.Area()) > areaMin)
+                {
+                    if (count < capacity)
+                    {
+                        index = uint8_t(indexMin + count);
+                        rects.push_back(rect);
+                    }
+                    count++;
+                }
+                for (size_t i = 0; i < region.size(); ++i)
+                    dst.At<uint8_t>(region[i].x, region[i].y) = index;
+            }
+        }
+        return count;
+    }
+
+    bool SegmentationLabelAutoTest(int width, int height, const FuncL & f1, const FuncL & f2)
+    {
+        bool result = true;
+
+        TEST_LOG_SS(Info, "Test " << f1.description << " & " << f2.description << " for size [" << width << "," << height << "].");
+
+        const uint8_t seedIndex = 1, emptyIndex = 0, invalidIndex = 2, threshold = 96, indexMin = 3;
+        const size_t areaMin = 16;
+
+        View s(width, height, View::Gray8, NULL, TEST_ALIGN(width));
+        FillSeedMask(s, seedIndex, emptyIndex, invalidIndex);
+
+        View difference(width, height, View::Gray8, NULL, TEST_ALIGN(width));
+        FillRandom(difference, 0, 160);
+
+        View d1(width, height, View::Gray8, NULL, TEST_ALIGN(width));
+        View d2(width, height, View::Gray8, NULL, TEST_ALIGN(width));
+        Rects r1, r2;
+        size_t c1, c2;
+
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(f1.Call(s, difference, seedIndex, emptyIndex, invalidIndex, threshold, areaMin, indexMin, d1, r1, c1));
+
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(f2.Call(s, difference, seedIndex, emptyIndex, invalidIndex, threshold, areaMin, indexMin, d2, r2, c2));
+
+        if (c1 != c2)
+        {
+            TEST_LOG_SS(Error, "There are different region count: " << c1 << " != " << c2 << ".");
+            result = false;
+        }
+
+        result = result && Compare(d1, d2, 0, true, 64);
+
+        result = result && Compare(r1, r2, true);
+
+        View d3(width, height, View::Gray8, NULL, TEST_ALIGN(width));
+        Rects r3;
+        size_t c3 = SegmentationLabelReference(s, difference, seedIndex, emptyIndex, invalidIndex, threshold, areaMin, indexMin, d3, r3);
+        if (c2 != c3)
+        {
+            TEST_LOG_SS(Error, "There are different region count of " << f2.description << " and reference flood fill: " << c2 << " != " << c3 << ".");
+            result = false;
+        }
+
+        result = result && Compare(d2, d3, 0, true, 64);
+
+        result = result && Compare(r2, r3, true);
+
+        return result;
+    }
+
+    bool SegmentationLabelAutoTest(const FuncL & f1, const FuncL & f2)
+    {
+        bool result = true;
+
+        result = result && SegmentationLabelAutoTest(W, H, f1, f2);
+        result = result && SegmentationLabelAutoTest(W + O, H - O, f1, f2);
+        result = result && SegmentationLabelAutoTest(W - O, H + O, f1, f2);
+
+        return result;
+    }
+
+    bool SegmentationLabelAutoTest()
+    {
+        bool result = true;
+
+        result = result && SegmentationLabelAutoTest(FUNC_L(Simd::Base::SegmentationLabel), FUNC_L(SimdSegmentationLabel));
+
+#ifdef SIMD_SSE2_ENABLE
+        if (Simd::Sse2::Enable && W >= Simd::Sse2::DA)
+            result = result && SegmentationLabelAutoTest(FUNC_L(Simd::Sse2::SegmentationLabel), FUNC_L(SimdSegmentationLabel));
+#endif
+
+#ifdef SIMD_AVX2_ENABLE
+        if (Simd::Avx2::Enable && W >= Simd::Avx2::A)
+            result = result && SegmentationLabelAutoTest(FUNC_L(Simd::Avx2::SegmentationLabel), FUNC_L(SimdSegmentationLabel));
+#endif
+
+#ifdef SIMD_AVX512BW_ENABLE
+        if (Simd::Avx512bw::Enable && W >= Simd::Avx512bw::A)
+            result = result && SegmentationLabelAutoTest(FUNC_L(Simd::Avx512bw::SegmentationLabel), FUNC_L(SimdSegmentationLabel));
+#endif
+
+        return result;
+    }
+
     //-----------------------------------------------------------------------
 
     bool SegmentationShrinkRegionDataTest(bool create, int width, int height, const FuncSR & f)
@@ -588,4 +788,61 @@ namespace Test
 
         return result;
     }
+
+    bool SegmentationLabelDataTest(bool create, int width, int height, const FuncL & f)
+    {
+        bool result = true;
+
+        Data data(f.description);
+
+        TEST_LOG_SS(Info, (create ? "Create" : "Verify") << " test " << f.description << " [" << width << ", " << height << "].");
+
+        const uint8_t seedIndex = 1, emptyIndex = 0, invalidIndex = 2, threshold = 96, indexMin = 3;
+        const size_t areaMin = 16;
+
+        View s(width, height, View::Gray8, NULL, TEST_ALIGN(width));
+        View difference(width, height, View::Gray8, NULL, TEST_ALIGN(width));
+
+        View d1(width, height, View::Gray8, NULL, TEST_ALIGN(width));
+        View d2(width, height, View::Gray8, NULL, TEST_ALIGN(width));
+        Rects r1, r2;
+        size_t c1, c2;
+
+        if (create)
+        {
+            FillSeedMask(s, seedIndex, emptyIndex, invalidIndex);
+            FillRandom(difference, 0, 160);
+
+            TEST_SAVE(s);
+            TEST_SAVE(difference);
+
+            f.Call(s, difference, seedIndex, emptyIndex, invalidIndex, threshold, areaMin, indexMin, d1, r1, c1);
+
+            TEST_SAVE(d1);
+        }
+        else
+        {
+            TEST_LOAD(s);
+            TEST_LOAD(difference);
+
+            TEST_LOAD(d1);
+
+            f.Call(s, difference, seedIndex, emptyIndex, invalidIndex, threshold, areaMin, indexMin, d2, r2, c2);
+
+            TEST_SAVE(d2);
+
+            result = result && Compare(d1, d2, 0, true, 64);
+        }
+
+        return result;
+    }
+
+    bool SegmentationLabelDataTest(bool create)
+    {
+        bool result = true;
+
+        result = result && SegmentationLabelDataTest(create, DW, DH, FUNC_L(SimdSegmentationLabel));
+
+        return result;
+    }
 }
@@ -421,6 +421,140 @@ namespace Test
         return result;
     }
 
+    namespace
+    {
+        struct Func5
+        {
+            typedef void(*FuncPtr)(const uint8_t * gray, size_t grayStride, size_t width, size_t height, uint8_t saturation, uint8_t boost,
+                const uint8_t * grayLo, size_t grayLoStride, const uint8_t * grayHi, size_t grayHiStride, uint16_t grayWeight,
+                uint8_t * dx, size_t dxStride, const uint8_t * dxLo, size_t dxLoStride, const uint8_t * dxHi, size_t dxHiStride, uint16_t dxWeight,
+                uint8_t * dy, size_t dyStride, const uint8_t * dyLo, size_t dyLoStride, const uint8_t * dyHi, size_t dyHiStride, uint16_t dyWeight,
+                const uint8_t * mask, size_t maskStride, uint8_t * difference, size_t differenceStride);
+
+            FuncPtr func;
+            String description;
+
+            Func5(const FuncPtr & f, const String & d) : func(f), description(d) {}
+
+            void Call(const View & gray, uint8_t saturation, uint8_t boost, const View * lo, const View * hi, const uint16_t * weight,
+                const View & mask, View & dx, View & dy, View & difference) const
+            {
+                TEST_PERFORMANCE_TEST(description);
+                func(gray.data, gray.stride, gray.width, gray.height, saturation, boost, lo[0].data, lo[0].stride, hi[0].data, hi[0].stride, weight[0],
+                    dx.data, dx.stride, lo[1].data, lo[1].stride, hi[1].data, hi[1].stride, weight[1], dy.data, dy.stride, lo[2].data, lo[2].stride, hi[2].data, hi[2].stride, weight[2],
+                    mask.data, mask.stride, difference.data, difference.stride);
+            }
+        };
+    }
+#define FUNC5(function) Func5(function, #function)
+
+    bool TextureFeatureDifferenceAutoTest(int width, int height, uint16_t weight, bool masked, const Func5 & f1, const Func5 & f2)
+    {
+        bool result = true;
+
+        TEST_LOG_SS(Info, "Test " << f1.description << " & " << f2.description << " [" << width << ", " << height << "] <" << weight << ", " << masked << ">.");
+
+        const int saturation = 16, boost = 4;
+        const uint16_t weights[3] = { weight, uint16_t(weight * 3 / 2), uint16_t(weight / 2 + 256) };
+
+        View gray(width, height, View::Gray8, NULL, TEST_ALIGN(width));
+        FillRandom(gray);
+
+        View lo[3], hi[3];
+        for (size_t i = 0; i < 3; ++i)
+        {
+            lo[i].Recreate(width, height, View::Gray8, NULL, TEST_ALIGN(width));
+            FillRandom(lo[i], 0, 127);
+            hi[i].Recreate(width, height, View::Gray8, NULL, TEST_ALIGN(width));
+            FillRandom(hi[i], 128, 255);
+        }
+
+        View mask;
+        if (masked)
+        {
+            mask.Recreate(width, height, View::Gray8, NULL, TEST_ALIGN(width));
+            FillRandom(mask);
+        }
+
+        View dx1(width, height, View::Gray8, NULL, TEST_ALIGN(width));
+        View dy1(width, height, View::Gray8, NULL, TEST_ALIGN(width));
+        View difference1(width, height, View::Gray8, NULL, TEST_ALIGN(width));
+        View dx2(width, height, View::Gray8, NULL, TEST_ALIGN(width));
+        View dy2(width, height, View::Gray8, NULL, TEST_ALIGN(width));
+        View difference2(width, height, View::Gray8, NULL, TEST_ALIGN(width));
+
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(f1.Call(gray, saturation, boost, lo, hi, weights, mask, dx1, dy1, difference1));
+
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(f2.Call(gray, saturation, boost, lo, hi, weights, mask, dx2, dy2, difference2));
+
+        result = result && Compare(dx1, dx2, 0, true, 32, 0, "dx");
+        result = result && Compare(dy1, dy2, 0, true, 32, 0, "dy");
+        result = result && Compare(difference1, difference2, 0, true, 32, 0, "difference");
+
+        View dx3(width, height, View::Gray8, NULL, TEST_ALIGN(width));
+        View dy3(width, height, View::Gray8, NULL, TEST_ALIGN(width));
+        View difference3(width, height, View::Gray8, NULL, TEST_ALIGN(width));
+        Simd::TextureBoostedSaturatedGradient(gray, saturation, boost, dx3, dy3);
+        Simd::Fill(difference3, 0);
+        Simd::AddFeatureDifference(gray, lo[0], hi[0], weights[0], difference3);
+        Simd::AddFeatureDifference(dx3, lo[1], hi[1], weights[1], difference3);
+        Simd::AddFeatureDifference(dy3, lo[2], hi[2], weights[2], difference3);
+        if (masked)
+            Simd::OperationBinary8u(difference3, mask, difference3, SimdOperationBinary8uAnd);
+
+        result = result && Compare(dx2, dx3, 0, true, 32, 0, "dx (unfused)");
+        result = result && Compare(dy2, dy3, 0, true, 32, 0, "dy (unfused)");
+        result = result && Compare(difference2, difference3, 0, true, 32, 0, "difference (unfused)");
+
+        return result;
+    }
+
+    bool TextureFeatureDifferenceAutoTest(int width, int height, const Func5 & f1, const Func5 & f2)
+    {
+        bool result = true;
+
+        result = result && TextureFeatureDifferenceAutoTest(width, height, 256 * 2, false, f1, f2);
+        result = result && TextureFeatureDifferenceAutoTest(width, height, 256 * 18, true, f1, f2);
+        result = result && TextureFeatureDifferenceAutoTest(width, height, 256 * 64, true, f1, f2);
+
+        return result;
+    }
+
+    bool TextureFeatureDifferenceAutoTest(const Func5 & f1, const Func5 & f2)
+    {
+        bool result = true;
+
+        result = result && TextureFeatureDifferenceAutoTest(W, H, f1, f2);
+        result = result && TextureFeatureDifferenceAutoTest(W + O, H - O, f1, f2);
+        result = result && TextureFeatureDifferenceAutoTest(W - O, H + O, f1, f2);
+
+        return result;
+    }
+
+    bool TextureFeatureDifferenceAutoTest()
+    {
+        bool result = true;
+
+        result = result && TextureFeatureDifferenceAutoTest(FUNC5(Simd::Base::TextureFeatureDifference), FUNC5(SimdTextureFeatureDifference));
+
+#ifdef SIMD_SSE2_ENABLE
+        if (Simd::Sse2::Enable)
+            result = result && TextureFeatureDifferenceAutoTest(FUNC5(Simd::Sse2::TextureFeatureDifference), FUNC5(SimdTextureFeatureDifference));
+#endif 
+
+#ifdef SIMD_AVX2_ENABLE
+        if (Simd::Avx2::Enable)
+            result = result && TextureFeatureDifferenceAutoTest(FUNC5(Simd::Avx2::TextureFeatureDifference), FUNC5(SimdTextureFeatureDifference));
+#endif 
+
+#ifdef SIMD_AVX512BW_ENABLE
+        if (Simd::Avx512bw::Enable)
+            result = result && TextureFeatureDifferenceAutoTest(FUNC5(Simd::Avx512bw::TextureFeatureDifference), FUNC5(SimdTextureFeatureDifference));
+#endif 
+
+        return result;
+    }
+
     //-----------------------------------------------------------------------
 
     bool TextureBoostedSaturatedGradientDataTest(bool create, int width, int height, const Func1 & f)
@@ -632,4 +766,85 @@ namespace Test
 
         return result;
     }
+
+    bool TextureFeatureDifferenceDataTest(bool create, int width, int height, const Func5 & f)
+    {
+        bool result = true;
+
+        Data data(f.description);
+
+        TEST_LOG_SS(Info, (create ? "Create" : "Verify") << " test " << f.description << " [" << width << ", " << height << "].");
+
+        const int saturation = 16, boost = 4;
+        const uint16_t weights[3] = { 256 * 18, 256 * 27, 256 * 10 };
+
+        View gray(width, height, View::Gray8, NULL, TEST_ALIGN(width));
+        View lo[3], hi[3];
+        for (size_t i = 0; i < 3; ++i)
+        {
+            lo[i].Recreate(width, height, View::Gray8, NULL, TEST_ALIGN(width));
+            hi[i].Recreate(width, height, View::Gray8, NULL, TEST_ALIGN(width));
+        }
+        View mask(width, height, View::Gray8, NULL, TEST_ALIGN(width));
+        View lo0 = lo[0], lo1 = lo[1], lo2 = lo[2], hi0 = hi[0], hi1 = hi[1], hi2 = hi[2];
+
+        View dx(width, height, View::Gray8, NULL, TEST_ALIGN(width));
+        View dy(width, height, View::Gray8, NULL, TEST_ALIGN(width));
+        View difference1(width, height, View::Gray8, NULL, TEST_ALIGN(width));
+        View difference2(width, height, View::Gray8, NULL, TEST_ALIGN(width));
+
+        if (create)
+        {
+            FillRandom(gray);
+            for (size_t i = 0; i < 3; ++i)
+            {
+                FillRandom(lo[i], 0, 127);
+                FillRandom(hi[i], 128, 255);
+            }
+            FillRandom(mask);
+
+            TEST_SAVE(gray);
+            TEST_SAVE(lo0);
+            TEST_SAVE(lo1);
+            TEST_SAVE(lo2);
+            TEST_SAVE(hi0);
+            TEST_SAVE(hi1);
+            TEST_SAVE(hi2);
+            TEST_SAVE(mask);
+
+            f.Call(gray, saturation, boost, lo, hi, weights, mask, dx, dy, difference1);
+
+            TEST_SAVE(difference1);
+        }
+        else
+        {
+            TEST_LOAD(gray);
+            TEST_LOAD(lo0);
+            TEST_LOAD(lo1);
+            TEST_LOAD(lo2);
+            TEST_LOAD(hi0);
+            TEST_LOAD(hi1);
+            TEST_LOAD(hi2);
+            TEST_LOAD(mask);
+
+            TEST_LOAD(difference1);
+
+            f.Call(gray, saturation, boost, lo, hi, weights, mask, dx, dy, difference2);
+
+            TEST_SAVE(difference2);
+
+            result = result && Compare(difference1, difference2, 0, true, 32, 0);
+        }
+
+        return result;
+    }
+
+    bool TextureFeatureDifferenceDataTest(bool create)
+    {
+        bool result = true;
+
+        result = result && TextureFeatureDifferenceDataTest(create, DW, DH, FUNC5(SimdTextureFeatureDifference));
+
+        return result;
+    }
 }